@@ -0,0 +1,371 @@
+/**
+ * @file bd_ring_test.c
+ * @brief Host Tests for bd_ring
+ *
+ * Drives a ring over an AXI DMA-like descriptor layout with recording
+ * cache callbacks: allocation, commit, reap and retire across wraparound,
+ * full and empty rings, and the one-or-two cache operations per commit.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "bd_ring.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define RING_COUNT          8
+#define BD_SIZE             64
+#define BD_STATUS_OFFSET    0x1C
+#define BD_COMPLETE_MASK    0x80000000U
+#define MAX_OPS             8
+
+typedef struct {
+    uint64_t addr;
+    uint32_t size;
+} CacheOp_t;
+
+static const BdRingLayout_t g_Layout = {
+    .bd_size = BD_SIZE,
+    .next_lo_offset = 0x00,
+    .next_hi_offset = 0x04,
+    .status_offset = BD_STATUS_OFFSET,
+    .complete_mask = BD_COMPLETE_MASK
+};
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static uint8_t g_Mem[RING_COUNT * BD_SIZE] __attribute__((aligned(64)));
+static BdRing_t g_Ring;
+
+static CacheOp_t g_FlushOps[MAX_OPS];
+static uint32_t g_NumFlush;
+static CacheOp_t g_InvalOps[MAX_OPS];
+static uint32_t g_NumInval;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void record_flush(uint64_t addr, uint32_t size)
+{
+    if (g_NumFlush < MAX_OPS) {
+        g_FlushOps[g_NumFlush] = (CacheOp_t){ addr, size };
+    }
+    g_NumFlush++;
+}
+
+static void record_inval(uint64_t addr, uint32_t size)
+{
+    if (g_NumInval < MAX_OPS) {
+        g_InvalOps[g_NumInval] = (CacheOp_t){ addr, size };
+    }
+    g_NumInval++;
+}
+
+static void clear_ops(void)
+{
+    g_NumFlush = 0;
+    g_NumInval = 0;
+}
+
+static uint64_t bd_addr(uint32_t index)
+{
+    return (uint64_t)(uintptr_t)g_Mem + (uint64_t)index * BD_SIZE;
+}
+
+static uint32_t* bd_status(uint32_t index)
+{
+    return (uint32_t*)(g_Mem + (size_t)index * BD_SIZE + BD_STATUS_OFFSET);
+}
+
+/* Engine write-back: mark n descriptors from index complete */
+static void complete_bds(uint32_t index, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        *bd_status((index + i) % RING_COUNT) |= BD_COMPLETE_MASK;
+    }
+}
+
+static void fresh_ring(void)
+{
+    CHECK(bd_ring_init(&g_Ring, g_Mem, RING_COUNT, &g_Layout, record_flush, record_inval));
+    clear_ops();
+}
+
+/* Move head and tail to index with nothing outstanding */
+static void advance_to(uint32_t index)
+{
+    uint32_t first;
+
+    if (index == 0) {
+        return;
+    }
+    first = bd_ring_alloc(&g_Ring, index);
+    CHECK(bd_ring_commit(&g_Ring, first, index));
+    bd_ring_retire(&g_Ring, index);
+    CHECK_EQ(g_Ring.head, index);
+    CHECK_EQ(g_Ring.tail, index);
+    clear_ops();
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+static void test_init_links_ring(void)
+{
+    BdRing_t ring;
+
+    CHECK(!bd_ring_init(&ring, NULL, RING_COUNT, &g_Layout, NULL, NULL));
+    CHECK(!bd_ring_init(&ring, g_Mem, 0, &g_Layout, NULL, NULL));
+    CHECK(!bd_ring_init(&ring, g_Mem, RING_COUNT, NULL, NULL, NULL));
+
+    memset(g_Mem, 0xFF, sizeof(g_Mem));
+    clear_ops();
+    CHECK(bd_ring_init(&g_Ring, g_Mem, RING_COUNT, &g_Layout, record_flush, record_inval));
+
+    for (uint32_t i = 0; i < RING_COUNT; i++) {
+        uint32_t* bd = (uint32_t*)(g_Mem + (size_t)i * BD_SIZE);
+        uint64_t next = bd_addr((i + 1) % RING_COUNT);
+
+        CHECK_EQ(bd[0], (uint32_t)next);
+        CHECK_EQ(bd[1], (uint32_t)(next >> 32));
+        CHECK_EQ(*bd_status(i), 0);
+    }
+
+    /* Whole ring cleaned once */
+    CHECK_EQ(g_NumFlush, 1);
+    CHECK_EQ(g_FlushOps[0].addr, bd_addr(0));
+    CHECK_EQ(g_FlushOps[0].size, RING_COUNT * BD_SIZE);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), RING_COUNT);
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 0);
+}
+
+static void test_full_and_empty(void)
+{
+    uint32_t first;
+
+    fresh_ring();
+
+    CHECK_EQ(bd_ring_alloc(&g_Ring, 0), BD_RING_INVALID_INDEX);
+    CHECK_EQ(bd_ring_alloc(&g_Ring, RING_COUNT + 1), BD_RING_INVALID_INDEX);
+
+    first = bd_ring_alloc(&g_Ring, RING_COUNT);
+    CHECK_EQ(first, 0);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), 0);
+    CHECK_EQ(bd_ring_alloc(&g_Ring, 1), BD_RING_INVALID_INDEX);
+
+    /* Allocated but not committed: nothing to reap or retire */
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 0);
+    CHECK_EQ(bd_ring_reap(&g_Ring, 0), 0);
+    bd_ring_retire(&g_Ring, 3);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), 0);
+
+    CHECK(bd_ring_commit(&g_Ring, first, RING_COUNT));
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), RING_COUNT);
+    CHECK_EQ(g_Ring.last, RING_COUNT - 1);
+
+    /* Engine has not written anything back yet */
+    CHECK_EQ(bd_ring_reap(&g_Ring, 0), 0);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), 0);
+
+    complete_bds(0, RING_COUNT);
+    CHECK_EQ(bd_ring_reap(&g_Ring, 0), RING_COUNT);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), RING_COUNT);
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 0);
+    CHECK_EQ(g_Ring.head, g_Ring.tail);
+}
+
+static void test_commit_order(void)
+{
+    uint32_t a, b;
+
+    fresh_ring();
+
+    a = bd_ring_alloc(&g_Ring, 2);
+    b = bd_ring_alloc(&g_Ring, 3);
+    CHECK_EQ(a, 0);
+    CHECK_EQ(b, 2);
+
+    /* Second batch cannot be committed before the first */
+    CHECK(!bd_ring_commit(&g_Ring, b, 3));
+    CHECK(!bd_ring_commit(&g_Ring, a, 0));
+    CHECK(!bd_ring_commit(&g_Ring, a, 6));
+    CHECK_EQ(g_NumFlush, 0);
+
+    CHECK(bd_ring_commit(&g_Ring, a, 2));
+    CHECK(bd_ring_commit(&g_Ring, b, 3));
+    CHECK(!bd_ring_commit(&g_Ring, bd_ring_next(&g_Ring, 4), 1));
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 5);
+    CHECK_EQ(g_Ring.last, 4);
+    CHECK_EQ(g_Ring.stats.commits, 2);
+    CHECK_EQ(g_Ring.stats.bds_committed, 5);
+}
+
+static void test_reap_stops_at_incomplete(void)
+{
+    uint32_t first;
+
+    fresh_ring();
+
+    first = bd_ring_alloc(&g_Ring, 6);
+    CHECK(bd_ring_commit(&g_Ring, first, 6));
+
+    /* 0, 1 done, 2 pending, 3 done: only 0 and 1 may retire */
+    complete_bds(0, 2);
+    complete_bds(3, 1);
+    CHECK_EQ(bd_ring_reap(&g_Ring, 0), 2);
+    CHECK_EQ(g_Ring.tail, 2);
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 4);
+
+    /* max limits the walk */
+    complete_bds(2, 4);
+    CHECK_EQ(bd_ring_reap(&g_Ring, 1), 1);
+    CHECK_EQ(bd_ring_reap(&g_Ring, 0), 3);
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 0);
+    CHECK_EQ(g_Ring.stats.bds_reaped, 6);
+
+    /* retire clamps to what is outstanding */
+    first = bd_ring_alloc(&g_Ring, 2);
+    CHECK(bd_ring_commit(&g_Ring, first, 2));
+    bd_ring_retire(&g_Ring, 100);
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 0);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), RING_COUNT);
+}
+
+static void test_contiguous_commit_one_op(void)
+{
+    uint32_t first;
+
+    fresh_ring();
+    advance_to(2);
+
+    first = bd_ring_alloc(&g_Ring, 4);
+    CHECK_EQ(first, 2);
+    CHECK(bd_ring_commit(&g_Ring, first, 4));
+    CHECK_EQ(g_NumFlush, 1);
+    CHECK_EQ(g_FlushOps[0].addr, bd_addr(2));
+    CHECK_EQ(g_FlushOps[0].size, 4 * BD_SIZE);
+
+    /* Ending exactly at the last descriptor does not wrap */
+    clear_ops();
+    first = bd_ring_alloc(&g_Ring, 2);
+    CHECK_EQ(first, 6);
+    CHECK(bd_ring_commit(&g_Ring, first, 2));
+    CHECK_EQ(g_NumFlush, 1);
+    CHECK_EQ(g_FlushOps[0].addr, bd_addr(6));
+    CHECK_EQ(g_FlushOps[0].size, 2 * BD_SIZE);
+    CHECK_EQ(g_Ring.head, 0);
+}
+
+static void test_wrapping_commit_two_ops(void)
+{
+    uint64_t ops_before;
+    uint32_t first;
+
+    fresh_ring();
+    advance_to(RING_COUNT - 2);
+    ops_before = g_Ring.stats.flush_ops;
+
+    first = bd_ring_alloc(&g_Ring, 5);
+    CHECK_EQ(first, RING_COUNT - 2);
+    CHECK_EQ(g_Ring.head, 3);
+    CHECK_EQ(bd_ring_bd_addr(&g_Ring, first + 2), bd_addr(0));
+
+    CHECK(bd_ring_commit(&g_Ring, first, 5));
+    CHECK_EQ(g_NumFlush, 2);
+    CHECK_EQ(g_FlushOps[0].addr, bd_addr(RING_COUNT - 2));
+    CHECK_EQ(g_FlushOps[0].size, 2 * BD_SIZE);
+    CHECK_EQ(g_FlushOps[1].addr, bd_addr(0));
+    CHECK_EQ(g_FlushOps[1].size, 3 * BD_SIZE);
+    CHECK_EQ(g_Ring.stats.flush_ops - ops_before, 2);
+    CHECK_EQ(g_Ring.last, 2);
+
+    /* Reaping the wrapped span invalidates it in the same two pieces */
+    complete_bds(RING_COUNT - 2, 5);
+    CHECK_EQ(bd_ring_reap(&g_Ring, 0), 5);
+    CHECK_EQ(g_NumInval, 2);
+    CHECK_EQ(g_InvalOps[0].addr, bd_addr(RING_COUNT - 2));
+    CHECK_EQ(g_InvalOps[0].size, 2 * BD_SIZE);
+    CHECK_EQ(g_InvalOps[1].addr, bd_addr(0));
+    CHECK_EQ(g_InvalOps[1].size, 3 * BD_SIZE);
+    CHECK_EQ(g_Ring.tail, 3);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), RING_COUNT);
+}
+
+static void test_many_laps(void)
+{
+    uint32_t lap_batches = 0;
+
+    fresh_ring();
+
+    /* Batches of 1..RING_COUNT keep every head/tail offset in play */
+    for (uint32_t i = 0; i < 200; i++) {
+        uint32_t n = 1 + (i * 5) % RING_COUNT;
+        uint32_t start = g_Ring.head;
+        uint32_t first;
+
+        clear_ops();
+        first = bd_ring_alloc(&g_Ring, n);
+        CHECK_EQ(first, start);
+        for (uint32_t j = 0; j < n; j++) {
+            *bd_status((first + j) % RING_COUNT) = 0;
+        }
+        CHECK(bd_ring_commit(&g_Ring, first, n));
+        CHECK_EQ(g_NumFlush, (start + n > RING_COUNT) ? 2 : 1);
+        if (start + n > RING_COUNT) {
+            lap_batches++;
+        }
+
+        complete_bds(first, n);
+        CHECK_EQ(bd_ring_reap(&g_Ring, 0), n);
+        CHECK_EQ(g_Ring.head, (start + n) % RING_COUNT);
+        CHECK_EQ(g_Ring.tail, g_Ring.head);
+    }
+    CHECK(lap_batches > 0);
+}
+
+static void test_reset(void)
+{
+    uint32_t first;
+
+    fresh_ring();
+    first = bd_ring_alloc(&g_Ring, 5);
+    CHECK(bd_ring_commit(&g_Ring, first, 3));
+
+    bd_ring_reset(&g_Ring);
+    CHECK_EQ(g_Ring.head, 0);
+    CHECK_EQ(g_Ring.tail, 0);
+    CHECK_EQ(bd_ring_free_count(&g_Ring), RING_COUNT);
+    CHECK_EQ(bd_ring_outstanding(&g_Ring), 0);
+    CHECK_EQ(g_Ring.last, RING_COUNT - 1);
+
+    bd_ring_clear_stats(&g_Ring);
+    CHECK_EQ(g_Ring.stats.commits, 0);
+    CHECK_EQ(g_Ring.stats.flush_ops, 0);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+int main(void)
+{
+    printf("bd_ring_test:\n");
+    RUN_TEST(test_init_links_ring);
+    RUN_TEST(test_full_and_empty);
+    RUN_TEST(test_commit_order);
+    RUN_TEST(test_reap_stops_at_incomplete);
+    RUN_TEST(test_contiguous_commit_one_op);
+    RUN_TEST(test_wrapping_commit_two_ops);
+    RUN_TEST(test_many_laps);
+    RUN_TEST(test_reset);
+    return test_report("bd_ring_test");
+}
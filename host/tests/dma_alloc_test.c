@@ -0,0 +1,324 @@
+/**
+ * @file dma_alloc_test.c
+ * @brief Host Tests for dma_alloc
+ *
+ * Arenas describe address ranges that are never dereferenced, so the
+ * tests use target-like addresses (DDR, OCM) without backing memory.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "dma_alloc.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define DDR_BASE            0x10000000ULL
+#define DDR_SIZE            (64ULL * 1024 * 1024)
+#define OCM_BASE            0xFFFC0000ULL
+#define OCM_SIZE            (256ULL * 1024)
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static DmaArena_t g_Arena;
+static DmaArena_t g_Other;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static DmaAllocStats_t arena_stats(const DmaArena_t* arena)
+{
+    DmaAllocStats_t stats;
+
+    dma_arena_get_stats(arena, &stats);
+    return stats;
+}
+
+/* Arena back to a single free extent covering everything */
+static bool arena_is_empty(const DmaArena_t* arena)
+{
+    DmaAllocStats_t stats = arena_stats(arena);
+
+    return arena->num_extents == 1 && stats.free_bytes == arena->size &&
+           stats.largest_free == arena->size && stats.bytes_in_use == 0 &&
+           stats.slabs == 0 && stats.large_blocks == 0;
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+static void test_init(void)
+{
+    CHECK_EQ(dma_arena_init(NULL, "x", DDR_BASE, DDR_SIZE), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(dma_arena_init(&g_Arena, "x", DDR_BASE + 1, 32), DMA_ALLOC_ERR_INVALID);
+
+    /* Base rounded up, size rounded down to cache lines */
+    CHECK_EQ(dma_arena_init(&g_Arena, "x", DDR_BASE + 1, 4096), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.base, DDR_BASE + DMA_ALLOC_MIN_ALIGN);
+    CHECK_EQ(g_Arena.size, 4096 - DMA_ALLOC_MIN_ALIGN);
+    CHECK(arena_is_empty(&g_Arena));
+
+    CHECK(dma_arena_owns(&g_Arena, g_Arena.base));
+    CHECK(!dma_arena_owns(&g_Arena, g_Arena.base + g_Arena.size));
+    CHECK(!dma_arena_owns(&g_Arena, DDR_BASE));
+}
+
+static void test_size_classes(void)
+{
+    CHECK_EQ(dma_alloc_size_class(1, 0), 0);
+    CHECK_EQ(dma_alloc_size_class(64, 0), 0);
+    CHECK_EQ(dma_alloc_size_class(65, 0), 1);
+    CHECK_EQ(dma_alloc_size_class(100, 4096), 6);
+    CHECK_EQ(dma_alloc_size_class(DMA_ALLOC_MAX_CLASS_SIZE, 0), DMA_ALLOC_NUM_CLASSES - 1);
+    CHECK_EQ(dma_alloc_size_class(DMA_ALLOC_MAX_CLASS_SIZE + 1, 0), DMA_ALLOC_NUM_CLASSES);
+    CHECK_EQ(dma_alloc_class_size(0), 64);
+    CHECK_EQ(dma_alloc_class_size(DMA_ALLOC_NUM_CLASSES - 1), 32 * 1024);
+}
+
+static void test_slab_size_scales(void)
+{
+    CHECK_EQ(dma_arena_init(&g_Arena, "ddr", DDR_BASE, DDR_SIZE), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.slab_size, DMA_ALLOC_MAX_SLAB_SIZE);
+    CHECK_EQ(g_Arena.slab_classes, DMA_ALLOC_NUM_CLASSES);
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ocm", OCM_BASE, OCM_SIZE), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.slab_size, 16 * 1024);
+    CHECK_EQ(g_Arena.slab_classes, 8);
+
+    /* Too small for slabs: everything takes the extent path */
+    CHECK_EQ(dma_arena_init(&g_Arena, "tiny", OCM_BASE, 32 * 1024), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.slab_size, 0);
+    CHECK(dma_arena_alloc(&g_Arena, 64, 0) != 0);
+    CHECK_EQ(arena_stats(&g_Arena).slabs, 0);
+    CHECK_EQ(arena_stats(&g_Arena).large_blocks, 1);
+}
+
+static void test_small_alloc_free(void)
+{
+    uint64_t blocks[16];
+    DmaAllocStats_t stats;
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ddr", DDR_BASE, DDR_SIZE), DMA_ALLOC_OK);
+
+    for (uint32_t i = 0; i < 16; i++) {
+        blocks[i] = dma_arena_alloc(&g_Arena, 100, 0);
+        CHECK(blocks[i] != 0);
+        CHECK_EQ(blocks[i] % 128, 0);
+        for (uint32_t j = 0; j < i; j++) {
+            CHECK(blocks[i] != blocks[j]);
+        }
+    }
+
+    /* One 128B-class slab, slab-size aligned, blocks handed out in order */
+    stats = arena_stats(&g_Arena);
+    CHECK_EQ(stats.slabs, 1);
+    CHECK_EQ(stats.class_blocks[1], 16);
+    CHECK_EQ(stats.bytes_in_use, 16 * 128);
+    CHECK_EQ(blocks[0] % DMA_ALLOC_MAX_SLAB_SIZE, 0);
+    CHECK_EQ(blocks[15], blocks[0] + 15 * 128);
+
+    /* A freed block is reused first */
+    CHECK_EQ(dma_arena_free(&g_Arena, blocks[5]), DMA_ALLOC_OK);
+    CHECK_EQ(dma_arena_alloc(&g_Arena, 128, 0), blocks[5]);
+
+    /* A different class gets its own slab */
+    CHECK(dma_arena_alloc(&g_Arena, 1024, 0) != 0);
+    CHECK_EQ(arena_stats(&g_Arena).slabs, 2);
+
+    CHECK_EQ(arena_stats(&g_Arena).allocs, 18);
+    CHECK_EQ(arena_stats(&g_Arena).frees, 1);
+}
+
+static void test_slab_returned_when_empty(void)
+{
+    uint32_t per_slab = DMA_ALLOC_MAX_SLAB_SIZE / 4096;
+    uint64_t blocks[2 * 16];
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ddr", DDR_BASE, DDR_SIZE), DMA_ALLOC_OK);
+
+    /* Fill one slab and spill into a second */
+    for (uint32_t i = 0; i < per_slab + 1; i++) {
+        blocks[i] = dma_arena_alloc(&g_Arena, 4096, 0);
+        CHECK(blocks[i] != 0);
+    }
+    CHECK_EQ(arena_stats(&g_Arena).slabs, 2);
+
+    /* Emptying the second slab hands it back */
+    CHECK_EQ(dma_arena_free(&g_Arena, blocks[per_slab]), DMA_ALLOC_OK);
+    CHECK_EQ(arena_stats(&g_Arena).slabs, 1);
+
+    for (uint32_t i = 0; i < per_slab; i++) {
+        CHECK_EQ(dma_arena_free(&g_Arena, blocks[i]), DMA_ALLOC_OK);
+    }
+    CHECK(arena_is_empty(&g_Arena));
+}
+
+static void test_extent_split_and_coalesce(void)
+{
+    const uint64_t sz = 1024 * 1024;
+    uint64_t a, b, c;
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ddr", DDR_BASE, DDR_SIZE), DMA_ALLOC_OK);
+
+    a = dma_arena_alloc(&g_Arena, sz, 0);
+    b = dma_arena_alloc(&g_Arena, sz, 0);
+    c = dma_arena_alloc(&g_Arena, sz, 0);
+    CHECK_EQ(a, DDR_BASE);
+    CHECK_EQ(b, a + sz);
+    CHECK_EQ(c, b + sz);
+    CHECK_EQ(g_Arena.num_extents, 4);
+    CHECK_EQ(arena_stats(&g_Arena).large_blocks, 3);
+
+    /* Middle hole, then its neighbours merge into it from both sides */
+    CHECK_EQ(dma_arena_free(&g_Arena, b), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.num_extents, 4);
+    CHECK_EQ(arena_stats(&g_Arena).largest_free, DDR_SIZE - 3 * sz);
+
+    /* First fit: a smaller request lands in the hole */
+    CHECK_EQ(dma_arena_alloc(&g_Arena, sz / 2, 0), b);
+    CHECK_EQ(g_Arena.num_extents, 5);
+    CHECK_EQ(dma_arena_free(&g_Arena, b), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.num_extents, 4);
+
+    CHECK_EQ(dma_arena_free(&g_Arena, a), DMA_ALLOC_OK);
+    CHECK_EQ(g_Arena.num_extents, 3);
+    CHECK_EQ(dma_arena_free(&g_Arena, c), DMA_ALLOC_OK);
+    CHECK(arena_is_empty(&g_Arena));
+}
+
+static void test_alignment_padding(void)
+{
+    const uint64_t base = DDR_BASE + 4096;
+    uint64_t a, b;
+
+    /* Base is 4KB aligned but not 64KB aligned */
+    CHECK_EQ(dma_arena_init(&g_Arena, "ddr", base, DDR_SIZE), DMA_ALLOC_OK);
+
+    a = dma_arena_alloc(&g_Arena, 100 * 1024, 64 * 1024);
+    CHECK(a != 0);
+    CHECK_EQ(a % (64 * 1024), 0);
+    CHECK_EQ(a, (base + 0xFFFF) & ~0xFFFFULL);
+
+    /* The padding in front stays free and serves a later request */
+    CHECK_EQ(g_Arena.extents[0].state, DMA_EXTENT_FREE);
+    CHECK_EQ(g_Arena.extents[0].size, a - base);
+    b = dma_arena_alloc(&g_Arena, 40 * 1024, 0);
+    CHECK_EQ(b, base);
+
+    /* Non power-of-two alignment is rejected */
+    CHECK_EQ(dma_arena_alloc(&g_Arena, 4096, 3000), 0);
+    CHECK_EQ(dma_arena_alloc(&g_Arena, 0, 0), 0);
+
+    CHECK_EQ(dma_arena_free(&g_Arena, a), DMA_ALLOC_OK);
+    CHECK_EQ(dma_arena_free(&g_Arena, b), DMA_ALLOC_OK);
+    CHECK(arena_is_empty(&g_Arena));
+}
+
+static void test_rejects_double_and_foreign_free(void)
+{
+    uint64_t small, large, other;
+    DmaAllocStats_t before;
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ddr", DDR_BASE, DDR_SIZE), DMA_ALLOC_OK);
+    CHECK_EQ(dma_arena_init(&g_Other, "ocm", OCM_BASE, OCM_SIZE), DMA_ALLOC_OK);
+
+    small = dma_arena_alloc(&g_Arena, 256, 0);
+    large = dma_arena_alloc(&g_Arena, 1024 * 1024, 0);
+    other = dma_arena_alloc(&g_Other, 256, 0);
+    CHECK(small != 0 && large != 0 && other != 0);
+
+    /* Foreign: another arena's block, outside the range, inside a block */
+    CHECK_EQ(dma_arena_free(&g_Arena, other), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(dma_arena_free(&g_Arena, DDR_BASE + DDR_SIZE), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(dma_arena_free(&g_Arena, small + 64), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(dma_arena_free(&g_Arena, large + 64), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(dma_arena_free(NULL, small), DMA_ALLOC_ERR_INVALID);
+
+    CHECK_EQ(dma_arena_free(&g_Arena, small), DMA_ALLOC_OK);
+    CHECK_EQ(dma_arena_free(&g_Arena, large), DMA_ALLOC_OK);
+
+    /* Double frees leave the accounting untouched */
+    before = arena_stats(&g_Arena);
+    CHECK_EQ(dma_arena_free(&g_Arena, small), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(dma_arena_free(&g_Arena, large), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(arena_stats(&g_Arena).frees, before.frees);
+    CHECK_EQ(arena_stats(&g_Arena).bytes_in_use, before.bytes_in_use);
+    CHECK(arena_is_empty(&g_Arena));
+
+    /* Double free of a block whose slab is still live */
+    small = dma_arena_alloc(&g_Arena, 256, 0);
+    large = dma_arena_alloc(&g_Arena, 256, 0);
+    CHECK_EQ(dma_arena_free(&g_Arena, small), DMA_ALLOC_OK);
+    CHECK_EQ(dma_arena_free(&g_Arena, small), DMA_ALLOC_ERR_INVALID);
+    CHECK_EQ(arena_stats(&g_Arena).class_blocks[2], 1);
+
+    CHECK_EQ(dma_arena_free(&g_Other, other), DMA_ALLOC_OK);
+    CHECK(arena_is_empty(&g_Other));
+}
+
+static void test_ocm_small_requests_do_not_pin_arena(void)
+{
+    uint64_t blocks[DMA_ALLOC_NUM_CLASSES];
+    DmaAllocStats_t stats;
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ocm", OCM_BASE, OCM_SIZE), DMA_ALLOC_OK);
+
+    /* One request per class: slab classes pin 16KB each, the rest are exact */
+    for (uint32_t c = 0; c < DMA_ALLOC_NUM_CLASSES; c++) {
+        blocks[c] = dma_arena_alloc(&g_Arena, dma_alloc_class_size(c), 0);
+        CHECK(blocks[c] != 0);
+    }
+    stats = arena_stats(&g_Arena);
+    CHECK_EQ(stats.slabs, 8);
+    CHECK_EQ(stats.large_blocks, 2);
+    CHECK_EQ(stats.free_bytes, OCM_SIZE - 8 * 16 * 1024 - (16 + 32) * 1024);
+
+    /* A half-arena buffer still fits */
+    CHECK(dma_arena_alloc(&g_Arena, 64 * 1024, 0) != 0);
+
+    dma_arena_reset(&g_Arena);
+    CHECK(arena_is_empty(&g_Arena));
+}
+
+static void test_exhaustion(void)
+{
+    uint32_t count = 0;
+
+    CHECK_EQ(dma_arena_init(&g_Arena, "ocm", OCM_BASE, OCM_SIZE), DMA_ALLOC_OK);
+
+    while (dma_arena_alloc(&g_Arena, 64 * 1024, 0) != 0) {
+        count++;
+    }
+    CHECK_EQ(count, 4);
+    CHECK_EQ(arena_stats(&g_Arena).failures, 1);
+    CHECK_EQ(dma_arena_alloc(&g_Arena, 64, 0), 0);
+    CHECK_EQ(arena_stats(&g_Arena).failures, 2);
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+int main(void)
+{
+    printf("dma_alloc_test:\n");
+    RUN_TEST(test_init);
+    RUN_TEST(test_size_classes);
+    RUN_TEST(test_slab_size_scales);
+    RUN_TEST(test_small_alloc_free);
+    RUN_TEST(test_slab_returned_when_empty);
+    RUN_TEST(test_extent_split_and_coalesce);
+    RUN_TEST(test_alignment_padding);
+    RUN_TEST(test_rejects_double_and_foreign_free);
+    RUN_TEST(test_ocm_small_requests_do_not_pin_arena);
+    RUN_TEST(test_exhaustion);
+    return test_report("dma_alloc_test");
+}
@@ -0,0 +1,57 @@
+/**
+ * @file host_test.h
+ * @brief Minimal Check Macros for the Host Unit Tests
+ *
+ * The tests build BSP-free modules from src/utils with the host compiler.
+ * A failed CHECK prints its location and is counted; each test program
+ * exits non-zero if any check failed.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+static unsigned long g_TestChecks = 0;
+static unsigned long g_TestFailures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        g_TestChecks++;                                                         \
+        if (!(cond)) {                                                          \
+            g_TestFailures++;                                                   \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                          \
+    do {                                                                        \
+        unsigned long long _a = (unsigned long long)(a);                        \
+        unsigned long long _b = (unsigned long long)(b);                        \
+        g_TestChecks++;                                                         \
+        if (_a != _b) {                                                         \
+            g_TestFailures++;                                                   \
+            fprintf(stderr, "%s:%d: %s == %s failed (0x%llx != 0x%llx)\n",      \
+                    __FILE__, __LINE__, #a, #b, _a, _b);                        \
+        }                                                                       \
+    } while (0)
+
+#define RUN_TEST(fn)                                                            \
+    do {                                                                        \
+        unsigned long _before = g_TestFailures;                                 \
+        fn();                                                                   \
+        printf("  %-40s %s\n", #fn, g_TestFailures == _before ? "ok" : "FAIL"); \
+    } while (0)
+
+/* Summary line and exit status for main() */
+static inline int test_report(const char* name)
+{
+    printf("%s: %lu checks, %lu failure(s)\n", name, g_TestChecks, g_TestFailures);
+    return g_TestFailures == 0 ? 0 : 1;
+}
+
+#endif /* HOST_TEST_H */
@@ -0,0 +1,250 @@
+/**
+ * @file spsc_test.c
+ * @brief Host Tests for spsc_queue and smp_worker
+ *
+ * Single-threaded checks of the queue's full/empty/wraparound behaviour,
+ * then a pthread producer/consumer pair and an smp_worker driven from a
+ * second thread, standing in for the two A72 cores.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "host_test.h"
+#include "spsc_queue.h"
+#include "smp_worker.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define QUEUE_CAPACITY      16
+#define THREAD_ITEMS        200000U
+#define WORKER_ROUNDS       20
+#define WORKER_JOBS         1000U
+
+typedef struct {
+    uint32_t seq;
+    uint32_t check;
+} Item_t;
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static SpscQueue_t g_Queue;
+static Item_t g_Storage[QUEUE_CAPACITY];
+static SmpWorker_t g_Worker __attribute__((aligned(64)));
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint32_t item_check(uint32_t seq)
+{
+    return seq * 2654435761U ^ 0xA5A5A5A5U;
+}
+
+static void* producer_thread(void* arg)
+{
+    (void)arg;
+
+    for (uint32_t i = 0; i < THREAD_ITEMS; i++) {
+        Item_t item = { i, item_check(i) };
+
+        while (!spsc_queue_push(&g_Queue, &item)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* worker_thread(void* arg)
+{
+    smp_worker_run((SmpWorker_t*)arg);
+    return NULL;
+}
+
+/* Job: square the value in place, return its low byte as status */
+static int square_job(void* arg)
+{
+    uint64_t* v = (uint64_t*)arg;
+
+    *v = *v * *v;
+    return (int)(*v & 0xFF);
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+static void test_init_rejects_bad_params(void)
+{
+    SpscQueue_t q;
+
+    CHECK(!spsc_queue_init(&q, g_Storage, 0, sizeof(Item_t)));
+    CHECK(!spsc_queue_init(&q, g_Storage, 12, sizeof(Item_t)));
+    CHECK(!spsc_queue_init(&q, NULL, QUEUE_CAPACITY, sizeof(Item_t)));
+    CHECK(!spsc_queue_init(&q, g_Storage, QUEUE_CAPACITY, 0));
+    CHECK(spsc_queue_init(&q, g_Storage, QUEUE_CAPACITY, sizeof(Item_t)));
+}
+
+static void test_full_and_empty(void)
+{
+    Item_t item;
+
+    CHECK(spsc_queue_init(&g_Queue, g_Storage, QUEUE_CAPACITY, sizeof(Item_t)));
+    CHECK_EQ(spsc_queue_count(&g_Queue), 0);
+    CHECK(!spsc_queue_pop(&g_Queue, &item));
+
+    for (uint32_t i = 0; i < QUEUE_CAPACITY; i++) {
+        item.seq = i;
+        CHECK(spsc_queue_push(&g_Queue, &item));
+    }
+    CHECK_EQ(spsc_queue_count(&g_Queue), QUEUE_CAPACITY);
+    item.seq = 999;
+    CHECK(!spsc_queue_push(&g_Queue, &item));
+
+    for (uint32_t i = 0; i < QUEUE_CAPACITY; i++) {
+        CHECK(spsc_queue_pop(&g_Queue, &item));
+        CHECK_EQ(item.seq, i);
+    }
+    CHECK(!spsc_queue_pop(&g_Queue, &item));
+    CHECK_EQ(spsc_queue_count(&g_Queue), 0);
+}
+
+static void test_wraparound_order(void)
+{
+    uint32_t next_push = 0, next_pop = 0;
+    Item_t item;
+
+    CHECK(spsc_queue_init(&g_Queue, g_Storage, QUEUE_CAPACITY, sizeof(Item_t)));
+
+    /* Uneven batches walk the indices around the ring many times */
+    for (uint32_t round = 0; round < 1000; round++) {
+        uint32_t n_push = 1 + round % QUEUE_CAPACITY;
+        uint32_t n_pop = 1 + (round * 7) % QUEUE_CAPACITY;
+
+        for (uint32_t i = 0; i < n_push; i++) {
+            item.seq = next_push;
+            if (!spsc_queue_push(&g_Queue, &item)) {
+                break;
+            }
+            next_push++;
+        }
+        for (uint32_t i = 0; i < n_pop; i++) {
+            if (!spsc_queue_pop(&g_Queue, &item)) {
+                break;
+            }
+            CHECK_EQ(item.seq, next_pop);
+            next_pop++;
+        }
+        CHECK_EQ(spsc_queue_count(&g_Queue), next_push - next_pop);
+    }
+}
+
+static void test_threaded_producer_consumer(void)
+{
+    pthread_t producer;
+    uint32_t expect = 0;
+    uint32_t bad = 0;
+    Item_t item;
+
+    CHECK(spsc_queue_init(&g_Queue, g_Storage, QUEUE_CAPACITY, sizeof(Item_t)));
+    CHECK_EQ(pthread_create(&producer, NULL, producer_thread, NULL), 0);
+
+    while (expect < THREAD_ITEMS) {
+        if (!spsc_queue_pop(&g_Queue, &item)) {
+            sched_yield();
+            continue;
+        }
+        if (item.seq != expect || item.check != item_check(expect)) {
+            bad++;
+        }
+        expect++;
+    }
+
+    pthread_join(producer, NULL);
+    CHECK_EQ(bad, 0);
+    CHECK(!spsc_queue_pop(&g_Queue, &item));
+}
+
+static void test_worker_jobs(void)
+{
+    static uint64_t values[WORKER_JOBS];
+    pthread_t worker;
+    uint32_t mismatches = 0;
+    SmpDone_t done;
+
+    smp_worker_init(&g_Worker);
+    CHECK_EQ(pthread_create(&worker, NULL, worker_thread, &g_Worker), 0);
+
+    for (uint32_t round = 0; round < WORKER_ROUNDS; round++) {
+        uint32_t submitted = 0, reaped = 0;
+
+        for (uint32_t i = 0; i < WORKER_JOBS; i++) {
+            values[i] = round * WORKER_JOBS + i;
+        }
+
+        while (reaped < WORKER_JOBS) {
+            if (submitted < WORKER_JOBS &&
+                smp_worker_submit(&g_Worker, square_job, &values[submitted], submitted)) {
+                submitted++;
+                continue;
+            }
+            if (!smp_worker_reap(&g_Worker, &done)) {
+                sched_yield();
+                continue;
+            }
+            uint64_t v = (uint64_t)round * WORKER_JOBS + done.cookie;
+            if (values[done.cookie] != v * v || done.status != (int)((v * v) & 0xFF)) {
+                mismatches++;
+            }
+            reaped++;
+        }
+        CHECK_EQ(smp_worker_pending(&g_Worker), 0);
+    }
+
+    smp_worker_stop(&g_Worker);
+    pthread_join(worker, NULL);
+
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(g_Worker.jobs_run, (uint64_t)WORKER_ROUNDS * WORKER_JOBS);
+    CHECK(!smp_worker_is_running(&g_Worker));
+}
+
+static void test_worker_depth_limit(void)
+{
+    static uint64_t value = 3;
+    uint32_t accepted = 0;
+    SmpDone_t done;
+
+    /* No worker running: submissions stop at the queue depth */
+    smp_worker_init(&g_Worker);
+    while (accepted < 2 * SMP_WORKER_QUEUE_DEPTH &&
+           smp_worker_submit(&g_Worker, square_job, &value, accepted)) {
+        accepted++;
+    }
+    CHECK_EQ(accepted, SMP_WORKER_QUEUE_DEPTH);
+    CHECK_EQ(smp_worker_pending(&g_Worker), SMP_WORKER_QUEUE_DEPTH);
+    CHECK(!smp_worker_reap(&g_Worker, &done));
+}
+
+/*******************************************************************************
+ * Main
+ ******************************************************************************/
+
+int main(void)
+{
+    printf("spsc_test:\n");
+    RUN_TEST(test_init_rejects_bad_params);
+    RUN_TEST(test_full_and_empty);
+    RUN_TEST(test_wraparound_order);
+    RUN_TEST(test_threaded_producer_consumer);
+    RUN_TEST(test_worker_jobs);
+    RUN_TEST(test_worker_depth_limit);
+    return test_report("spsc_test");
+}
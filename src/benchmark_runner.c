@@ -0,0 +1,414 @@
+/**
+ * @file benchmark_runner.c
+ * @brief Generic Test Runner
+ *
+ * Implements benchmark_run_test() on top of the DMA operations table, so
+ * any TestConfig_t (engine, regions, mode, channels, direction) can be
+ * executed without engine-specific code in the caller.
+ */
+
+#include <string.h>
+#include "dma_benchmark.h"
+#include "drivers/dma_ops.h"
+#include "utils/timer_utils.h"
+#include "utils/memory_utils.h"
+#include "utils/data_patterns.h"
+#include "utils/cache_utils.h"
+#include "utils/dma_phase.h"
+#include "utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define RUNNER_MAX_CHANNELS     16
+#define RUNNER_UNALIGNED_OFFSET 4       /* Byte offset used when !aligned */
+#define RUNNER_BUF_ALIGN        KB(4)
+
+typedef struct {
+    uint64_t src_addr;
+    uint64_t dst_addr;
+    uint64_t src_block;         /* Allocated blocks (addr minus skew) */
+    uint64_t dst_block;
+    uint32_t seed;
+} RunnerChannel_t;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/**
+ * Resolve the transfer mode into the submit flavor. POLLING runs the
+ * channels asynchronously and takes whichever descriptor mode the engine
+ * offers; INTERRUPT needs a wired-up completion interrupt.
+ */
+static int runner_resolve_mode(DmaMode_t mode, const DmaCaps_t* caps,
+                               bool* use_sg, bool* async)
+{
+    *async = false;
+
+    switch (mode) {
+        case DMA_MODE_SIMPLE:
+            *use_sg = false;
+            return caps->has_simple ? DMA_SUCCESS : DMA_ERROR_NOT_SUPPORTED;
+
+        case DMA_MODE_SG:
+            *use_sg = true;
+            return caps->has_sg ? DMA_SUCCESS : DMA_ERROR_NOT_SUPPORTED;
+
+        case DMA_MODE_POLLING:
+            *use_sg = caps->has_sg;
+            *async = true;
+            return DMA_SUCCESS;
+
+        case DMA_MODE_INTERRUPT:
+            *use_sg = caps->has_sg;
+            return caps->has_irq ? DMA_SUCCESS : DMA_ERROR_NOT_SUPPORTED;
+
+        default:
+            return DMA_ERROR_INVALID_PARAM;
+    }
+}
+
+static void runner_free_buffers(RunnerChannel_t* ch, uint32_t num_channels)
+{
+    uint32_t c;
+
+    for (c = 0; c < num_channels; c++) {
+        memory_free_dma_buffer(ch[c].src_block);
+        memory_free_dma_buffer(ch[c].dst_block);
+        ch[c].src_block = ch[c].dst_block = 0;
+    }
+}
+
+/**
+ * Allocate one read and one write buffer per channel. Bidirectional runs
+ * swap the regions on odd channels so both directions are in flight.
+ */
+static int runner_place_buffers(const TestConfig_t* config, uint32_t num_channels,
+                                RunnerChannel_t* ch)
+{
+    uint32_t size = config->transfer_size;
+    uint32_t offset = config->aligned ? 0 : RUNNER_UNALIGNED_OFFSET;
+    uint32_t c;
+
+    memset(ch, 0, num_channels * sizeof(*ch));
+
+    for (c = 0; c < num_channels; c++) {
+        MemoryRegion_t rd_region = config->src_region;
+        MemoryRegion_t wr_region = config->dst_region;
+
+        if (config->bidirectional && (c & 1)) {
+            rd_region = config->dst_region;
+            wr_region = config->src_region;
+        }
+
+        ch[c].src_block = (uint64_t)(uintptr_t)memory_alloc_aligned(rd_region, size + offset,
+                                                                    RUNNER_BUF_ALIGN);
+        ch[c].dst_block = (uint64_t)(uintptr_t)memory_alloc_aligned(wr_region, size + offset,
+                                                                    RUNNER_BUF_ALIGN);
+        ch[c].src_addr = ch[c].src_block + offset;
+        ch[c].dst_addr = ch[c].dst_block + offset;
+        ch[c].seed = c;
+
+        if (ch[c].src_block == 0 || ch[c].dst_block == 0) {
+            runner_free_buffers(ch, c + 1);
+            return DMA_ERROR_NO_MEMORY;
+        }
+    }
+
+    return DMA_SUCCESS;
+}
+
+static void runner_close_channels(const DmaOps_t* ops, uint32_t num_channels)
+{
+    uint32_t c;
+
+    if (ops->close_channel == NULL) {
+        return;
+    }
+    for (c = 0; c < num_channels; c++) {
+        ops->close_channel(c);
+    }
+}
+
+/**
+ * Bring every channel in @p pending to rest after a failed iteration, so
+ * the caller can free the buffers. Channels are waited out; if one will
+ * not finish, or the failing channel timed out and may still be moving
+ * data, the engine is reset.
+ */
+static void runner_drain_channels(const DmaOps_t* ops, uint32_t num_channels,
+                                  uint32_t pending, int failure)
+{
+    bool reset = (failure == DMA_ERROR_TIMEOUT);
+    uint32_t c;
+
+    for (c = 0; c < num_channels && !reset; c++) {
+        if ((pending & (1U << c)) && ops->wait(c, DMA_TIMEOUT_US) != DMA_SUCCESS) {
+            reset = true;
+        }
+    }
+
+    if (reset && ops->reset != NULL) {
+        ops->reset();
+    }
+}
+
+/**
+ * Submit one transfer per channel and wait until every channel is done.
+ * Synchronous modes wait on each channel in turn; async mode round-robins
+ * the non-blocking poll so channels are reaped in completion order.
+ */
+static int runner_run_iteration(const DmaOps_t* ops, const RunnerChannel_t* ch,
+                                uint32_t num_channels, uint32_t size,
+                                bool use_sg, bool async, uint64_t* submit_ns)
+{
+    uint32_t pending = 0;
+    uint64_t start, deadline;
+    uint32_t c;
+    int status;
+
+    start = timer_start();
+    for (c = 0; c < num_channels; c++) {
+        status = ops->submit(c, ch[c].src_addr, ch[c].dst_addr, size, use_sg);
+        if (status != DMA_SUCCESS) {
+            /* Drain whatever was already started before reporting */
+            runner_drain_channels(ops, num_channels, pending, status);
+            return status;
+        }
+        pending |= (1U << c);
+    }
+    *submit_ns += timer_stop_ns(start);
+
+    if (!async) {
+        for (c = 0; c < num_channels; c++) {
+            status = ops->wait(c, DMA_TIMEOUT_US);
+            if (status != DMA_SUCCESS) {
+                runner_drain_channels(ops, num_channels, pending & ~((2U << c) - 1), status);
+                return status;
+            }
+        }
+        return DMA_SUCCESS;
+    }
+
+    deadline = timer_get_cycles() +
+               (timer_get_frequency() / 1000000ULL) * DMA_TIMEOUT_US;
+
+    while (pending != 0) {
+        for (c = 0; c < num_channels; c++) {
+            if (!(pending & (1U << c))) {
+                continue;
+            }
+            status = ops->poll(c);
+            if (status == DMA_ERROR_BUSY) {
+                continue;
+            }
+            if (status != DMA_SUCCESS) {
+                runner_drain_channels(ops, num_channels, pending & ~(1U << c), status);
+                return status;
+            }
+            pending &= ~(1U << c);
+        }
+
+        if (pending != 0 && timer_get_cycles() > deadline) {
+            runner_drain_channels(ops, num_channels, pending, DMA_ERROR_TIMEOUT);
+            return DMA_ERROR_TIMEOUT;
+        }
+    }
+
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int benchmark_run_test(const TestConfig_t* config, TestResult_t* result)
+{
+    RunnerChannel_t ch[RUNNER_MAX_CHANNELS];
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    uint32_t num_channels, iterations, opened = 0;
+    uint32_t size, i, c;
+    uint64_t start, iter_ns;
+    uint64_t total_ns = 0, submit_ns = 0;
+    uint64_t min_ns = UINT64_MAX, max_ns = 0;
+    uint64_t iter_bytes;
+    bool use_sg, async, verify;
+    int status;
+
+    if (config == NULL || result == NULL) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    ops = dma_ops_get(config->dma_type);
+    if (ops == NULL || dma_ops_get_caps(config->dma_type, &caps) != DMA_SUCCESS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    size = config->transfer_size;
+    if (size == 0 || size > caps.max_transfer_len) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    num_channels = (config->num_channels == 0) ? 1 : config->num_channels;
+    if (num_channels > caps.num_channels || num_channels > RUNNER_MAX_CHANNELS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    if (config->bidirectional && num_channels < 2) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = runner_resolve_mode(config->mode, &caps, &use_sg, &async);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    iterations = (config->iterations == 0) ? DEFAULT_TEST_ITERATIONS : config->iterations;
+    verify = config->verify_data || config->test_type == TEST_INTEGRITY;
+
+    status = runner_place_buffers(config, num_channels, ch);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    LOG_DEBUG("Run: %s %s %lu B x%lu ch, %s%s\r\n",
+              ops->name, dma_mode_to_string(config->mode), (unsigned long)size,
+              (unsigned long)num_channels, use_sg ? "SG" : "simple",
+              async ? " async" : "");
+
+    memset(result, 0, sizeof(*result));
+    result->dma_type = config->dma_type;
+    result->test_type = config->test_type;
+    result->src_region = config->src_region;
+    result->dst_region = config->dst_region;
+    result->pattern = config->pattern;
+    result->mode = config->mode;
+    result->transfer_size = size;
+    result->num_channels = num_channels;
+    result->min_throughput = UINT32_MAX;
+
+    /* Prepare source data (distinct seed per channel) */
+    for (c = 0; c < num_channels; c++) {
+        pattern_fill((void*)(uintptr_t)ch[c].src_addr, size, config->pattern, ch[c].seed);
+        if (caps.needs_cache_maint) {
+            cache_prep_dma_src(ch[c].src_addr, size);
+        }
+    }
+
+    if (ops->open_channel != NULL) {
+        for (opened = 0; opened < num_channels; opened++) {
+            status = ops->open_channel(opened);
+            if (status != DMA_SUCCESS) {
+                goto out;
+            }
+        }
+    }
+
+    /* Warmup */
+    for (i = 0; i < WARMUP_ITERATIONS; i++) {
+        status = runner_run_iteration(ops, ch, num_channels, size, use_sg, async, &submit_ns);
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+    }
+    submit_ns = 0;
+
+    iter_bytes = (uint64_t)size * num_channels;
+
+    dma_phase_record_start();
+    for (i = 0; i < iterations && !g_TestAbort; i++) {
+        if (caps.needs_cache_maint) {
+            for (c = 0; c < num_channels; c++) {
+                cache_prep_dma_dst(ch[c].dst_addr, size);
+            }
+        }
+
+        start = timer_start();
+        status = runner_run_iteration(ops, ch, num_channels, size, use_sg, async, &submit_ns);
+        iter_ns = timer_stop_ns(start);
+
+        if (status != DMA_SUCCESS) {
+            LOG_ERROR("%s transfer failed at iteration %lu: %d\r\n",
+                      ops->name, (unsigned long)i, status);
+            goto out;
+        }
+
+        total_ns += iter_ns;
+        if (iter_ns < min_ns) min_ns = iter_ns;
+        if (iter_ns > max_ns) max_ns = iter_ns;
+
+        {
+            uint32_t mbps = CALC_THROUGHPUT_MBPS(iter_bytes, MAX(iter_ns / 1000, 1));
+            if (mbps < result->min_throughput) result->min_throughput = mbps;
+            if (mbps > result->max_throughput) result->max_throughput = mbps;
+        }
+    }
+    iterations = i;
+    dma_phase_record_stop(result->phase_ns);
+
+    /* Verify the last iteration's data */
+    result->data_integrity = true;
+    if (verify && iterations > 0) {
+        for (c = 0; c < num_channels; c++) {
+            uint32_t err_off;
+            uint8_t expected, actual;
+
+            if (caps.needs_cache_maint) {
+                cache_complete_dma_dst(ch[c].dst_addr, size);
+            }
+            if (!pattern_verify((void*)(uintptr_t)ch[c].dst_addr, size, config->pattern,
+                                ch[c].seed, &err_off, &expected, &actual)) {
+                if (result->data_integrity) {
+                    result->first_error_offset = err_off;
+                    LOG_ERROR("%s ch%lu verify failed at offset %lu: expected 0x%02X got 0x%02X\r\n",
+                              ops->name, (unsigned long)c, (unsigned long)err_off,
+                              expected, actual);
+                }
+                result->data_integrity = false;
+                result->error_count++;
+            }
+        }
+        if (!result->data_integrity) {
+            status = DMA_ERROR_VERIFY_FAIL;
+        }
+    }
+
+    if (iterations > 0) {
+        uint64_t avg_ns = total_ns / iterations;
+
+        result->iterations = iterations;
+        result->total_bytes = iter_bytes * iterations;
+        result->total_time_us = total_ns / 1000;
+        result->throughput_mbps = CALC_THROUGHPUT_MBPS(result->total_bytes,
+                                                       MAX(result->total_time_us, 1));
+        result->avg_throughput = result->throughput_mbps;
+        result->latency_ns = (uint32_t)avg_ns;
+        result->latency_us = (uint32_t)(avg_ns / 1000);
+        result->min_latency = (uint32_t)(min_ns / 1000);
+        result->max_latency = (uint32_t)(max_ns / 1000);
+        result->avg_latency = result->latency_us;
+        result->setup_time_us = (uint32_t)(submit_ns / iterations / 1000);
+        result->cpu_utilization = (total_ns > 0) ?
+                                  (uint32_t)((submit_ns * 100) / total_ns) : 0;
+    } else {
+        result->min_throughput = 0;
+    }
+
+out:
+    dma_phase_record_stop(NULL);
+    runner_close_channels(ops, opened);
+    runner_free_buffers(ch, num_channels);
+
+    g_BenchmarkStats.tests_run++;
+    if (status == DMA_SUCCESS) {
+        g_BenchmarkStats.tests_passed++;
+        g_BenchmarkStats.total_bytes_transferred += result->total_bytes;
+        g_BenchmarkStats.total_time_us += result->total_time_us;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+
+    return status;
+}
@@ -49,6 +49,7 @@ typedef enum {
     PATTERN_ALL_ZEROS,       /* 0x00, 0x00, 0x00, ... */
     PATTERN_RANDOM,          /* PRNG generated */
     PATTERN_CHECKERBOARD,    /* 0xAA, 0x55, 0xAA, 0x55, ... */
+    PATTERN_RANDOM_CTR,      /* Counter-based PRNG: word i = f(seed, i) */
     PATTERN_COUNT
 } DataPattern_t;
 
@@ -94,6 +95,30 @@ static const uint32_t g_TransferSizes[] = {
 
 #define NUM_TRANSFER_SIZES (sizeof(g_TransferSizes) / sizeof(g_TransferSizes[0]))
 
+/*******************************************************************************
+ * Batched Transfer Entry
+ ******************************************************************************/
+
+typedef struct {
+    uint64_t        src_addr;
+    uint64_t        dst_addr;
+    uint32_t        length;
+} DmaXfer_t;
+
+/*******************************************************************************
+ * Transfer Phases
+ ******************************************************************************/
+
+typedef enum {
+    DMA_PHASE_SRC_FLUSH = 0,        /* Clean source lines to memory */
+    DMA_PHASE_DST_INVALIDATE,       /* Drop destination lines before the DMA */
+    DMA_PHASE_PROGRAM,              /* Descriptor and register programming */
+    DMA_PHASE_HW_TRANSFER,          /* Doorbell until the poll that sees completion */
+    DMA_PHASE_COMPLETION,           /* Completion detection and status decode */
+    DMA_PHASE_POST_INVALIDATE,      /* Drop destination lines after the DMA */
+    DMA_PHASE_COUNT
+} DmaPhase_t;
+
 /*******************************************************************************
  * Test Configuration
  ******************************************************************************/
@@ -152,6 +177,9 @@ typedef struct {
     uint32_t        num_channels;      /* For MCDMA/multi-channel tests */
     uint64_t        total_bytes;
     uint64_t        total_time_us;
+
+    /* Time per phase summed over the timed iterations (ns) */
+    uint64_t        phase_ns[DMA_PHASE_COUNT];
 } TestResult_t;
 
 /*******************************************************************************
@@ -5,6 +5,7 @@
  * Wrapper for Xilinx AXI Central DMA IP for memory-to-memory transfers.
  */
 
+#include <stddef.h>
 #include <string.h>
 #include "xil_io.h"
 #include "xil_cache.h"
@@ -13,6 +14,10 @@
 #include "../platform_config.h"
 #include "../utils/timer_utils.h"
 #include "../utils/debug_print.h"
+#include "../utils/dma_wait.h"
+#include "../utils/dma_buf.h"
+#include "../utils/dma_phase.h"
+#include "../utils/cache_utils.h"
 
 /*******************************************************************************
  * Local Variables
@@ -20,8 +25,17 @@
 
 static AxiCdmaInst_t g_AxiCdma = {0};
 
-/* Descriptor memory (aligned to 64 bytes) */
-static AxiCdmaSgDesc_t g_DescRing[MAX_SG_DESCRIPTORS] __attribute__((aligned(64)));
+/* Descriptor memory, allocated from the configured region */
+static AxiCdmaSgDesc_t* g_DescRing;
+static DescRingConfig_t g_RingConfig = DESC_RING_CONFIG_DEFAULT;
+
+static const BdRingLayout_t g_AxiCdmaBdLayout = {
+    .bd_size = sizeof(AxiCdmaSgDesc_t),
+    .next_lo_offset = offsetof(AxiCdmaSgDesc_t, next_desc),
+    .next_hi_offset = offsetof(AxiCdmaSgDesc_t, next_desc_msb),
+    .status_offset = offsetof(AxiCdmaSgDesc_t, status),
+    .complete_mask = XAXICDMA_BD_STS_COMPLETE_MASK
+};
 
 /*******************************************************************************
  * Helper Functions
@@ -68,7 +82,10 @@ int axi_cdma_init(void)
 
     /* Setup SG descriptor ring if SG mode */
     if (g_AxiCdma.sg_mode) {
-        if (axi_cdma_setup_sg_ring(g_DescRing, MAX_SG_DESCRIPTORS) != 0) {
+        if (g_DescRing == NULL) {
+            g_DescRing = memory_alloc_desc_ring(&g_RingConfig, sizeof(AxiCdmaSgDesc_t));
+        }
+        if (axi_cdma_setup_sg_ring(g_DescRing, g_RingConfig.depth) != 0) {
             LOG_ERROR("AXI CDMA: SG ring setup failed\r\n");
             return DMA_ERROR_DMA_FAIL;
         }
@@ -119,6 +136,9 @@ int axi_cdma_reset(void)
     g_AxiCdma.transfer_complete = false;
     g_AxiCdma.transfer_error = 0;
 
+    /* Descriptors in flight were discarded by the reset */
+    bd_ring_reset(&g_AxiCdma.desc_ring);
+
     return DMA_SUCCESS;
 }
 
@@ -142,39 +162,69 @@ int axi_cdma_configure(bool use_sg, bool use_irq)
 
 int axi_cdma_setup_sg_ring(AxiCdmaSgDesc_t* descs, uint32_t num_descs)
 {
-    uint32_t i;
-    uint64_t desc_addr;
-
     if (!descs || num_descs == 0) {
         return DMA_ERROR_INVALID_PARAM;
     }
 
-    g_AxiCdma.desc_ring = descs;
-    g_AxiCdma.ring_size = num_descs;
+    if (!bd_ring_init(&g_AxiCdma.desc_ring, descs, num_descs, &g_AxiCdmaBdLayout,
+                      cache_flush_range, cache_invalidate_range)) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
 
-    /* Initialize descriptor ring */
-    memset(descs, 0, num_descs * sizeof(AxiCdmaSgDesc_t));
-    for (i = 0; i < num_descs; i++) {
-        desc_addr = (uint64_t)&descs[(i + 1) % num_descs];
-        descs[i].next_desc = (uint32_t)(desc_addr & 0xFFFFFFFF);
-        descs[i].next_desc_msb = (uint32_t)(desc_addr >> 32);
+    return DMA_SUCCESS;
+}
+
+int axi_cdma_set_ring_config(const DescRingConfig_t* config)
+{
+    AxiCdmaSgDesc_t* descs;
+    int status;
+
+    if (!memory_desc_ring_config_valid(config)) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (!g_AxiCdma.initialized || !g_AxiCdma.sg_mode) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (bd_ring_outstanding(&g_AxiCdma.desc_ring) != 0 && axi_cdma_is_busy()) {
+        return DMA_ERROR_BUSY;
     }
 
-    /* Flush descriptor memory */
-    Xil_DCacheFlushRange((UINTPTR)descs, num_descs * sizeof(AxiCdmaSgDesc_t));
+    descs = memory_alloc_desc_ring(config, sizeof(AxiCdmaSgDesc_t));
+    if (descs == NULL) {
+        return DMA_ERROR_NO_MEMORY;
+    }
 
-    g_AxiCdma.desc_head = 0;
-    g_AxiCdma.desc_tail = 0;
+    /* Halt the engine so the next chain loads CURDESC from the new ring */
+    status = axi_cdma_reset();
+    if (status == DMA_SUCCESS) {
+        status = axi_cdma_setup_sg_ring(descs, config->depth);
+    }
+    if (status != DMA_SUCCESS) {
+        memory_free_aligned(descs);
+        return status;
+    }
 
+    memory_free_aligned(g_DescRing);
+    g_DescRing = descs;
+    g_RingConfig = *config;
     return DMA_SUCCESS;
 }
 
+void axi_cdma_get_ring_config(DescRingConfig_t* config)
+{
+    if (config != NULL) {
+        *config = g_RingConfig;
+    }
+}
+
 /*******************************************************************************
  * Transfer Functions
  ******************************************************************************/
 
 int axi_cdma_simple_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
 {
+    uint64_t phase_start;
+
     if (!g_AxiCdma.initialized) {
         return DMA_ERROR_NOT_INIT;
     }
@@ -185,13 +235,20 @@ int axi_cdma_simple_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t leng
     }
 
     /* Flush source buffer from cache */
-    Xil_DCacheFlushRange(src_addr, length);
+    dma_buf_sync_for_device(src_addr, length, DMA_DIR_TO_DEVICE);
 
     /* Invalidate destination buffer */
-    Xil_DCacheInvalidateRange(dst_addr, length);
+    dma_buf_sync_for_device(dst_addr, length, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     /* Clear completion flag */
     g_AxiCdma.transfer_complete = false;
+    g_AxiCdma.transfer_length = length;
+    g_AxiCdma.last_desc = NULL;
+
+    /* Drop an IOC left over from an earlier transfer */
+    axi_cdma_write_reg(XAXICDMA_SR_OFFSET, XAXICDMA_SR_IOC_IRQ_MASK);
 
     /* Set source address */
     axi_cdma_write_reg(XAXICDMA_SA_OFFSET, (uint32_t)(src_addr & 0xFFFFFFFF));
@@ -203,6 +260,7 @@ int axi_cdma_simple_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t leng
 
     /* Set bytes to transfer (starts the transfer) */
     axi_cdma_write_reg(XAXICDMA_BTT_OFFSET, length);
+    dma_phase_kick(phase_start);
 
     return DMA_SUCCESS;
 }
@@ -210,7 +268,9 @@ int axi_cdma_simple_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t leng
 int axi_cdma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
 {
     uint64_t desc_addr;
+    uint64_t phase_start;
     AxiCdmaSgDesc_t* desc;
+    uint32_t idx;
 
     if (!g_AxiCdma.initialized || !g_AxiCdma.sg_mode) {
         return DMA_ERROR_NOT_INIT;
@@ -221,8 +281,18 @@ int axi_cdma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
         return DMA_ERROR_BUSY;
     }
 
+    /* Reclaim written-back descriptors if the ring is full */
+    if (bd_ring_free_count(&g_AxiCdma.desc_ring) == 0) {
+        bd_ring_reap(&g_AxiCdma.desc_ring, 0);
+    }
+    phase_start = dma_phase_begin();
+    idx = bd_ring_alloc(&g_AxiCdma.desc_ring, 1);
+    if (idx == BD_RING_INVALID_INDEX) {
+        return DMA_ERROR_BUSY;
+    }
+
     /* Setup descriptor */
-    desc = &g_AxiCdma.desc_ring[g_AxiCdma.desc_head];
+    desc = (AxiCdmaSgDesc_t*)bd_ring_bd(&g_AxiCdma.desc_ring, idx);
     desc->src_addr = (uint32_t)(src_addr & 0xFFFFFFFF);
     desc->src_addr_msb = (uint32_t)(src_addr >> 32);
     desc->dst_addr = (uint32_t)(dst_addr & 0xFFFFFFFF);
@@ -231,12 +301,20 @@ int axi_cdma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
     desc->status = 0;
 
     /* Flush descriptor and buffers */
-    Xil_DCacheFlushRange((UINTPTR)desc, sizeof(AxiCdmaSgDesc_t));
-    Xil_DCacheFlushRange(src_addr, length);
-    Xil_DCacheInvalidateRange(dst_addr, length);
+    bd_ring_commit(&g_AxiCdma.desc_ring, idx, 1);
+    dma_phase_end(DMA_PHASE_PROGRAM, phase_start);
+    dma_buf_sync_for_device(src_addr, length, DMA_DIR_TO_DEVICE);
+    dma_buf_sync_for_device(dst_addr, length, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     /* Clear completion flag */
     g_AxiCdma.transfer_complete = false;
+    g_AxiCdma.transfer_length = length;
+    g_AxiCdma.last_desc = desc;
+
+    /* New chain: drop IOC left over from earlier transfers */
+    axi_cdma_write_reg(XAXICDMA_SR_OFFSET, XAXICDMA_SR_IOC_IRQ_MASK);
 
     /* Set current descriptor pointer */
     desc_addr = (uint64_t)desc;
@@ -246,28 +324,133 @@ int axi_cdma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
     /* Set tail descriptor pointer (starts the transfer) */
     axi_cdma_write_reg(XAXICDMA_TDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
     axi_cdma_write_reg(XAXICDMA_TDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
+    dma_phase_kick(phase_start);
+
+    return DMA_SUCCESS;
+}
 
-    /* Update ring index */
-    g_AxiCdma.desc_head = (g_AxiCdma.desc_head + 1) % g_AxiCdma.ring_size;
+int axi_cdma_sg_transfer_batch(const DmaXfer_t* xfers, uint32_t count, bool doorbell_per_bd)
+{
+    BdRing_t* ring = &g_AxiCdma.desc_ring;
+    AxiCdmaSgDesc_t* desc = NULL;
+    uint64_t desc_addr;
+    uint32_t first, idx, i;
+    uint32_t total = 0;
+    bool start;
+
+    if (!g_AxiCdma.initialized || !g_AxiCdma.sg_mode) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (xfers == NULL || count == 0 || count > ring->count) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    if (bd_ring_free_count(ring) < count) {
+        bd_ring_reap(ring, 0);
+    }
+
+    /* Nothing outstanding: start a new chain; otherwise append to the running one */
+    start = (bd_ring_outstanding(ring) == 0);
+    if (start && axi_cdma_is_busy()) {
+        return DMA_ERROR_BUSY;
+    }
+
+    first = bd_ring_alloc(ring, count);
+    if (first == BD_RING_INVALID_INDEX) {
+        return DMA_ERROR_BUSY;
+    }
+
+    g_AxiCdma.transfer_complete = false;
+
+    for (i = 0, idx = first; i < count; i++, idx = bd_ring_next(ring, idx)) {
+        desc = (AxiCdmaSgDesc_t*)bd_ring_bd(ring, idx);
+        desc->src_addr = (uint32_t)(xfers[i].src_addr & 0xFFFFFFFF);
+        desc->src_addr_msb = (uint32_t)(xfers[i].src_addr >> 32);
+        desc->dst_addr = (uint32_t)(xfers[i].dst_addr & 0xFFFFFFFF);
+        desc->dst_addr_msb = (uint32_t)(xfers[i].dst_addr >> 32);
+        desc->control = xfers[i].length;
+        desc->status = 0;
+        total += xfers[i].length;
+
+        if (!doorbell_per_bd) {
+            continue;
+        }
+
+        /* One descriptor at a time: clean it, then ring the doorbell */
+        bd_ring_commit(ring, idx, 1);
+        dma_buf_sync_for_device(xfers[i].src_addr, xfers[i].length, DMA_DIR_TO_DEVICE);
+        dma_buf_sync_for_device(xfers[i].dst_addr, xfers[i].length, DMA_DIR_FROM_DEVICE);
+
+        desc_addr = (uint64_t)desc;
+        if (i == 0 && start) {
+            axi_cdma_write_reg(XAXICDMA_SR_OFFSET, XAXICDMA_SR_IOC_IRQ_MASK);
+            axi_cdma_write_reg(XAXICDMA_CDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
+            axi_cdma_write_reg(XAXICDMA_CDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
+        }
+        axi_cdma_write_reg(XAXICDMA_TDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
+        axi_cdma_write_reg(XAXICDMA_TDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
+    }
+
+    if (!doorbell_per_bd) {
+        /* Whole chain: one ring clean, one tail pointer write */
+        bd_ring_commit(ring, first, count);
+        for (i = 0; i < count; i++) {
+            dma_buf_sync_for_device(xfers[i].src_addr, xfers[i].length, DMA_DIR_TO_DEVICE);
+            dma_buf_sync_for_device(xfers[i].dst_addr, xfers[i].length, DMA_DIR_FROM_DEVICE);
+        }
+
+        if (start) {
+            axi_cdma_write_reg(XAXICDMA_SR_OFFSET, XAXICDMA_SR_IOC_IRQ_MASK);
+            desc_addr = bd_ring_bd_addr(ring, first);
+            axi_cdma_write_reg(XAXICDMA_CDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
+            axi_cdma_write_reg(XAXICDMA_CDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
+        }
+
+        desc_addr = (uint64_t)desc;
+        axi_cdma_write_reg(XAXICDMA_TDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
+        axi_cdma_write_reg(XAXICDMA_TDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
+    }
+
+    g_AxiCdma.transfer_length = total;
+    g_AxiCdma.last_desc = desc;
 
     return DMA_SUCCESS;
 }
 
+int axi_cdma_sg_reap(void)
+{
+    if (!g_AxiCdma.initialized || !g_AxiCdma.sg_mode) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (axi_cdma_read_reg(XAXICDMA_SR_OFFSET) & XAXICDMA_SR_ALL_ERR_MASK) {
+        g_AxiCdma.errors++;
+        return DMA_ERROR_DMA_FAIL;
+    }
+    return (int)bd_ring_reap(&g_AxiCdma.desc_ring, 0);
+}
+
 /*******************************************************************************
  * Wait Functions
  ******************************************************************************/
 
 int axi_cdma_wait_complete(uint32_t timeout_us)
 {
+    DmaWait_t wait;
     uint32_t status;
-    uint32_t elapsed_us = 0;
-    uint32_t poll_interval_us = 10;  /* 10us poll interval */
     uint32_t loop_count = 0;
 
     LOG_DEBUG("AXI CDMA: Wait complete, timeout=%lu us\r\n", (unsigned long)timeout_us);
 
-    while (elapsed_us < timeout_us) {
-        status = axi_cdma_read_reg(XAXICDMA_SR_OFFSET);
+    dma_wait_begin(&wait, timeout_us, dma_wait_expected_ns(DMA_TYPE_AXI_CDMA, g_AxiCdma.transfer_length));
+
+    do {
+        /* BD polling: stay off the register bus until the BD is written back */
+        if (dma_wait_use_bd() && g_AxiCdma.last_desc != NULL &&
+            !dma_wait_bd_complete(&g_AxiCdma.last_desc->status, XAXICDMA_BD_STS_COMPLETE_MASK)) {
+            continue;
+        }
+
+        status = dma_wait_mmio_read(g_AxiCdma.base_addr + XAXICDMA_SR_OFFSET);
         loop_count++;
 
         /* Check for errors */
@@ -279,35 +462,49 @@ int axi_cdma_wait_complete(uint32_t timeout_us)
                       (unsigned long)loop_count);
             /* Clear error bits by writing 1 */
             axi_cdma_write_reg(XAXICDMA_SR_OFFSET, status & XAXICDMA_SR_ALL_ERR_MASK);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
         /* Check for completion (idle) */
         if (status & XAXICDMA_SR_IDLE_MASK) {
+            axi_cdma_write_reg(XAXICDMA_SR_OFFSET, XAXICDMA_SR_IOC_IRQ_MASK);
             g_AxiCdma.transfer_complete = true;
             g_AxiCdma.num_transfers++;
+            bd_ring_retire(&g_AxiCdma.desc_ring, bd_ring_outstanding(&g_AxiCdma.desc_ring));
             LOG_DEBUG("AXI CDMA: Complete (idle), loops=%lu\r\n", (unsigned long)loop_count);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        /* Check IOC interrupt status */
+        /*
+         * Check IOC interrupt status. On a descriptor chain IOC only means
+         * some BD finished, so retire what has been written back and keep
+         * waiting until the last BD is among them. IOC is cleared first so
+         * a BD finishing during the reap raises it again.
+         */
         if (status & XAXICDMA_SR_IOC_IRQ_MASK) {
-            /* Clear interrupt */
             axi_cdma_write_reg(XAXICDMA_SR_OFFSET, XAXICDMA_SR_IOC_IRQ_MASK);
+            if (g_AxiCdma.last_desc != NULL) {
+                bd_ring_reap(&g_AxiCdma.desc_ring, 0);
+                if (bd_ring_outstanding(&g_AxiCdma.desc_ring) != 0) {
+                    continue;
+                }
+            }
             g_AxiCdma.transfer_complete = true;
             g_AxiCdma.num_transfers++;
             LOG_DEBUG("AXI CDMA: Complete (IOC), loops=%lu\r\n", (unsigned long)loop_count);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        /* Use usleep for reliable timing */
-        usleep(poll_interval_us);
-        elapsed_us += poll_interval_us;
-    }
+    } while (dma_wait_continue(&wait));
 
+    dma_wait_end(&wait, true);
     status = axi_cdma_read_reg(XAXICDMA_SR_OFFSET);
     LOG_ERROR("AXI CDMA Timeout: final_status=0x%08lX, loops=%lu, elapsed=%lu us\r\n",
-              (unsigned long)status, (unsigned long)loop_count, (unsigned long)elapsed_us);
+              (unsigned long)status, (unsigned long)loop_count,
+              (unsigned long)dma_wait_elapsed_us(&wait));
     return DMA_ERROR_TIMEOUT;
 }
 
@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../dma_benchmark.h"
+#include "../utils/bd_ring.h"
+#include "../utils/memory_utils.h"
 
 /*******************************************************************************
  * AXI CDMA Register Offsets
@@ -95,14 +97,13 @@ typedef struct {
     uint32_t max_burst_len;
 
     /* Descriptor ring */
-    AxiCdmaSgDesc_t* desc_ring;
-    uint32_t ring_size;
-    uint32_t desc_head;
-    uint32_t desc_tail;
+    BdRing_t desc_ring;
 
     /* Transfer state */
     volatile bool transfer_complete;
     volatile uint32_t transfer_error;
+    uint32_t transfer_length;        /* In-flight length (wait prediction) */
+    AxiCdmaSgDesc_t* last_desc;      /* Last submitted BD, NULL in simple mode */
 
     /* Statistics */
     uint64_t bytes_transferred;
@@ -147,6 +148,24 @@ int axi_cdma_configure(bool use_sg, bool use_irq);
  */
 int axi_cdma_setup_sg_ring(AxiCdmaSgDesc_t* descs, uint32_t num_descs);
 
+/**
+ * @brief Reallocate the SG descriptor ring with a new placement and depth
+ *
+ * Resets the engine. The ring is allocated at init with
+ * DESC_RING_CONFIG_DEFAULT.
+ *
+ * @param config Ring placement and depth
+ * @return 0 on success, DMA_ERROR_BUSY with descriptors outstanding,
+ *         DMA_ERROR_NO_MEMORY if the region is full (old ring kept)
+ */
+int axi_cdma_set_ring_config(const DescRingConfig_t* config);
+
+/**
+ * @brief Get the current descriptor ring placement and depth
+ * @param config Configuration output
+ */
+void axi_cdma_get_ring_config(DescRingConfig_t* config);
+
 /**
  * @brief Start a simple (non-SG) memory-to-memory transfer
  * @param src_addr Source address
@@ -165,6 +184,24 @@ int axi_cdma_simple_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t leng
  */
 int axi_cdma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length);
 
+/**
+ * @brief Start a chain of Scatter-Gather transfers, or append it to the
+ *        chain still in flight
+ * @param xfers Transfers, one descriptor each
+ * @param count Number of transfers (at most the ring size)
+ * @param doorbell_per_bd true: commit and write the tail pointer after every
+ *        descriptor; false: commit all, then one tail pointer write
+ * @return 0 on success, negative error code on failure
+ */
+int axi_cdma_sg_transfer_batch(const DmaXfer_t* xfers, uint32_t count, bool doorbell_per_bd);
+
+/**
+ * @brief Retire completed Scatter-Gather descriptors (queued operation)
+ * @return Number of transfers completed since the last call, or negative
+ *         error code if the engine reports an error
+ */
+int axi_cdma_sg_reap(void);
+
 /**
  * @brief Wait for transfer completion (polling)
  * @param timeout_us Timeout in microseconds
@@ -5,6 +5,7 @@
  * Wrapper for Xilinx AXI DMA IP with Scatter-Gather support.
  */
 
+#include <stddef.h>
 #include <string.h>
 #include "xil_io.h"
 #include "xil_cache.h"
@@ -13,6 +14,10 @@
 #include "../platform_config.h"
 #include "../utils/timer_utils.h"
 #include "../utils/debug_print.h"
+#include "../utils/dma_wait.h"
+#include "../utils/dma_buf.h"
+#include "../utils/dma_phase.h"
+#include "../utils/cache_utils.h"
 
 /*******************************************************************************
  * Local Variables
@@ -20,9 +25,18 @@
 
 static AxiDmaInst_t g_AxiDma = {0};
 
-/* Descriptor memory (aligned to 64 bytes) */
-static AxiDmaSgDesc_t g_TxDescRing[MAX_SG_DESCRIPTORS] __attribute__((aligned(64)));
-static AxiDmaSgDesc_t g_RxDescRing[MAX_SG_DESCRIPTORS] __attribute__((aligned(64)));
+/* Descriptor memory, allocated from the configured region */
+static AxiDmaSgDesc_t* g_TxDescRing;
+static AxiDmaSgDesc_t* g_RxDescRing;
+static DescRingConfig_t g_RingConfig = DESC_RING_CONFIG_DEFAULT;
+
+static const BdRingLayout_t g_AxiDmaBdLayout = {
+    .bd_size = sizeof(AxiDmaSgDesc_t),
+    .next_lo_offset = offsetof(AxiDmaSgDesc_t, next_desc),
+    .next_hi_offset = offsetof(AxiDmaSgDesc_t, next_desc_msb),
+    .status_offset = offsetof(AxiDmaSgDesc_t, status),
+    .complete_mask = XAXIDMA_BD_STS_COMPLETE_MASK
+};
 
 /*******************************************************************************
  * Helper Functions
@@ -120,9 +134,15 @@ int axi_dma_init(void)
 
     /* Setup SG descriptor rings if SG mode */
     if (g_AxiDma.sg_mode) {
+        if (g_TxDescRing == NULL) {
+            g_TxDescRing = memory_alloc_desc_ring(&g_RingConfig, sizeof(AxiDmaSgDesc_t));
+        }
+        if (g_RxDescRing == NULL) {
+            g_RxDescRing = memory_alloc_desc_ring(&g_RingConfig, sizeof(AxiDmaSgDesc_t));
+        }
         LOG_ALWAYS("AXI DMA: Setting up SG rings at TX=0x%p, RX=0x%p\r\n",
                    (void*)g_TxDescRing, (void*)g_RxDescRing);
-        if (axi_dma_setup_sg_ring(g_TxDescRing, g_RxDescRing, MAX_SG_DESCRIPTORS) != 0) {
+        if (axi_dma_setup_sg_ring(g_TxDescRing, g_RxDescRing, g_RingConfig.depth) != 0) {
             LOG_ERROR("AXI DMA: SG ring setup failed\r\n");
             return DMA_ERROR_DMA_FAIL;
         }
@@ -197,6 +217,10 @@ int axi_dma_reset(void)
     g_AxiDma.tx_error = 0;
     g_AxiDma.rx_error = 0;
 
+    /* Descriptors in flight were discarded by the reset */
+    bd_ring_reset(&g_AxiDma.tx_ring);
+    bd_ring_reset(&g_AxiDma.rx_ring);
+
     return DMA_SUCCESS;
 }
 
@@ -224,45 +248,71 @@ int axi_dma_configure(bool use_sg, bool use_irq)
 
 int axi_dma_setup_sg_ring(AxiDmaSgDesc_t* tx_descs, AxiDmaSgDesc_t* rx_descs, uint32_t num_descs)
 {
-    uint32_t i;
-    uint64_t desc_addr;
-
     if (!tx_descs || !rx_descs || num_descs == 0) {
         return DMA_ERROR_INVALID_PARAM;
     }
 
-    g_AxiDma.tx_ring = tx_descs;
-    g_AxiDma.rx_ring = rx_descs;
-    g_AxiDma.ring_size = num_descs;
-
-    /* Initialize TX descriptor ring */
-    memset(tx_descs, 0, num_descs * sizeof(AxiDmaSgDesc_t));
-    for (i = 0; i < num_descs; i++) {
-        desc_addr = (uint64_t)&tx_descs[(i + 1) % num_descs];
-        tx_descs[i].next_desc = (uint32_t)(desc_addr & 0xFFFFFFFF);
-        tx_descs[i].next_desc_msb = (uint32_t)(desc_addr >> 32);
+    if (!bd_ring_init(&g_AxiDma.tx_ring, tx_descs, num_descs, &g_AxiDmaBdLayout,
+                      cache_flush_range, cache_invalidate_range) ||
+        !bd_ring_init(&g_AxiDma.rx_ring, rx_descs, num_descs, &g_AxiDmaBdLayout,
+                      cache_flush_range, cache_invalidate_range)) {
+        return DMA_ERROR_INVALID_PARAM;
     }
 
-    /* Initialize RX descriptor ring */
-    memset(rx_descs, 0, num_descs * sizeof(AxiDmaSgDesc_t));
-    for (i = 0; i < num_descs; i++) {
-        desc_addr = (uint64_t)&rx_descs[(i + 1) % num_descs];
-        rx_descs[i].next_desc = (uint32_t)(desc_addr & 0xFFFFFFFF);
-        rx_descs[i].next_desc_msb = (uint32_t)(desc_addr >> 32);
+    return DMA_SUCCESS;
+}
+
+int axi_dma_set_ring_config(const DescRingConfig_t* config)
+{
+    AxiDmaSgDesc_t* tx_descs;
+    AxiDmaSgDesc_t* rx_descs;
+    int status;
+
+    if (!memory_desc_ring_config_valid(config)) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (!g_AxiDma.initialized || !g_AxiDma.sg_mode) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if ((bd_ring_outstanding(&g_AxiDma.tx_ring) != 0 && axi_dma_tx_busy()) ||
+        (bd_ring_outstanding(&g_AxiDma.rx_ring) != 0 && axi_dma_rx_busy())) {
+        return DMA_ERROR_BUSY;
     }
 
-    /* Flush descriptor memory */
-    Xil_DCacheFlushRange((UINTPTR)tx_descs, num_descs * sizeof(AxiDmaSgDesc_t));
-    Xil_DCacheFlushRange((UINTPTR)rx_descs, num_descs * sizeof(AxiDmaSgDesc_t));
+    tx_descs = memory_alloc_desc_ring(config, sizeof(AxiDmaSgDesc_t));
+    rx_descs = memory_alloc_desc_ring(config, sizeof(AxiDmaSgDesc_t));
+    if (tx_descs == NULL || rx_descs == NULL) {
+        memory_free_aligned(tx_descs);
+        memory_free_aligned(rx_descs);
+        return DMA_ERROR_NO_MEMORY;
+    }
 
-    g_AxiDma.tx_head = 0;
-    g_AxiDma.tx_tail = 0;
-    g_AxiDma.rx_head = 0;
-    g_AxiDma.rx_tail = 0;
+    /* Halt both channels so the next chains load CURDESC from the new rings */
+    status = axi_dma_reset();
+    if (status == DMA_SUCCESS) {
+        status = axi_dma_setup_sg_ring(tx_descs, rx_descs, config->depth);
+    }
+    if (status != DMA_SUCCESS) {
+        memory_free_aligned(tx_descs);
+        memory_free_aligned(rx_descs);
+        return status;
+    }
 
+    memory_free_aligned(g_TxDescRing);
+    memory_free_aligned(g_RxDescRing);
+    g_TxDescRing = tx_descs;
+    g_RxDescRing = rx_descs;
+    g_RingConfig = *config;
     return DMA_SUCCESS;
 }
 
+void axi_dma_get_ring_config(DescRingConfig_t* config)
+{
+    if (config != NULL) {
+        *config = g_RingConfig;
+    }
+}
+
 /*******************************************************************************
  * Transfer Functions
  ******************************************************************************/
@@ -305,7 +355,9 @@ int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
     uint64_t desc_addr;
     AxiDmaSgDesc_t* tx_desc;
     AxiDmaSgDesc_t* rx_desc;
+    uint32_t tx_idx, rx_idx;
     uint32_t cr_value;
+    uint64_t phase_start;
 
     LOG_DEBUG("AXI DMA SG: src=0x%llX, dst=0x%llX, len=%lu\r\n",
               (unsigned long long)src_addr, (unsigned long long)dst_addr, (unsigned long)length);
@@ -326,8 +378,23 @@ int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
         return DMA_ERROR_INVALID_PARAM;
     }
 
+    /* Reclaim written-back descriptors if either ring is full */
+    if (bd_ring_free_count(&g_AxiDma.tx_ring) == 0) {
+        bd_ring_reap(&g_AxiDma.tx_ring, 0);
+    }
+    if (bd_ring_free_count(&g_AxiDma.rx_ring) == 0) {
+        bd_ring_reap(&g_AxiDma.rx_ring, 0);
+    }
+    if (bd_ring_free_count(&g_AxiDma.tx_ring) == 0 ||
+        bd_ring_free_count(&g_AxiDma.rx_ring) == 0) {
+        return DMA_ERROR_BUSY;
+    }
+    phase_start = dma_phase_begin();
+    tx_idx = bd_ring_alloc(&g_AxiDma.tx_ring, 1);
+    rx_idx = bd_ring_alloc(&g_AxiDma.rx_ring, 1);
+
     /* Setup TX descriptor */
-    tx_desc = &g_AxiDma.tx_ring[g_AxiDma.tx_head];
+    tx_desc = (AxiDmaSgDesc_t*)bd_ring_bd(&g_AxiDma.tx_ring, tx_idx);
     tx_desc->buffer_addr = (uint32_t)(src_addr & 0xFFFFFFFF);
     tx_desc->buffer_addr_msb = (uint32_t)(src_addr >> 32);
     tx_desc->control = XAXIDMA_BD_CTRL_TXSOF_MASK | XAXIDMA_BD_CTRL_TXEOF_MASK | length;
@@ -338,7 +405,7 @@ int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
               (unsigned long)tx_desc->buffer_addr, (unsigned long)tx_desc->control);
 
     /* Setup RX descriptor */
-    rx_desc = &g_AxiDma.rx_ring[g_AxiDma.rx_head];
+    rx_desc = (AxiDmaSgDesc_t*)bd_ring_bd(&g_AxiDma.rx_ring, rx_idx);
     rx_desc->buffer_addr = (uint32_t)(dst_addr & 0xFFFFFFFF);
     rx_desc->buffer_addr_msb = (uint32_t)(dst_addr >> 32);
     rx_desc->control = length;
@@ -348,17 +415,28 @@ int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
               (void*)rx_desc, (unsigned long)rx_desc->buffer_addr_msb,
               (unsigned long)rx_desc->buffer_addr, (unsigned long)rx_desc->control);
 
-    /* Flush descriptors */
-    Xil_DCacheFlushRange((UINTPTR)tx_desc, sizeof(AxiDmaSgDesc_t));
-    Xil_DCacheFlushRange((UINTPTR)rx_desc, sizeof(AxiDmaSgDesc_t));
+    /* Hand descriptors to the engine (cleans them from the cache) */
+    bd_ring_commit(&g_AxiDma.tx_ring, tx_idx, 1);
+    bd_ring_commit(&g_AxiDma.rx_ring, rx_idx, 1);
+    dma_phase_end(DMA_PHASE_PROGRAM, phase_start);
 
     /* Flush source buffer, invalidate destination buffer */
-    Xil_DCacheFlushRange(src_addr, length);
-    Xil_DCacheInvalidateRange(dst_addr, length);
+    dma_buf_sync_for_device(src_addr, length, DMA_DIR_TO_DEVICE);
+    dma_buf_sync_for_device(dst_addr, length, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     /* Clear completion flags */
     g_AxiDma.tx_complete = false;
     g_AxiDma.rx_complete = false;
+    g_AxiDma.tx_length = length;
+    g_AxiDma.rx_length = length;
+    g_AxiDma.tx_last_desc = tx_desc;
+    g_AxiDma.rx_last_desc = rx_desc;
+
+    /* New chains: drop IOC left over from earlier transfers */
+    axi_dma_write_rx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
+    axi_dma_write_tx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
 
     /* Start RX channel */
     desc_addr = (uint64_t)rx_desc;
@@ -381,6 +459,7 @@ int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
 
     axi_dma_write_tx_reg(XAXIDMA_TDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
     axi_dma_write_tx_reg(XAXIDMA_TDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
+    dma_phase_kick(phase_start);
 
     /* Debug: check status immediately after starting */
     {
@@ -390,15 +469,154 @@ int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length)
                   (unsigned long)tx_sr, (unsigned long)rx_sr);
     }
 
-    /* Update ring indices */
-    g_AxiDma.tx_head = (g_AxiDma.tx_head + 1) % g_AxiDma.ring_size;
-    g_AxiDma.rx_head = (g_AxiDma.rx_head + 1) % g_AxiDma.ring_size;
+    return DMA_SUCCESS;
+}
+
+/* Start (first) or extend (tail only) both channel chains */
+static void axi_dma_sg_kick(uint64_t tx_desc_addr, uint64_t rx_desc_addr,
+                            uint64_t tx_tail_addr, uint64_t rx_tail_addr, bool start)
+{
+    uint64_t phase_start = dma_phase_begin();
+    uint32_t cr_value;
+
+    if (start) {
+        /* New chains: drop IOC left over from earlier transfers */
+        axi_dma_write_rx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
+        axi_dma_write_tx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
+
+        axi_dma_write_rx_reg(XAXIDMA_CDESC_OFFSET, (uint32_t)(rx_desc_addr & 0xFFFFFFFF));
+        axi_dma_write_rx_reg(XAXIDMA_CDESC_MSB_OFFSET, (uint32_t)(rx_desc_addr >> 32));
+        cr_value = axi_dma_read_rx_reg(XAXIDMA_CR_OFFSET);
+        axi_dma_write_rx_reg(XAXIDMA_CR_OFFSET, cr_value | XAXIDMA_CR_RUNSTOP_MASK);
+
+        axi_dma_write_tx_reg(XAXIDMA_CDESC_OFFSET, (uint32_t)(tx_desc_addr & 0xFFFFFFFF));
+        axi_dma_write_tx_reg(XAXIDMA_CDESC_MSB_OFFSET, (uint32_t)(tx_desc_addr >> 32));
+        cr_value = axi_dma_read_tx_reg(XAXIDMA_CR_OFFSET);
+        axi_dma_write_tx_reg(XAXIDMA_CR_OFFSET, cr_value | XAXIDMA_CR_RUNSTOP_MASK);
+    }
+
+    /* RX tail first so S2MM is ready before MM2S produces data */
+    axi_dma_write_rx_reg(XAXIDMA_TDESC_OFFSET, (uint32_t)(rx_tail_addr & 0xFFFFFFFF));
+    axi_dma_write_rx_reg(XAXIDMA_TDESC_MSB_OFFSET, (uint32_t)(rx_tail_addr >> 32));
+    axi_dma_write_tx_reg(XAXIDMA_TDESC_OFFSET, (uint32_t)(tx_tail_addr & 0xFFFFFFFF));
+    axi_dma_write_tx_reg(XAXIDMA_TDESC_MSB_OFFSET, (uint32_t)(tx_tail_addr >> 32));
+    dma_phase_kick(phase_start);
+}
+
+int axi_dma_sg_transfer_batch(const DmaXfer_t* xfers, uint32_t count, bool doorbell_per_bd)
+{
+    AxiDmaSgDesc_t* tx_desc = NULL;
+    AxiDmaSgDesc_t* rx_desc = NULL;
+    uint32_t tx_first, rx_first, tx_idx, rx_idx, i;
+    uint32_t total = 0;
+    bool start;
+
+    if (!g_AxiDma.initialized || !g_AxiDma.sg_mode) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (xfers == NULL || count == 0 || count > g_AxiDma.tx_ring.count ||
+        count > g_AxiDma.rx_ring.count) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (xfers[i].length > g_AxiDma.max_transfer_len) {
+            LOG_ERROR("AXI DMA SG: Length %lu exceeds max %lu\r\n",
+                      (unsigned long)xfers[i].length, (unsigned long)g_AxiDma.max_transfer_len);
+            return DMA_ERROR_INVALID_PARAM;
+        }
+    }
+
+    if (bd_ring_free_count(&g_AxiDma.tx_ring) < count) {
+        bd_ring_reap(&g_AxiDma.tx_ring, 0);
+    }
+    if (bd_ring_free_count(&g_AxiDma.rx_ring) < count) {
+        bd_ring_reap(&g_AxiDma.rx_ring, 0);
+    }
+    if (bd_ring_free_count(&g_AxiDma.tx_ring) < count ||
+        bd_ring_free_count(&g_AxiDma.rx_ring) < count) {
+        return DMA_ERROR_BUSY;
+    }
+
+    /* Nothing outstanding: start new chains; otherwise append to the running ones */
+    start = (bd_ring_outstanding(&g_AxiDma.rx_ring) == 0);
+
+    tx_first = bd_ring_alloc(&g_AxiDma.tx_ring, count);
+    rx_first = bd_ring_alloc(&g_AxiDma.rx_ring, count);
+
+    g_AxiDma.tx_complete = false;
+    g_AxiDma.rx_complete = false;
+
+    for (i = 0, tx_idx = tx_first, rx_idx = rx_first; i < count;
+         i++, tx_idx = bd_ring_next(&g_AxiDma.tx_ring, tx_idx),
+         rx_idx = bd_ring_next(&g_AxiDma.rx_ring, rx_idx)) {
+        tx_desc = (AxiDmaSgDesc_t*)bd_ring_bd(&g_AxiDma.tx_ring, tx_idx);
+        tx_desc->buffer_addr = (uint32_t)(xfers[i].src_addr & 0xFFFFFFFF);
+        tx_desc->buffer_addr_msb = (uint32_t)(xfers[i].src_addr >> 32);
+        tx_desc->control = XAXIDMA_BD_CTRL_TXSOF_MASK | XAXIDMA_BD_CTRL_TXEOF_MASK |
+                           xfers[i].length;
+        tx_desc->status = 0;
+
+        rx_desc = (AxiDmaSgDesc_t*)bd_ring_bd(&g_AxiDma.rx_ring, rx_idx);
+        rx_desc->buffer_addr = (uint32_t)(xfers[i].dst_addr & 0xFFFFFFFF);
+        rx_desc->buffer_addr_msb = (uint32_t)(xfers[i].dst_addr >> 32);
+        rx_desc->control = xfers[i].length;
+        rx_desc->status = 0;
+        total += xfers[i].length;
+
+        if (!doorbell_per_bd) {
+            continue;
+        }
+
+        bd_ring_commit(&g_AxiDma.tx_ring, tx_idx, 1);
+        bd_ring_commit(&g_AxiDma.rx_ring, rx_idx, 1);
+        dma_buf_sync_for_device(xfers[i].src_addr, xfers[i].length, DMA_DIR_TO_DEVICE);
+        dma_buf_sync_for_device(xfers[i].dst_addr, xfers[i].length, DMA_DIR_FROM_DEVICE);
+
+        axi_dma_sg_kick((uint64_t)tx_desc, (uint64_t)rx_desc,
+                        (uint64_t)tx_desc, (uint64_t)rx_desc, i == 0 && start);
+    }
+
+    if (!doorbell_per_bd) {
+        bd_ring_commit(&g_AxiDma.tx_ring, tx_first, count);
+        bd_ring_commit(&g_AxiDma.rx_ring, rx_first, count);
+        for (i = 0; i < count; i++) {
+            dma_buf_sync_for_device(xfers[i].src_addr, xfers[i].length, DMA_DIR_TO_DEVICE);
+            dma_buf_sync_for_device(xfers[i].dst_addr, xfers[i].length, DMA_DIR_FROM_DEVICE);
+        }
+
+        axi_dma_sg_kick(bd_ring_bd_addr(&g_AxiDma.tx_ring, tx_first),
+                        bd_ring_bd_addr(&g_AxiDma.rx_ring, rx_first),
+                        (uint64_t)tx_desc, (uint64_t)rx_desc, start);
+    }
+
+    g_AxiDma.tx_length = total;
+    g_AxiDma.rx_length = total;
+    g_AxiDma.tx_last_desc = tx_desc;
+    g_AxiDma.rx_last_desc = rx_desc;
 
     return DMA_SUCCESS;
 }
 
+int axi_dma_sg_reap(void)
+{
+    if (!g_AxiDma.initialized || !g_AxiDma.sg_mode) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if ((axi_dma_read_tx_reg(XAXIDMA_SR_OFFSET) & XAXIDMA_SR_ALL_ERR_MASK) ||
+        (axi_dma_read_rx_reg(XAXIDMA_SR_OFFSET) & XAXIDMA_SR_ALL_ERR_MASK)) {
+        g_AxiDma.errors++;
+        return DMA_ERROR_DMA_FAIL;
+    }
+
+    /* A transfer is complete once its S2MM descriptor is */
+    bd_ring_reap(&g_AxiDma.tx_ring, 0);
+    return (int)bd_ring_reap(&g_AxiDma.rx_ring, 0);
+}
+
 int axi_dma_start_tx(uint64_t buffer_addr, uint32_t length)
 {
+    uint64_t phase_start;
     uint32_t cr_value;
 
     if (!g_AxiDma.initialized) {
@@ -406,7 +624,9 @@ int axi_dma_start_tx(uint64_t buffer_addr, uint32_t length)
     }
 
     /* Flush buffer from cache */
-    Xil_DCacheFlushRange(buffer_addr, length);
+    dma_buf_sync_for_device(buffer_addr, length, DMA_DIR_TO_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     /* Set source address */
     axi_dma_write_tx_reg(XAXIDMA_SRCADDR_OFFSET, (uint32_t)(buffer_addr & 0xFFFFFFFF));
@@ -414,6 +634,11 @@ int axi_dma_start_tx(uint64_t buffer_addr, uint32_t length)
 
     /* Clear completion flag */
     g_AxiDma.tx_complete = false;
+    g_AxiDma.tx_length = length;
+    g_AxiDma.tx_last_desc = NULL;
+
+    /* Drop an IOC left over from an earlier transfer */
+    axi_dma_write_tx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
 
     /* Start DMA */
     cr_value = axi_dma_read_tx_reg(XAXIDMA_CR_OFFSET);
@@ -421,12 +646,14 @@ int axi_dma_start_tx(uint64_t buffer_addr, uint32_t length)
 
     /* Set transfer length (starts the transfer) */
     axi_dma_write_tx_reg(XAXIDMA_BUFFLEN_OFFSET, length);
+    dma_phase_kick(phase_start);
 
     return DMA_SUCCESS;
 }
 
 int axi_dma_start_rx(uint64_t buffer_addr, uint32_t length)
 {
+    uint64_t phase_start;
     uint32_t cr_value;
 
     if (!g_AxiDma.initialized) {
@@ -434,7 +661,9 @@ int axi_dma_start_rx(uint64_t buffer_addr, uint32_t length)
     }
 
     /* Invalidate destination buffer */
-    Xil_DCacheInvalidateRange(buffer_addr, length);
+    dma_buf_sync_for_device(buffer_addr, length, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     /* Set destination address */
     axi_dma_write_rx_reg(XAXIDMA_DSTADDR_OFFSET, (uint32_t)(buffer_addr & 0xFFFFFFFF));
@@ -442,6 +671,11 @@ int axi_dma_start_rx(uint64_t buffer_addr, uint32_t length)
 
     /* Clear completion flag */
     g_AxiDma.rx_complete = false;
+    g_AxiDma.rx_length = length;
+    g_AxiDma.rx_last_desc = NULL;
+
+    /* Drop an IOC left over from an earlier transfer */
+    axi_dma_write_rx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
 
     /* Start DMA */
     cr_value = axi_dma_read_rx_reg(XAXIDMA_CR_OFFSET);
@@ -449,6 +683,7 @@ int axi_dma_start_rx(uint64_t buffer_addr, uint32_t length)
 
     /* Set transfer length (starts the transfer) */
     axi_dma_write_rx_reg(XAXIDMA_BUFFLEN_OFFSET, length);
+    dma_phase_kick(phase_start);
 
     return DMA_SUCCESS;
 }
@@ -459,15 +694,22 @@ int axi_dma_start_rx(uint64_t buffer_addr, uint32_t length)
 
 int axi_dma_wait_tx(uint32_t timeout_us)
 {
+    DmaWait_t wait;
     uint32_t status;
-    uint32_t elapsed_us = 0;
-    uint32_t poll_interval_us = 10;  /* 10us poll interval */
     uint32_t loop_count = 0;
 
     LOG_DEBUG("AXI DMA: Wait TX, timeout=%lu us\r\n", (unsigned long)timeout_us);
 
-    while (elapsed_us < timeout_us) {
-        status = axi_dma_read_tx_reg(XAXIDMA_SR_OFFSET);
+    dma_wait_begin(&wait, timeout_us, dma_wait_expected_ns(DMA_TYPE_AXI_DMA, g_AxiDma.tx_length));
+
+    do {
+        /* BD polling: stay off the register bus until the BD is written back */
+        if (dma_wait_use_bd() && g_AxiDma.tx_last_desc != NULL &&
+            !dma_wait_bd_complete(&g_AxiDma.tx_last_desc->status, XAXIDMA_BD_STS_COMPLETE_MASK)) {
+            continue;
+        }
+
+        status = dma_wait_mmio_read(g_AxiDma.base_addr + XAXIDMA_TX_OFFSET + XAXIDMA_SR_OFFSET);
         loop_count++;
 
         /* Check for errors */
@@ -479,49 +721,71 @@ int axi_dma_wait_tx(uint32_t timeout_us)
                       (unsigned long)loop_count);
             /* Clear error bits */
             axi_dma_write_tx_reg(XAXIDMA_SR_OFFSET, status & XAXIDMA_SR_ALL_ERR_MASK);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
         /* Check for completion (idle) */
         if (status & XAXIDMA_SR_IDLE_MASK) {
+            axi_dma_write_tx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
             g_AxiDma.tx_complete = true;
             g_AxiDma.tx_transfers++;
+            bd_ring_retire(&g_AxiDma.tx_ring, bd_ring_outstanding(&g_AxiDma.tx_ring));
             LOG_DEBUG("AXI DMA TX: Complete (idle), loops=%lu\r\n", (unsigned long)loop_count);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        /* Check IOC interrupt status */
+        /*
+         * Check IOC interrupt status. On a descriptor chain IOC only means
+         * some BD finished (IRQThreshold is 1), so retire what has been
+         * written back and keep waiting until the last BD is among them.
+         * IOC is cleared first so a BD finishing during the reap raises it
+         * again.
+         */
         if (status & XAXIDMA_SR_IOC_IRQ_MASK) {
-            /* Clear interrupt */
             axi_dma_write_tx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
+            if (g_AxiDma.tx_last_desc != NULL) {
+                bd_ring_reap(&g_AxiDma.tx_ring, 0);
+                if (bd_ring_outstanding(&g_AxiDma.tx_ring) != 0) {
+                    continue;
+                }
+            }
             g_AxiDma.tx_complete = true;
             g_AxiDma.tx_transfers++;
             LOG_DEBUG("AXI DMA TX: Complete (IOC), loops=%lu\r\n", (unsigned long)loop_count);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        /* Use usleep for reliable timing */
-        usleep(poll_interval_us);
-        elapsed_us += poll_interval_us;
-    }
+    } while (dma_wait_continue(&wait));
 
+    dma_wait_end(&wait, true);
     status = axi_dma_read_tx_reg(XAXIDMA_SR_OFFSET);
     LOG_ERROR("AXI DMA TX Timeout: final_status=0x%08lX, loops=%lu, elapsed=%lu us\r\n",
-              (unsigned long)status, (unsigned long)loop_count, (unsigned long)elapsed_us);
+              (unsigned long)status, (unsigned long)loop_count,
+              (unsigned long)dma_wait_elapsed_us(&wait));
     return DMA_ERROR_TIMEOUT;
 }
 
 int axi_dma_wait_rx(uint32_t timeout_us)
 {
+    DmaWait_t wait;
     uint32_t status;
-    uint32_t elapsed_us = 0;
-    uint32_t poll_interval_us = 10;  /* 10us poll interval */
     uint32_t loop_count = 0;
 
     LOG_DEBUG("AXI DMA: Wait RX, timeout=%lu us\r\n", (unsigned long)timeout_us);
 
-    while (elapsed_us < timeout_us) {
-        status = axi_dma_read_rx_reg(XAXIDMA_SR_OFFSET);
+    dma_wait_begin(&wait, timeout_us, dma_wait_expected_ns(DMA_TYPE_AXI_DMA, g_AxiDma.rx_length));
+
+    do {
+        /* BD polling: stay off the register bus until the BD is written back */
+        if (dma_wait_use_bd() && g_AxiDma.rx_last_desc != NULL &&
+            !dma_wait_bd_complete(&g_AxiDma.rx_last_desc->status, XAXIDMA_BD_STS_COMPLETE_MASK)) {
+            continue;
+        }
+
+        status = dma_wait_mmio_read(g_AxiDma.base_addr + XAXIDMA_RX_OFFSET + XAXIDMA_SR_OFFSET);
         loop_count++;
 
         /* Check for errors */
@@ -533,35 +797,50 @@ int axi_dma_wait_rx(uint32_t timeout_us)
                       (unsigned long)loop_count);
             /* Clear error bits */
             axi_dma_write_rx_reg(XAXIDMA_SR_OFFSET, status & XAXIDMA_SR_ALL_ERR_MASK);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
         /* Check for completion (idle) */
         if (status & XAXIDMA_SR_IDLE_MASK) {
+            axi_dma_write_rx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
             g_AxiDma.rx_complete = true;
             g_AxiDma.rx_transfers++;
+            bd_ring_retire(&g_AxiDma.rx_ring, bd_ring_outstanding(&g_AxiDma.rx_ring));
             LOG_DEBUG("AXI DMA RX: Complete (idle), loops=%lu\r\n", (unsigned long)loop_count);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        /* Check IOC interrupt status */
+        /*
+         * Check IOC interrupt status. On a descriptor chain IOC only means
+         * some BD finished (IRQThreshold is 1), so retire what has been
+         * written back and keep waiting until the last BD is among them.
+         * IOC is cleared first so a BD finishing during the reap raises it
+         * again.
+         */
         if (status & XAXIDMA_SR_IOC_IRQ_MASK) {
-            /* Clear interrupt */
             axi_dma_write_rx_reg(XAXIDMA_SR_OFFSET, XAXIDMA_SR_IOC_IRQ_MASK);
+            if (g_AxiDma.rx_last_desc != NULL) {
+                bd_ring_reap(&g_AxiDma.rx_ring, 0);
+                if (bd_ring_outstanding(&g_AxiDma.rx_ring) != 0) {
+                    continue;
+                }
+            }
             g_AxiDma.rx_complete = true;
             g_AxiDma.rx_transfers++;
             LOG_DEBUG("AXI DMA RX: Complete (IOC), loops=%lu\r\n", (unsigned long)loop_count);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        /* Use usleep for reliable timing */
-        usleep(poll_interval_us);
-        elapsed_us += poll_interval_us;
-    }
+    } while (dma_wait_continue(&wait));
 
+    dma_wait_end(&wait, true);
     status = axi_dma_read_rx_reg(XAXIDMA_SR_OFFSET);
     LOG_ERROR("AXI DMA RX Timeout: final_status=0x%08lX, loops=%lu, elapsed=%lu us\r\n",
-              (unsigned long)status, (unsigned long)loop_count, (unsigned long)elapsed_us);
+              (unsigned long)status, (unsigned long)loop_count,
+              (unsigned long)dma_wait_elapsed_us(&wait));
     return DMA_ERROR_TIMEOUT;
 }
 
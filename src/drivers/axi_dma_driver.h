@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../dma_benchmark.h"
+#include "../utils/bd_ring.h"
+#include "../utils/memory_utils.h"
 
 /*******************************************************************************
  * AXI DMA Register Offsets
@@ -104,19 +106,18 @@ typedef struct {
     uint32_t max_transfer_len;
 
     /* Descriptor rings */
-    AxiDmaSgDesc_t* tx_ring;
-    AxiDmaSgDesc_t* rx_ring;
-    uint32_t ring_size;
-    uint32_t tx_head;
-    uint32_t tx_tail;
-    uint32_t rx_head;
-    uint32_t rx_tail;
+    BdRing_t tx_ring;
+    BdRing_t rx_ring;
 
     /* Transfer state */
     volatile bool tx_complete;
     volatile bool rx_complete;
     volatile uint32_t tx_error;
     volatile uint32_t rx_error;
+    uint32_t tx_length;              /* In-flight length (wait prediction) */
+    uint32_t rx_length;
+    AxiDmaSgDesc_t* tx_last_desc;    /* Last submitted BD, NULL in simple mode */
+    AxiDmaSgDesc_t* rx_last_desc;
 
     /* Statistics */
     uint64_t tx_bytes;
@@ -164,6 +165,24 @@ int axi_dma_configure(bool use_sg, bool use_irq);
  */
 int axi_dma_setup_sg_ring(AxiDmaSgDesc_t* tx_descs, AxiDmaSgDesc_t* rx_descs, uint32_t num_descs);
 
+/**
+ * @brief Reallocate the TX and RX descriptor rings with a new placement and depth
+ *
+ * Resets the engine. The rings are allocated at init with
+ * DESC_RING_CONFIG_DEFAULT.
+ *
+ * @param config Ring placement and depth (applies to both rings)
+ * @return 0 on success, DMA_ERROR_BUSY with descriptors outstanding,
+ *         DMA_ERROR_NO_MEMORY if the region is full (old rings kept)
+ */
+int axi_dma_set_ring_config(const DescRingConfig_t* config);
+
+/**
+ * @brief Get the current descriptor ring placement and depth
+ * @param config Configuration output
+ */
+void axi_dma_get_ring_config(DescRingConfig_t* config);
+
 /**
  * @brief Start a simple (non-SG) transfer
  * @param src_addr Source address
@@ -182,6 +201,25 @@ int axi_dma_simple_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t lengt
  */
 int axi_dma_sg_transfer(uint64_t src_addr, uint64_t dst_addr, uint32_t length);
 
+/**
+ * @brief Start a chain of Scatter-Gather loopback transfers, or append it
+ *        to the chains still in flight
+ * @param xfers Transfers, one TX and one RX descriptor each
+ * @param count Number of transfers (at most the ring size)
+ * @param doorbell_per_bd true: commit and write the tail pointers after
+ *        every transfer; false: commit all, then one tail pointer write
+ *        per channel
+ * @return 0 on success, negative error code on failure
+ */
+int axi_dma_sg_transfer_batch(const DmaXfer_t* xfers, uint32_t count, bool doorbell_per_bd);
+
+/**
+ * @brief Retire completed Scatter-Gather descriptors (queued operation)
+ * @return Number of transfers completed since the last call, or negative
+ *         error code if either channel reports an error
+ */
+int axi_dma_sg_reap(void);
+
 /**
  * @brief Start MM2S (TX) transfer
  * @param buffer_addr Source buffer address
@@ -5,6 +5,7 @@
  * Wrapper for Xilinx AXI Multi-Channel DMA IP.
  */
 
+#include <stddef.h>
 #include <string.h>
 #include "xil_io.h"
 #include "xil_cache.h"
@@ -13,6 +14,10 @@
 #include "../platform_config.h"
 #include "../utils/timer_utils.h"
 #include "../utils/debug_print.h"
+#include "../utils/dma_wait.h"
+#include "../utils/dma_buf.h"
+#include "../utils/dma_phase.h"
+#include "../utils/cache_utils.h"
 
 /*******************************************************************************
  * Local Variables
@@ -20,9 +25,18 @@
 
 static AxiMcdmaInst_t g_AxiMcdma = {0};
 
-/* Descriptor memory for all channels */
-static McdmaSgDesc_t g_Mm2sDescRing[MCDMA_MAX_CHANNELS][MAX_SG_DESCRIPTORS] __attribute__((aligned(64)));
-static McdmaSgDesc_t g_S2mmDescRing[MCDMA_MAX_CHANNELS][MAX_SG_DESCRIPTORS] __attribute__((aligned(64)));
+/* Descriptor memory per channel, allocated from the configured region on enable */
+static McdmaSgDesc_t* g_Mm2sDescRing[MCDMA_MAX_CHANNELS];
+static McdmaSgDesc_t* g_S2mmDescRing[MCDMA_MAX_CHANNELS];
+static DescRingConfig_t g_RingConfig = DESC_RING_CONFIG_DEFAULT;
+
+static const BdRingLayout_t g_McdmaBdLayout = {
+    .bd_size = sizeof(McdmaSgDesc_t),
+    .next_lo_offset = offsetof(McdmaSgDesc_t, next_desc),
+    .next_hi_offset = offsetof(McdmaSgDesc_t, next_desc_msb),
+    .status_offset = offsetof(McdmaSgDesc_t, status),
+    .complete_mask = XMCDMA_BD_STS_COMPLETE_MASK
+};
 
 /*******************************************************************************
  * Helper Functions
@@ -62,6 +76,19 @@ static inline uint32_t mcdma_read_s2mm_ch_reg(uint32_t channel, uint32_t offset)
     return Xil_In32(g_AxiMcdma.base_addr + ch_base + offset);
 }
 
+/* Status reads from the wait loops are counted by the wait layer */
+static inline uint32_t mcdma_poll_mm2s_sr(uint32_t channel)
+{
+    uint32_t ch_base = MCDMA_MM2S_BASE_OFFSET + (channel * MCDMA_CHANNEL_OFFSET);
+    return dma_wait_mmio_read(g_AxiMcdma.base_addr + ch_base + XMCDMA_CH_SR_OFFSET);
+}
+
+static inline uint32_t mcdma_poll_s2mm_sr(uint32_t channel)
+{
+    uint32_t ch_base = MCDMA_S2MM_BASE_OFFSET + (channel * MCDMA_CHANNEL_OFFSET);
+    return dma_wait_mmio_read(g_AxiMcdma.base_addr + ch_base + XMCDMA_CH_SR_OFFSET);
+}
+
 /*******************************************************************************
  * Initialization Functions
  ******************************************************************************/
@@ -85,14 +112,10 @@ int axi_mcdma_init(void)
         g_AxiMcdma.mm2s_channels[i].channel_id = i;
         g_AxiMcdma.mm2s_channels[i].enabled = false;
         g_AxiMcdma.mm2s_channels[i].busy = false;
-        g_AxiMcdma.mm2s_channels[i].desc_ring = g_Mm2sDescRing[i];
-        g_AxiMcdma.mm2s_channels[i].ring_size = MAX_SG_DESCRIPTORS;
 
         g_AxiMcdma.s2mm_channels[i].channel_id = i;
         g_AxiMcdma.s2mm_channels[i].enabled = false;
         g_AxiMcdma.s2mm_channels[i].busy = false;
-        g_AxiMcdma.s2mm_channels[i].desc_ring = g_S2mmDescRing[i];
-        g_AxiMcdma.s2mm_channels[i].ring_size = MAX_SG_DESCRIPTORS;
     }
 
     /* Reset MCDMA */
@@ -169,6 +192,12 @@ int axi_mcdma_reset(void)
         return DMA_ERROR_TIMEOUT;
     }
 
+    /* Descriptors in flight were discarded by the reset */
+    for (uint32_t i = 0; i < MCDMA_MAX_CHANNELS; i++) {
+        bd_ring_reset(&g_AxiMcdma.mm2s_channels[i].desc_ring);
+        bd_ring_reset(&g_AxiMcdma.s2mm_channels[i].desc_ring);
+    }
+
     return DMA_SUCCESS;
 }
 
@@ -196,7 +225,13 @@ int axi_mcdma_enable_mm2s_channel(uint32_t channel, bool use_irq)
     }
 
     /* Setup descriptor ring */
-    axi_mcdma_setup_mm2s_ring(channel, g_Mm2sDescRing[channel], MAX_SG_DESCRIPTORS);
+    if (g_Mm2sDescRing[channel] == NULL) {
+        g_Mm2sDescRing[channel] = memory_alloc_desc_ring(&g_RingConfig, sizeof(McdmaSgDesc_t));
+        if (g_Mm2sDescRing[channel] == NULL) {
+            return DMA_ERROR_NO_MEMORY;
+        }
+    }
+    axi_mcdma_setup_mm2s_ring(channel, g_Mm2sDescRing[channel], g_RingConfig.depth);
 
     /* Configure channel */
     cr_value = 0;
@@ -225,7 +260,13 @@ int axi_mcdma_enable_s2mm_channel(uint32_t channel, bool use_irq)
     }
 
     /* Setup descriptor ring */
-    axi_mcdma_setup_s2mm_ring(channel, g_S2mmDescRing[channel], MAX_SG_DESCRIPTORS);
+    if (g_S2mmDescRing[channel] == NULL) {
+        g_S2mmDescRing[channel] = memory_alloc_desc_ring(&g_RingConfig, sizeof(McdmaSgDesc_t));
+        if (g_S2mmDescRing[channel] == NULL) {
+            return DMA_ERROR_NO_MEMORY;
+        }
+    }
+    axi_mcdma_setup_s2mm_ring(channel, g_S2mmDescRing[channel], g_RingConfig.depth);
 
     /* Configure channel */
     cr_value = 0;
@@ -286,56 +327,60 @@ int axi_mcdma_disable_s2mm_channel(uint32_t channel)
     return DMA_SUCCESS;
 }
 
-int axi_mcdma_setup_mm2s_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t num_descs)
+int axi_mcdma_set_ring_config(const DescRingConfig_t* config)
 {
-    uint32_t i;
-    uint64_t desc_addr;
-
-    if (channel >= MCDMA_MAX_CHANNELS || !descs || num_descs == 0) {
+    if (!memory_desc_ring_config_valid(config)) {
         return DMA_ERROR_INVALID_PARAM;
     }
 
-    /* Initialize descriptor ring */
-    memset(descs, 0, num_descs * sizeof(McdmaSgDesc_t));
-    for (i = 0; i < num_descs; i++) {
-        desc_addr = (uint64_t)&descs[(i + 1) % num_descs];
-        descs[i].next_desc = (uint32_t)(desc_addr & 0xFFFFFFFF);
-        descs[i].next_desc_msb = (uint32_t)(desc_addr >> 32);
+    for (uint32_t i = 0; i < MCDMA_MAX_CHANNELS; i++) {
+        if (g_AxiMcdma.mm2s_channels[i].enabled || g_AxiMcdma.s2mm_channels[i].enabled) {
+            return DMA_ERROR_BUSY;
+        }
     }
 
-    Xil_DCacheFlushRange((UINTPTR)descs, num_descs * sizeof(McdmaSgDesc_t));
-
-    g_AxiMcdma.mm2s_channels[channel].desc_ring = descs;
-    g_AxiMcdma.mm2s_channels[channel].ring_size = num_descs;
-    g_AxiMcdma.mm2s_channels[channel].desc_head = 0;
-    g_AxiMcdma.mm2s_channels[channel].desc_tail = 0;
-
+    /* Next enable allocates with the new configuration */
+    for (uint32_t i = 0; i < MCDMA_MAX_CHANNELS; i++) {
+        memory_free_aligned(g_Mm2sDescRing[i]);
+        memory_free_aligned(g_S2mmDescRing[i]);
+        g_Mm2sDescRing[i] = NULL;
+        g_S2mmDescRing[i] = NULL;
+    }
+    g_RingConfig = *config;
     return DMA_SUCCESS;
 }
 
-int axi_mcdma_setup_s2mm_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t num_descs)
+void axi_mcdma_get_ring_config(DescRingConfig_t* config)
 {
-    uint32_t i;
-    uint64_t desc_addr;
+    if (config != NULL) {
+        *config = g_RingConfig;
+    }
+}
 
+int axi_mcdma_setup_mm2s_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t num_descs)
+{
     if (channel >= MCDMA_MAX_CHANNELS || !descs || num_descs == 0) {
         return DMA_ERROR_INVALID_PARAM;
     }
 
-    /* Initialize descriptor ring */
-    memset(descs, 0, num_descs * sizeof(McdmaSgDesc_t));
-    for (i = 0; i < num_descs; i++) {
-        desc_addr = (uint64_t)&descs[(i + 1) % num_descs];
-        descs[i].next_desc = (uint32_t)(desc_addr & 0xFFFFFFFF);
-        descs[i].next_desc_msb = (uint32_t)(desc_addr >> 32);
+    if (!bd_ring_init(&g_AxiMcdma.mm2s_channels[channel].desc_ring, descs, num_descs,
+                      &g_McdmaBdLayout, cache_flush_range, cache_invalidate_range)) {
+        return DMA_ERROR_INVALID_PARAM;
     }
 
-    Xil_DCacheFlushRange((UINTPTR)descs, num_descs * sizeof(McdmaSgDesc_t));
+    return DMA_SUCCESS;
+}
 
-    g_AxiMcdma.s2mm_channels[channel].desc_ring = descs;
-    g_AxiMcdma.s2mm_channels[channel].ring_size = num_descs;
-    g_AxiMcdma.s2mm_channels[channel].desc_head = 0;
-    g_AxiMcdma.s2mm_channels[channel].desc_tail = 0;
+int axi_mcdma_setup_s2mm_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t num_descs)
+{
+    if (channel >= MCDMA_MAX_CHANNELS || !descs || num_descs == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    if (!bd_ring_init(&g_AxiMcdma.s2mm_channels[channel].desc_ring, descs, num_descs,
+                      &g_McdmaBdLayout, cache_flush_range, cache_invalidate_range)) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
 
     return DMA_SUCCESS;
 }
@@ -363,12 +408,177 @@ int axi_mcdma_transfer(uint32_t channel, uint64_t src_addr, uint64_t dst_addr, u
     return DMA_SUCCESS;
 }
 
+/* Start (first) or extend (tail only) both directions of a channel */
+static void mcdma_sg_kick(uint32_t channel, uint64_t tx_desc_addr, uint64_t rx_desc_addr,
+                          uint64_t tx_tail_addr, uint64_t rx_tail_addr, bool start)
+{
+    uint64_t phase_start = dma_phase_begin();
+    uint32_t cr_value;
+
+    if (start) {
+        /* New chains: drop IOC left over from earlier transfers */
+        mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
+        mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
+
+        mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_CDESC_OFFSET, (uint32_t)(rx_desc_addr & 0xFFFFFFFF));
+        mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_CDESC_MSB_OFFSET, (uint32_t)(rx_desc_addr >> 32));
+        cr_value = mcdma_read_s2mm_ch_reg(channel, XMCDMA_CH_CR_OFFSET);
+        mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_CR_OFFSET, cr_value | XMCDMA_CH_CR_RS_MASK);
+
+        mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_CDESC_OFFSET, (uint32_t)(tx_desc_addr & 0xFFFFFFFF));
+        mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_CDESC_MSB_OFFSET, (uint32_t)(tx_desc_addr >> 32));
+        cr_value = mcdma_read_mm2s_ch_reg(channel, XMCDMA_CH_CR_OFFSET);
+        mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_CR_OFFSET, cr_value | XMCDMA_CH_CR_RS_MASK);
+    }
+
+    /* S2MM tail first so the receive side is armed before data arrives */
+    mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_TDESC_OFFSET, (uint32_t)(rx_tail_addr & 0xFFFFFFFF));
+    mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_TDESC_MSB_OFFSET, (uint32_t)(rx_tail_addr >> 32));
+    mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_TDESC_OFFSET, (uint32_t)(tx_tail_addr & 0xFFFFFFFF));
+    mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_TDESC_MSB_OFFSET, (uint32_t)(tx_tail_addr >> 32));
+    dma_phase_kick(phase_start);
+}
+
+int axi_mcdma_transfer_batch(uint32_t channel, const DmaXfer_t* xfers, uint32_t count,
+                             bool doorbell_per_bd)
+{
+    McdmaChannel_t* tx;
+    McdmaChannel_t* rx;
+    McdmaSgDesc_t* tx_desc = NULL;
+    McdmaSgDesc_t* rx_desc = NULL;
+    uint32_t tx_first, rx_first, tx_idx, rx_idx, i;
+    uint32_t total = 0;
+    bool start;
+
+    if (!g_AxiMcdma.initialized || channel >= g_AxiMcdma.num_mm2s_channels ||
+        channel >= g_AxiMcdma.num_s2mm_channels) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    tx = &g_AxiMcdma.mm2s_channels[channel];
+    rx = &g_AxiMcdma.s2mm_channels[channel];
+    if (!tx->enabled || !rx->enabled) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (xfers == NULL || count == 0 || count > tx->desc_ring.count ||
+        count > rx->desc_ring.count) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    if (bd_ring_free_count(&tx->desc_ring) < count) {
+        bd_ring_reap(&tx->desc_ring, 0);
+    }
+    if (bd_ring_free_count(&rx->desc_ring) < count) {
+        bd_ring_reap(&rx->desc_ring, 0);
+    }
+    if (bd_ring_free_count(&tx->desc_ring) < count ||
+        bd_ring_free_count(&rx->desc_ring) < count) {
+        return DMA_ERROR_BUSY;
+    }
+
+    /* Nothing outstanding: start new chains; otherwise append to the running ones */
+    start = (bd_ring_outstanding(&rx->desc_ring) == 0);
+
+    tx_first = bd_ring_alloc(&tx->desc_ring, count);
+    rx_first = bd_ring_alloc(&rx->desc_ring, count);
+
+    tx->transfer_complete = false;
+    rx->transfer_complete = false;
+    tx->busy = true;
+    rx->busy = true;
+
+    for (i = 0, tx_idx = tx_first, rx_idx = rx_first; i < count;
+         i++, tx_idx = bd_ring_next(&tx->desc_ring, tx_idx),
+         rx_idx = bd_ring_next(&rx->desc_ring, rx_idx)) {
+        tx_desc = (McdmaSgDesc_t*)bd_ring_bd(&tx->desc_ring, tx_idx);
+        tx_desc->buffer_addr = (uint32_t)(xfers[i].src_addr & 0xFFFFFFFF);
+        tx_desc->buffer_addr_msb = (uint32_t)(xfers[i].src_addr >> 32);
+        tx_desc->control = XMCDMA_BD_CTRL_SOF_MASK | XMCDMA_BD_CTRL_EOF_MASK | xfers[i].length;
+        tx_desc->status = 0;
+
+        rx_desc = (McdmaSgDesc_t*)bd_ring_bd(&rx->desc_ring, rx_idx);
+        rx_desc->buffer_addr = (uint32_t)(xfers[i].dst_addr & 0xFFFFFFFF);
+        rx_desc->buffer_addr_msb = (uint32_t)(xfers[i].dst_addr >> 32);
+        rx_desc->control = xfers[i].length;
+        rx_desc->status = 0;
+        total += xfers[i].length;
+
+        if (!doorbell_per_bd) {
+            continue;
+        }
+
+        bd_ring_commit(&tx->desc_ring, tx_idx, 1);
+        bd_ring_commit(&rx->desc_ring, rx_idx, 1);
+        dma_buf_sync_for_device(xfers[i].src_addr, xfers[i].length, DMA_DIR_TO_DEVICE);
+        dma_buf_sync_for_device(xfers[i].dst_addr, xfers[i].length, DMA_DIR_FROM_DEVICE);
+
+        mcdma_sg_kick(channel, (uint64_t)tx_desc, (uint64_t)rx_desc,
+                      (uint64_t)tx_desc, (uint64_t)rx_desc, i == 0 && start);
+    }
+
+    if (!doorbell_per_bd) {
+        bd_ring_commit(&tx->desc_ring, tx_first, count);
+        bd_ring_commit(&rx->desc_ring, rx_first, count);
+        for (i = 0; i < count; i++) {
+            dma_buf_sync_for_device(xfers[i].src_addr, xfers[i].length, DMA_DIR_TO_DEVICE);
+            dma_buf_sync_for_device(xfers[i].dst_addr, xfers[i].length, DMA_DIR_FROM_DEVICE);
+        }
+
+        mcdma_sg_kick(channel, bd_ring_bd_addr(&tx->desc_ring, tx_first),
+                      bd_ring_bd_addr(&rx->desc_ring, rx_first),
+                      (uint64_t)tx_desc, (uint64_t)rx_desc, start);
+    }
+
+    tx->transfer_length = total;
+    rx->transfer_length = total;
+    tx->last_desc = tx_desc;
+    rx->last_desc = rx_desc;
+
+    return DMA_SUCCESS;
+}
+
+int axi_mcdma_reap(uint32_t channel)
+{
+    McdmaChannel_t* tx;
+    McdmaChannel_t* rx;
+    int completed;
+
+    if (!g_AxiMcdma.initialized || channel >= g_AxiMcdma.num_mm2s_channels ||
+        channel >= g_AxiMcdma.num_s2mm_channels) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    tx = &g_AxiMcdma.mm2s_channels[channel];
+    rx = &g_AxiMcdma.s2mm_channels[channel];
+    if (!tx->enabled || !rx->enabled) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if ((mcdma_read_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET) & XMCDMA_CH_SR_ERR_MASK) ||
+        (mcdma_read_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET) & XMCDMA_CH_SR_ERR_MASK)) {
+        rx->errors++;
+        g_AxiMcdma.total_errors++;
+        return DMA_ERROR_DMA_FAIL;
+    }
+
+    /* A transfer is complete once its S2MM descriptor is */
+    bd_ring_reap(&tx->desc_ring, 0);
+    completed = (int)bd_ring_reap(&rx->desc_ring, 0);
+    if (bd_ring_outstanding(&rx->desc_ring) == 0) {
+        tx->busy = false;
+        rx->busy = false;
+    }
+
+    return completed;
+}
+
 int axi_mcdma_start_mm2s(uint32_t channel, uint64_t buffer_addr, uint32_t length)
 {
     McdmaChannel_t* ch;
     McdmaSgDesc_t* desc;
     uint64_t desc_addr;
+    uint64_t phase_start;
     uint32_t cr_value;
+    uint32_t idx;
 
     if (!g_AxiMcdma.initialized || channel >= g_AxiMcdma.num_mm2s_channels) {
         return DMA_ERROR_INVALID_PARAM;
@@ -379,18 +589,36 @@ int axi_mcdma_start_mm2s(uint32_t channel, uint64_t buffer_addr, uint32_t length
         return DMA_ERROR_NOT_INIT;
     }
 
+    /* Reclaim written-back descriptors if the ring is full */
+    if (bd_ring_free_count(&ch->desc_ring) == 0) {
+        bd_ring_reap(&ch->desc_ring, 0);
+    }
+    phase_start = dma_phase_begin();
+    idx = bd_ring_alloc(&ch->desc_ring, 1);
+    if (idx == BD_RING_INVALID_INDEX) {
+        return DMA_ERROR_BUSY;
+    }
+
     /* Setup descriptor */
-    desc = &ch->desc_ring[ch->desc_head];
+    desc = (McdmaSgDesc_t*)bd_ring_bd(&ch->desc_ring, idx);
     desc->buffer_addr = (uint32_t)(buffer_addr & 0xFFFFFFFF);
     desc->buffer_addr_msb = (uint32_t)(buffer_addr >> 32);
     desc->control = XMCDMA_BD_CTRL_SOF_MASK | XMCDMA_BD_CTRL_EOF_MASK | length;
     desc->status = 0;
 
-    Xil_DCacheFlushRange((UINTPTR)desc, sizeof(McdmaSgDesc_t));
-    Xil_DCacheFlushRange(buffer_addr, length);
+    bd_ring_commit(&ch->desc_ring, idx, 1);
+    dma_phase_end(DMA_PHASE_PROGRAM, phase_start);
+    dma_buf_sync_for_device(buffer_addr, length, DMA_DIR_TO_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     ch->transfer_complete = false;
     ch->busy = true;
+    ch->transfer_length = length;
+    ch->last_desc = desc;
+
+    /* New chain: drop IOC left over from earlier transfers */
+    mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
 
     /* Set current descriptor */
     desc_addr = (uint64_t)desc;
@@ -404,8 +632,7 @@ int axi_mcdma_start_mm2s(uint32_t channel, uint64_t buffer_addr, uint32_t length
     /* Set tail descriptor (starts transfer) */
     mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_TDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
     mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_TDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
-
-    ch->desc_head = (ch->desc_head + 1) % ch->ring_size;
+    dma_phase_kick(phase_start);
 
     return DMA_SUCCESS;
 }
@@ -415,7 +642,9 @@ int axi_mcdma_start_s2mm(uint32_t channel, uint64_t buffer_addr, uint32_t length
     McdmaChannel_t* ch;
     McdmaSgDesc_t* desc;
     uint64_t desc_addr;
+    uint64_t phase_start;
     uint32_t cr_value;
+    uint32_t idx;
 
     if (!g_AxiMcdma.initialized || channel >= g_AxiMcdma.num_s2mm_channels) {
         return DMA_ERROR_INVALID_PARAM;
@@ -426,18 +655,36 @@ int axi_mcdma_start_s2mm(uint32_t channel, uint64_t buffer_addr, uint32_t length
         return DMA_ERROR_NOT_INIT;
     }
 
+    /* Reclaim written-back descriptors if the ring is full */
+    if (bd_ring_free_count(&ch->desc_ring) == 0) {
+        bd_ring_reap(&ch->desc_ring, 0);
+    }
+    phase_start = dma_phase_begin();
+    idx = bd_ring_alloc(&ch->desc_ring, 1);
+    if (idx == BD_RING_INVALID_INDEX) {
+        return DMA_ERROR_BUSY;
+    }
+
     /* Setup descriptor */
-    desc = &ch->desc_ring[ch->desc_head];
+    desc = (McdmaSgDesc_t*)bd_ring_bd(&ch->desc_ring, idx);
     desc->buffer_addr = (uint32_t)(buffer_addr & 0xFFFFFFFF);
     desc->buffer_addr_msb = (uint32_t)(buffer_addr >> 32);
     desc->control = length;
     desc->status = 0;
 
-    Xil_DCacheFlushRange((UINTPTR)desc, sizeof(McdmaSgDesc_t));
-    Xil_DCacheInvalidateRange(buffer_addr, length);
+    bd_ring_commit(&ch->desc_ring, idx, 1);
+    dma_phase_end(DMA_PHASE_PROGRAM, phase_start);
+    dma_buf_sync_for_device(buffer_addr, length, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     ch->transfer_complete = false;
     ch->busy = true;
+    ch->transfer_length = length;
+    ch->last_desc = desc;
+
+    /* New chain: drop IOC left over from earlier transfers */
+    mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
 
     /* Set current descriptor */
     desc_addr = (uint64_t)desc;
@@ -451,8 +698,7 @@ int axi_mcdma_start_s2mm(uint32_t channel, uint64_t buffer_addr, uint32_t length
     /* Set tail descriptor (starts transfer) */
     mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_TDESC_OFFSET, (uint32_t)(desc_addr & 0xFFFFFFFF));
     mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_TDESC_MSB_OFFSET, (uint32_t)(desc_addr >> 32));
-
-    ch->desc_head = (ch->desc_head + 1) % ch->ring_size;
+    dma_phase_kick(phase_start);
 
     return DMA_SUCCESS;
 }
@@ -464,9 +710,8 @@ int axi_mcdma_start_s2mm(uint32_t channel, uint64_t buffer_addr, uint32_t length
 int axi_mcdma_wait_mm2s(uint32_t channel, uint32_t timeout_us)
 {
     McdmaChannel_t* ch;
+    DmaWait_t wait;
     uint32_t status;
-    uint32_t elapsed_us = 0;
-    uint32_t poll_interval_us = 10;
 
     if (channel >= g_AxiMcdma.num_mm2s_channels) {
         return DMA_ERROR_INVALID_PARAM;
@@ -474,8 +719,16 @@ int axi_mcdma_wait_mm2s(uint32_t channel, uint32_t timeout_us)
 
     ch = &g_AxiMcdma.mm2s_channels[channel];
 
-    while (elapsed_us < timeout_us) {
-        status = mcdma_read_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET);
+    dma_wait_begin(&wait, timeout_us, dma_wait_expected_ns(DMA_TYPE_AXI_MCDMA, ch->transfer_length));
+
+    do {
+        /* BD polling: stay off the register bus until the BD is written back */
+        if (dma_wait_use_bd() && ch->last_desc != NULL &&
+            !dma_wait_bd_complete(&ch->last_desc->status, XMCDMA_BD_STS_COMPLETE_MASK)) {
+            continue;
+        }
+
+        status = mcdma_poll_mm2s_sr(channel);
 
         if (status & XMCDMA_CH_SR_ERR_MASK) {
             ch->transfer_error = status;
@@ -484,28 +737,37 @@ int axi_mcdma_wait_mm2s(uint32_t channel, uint32_t timeout_us)
             LOG_ERROR("MCDMA MM2S ch%lu Error: status=0x%08lX\r\n",
                       (unsigned long)channel, (unsigned long)status);
             mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET, status);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
         if (status & XMCDMA_CH_SR_IDLE_MASK) {
+            mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
             ch->transfer_complete = true;
             ch->num_transfers++;
             ch->busy = false;
+            bd_ring_retire(&ch->desc_ring, bd_ring_outstanding(&ch->desc_ring));
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
+        /* IOC fires per BD: done only once the last BD has been written back */
         if (status & XMCDMA_CH_SR_IOC_IRQ_MASK) {
             mcdma_write_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
+            bd_ring_reap(&ch->desc_ring, 0);
+            if (bd_ring_outstanding(&ch->desc_ring) != 0) {
+                continue;
+            }
             ch->transfer_complete = true;
             ch->num_transfers++;
             ch->busy = false;
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        usleep(poll_interval_us);
-        elapsed_us += poll_interval_us;
-    }
+    } while (dma_wait_continue(&wait));
 
+    dma_wait_end(&wait, true);
     LOG_ERROR("MCDMA MM2S ch%lu Timeout: status=0x%08lX\r\n",
               (unsigned long)channel, (unsigned long)mcdma_read_mm2s_ch_reg(channel, XMCDMA_CH_SR_OFFSET));
     return DMA_ERROR_TIMEOUT;
@@ -514,9 +776,8 @@ int axi_mcdma_wait_mm2s(uint32_t channel, uint32_t timeout_us)
 int axi_mcdma_wait_s2mm(uint32_t channel, uint32_t timeout_us)
 {
     McdmaChannel_t* ch;
+    DmaWait_t wait;
     uint32_t status;
-    uint32_t elapsed_us = 0;
-    uint32_t poll_interval_us = 10;
 
     if (channel >= g_AxiMcdma.num_s2mm_channels) {
         return DMA_ERROR_INVALID_PARAM;
@@ -524,8 +785,16 @@ int axi_mcdma_wait_s2mm(uint32_t channel, uint32_t timeout_us)
 
     ch = &g_AxiMcdma.s2mm_channels[channel];
 
-    while (elapsed_us < timeout_us) {
-        status = mcdma_read_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET);
+    dma_wait_begin(&wait, timeout_us, dma_wait_expected_ns(DMA_TYPE_AXI_MCDMA, ch->transfer_length));
+
+    do {
+        /* BD polling: stay off the register bus until the BD is written back */
+        if (dma_wait_use_bd() && ch->last_desc != NULL &&
+            !dma_wait_bd_complete(&ch->last_desc->status, XMCDMA_BD_STS_COMPLETE_MASK)) {
+            continue;
+        }
+
+        status = mcdma_poll_s2mm_sr(channel);
 
         if (status & XMCDMA_CH_SR_ERR_MASK) {
             ch->transfer_error = status;
@@ -534,28 +803,37 @@ int axi_mcdma_wait_s2mm(uint32_t channel, uint32_t timeout_us)
             LOG_ERROR("MCDMA S2MM ch%lu Error: status=0x%08lX\r\n",
                       (unsigned long)channel, (unsigned long)status);
             mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET, status);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
         if (status & XMCDMA_CH_SR_IDLE_MASK) {
+            mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
             ch->transfer_complete = true;
             ch->num_transfers++;
             ch->busy = false;
+            bd_ring_retire(&ch->desc_ring, bd_ring_outstanding(&ch->desc_ring));
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
+        /* IOC fires per BD: done only once the last BD has been written back */
         if (status & XMCDMA_CH_SR_IOC_IRQ_MASK) {
             mcdma_write_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET, XMCDMA_CH_SR_IOC_IRQ_MASK);
+            bd_ring_reap(&ch->desc_ring, 0);
+            if (bd_ring_outstanding(&ch->desc_ring) != 0) {
+                continue;
+            }
             ch->transfer_complete = true;
             ch->num_transfers++;
             ch->busy = false;
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
-        usleep(poll_interval_us);
-        elapsed_us += poll_interval_us;
-    }
+    } while (dma_wait_continue(&wait));
 
+    dma_wait_end(&wait, true);
     LOG_ERROR("MCDMA S2MM ch%lu Timeout: status=0x%08lX\r\n",
               (unsigned long)channel, (unsigned long)mcdma_read_s2mm_ch_reg(channel, XMCDMA_CH_SR_OFFSET));
     return DMA_ERROR_TIMEOUT;
@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../dma_benchmark.h"
+#include "../utils/bd_ring.h"
+#include "../utils/memory_utils.h"
 
 /*******************************************************************************
  * AXI MCDMA Configuration
@@ -112,12 +114,11 @@ typedef struct {
     uint32_t channel_id;
     bool enabled;
     bool busy;
-    McdmaSgDesc_t* desc_ring;
-    uint32_t ring_size;
-    uint32_t desc_head;
-    uint32_t desc_tail;
+    BdRing_t desc_ring;
     volatile bool transfer_complete;
     volatile uint32_t transfer_error;
+    uint32_t transfer_length;        /* In-flight length (wait prediction) */
+    McdmaSgDesc_t* last_desc;        /* Last submitted BD */
     uint64_t bytes_transferred;
     uint32_t num_transfers;
     uint32_t errors;
@@ -221,6 +222,23 @@ int axi_mcdma_setup_mm2s_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t n
  */
 int axi_mcdma_setup_s2mm_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t num_descs);
 
+/**
+ * @brief Set the placement and depth of the channel descriptor rings
+ *
+ * Rings are allocated when a channel is enabled, so this only frees the
+ * current ones; every channel must be disabled.
+ *
+ * @param config Ring placement and depth (applies to every ring)
+ * @return 0 on success, DMA_ERROR_BUSY if a channel is enabled
+ */
+int axi_mcdma_set_ring_config(const DescRingConfig_t* config);
+
+/**
+ * @brief Get the current descriptor ring placement and depth
+ * @param config Configuration output
+ */
+void axi_mcdma_get_ring_config(DescRingConfig_t* config);
+
 /**
  * @brief Start a transfer on a specific channel pair (MM2S and S2MM)
  * @param channel Channel number
@@ -231,6 +249,28 @@ int axi_mcdma_setup_s2mm_ring(uint32_t channel, McdmaSgDesc_t* descs, uint32_t n
  */
 int axi_mcdma_transfer(uint32_t channel, uint64_t src_addr, uint64_t dst_addr, uint32_t length);
 
+/**
+ * @brief Start a chain of transfers on a channel pair, or append it to the
+ *        chains still in flight
+ * @param channel Channel number
+ * @param xfers Transfers, one MM2S and one S2MM descriptor each
+ * @param count Number of transfers (at most the ring size)
+ * @param doorbell_per_bd true: commit and write the tail pointers after
+ *        every transfer; false: commit all, then one tail pointer write
+ *        per direction
+ * @return 0 on success, negative error code on failure
+ */
+int axi_mcdma_transfer_batch(uint32_t channel, const DmaXfer_t* xfers, uint32_t count,
+                             bool doorbell_per_bd);
+
+/**
+ * @brief Retire completed descriptors on a channel pair (queued operation)
+ * @param channel Channel number
+ * @return Number of transfers completed since the last call, or negative
+ *         error code if either direction reports an error
+ */
+int axi_mcdma_reap(uint32_t channel);
+
 /**
  * @brief Start MM2S transfer on a channel
  * @param channel Channel number
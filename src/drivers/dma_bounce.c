@@ -0,0 +1,230 @@
+/**
+ * @file dma_bounce.c
+ * @brief OCM Bounce-Buffer Copy Path Implementation
+ *
+ * Bulk moves run through the ops table on channel 0. A bounced chunk is
+ * read from DDR as the whole lines that cover it, so both ends of the
+ * first hop are aligned, and the second hop only has the source
+ * misalignment, which it resolves against OCM rather than DDR.
+ */
+
+#include <string.h>
+#include "dma_bounce.h"
+#include "../platform_config.h"
+#include "../utils/memory_utils.h"
+#include "../utils/cache_utils.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define BOUNCE_LINE_MASK            ((uint64_t)BUFFER_ALIGNMENT - 1)
+
+/* Largest bulk chunk per slot: room for the leading misalignment (the
+ * first hop also stays within the engine limit with one line less) */
+#define BOUNCE_CHUNK_MAX            (DMA_BOUNCE_SLOT_SIZE - BUFFER_ALIGNMENT)
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static const DmaOps_t* g_BounceOps = NULL;
+static bool g_BounceUseSg = false;
+static uint32_t g_BounceMaxLen = 0;
+static uint32_t g_BounceThreshold = DMA_BOUNCE_DEFAULT_THRESHOLD;
+static uint64_t g_BounceSlots = 0;          /* OCM, DMA_BOUNCE_NUM_SLOTS slots */
+static uint32_t g_BounceNextSlot = 0;
+static DmaBounceStats_t g_BounceStats;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int bounce_dma(uint64_t dst, uint64_t src, uint32_t len)
+{
+    int status = dma_ops_transfer(g_BounceOps, 0, src, dst, len, g_BounceUseSg);
+
+    if (status == DMA_SUCCESS) {
+        g_BounceStats.dma_bytes += len;
+    }
+    return status;
+}
+
+/* Move a line-aligned destination chunk, through a slot if src is not aligned */
+static int bounce_move_bulk(uint64_t dst, uint64_t src, uint32_t len)
+{
+    uint64_t misalign = src & BOUNCE_LINE_MASK;
+    uint64_t slot;
+    int status;
+
+    if (misalign == 0 && len >= g_BounceThreshold) {
+        return bounce_dma(dst, src, len);
+    }
+
+    slot = g_BounceSlots + (uint64_t)g_BounceNextSlot * DMA_BOUNCE_SLOT_SIZE;
+    g_BounceNextSlot = (g_BounceNextSlot + 1) % DMA_BOUNCE_NUM_SLOTS;
+
+    status = bounce_dma(slot, src - misalign,
+                        (uint32_t)ALIGN_UP(misalign + len, (uint64_t)BUFFER_ALIGNMENT));
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+    g_BounceStats.bounced++;
+
+    return bounce_dma(dst, slot + misalign, len);
+}
+
+static int bounce_staged(uint64_t dst, uint64_t src, uint32_t len)
+{
+    uint32_t head = (uint32_t)MIN((uint64_t)len, (0 - dst) & BOUNCE_LINE_MASK);
+    uint32_t tail = (uint32_t)((len - head) & BOUNCE_LINE_MASK);
+    uint32_t bulk = len - head - tail;
+    uint32_t done = 0;
+    uint32_t chunk;
+    int status;
+
+    /* Partial destination lines belong to the CPU only */
+    memcpy((void*)(uintptr_t)dst, (const void*)(uintptr_t)src, head);
+    memcpy((void*)(uintptr_t)(dst + len - tail), (const void*)(uintptr_t)(src + len - tail),
+           tail);
+    g_BounceStats.cpu_bytes += head + tail;
+
+    while (done < bulk) {
+        chunk = MIN(bulk - done, MIN(BOUNCE_CHUNK_MAX, g_BounceMaxLen - BUFFER_ALIGNMENT));
+        status = bounce_move_bulk(dst + head + done, src + head + done, chunk);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+        done += chunk;
+    }
+
+    if (bulk > 0) {
+        cache_complete_dma_dst(dst + head, bulk);
+    }
+    g_BounceStats.staged++;
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int dma_bounce_init(DmaType_t engine, uint32_t threshold)
+{
+    const DmaOps_t* ops = dma_ops_get(engine);
+    DmaCaps_t caps;
+    int status;
+
+    if (engine == DMA_TYPE_CPU_MEMCPY) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (ops == NULL || dma_ops_get_caps(engine, &caps) != DMA_SUCCESS ||
+        caps.num_channels == 0 || caps.max_transfer_len < 2 * BUFFER_ALIGNMENT) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    dma_bounce_deinit();
+
+    g_BounceSlots = memory_alloc_dma_buffer(MEM_REGION_OCM,
+                                            (uint64_t)DMA_BOUNCE_NUM_SLOTS * DMA_BOUNCE_SLOT_SIZE);
+    if (g_BounceSlots == 0) {
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    if (ops->open_channel != NULL) {
+        status = ops->open_channel(0);
+        if (status != DMA_SUCCESS) {
+            memory_free_dma_buffer(g_BounceSlots);
+            g_BounceSlots = 0;
+            return status;
+        }
+    }
+
+    g_BounceOps = ops;
+    g_BounceUseSg = !caps.has_simple;
+    g_BounceMaxLen = caps.max_transfer_len & ~(uint32_t)BOUNCE_LINE_MASK;
+    g_BounceThreshold = threshold;
+    g_BounceNextSlot = 0;
+    dma_bounce_clear_stats();
+    return DMA_SUCCESS;
+}
+
+void dma_bounce_deinit(void)
+{
+    if (g_BounceOps != NULL && g_BounceOps->close_channel != NULL) {
+        g_BounceOps->close_channel(0);
+    }
+    g_BounceOps = NULL;
+
+    memory_free_dma_buffer(g_BounceSlots);
+    g_BounceSlots = 0;
+}
+
+void dma_bounce_set_threshold(uint32_t threshold)
+{
+    g_BounceThreshold = threshold;
+}
+
+uint32_t dma_bounce_get_threshold(void)
+{
+    return g_BounceThreshold;
+}
+
+DmaBouncePath_t dma_bounce_select(uint64_t dst, uint64_t src, uint32_t len)
+{
+    if (len < g_BounceThreshold || len > g_BounceMaxLen ||
+        ((dst | src | len) & BOUNCE_LINE_MASK) != 0) {
+        return DMA_BOUNCE_PATH_STAGED;
+    }
+    return DMA_BOUNCE_PATH_DIRECT;
+}
+
+int dma_bounce_copy(uint64_t dst, uint64_t src, uint32_t len, uint32_t flags)
+{
+    DmaBouncePath_t path;
+    int status;
+
+    if (g_BounceOps == NULL) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (dst == 0 || src == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (len == 0) {
+        return DMA_SUCCESS;
+    }
+
+    if (flags & DMA_BOUNCE_F_DIRECT) {
+        path = DMA_BOUNCE_PATH_DIRECT;
+    } else if (flags & DMA_BOUNCE_F_STAGED) {
+        path = DMA_BOUNCE_PATH_STAGED;
+    } else {
+        path = dma_bounce_select(dst, src, len);
+    }
+
+    if (path == DMA_BOUNCE_PATH_STAGED) {
+        return bounce_staged(dst, src, len);
+    }
+
+    if (len > g_BounceMaxLen) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    status = bounce_dma(dst, src, len);
+    if (status == DMA_SUCCESS) {
+        cache_complete_dma_dst(dst, len);
+        g_BounceStats.direct++;
+    }
+    return status;
+}
+
+void dma_bounce_get_stats(DmaBounceStats_t* stats)
+{
+    if (stats != NULL) {
+        *stats = g_BounceStats;
+    }
+}
+
+void dma_bounce_clear_stats(void)
+{
+    memset(&g_BounceStats, 0, sizeof(g_BounceStats));
+}
@@ -0,0 +1,119 @@
+/**
+ * @file dma_bounce.h
+ * @brief OCM Bounce-Buffer Copy Path Header
+ *
+ * dma_bounce_copy() sends small or badly aligned copies through a staging
+ * path instead of one direct DMA. The CPU writes the partial cache lines
+ * at the head and tail of the destination, so the engine never owns a
+ * line the CPU shares with neighbouring data. The line-aligned bulk goes
+ * straight to the destination when the source is aligned as well and the
+ * bulk reaches the threshold; otherwise it is pulled into one of a ring
+ * of OCM slots in whole lines and pushed from there to the destination.
+ */
+
+#ifndef DMA_BOUNCE_H
+#define DMA_BOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dma_ops.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define DMA_BOUNCE_NUM_SLOTS            8
+#define DMA_BOUNCE_SLOT_SIZE            KB(8)
+#define DMA_BOUNCE_DEFAULT_THRESHOLD    KB(2)   /* Smaller copies are staged */
+
+/* Flags: force one path (0 = choose by size and alignment) */
+#define DMA_BOUNCE_F_AUTO               0x00000000U
+#define DMA_BOUNCE_F_DIRECT             0x00000001U
+#define DMA_BOUNCE_F_STAGED             0x00000002U
+
+/**
+ * @brief Paths a copy can take
+ */
+typedef enum {
+    DMA_BOUNCE_PATH_DIRECT = 0,         /* One DMA, source to destination */
+    DMA_BOUNCE_PATH_STAGED              /* CPU head/tail, DMA bulk (via OCM if needed) */
+} DmaBouncePath_t;
+
+/**
+ * @brief Bounce path statistics
+ */
+typedef struct {
+    uint32_t direct;                    /* Copies done with one direct DMA */
+    uint32_t staged;                    /* Copies through the staging path */
+    uint32_t bounced;                   /* Bulk chunks pulled through an OCM slot */
+    uint64_t cpu_bytes;                 /* Head/tail bytes written by the CPU */
+    uint64_t dma_bytes;                 /* Bytes moved by the engine, both hops */
+} DmaBounceStats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Allocate the OCM slot ring and open the engine channel
+ * @param engine Memory-to-memory engine to move the bulk with
+ * @param threshold Copies below this many bytes are always staged
+ * @return 0 on success, negative error code on failure
+ */
+int dma_bounce_init(DmaType_t engine, uint32_t threshold);
+
+/**
+ * @brief Release the slot ring and close the engine channel
+ */
+void dma_bounce_deinit(void);
+
+/**
+ * @brief Set the size below which copies are staged
+ * @param threshold Threshold in bytes
+ */
+void dma_bounce_set_threshold(uint32_t threshold);
+
+/**
+ * @brief Get the staging threshold
+ * @return Threshold in bytes
+ */
+uint32_t dma_bounce_get_threshold(void);
+
+/**
+ * @brief Path dma_bounce_copy() would take without a forcing flag
+ *
+ * Copies are direct only when they reach the threshold, fit the engine,
+ * and source, destination and length are all cache-line aligned.
+ *
+ * @param dst Destination address
+ * @param src Source address
+ * @param len Length in bytes
+ * @return Selected path
+ */
+DmaBouncePath_t dma_bounce_select(uint64_t dst, uint64_t src, uint32_t len);
+
+/**
+ * @brief Copy memory through the direct or the staging path
+ *
+ * On return the destination is visible to the CPU.
+ *
+ * @param dst Destination address
+ * @param src Source address
+ * @param len Length in bytes
+ * @param flags DMA_BOUNCE_F_* path override (DMA_BOUNCE_F_AUTO = choose)
+ * @return 0 on success, negative error code on failure
+ */
+int dma_bounce_copy(uint64_t dst, uint64_t src, uint32_t len, uint32_t flags);
+
+/**
+ * @brief Get bounce path statistics
+ * @param stats Statistics output
+ */
+void dma_bounce_get_stats(DmaBounceStats_t* stats);
+
+/**
+ * @brief Clear bounce path statistics
+ */
+void dma_bounce_clear_stats(void);
+
+#endif /* DMA_BOUNCE_H */
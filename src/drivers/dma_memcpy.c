@@ -0,0 +1,524 @@
+/**
+ * @file dma_memcpy.c
+ * @brief Size-Aware Copy Dispatcher Implementation
+ *
+ * Engine movers run through the ops table on channel 0 and finish with a
+ * CPU-side invalidate of the destination, so a DMA copy is a drop-in
+ * replacement for memcpy() on cacheable memory. Calibration times exactly
+ * that path; the CPU cost comes from memory_cpu_memcpy_benchmark().
+ */
+
+#include <string.h>
+#include "dma_memcpy.h"
+#include "dma_ops.h"
+#include "axi_mcdma_driver.h"
+#include "../platform_config.h"
+#include "../utils/timer_utils.h"
+#include "../utils/memory_utils.h"
+#include "../utils/cache_utils.h"
+#include "../utils/results_logger.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+/* Calibration buffers cover the largest bucket */
+#define MEMCPY_CAL_MAX_SIZE         (256U << (2 * (DMA_MEMCPY_NUM_BUCKETS - 1)))
+#define MEMCPY_CAL_MIN_SIZE         256U
+
+/* Copies per calibration point: enough work to swamp timer resolution */
+#define MEMCPY_CAL_CPU_BYTES        MB(64)
+#define MEMCPY_CAL_DMA_BYTES        MB(16)
+#define MEMCPY_CAL_DMA_MAX_ITERS    64
+
+typedef struct {
+    const DmaOps_t* ops;
+    bool use_sg;
+    uint32_t max_len;
+    bool available;
+} MemcpyMover_t;
+
+static const DmaType_t g_MoverTypes[DMA_MEMCPY_MOVER_COUNT] = {
+    [DMA_MEMCPY_MOVER_CPU]   = DMA_TYPE_CPU_MEMCPY,
+    [DMA_MEMCPY_MOVER_CDMA]  = DMA_TYPE_AXI_CDMA,
+    [DMA_MEMCPY_MOVER_MCDMA] = DMA_TYPE_AXI_MCDMA,
+    [DMA_MEMCPY_MOVER_LPD]   = DMA_TYPE_LPD_DMA
+};
+
+static const char* const g_MoverNames[DMA_MEMCPY_MOVER_COUNT] = {
+    "CPU", "CDMA", "MCDMA", "LPD"
+};
+
+static const char* const g_RegionNames[DMA_MEMCPY_REGION_COUNT] = {
+    "DDR", "OCM"
+};
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static MemcpyMover_t g_Movers[DMA_MEMCPY_MOVER_COUNT];
+static DmaMemcpyBucket_t g_MemcpyTable[DMA_MEMCPY_REGION_COUNT][DMA_MEMCPY_REGION_COUNT]
+                                      [DMA_MEMCPY_NUM_BUCKETS];
+static DmaMemcpyStats_t g_MemcpyStats;
+static bool g_MemcpyCalibrated = false;
+
+/* DDR4 scratch, allocated for the duration of a calibration */
+static uint64_t g_CalDdrSrc;
+static uint64_t g_CalDdrDst;
+
+/* OCM scratch from the OCM arena, held for one region pair at a time */
+static uint64_t g_CalOcm[2];
+static uint32_t g_CalOcmSize;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static DmaMemcpyRegion_t memcpy_classify(uint64_t addr)
+{
+    if (addr >= OCM_BASE_ADDR && addr < OCM_BASE_ADDR + OCM_SIZE) {
+        return DMA_MEMCPY_REGION_OCM;
+    }
+    return DMA_MEMCPY_REGION_DDR;
+}
+
+static uint32_t memcpy_bucket_index(uint32_t len)
+{
+    const DmaMemcpyBucket_t* row = g_MemcpyTable[0][0];
+
+    for (uint32_t b = 0; b < DMA_MEMCPY_NUM_BUCKETS; b++) {
+        if (len <= row[b].max_size) {
+            return b;
+        }
+    }
+    return DMA_MEMCPY_NUM_BUCKETS - 1;
+}
+
+/* Cheapest measured mover of a bucket within the allowed set */
+static DmaMemcpyMover_t memcpy_cheapest(const DmaMemcpyBucket_t* bucket, uint32_t allowed,
+                                        uint32_t len)
+{
+    DmaMemcpyMover_t best = DMA_MEMCPY_MOVER_COUNT;
+
+    for (uint32_t m = 0; m < DMA_MEMCPY_MOVER_COUNT; m++) {
+        if (!(allowed & DMA_MEMCPY_F_MOVER(m)) || !g_Movers[m].available ||
+            len > g_Movers[m].max_len || bucket->cost_ns[m] == 0) {
+            continue;
+        }
+        if (best == DMA_MEMCPY_MOVER_COUNT || bucket->cost_ns[m] < bucket->cost_ns[best]) {
+            best = (DmaMemcpyMover_t)m;
+        }
+    }
+    return best;
+}
+
+/* MCDMA channels can be closed by other scenarios; reopen on demand */
+static int memcpy_ensure_channel(DmaMemcpyMover_t mover)
+{
+    AxiMcdmaInst_t* mcdma;
+
+    if (mover != DMA_MEMCPY_MOVER_MCDMA) {
+        return DMA_SUCCESS;
+    }
+
+    mcdma = axi_mcdma_get_instance();
+    if (mcdma->mm2s_channels[0].enabled && mcdma->s2mm_channels[0].enabled) {
+        return DMA_SUCCESS;
+    }
+    return g_Movers[mover].ops->open_channel(0);
+}
+
+static int memcpy_run_mover(DmaMemcpyMover_t mover, uint64_t dst, uint64_t src, uint32_t len)
+{
+    const MemcpyMover_t* m = &g_Movers[mover];
+    int status;
+
+    if (mover == DMA_MEMCPY_MOVER_CPU) {
+        memcpy((void*)(uintptr_t)dst, (const void*)(uintptr_t)src, len);
+        return DMA_SUCCESS;
+    }
+
+    status = memcpy_ensure_channel(mover);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    /* Driver cleans src and invalidates dst before starting */
+    status = dma_ops_transfer(m->ops, 0, src, dst, len, m->use_sg);
+    if (status == DMA_SUCCESS) {
+        cache_complete_dma_dst(dst, len);
+    }
+    return status;
+}
+
+static uint32_t memcpy_cal_cpu(uint64_t dst, uint64_t src, uint32_t size)
+{
+    uint32_t iterations = (uint32_t)MAX(MEMCPY_CAL_CPU_BYTES / size, 4);
+    uint32_t mbps = memory_cpu_memcpy_benchmark((void*)(uintptr_t)dst,
+                                                (const void*)(uintptr_t)src,
+                                                size, iterations);
+
+    if (mbps == 0) {
+        return 0;
+    }
+    return (uint32_t)MAX(((uint64_t)size * 1000000000ULL) / ((uint64_t)mbps * 1048576ULL), 1);
+}
+
+static uint32_t memcpy_cal_dma(DmaMemcpyMover_t mover, uint64_t dst, uint64_t src, uint32_t size)
+{
+    uint32_t iterations = (uint32_t)MIN(MAX(MEMCPY_CAL_DMA_BYTES / size, 4),
+                                        MEMCPY_CAL_DMA_MAX_ITERS);
+    uint64_t start, elapsed_ns;
+
+    if (!g_Movers[mover].available || size > g_Movers[mover].max_len) {
+        return 0;
+    }
+
+    /* Warmup, also catches an engine that does not respond */
+    if (memcpy_run_mover(mover, dst, src, size) != DMA_SUCCESS) {
+        return 0;
+    }
+
+    start = timer_start();
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (memcpy_run_mover(mover, dst, src, size) != DMA_SUCCESS) {
+            return 0;
+        }
+    }
+    elapsed_ns = timer_stop_ns(start);
+
+    return (uint32_t)MAX(elapsed_ns / iterations, 1);
+}
+
+static void memcpy_cal_ocm_free(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(g_CalOcm); i++) {
+        memory_free_dma_buffer(g_CalOcm[i]);
+        g_CalOcm[i] = 0;
+    }
+    g_CalOcmSize = 0;
+}
+
+/* count OCM buffers, each as large as the arena allows up to the largest bucket */
+static void memcpy_cal_ocm_alloc(uint32_t count)
+{
+    uint32_t size;
+
+    for (size = (uint32_t)MIN((uint64_t)MEMCPY_CAL_MAX_SIZE, OCM_SIZE / count);
+         size >= MEMCPY_CAL_MIN_SIZE; size /= 2) {
+        bool ok = true;
+
+        for (uint32_t i = 0; i < count; i++) {
+            g_CalOcm[i] = memory_alloc_dma_buffer(MEM_REGION_OCM, size);
+            ok = ok && (g_CalOcm[i] != 0);
+        }
+        if (ok) {
+            g_CalOcmSize = size;
+            return;
+        }
+        memcpy_cal_ocm_free();
+    }
+}
+
+/* Buffers for one region pair, or false if size does not fit */
+static bool memcpy_cal_buffers(DmaMemcpyRegion_t src_region, DmaMemcpyRegion_t dst_region,
+                               uint32_t size, uint64_t* src, uint64_t* dst)
+{
+    uint32_t ocm = 0;
+
+    if (size > g_CalOcmSize && (src_region == DMA_MEMCPY_REGION_OCM ||
+                                dst_region == DMA_MEMCPY_REGION_OCM)) {
+        return false;
+    }
+
+    *src = (src_region == DMA_MEMCPY_REGION_OCM) ? g_CalOcm[ocm++] : g_CalDdrSrc;
+    *dst = (dst_region == DMA_MEMCPY_REGION_OCM) ? g_CalOcm[ocm++] : g_CalDdrDst;
+    return (*src != 0 && *dst != 0);
+}
+
+/* Uncalibrated guess: CPU for small copies, CDMA for the rest */
+static void memcpy_load_defaults(void)
+{
+    for (uint32_t s = 0; s < DMA_MEMCPY_REGION_COUNT; s++) {
+        for (uint32_t d = 0; d < DMA_MEMCPY_REGION_COUNT; d++) {
+            for (uint32_t b = 0; b < DMA_MEMCPY_NUM_BUCKETS; b++) {
+                DmaMemcpyBucket_t* bucket = &g_MemcpyTable[s][d][b];
+
+                memset(bucket, 0, sizeof(*bucket));
+                bucket->max_size = 256U << (2 * b);
+                bucket->mover = (bucket->max_size <= KB(4) ||
+                                 !g_Movers[DMA_MEMCPY_MOVER_CDMA].available) ?
+                                DMA_MEMCPY_MOVER_CPU : DMA_MEMCPY_MOVER_CDMA;
+            }
+        }
+    }
+    g_MemcpyCalibrated = false;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int dma_memcpy_init(void)
+{
+    DmaCaps_t caps;
+
+    memset(g_Movers, 0, sizeof(g_Movers));
+
+    for (uint32_t m = 0; m < DMA_MEMCPY_MOVER_COUNT; m++) {
+        MemcpyMover_t* mover = &g_Movers[m];
+
+        mover->ops = dma_ops_get(g_MoverTypes[m]);
+        if (mover->ops == NULL || dma_ops_get_caps(g_MoverTypes[m], &caps) != DMA_SUCCESS ||
+            caps.num_channels == 0) {
+            continue;
+        }
+
+        mover->use_sg = !caps.has_simple;
+        mover->max_len = caps.max_transfer_len;
+        mover->available = (mover->ops->open_channel == NULL ||
+                            mover->ops->open_channel(0) == DMA_SUCCESS);
+    }
+
+    memcpy_load_defaults();
+    dma_memcpy_clear_stats();
+    return DMA_SUCCESS;
+}
+
+int dma_memcpy_calibrate(void)
+{
+    uint64_t src, dst;
+    int status = DMA_SUCCESS;
+
+    g_CalDdrSrc = memory_alloc_dma_buffer(MEM_REGION_DDR4, MEMCPY_CAL_MAX_SIZE);
+    g_CalDdrDst = memory_alloc_dma_buffer(MEM_REGION_DDR4, MEMCPY_CAL_MAX_SIZE);
+    if (g_CalDdrSrc == 0 || g_CalDdrDst == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    for (uint32_t s = 0; s < DMA_MEMCPY_REGION_COUNT; s++) {
+        for (uint32_t d = 0; d < DMA_MEMCPY_REGION_COUNT; d++) {
+            DmaMemcpyBucket_t* row = g_MemcpyTable[s][d];
+            uint32_t ocm_count = (s == DMA_MEMCPY_REGION_OCM) + (d == DMA_MEMCPY_REGION_OCM);
+
+            if (ocm_count != 0) {
+                memcpy_cal_ocm_alloc(ocm_count);
+            }
+
+            for (uint32_t b = 0; b < DMA_MEMCPY_NUM_BUCKETS; b++) {
+                DmaMemcpyBucket_t* bucket = &row[b];
+                uint32_t size = bucket->max_size;
+                DmaMemcpyMover_t best;
+
+                if (g_TestAbort) {
+                    status = DMA_ERROR_BUSY;
+                    goto out;
+                }
+
+                memset(bucket->cost_ns, 0, sizeof(bucket->cost_ns));
+
+                if (!memcpy_cal_buffers((DmaMemcpyRegion_t)s, (DmaMemcpyRegion_t)d,
+                                        size, &src, &dst)) {
+                    /* Too large for the OCM scratch: reuse the last measured bucket */
+                    if (b > 0) {
+                        memcpy(bucket->cost_ns, row[b - 1].cost_ns, sizeof(bucket->cost_ns));
+                        if (!bucket->overridden) {
+                            bucket->mover = row[b - 1].mover;
+                        }
+                    }
+                    continue;
+                }
+
+                bucket->cost_ns[DMA_MEMCPY_MOVER_CPU] = memcpy_cal_cpu(dst, src, size);
+                for (uint32_t m = DMA_MEMCPY_MOVER_CPU + 1; m < DMA_MEMCPY_MOVER_COUNT; m++) {
+                    bucket->cost_ns[m] = memcpy_cal_dma((DmaMemcpyMover_t)m, dst, src, size);
+                }
+
+                best = memcpy_cheapest(bucket, DMA_MEMCPY_F_MOVER_MASK, size);
+                if (!bucket->overridden && best != DMA_MEMCPY_MOVER_COUNT) {
+                    bucket->mover = best;
+                }
+            }
+            memcpy_cal_ocm_free();
+        }
+    }
+
+    g_MemcpyCalibrated = true;
+
+out:
+    memcpy_cal_ocm_free();
+    memory_free_dma_buffer(g_CalDdrSrc);
+    memory_free_dma_buffer(g_CalDdrDst);
+    g_CalDdrSrc = g_CalDdrDst = 0;
+    return status;
+}
+
+DmaMemcpyMover_t dma_memcpy_select(const void* dst, const void* src,
+                                   uint32_t len, uint32_t flags)
+{
+    uint64_t dst_addr = (uint64_t)(uintptr_t)dst;
+    const DmaMemcpyBucket_t* bucket;
+    uint32_t allowed = flags & DMA_MEMCPY_F_MOVER_MASK;
+    DmaMemcpyMover_t best;
+
+    if (allowed == 0) {
+        allowed = DMA_MEMCPY_F_MOVER_MASK;
+    }
+
+    /* Engines need whole cache lines at the destination */
+    if (((dst_addr | len) & (BUFFER_ALIGNMENT - 1)) != 0) {
+        allowed &= DMA_MEMCPY_F_CPU;
+    }
+    if (allowed == 0) {
+        return DMA_MEMCPY_MOVER_COUNT;
+    }
+
+    bucket = &g_MemcpyTable[memcpy_classify((uint64_t)(uintptr_t)src)]
+                           [memcpy_classify(dst_addr)]
+                           [memcpy_bucket_index(len)];
+
+    if ((allowed & DMA_MEMCPY_F_MOVER(bucket->mover)) &&
+        g_Movers[bucket->mover].available && len <= g_Movers[bucket->mover].max_len) {
+        return bucket->mover;
+    }
+
+    best = memcpy_cheapest(bucket, allowed, len);
+    if (best != DMA_MEMCPY_MOVER_COUNT) {
+        return best;
+    }
+
+    /* Uncalibrated: first usable mover of the allowed set */
+    for (uint32_t m = 0; m < DMA_MEMCPY_MOVER_COUNT; m++) {
+        if ((allowed & DMA_MEMCPY_F_MOVER(m)) && g_Movers[m].available &&
+            len <= g_Movers[m].max_len) {
+            return (DmaMemcpyMover_t)m;
+        }
+    }
+    return DMA_MEMCPY_MOVER_COUNT;
+}
+
+int dma_memcpy(void* dst, const void* src, uint32_t len, uint32_t flags)
+{
+    DmaMemcpyMover_t mover;
+    int status;
+
+    if (dst == NULL || src == NULL) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (len == 0) {
+        return DMA_SUCCESS;
+    }
+
+    mover = dma_memcpy_select(dst, src, len, flags);
+    if (mover == DMA_MEMCPY_MOVER_COUNT) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (mover == DMA_MEMCPY_MOVER_CPU &&
+        (((uintptr_t)dst | len) & (BUFFER_ALIGNMENT - 1)) != 0) {
+        g_MemcpyStats.unaligned_to_cpu++;
+    }
+
+    status = memcpy_run_mover(mover, (uint64_t)(uintptr_t)dst,
+                              (uint64_t)(uintptr_t)src, len);
+    if (status == DMA_SUCCESS) {
+        g_MemcpyStats.calls[mover]++;
+        g_MemcpyStats.bytes[mover] += len;
+    }
+    return status;
+}
+
+int dma_memcpy_override(uint32_t size, DmaMemcpyMover_t mover)
+{
+    uint32_t b;
+
+    if (mover >= DMA_MEMCPY_MOVER_COUNT || !g_Movers[mover].available) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    b = memcpy_bucket_index(size);
+    for (uint32_t s = 0; s < DMA_MEMCPY_REGION_COUNT; s++) {
+        for (uint32_t d = 0; d < DMA_MEMCPY_REGION_COUNT; d++) {
+            g_MemcpyTable[s][d][b].mover = mover;
+            g_MemcpyTable[s][d][b].overridden = true;
+        }
+    }
+    return DMA_SUCCESS;
+}
+
+void dma_memcpy_clear_overrides(void)
+{
+    if (!g_MemcpyCalibrated) {
+        memcpy_load_defaults();
+        return;
+    }
+
+    for (uint32_t s = 0; s < DMA_MEMCPY_REGION_COUNT; s++) {
+        for (uint32_t d = 0; d < DMA_MEMCPY_REGION_COUNT; d++) {
+            for (uint32_t b = 0; b < DMA_MEMCPY_NUM_BUCKETS; b++) {
+                DmaMemcpyBucket_t* bucket = &g_MemcpyTable[s][d][b];
+                DmaMemcpyMover_t best = memcpy_cheapest(bucket, DMA_MEMCPY_F_MOVER_MASK,
+                                                        bucket->max_size);
+                bucket->overridden = false;
+                if (best != DMA_MEMCPY_MOVER_COUNT) {
+                    bucket->mover = best;
+                }
+            }
+        }
+    }
+}
+
+void dma_memcpy_print_table(void)
+{
+    char size_str[16];
+
+    LOG_RESULT("  Copy dispatcher table (%s, ns per copy incl. cache maintenance):\r\n",
+               g_MemcpyCalibrated ? "calibrated" : "defaults");
+
+    for (uint32_t s = 0; s < DMA_MEMCPY_REGION_COUNT; s++) {
+        for (uint32_t d = 0; d < DMA_MEMCPY_REGION_COUNT; d++) {
+            LOG_RESULT("\r\n  %s -> %s:\r\n", g_RegionNames[s], g_RegionNames[d]);
+            LOG_RESULT("  Up to      | CPU (ns)   | CDMA (ns)  | MCDMA (ns) | LPD (ns)   | Use\r\n");
+            LOG_RESULT("  -----------|------------|------------|------------|------------|------\r\n");
+
+            for (uint32_t b = 0; b < DMA_MEMCPY_NUM_BUCKETS; b++) {
+                const DmaMemcpyBucket_t* bucket = &g_MemcpyTable[s][d][b];
+
+                results_logger_format_size(bucket->max_size, size_str, sizeof(size_str));
+                LOG_RESULT("  %-10s | %10lu | %10lu | %10lu | %10lu | %s%s\r\n",
+                           size_str,
+                           (unsigned long)bucket->cost_ns[DMA_MEMCPY_MOVER_CPU],
+                           (unsigned long)bucket->cost_ns[DMA_MEMCPY_MOVER_CDMA],
+                           (unsigned long)bucket->cost_ns[DMA_MEMCPY_MOVER_MCDMA],
+                           (unsigned long)bucket->cost_ns[DMA_MEMCPY_MOVER_LPD],
+                           g_MoverNames[bucket->mover],
+                           bucket->overridden ? "*" : "");
+            }
+        }
+    }
+
+    LOG_RESULT("\r\n  0 = mover unavailable, * = user override\r\n");
+}
+
+void dma_memcpy_get_stats(DmaMemcpyStats_t* stats)
+{
+    if (stats != NULL) {
+        *stats = g_MemcpyStats;
+    }
+}
+
+void dma_memcpy_clear_stats(void)
+{
+    memset(&g_MemcpyStats, 0, sizeof(g_MemcpyStats));
+}
+
+const char* dma_memcpy_mover_to_string(DmaMemcpyMover_t mover)
+{
+    if (mover >= DMA_MEMCPY_MOVER_COUNT) {
+        return "NONE";
+    }
+    return g_MoverNames[mover];
+}
@@ -0,0 +1,153 @@
+/**
+ * @file dma_memcpy.h
+ * @brief Size-Aware Copy Dispatcher Header
+ *
+ * dma_memcpy() picks the fastest mover (CPU memcpy, AXI CDMA, AXI MCDMA
+ * or LPD DMA) for each request from a per-size cost table. Costs are
+ * measured at startup for every DDR/OCM source/destination pair and
+ * include the cache maintenance each engine path performs.
+ */
+
+#ifndef DMA_MEMCPY_H
+#define DMA_MEMCPY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Data movers the dispatcher chooses between
+ */
+typedef enum {
+    DMA_MEMCPY_MOVER_CPU = 0,
+    DMA_MEMCPY_MOVER_CDMA,
+    DMA_MEMCPY_MOVER_MCDMA,
+    DMA_MEMCPY_MOVER_LPD,
+    DMA_MEMCPY_MOVER_COUNT
+} DmaMemcpyMover_t;
+
+/**
+ * @brief Region classes with separate cost tables
+ */
+typedef enum {
+    DMA_MEMCPY_REGION_DDR = 0,
+    DMA_MEMCPY_REGION_OCM,
+    DMA_MEMCPY_REGION_COUNT
+} DmaMemcpyRegion_t;
+
+/* Flags: restrict the choice to a set of movers (0 = any) */
+#define DMA_MEMCPY_F_AUTO           0x00000000U
+#define DMA_MEMCPY_F_MOVER(m)       (1U << (m))
+#define DMA_MEMCPY_F_CPU            DMA_MEMCPY_F_MOVER(DMA_MEMCPY_MOVER_CPU)
+#define DMA_MEMCPY_F_CDMA           DMA_MEMCPY_F_MOVER(DMA_MEMCPY_MOVER_CDMA)
+#define DMA_MEMCPY_F_MCDMA          DMA_MEMCPY_F_MOVER(DMA_MEMCPY_MOVER_MCDMA)
+#define DMA_MEMCPY_F_LPD            DMA_MEMCPY_F_MOVER(DMA_MEMCPY_MOVER_LPD)
+#define DMA_MEMCPY_F_MOVER_MASK     ((1U << DMA_MEMCPY_MOVER_COUNT) - 1)
+
+/* Size buckets: 256B, 1KB, 4KB, ... 16MB (upper bounds, x4 each) */
+#define DMA_MEMCPY_NUM_BUCKETS      9
+
+/**
+ * @brief One size bucket of a cost table
+ */
+typedef struct {
+    uint32_t max_size;                              /* Bucket upper bound (bytes) */
+    uint32_t cost_ns[DMA_MEMCPY_MOVER_COUNT];       /* Per copy, 0 = unavailable */
+    DmaMemcpyMover_t mover;                         /* Current choice */
+    bool     overridden;                            /* Choice set by the user */
+} DmaMemcpyBucket_t;
+
+/**
+ * @brief Dispatcher statistics
+ */
+typedef struct {
+    uint32_t calls[DMA_MEMCPY_MOVER_COUNT];
+    uint64_t bytes[DMA_MEMCPY_MOVER_COUNT];
+    uint32_t unaligned_to_cpu;                      /* Unaligned requests (CPU only) */
+} DmaMemcpyStats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Open the engine channels used by the dispatcher and load the
+ *        default (uncalibrated) table
+ * @return 0 on success, negative error code on failure
+ */
+int dma_memcpy_init(void);
+
+/**
+ * @brief Measure every mover at every bucket size for every region pair
+ *        and pick the cheapest; user overrides are kept
+ * @return 0 on success, negative error code on failure
+ */
+int dma_memcpy_calibrate(void);
+
+/**
+ * @brief Copy memory with the mover the table selects
+ *
+ * Engines are only used when dst and len are cache-line aligned; other
+ * requests go to the CPU since a partial-line invalidate would discard
+ * neighbouring data.
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param len Length in bytes
+ * @param flags DMA_MEMCPY_F_* mover restriction (DMA_MEMCPY_F_AUTO = any)
+ * @return 0 on success, negative error code on failure
+ */
+int dma_memcpy(void* dst, const void* src, uint32_t len, uint32_t flags);
+
+/**
+ * @brief Mover dma_memcpy() would use for a request
+ * @param dst Destination
+ * @param src Source
+ * @param len Length in bytes
+ * @param flags DMA_MEMCPY_F_* mover restriction
+ * @return Selected mover, or DMA_MEMCPY_MOVER_COUNT if none is allowed
+ */
+DmaMemcpyMover_t dma_memcpy_select(const void* dst, const void* src,
+                                   uint32_t len, uint32_t flags);
+
+/**
+ * @brief Force a mover for the bucket containing size, in every region table
+ * @param size Any size within the bucket
+ * @param mover Mover to use
+ * @return 0 on success, negative error code on failure
+ */
+int dma_memcpy_override(uint32_t size, DmaMemcpyMover_t mover);
+
+/**
+ * @brief Drop all overrides and return to the measured choices
+ */
+void dma_memcpy_clear_overrides(void);
+
+/**
+ * @brief Print the cost tables and the selected mover per bucket
+ */
+void dma_memcpy_print_table(void);
+
+/**
+ * @brief Get dispatcher statistics
+ * @param stats Statistics output
+ */
+void dma_memcpy_get_stats(DmaMemcpyStats_t* stats);
+
+/**
+ * @brief Clear dispatcher statistics
+ */
+void dma_memcpy_clear_stats(void);
+
+/**
+ * @brief Get mover name
+ * @param mover Mover
+ * @return Name string
+ */
+const char* dma_memcpy_mover_to_string(DmaMemcpyMover_t mover);
+
+#endif /* DMA_MEMCPY_H */
@@ -0,0 +1,481 @@
+/**
+ * @file dma_ops.c
+ * @brief Engine-Agnostic DMA Operations Table Implementation
+ *
+ * Thin adapters from the common DmaOps_t interface onto each driver.
+ * poll() only samples status registers; once an engine reports idle (or
+ * an error) it hands over to the driver's wait function, which decodes
+ * errors and updates the driver statistics as before.
+ */
+
+#include <string.h>
+#include "dma_ops.h"
+#include "axi_dma_driver.h"
+#include "axi_cdma_driver.h"
+#include "axi_mcdma_driver.h"
+#include "lpd_dma_driver.h"
+#include "../platform_config.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define AXI_CDMA_MAX_TRANSFER_SIZE  0x03FFFFFF  /* 26-bit BTT */
+#define AXI_MCDMA_MAX_TRANSFER_SIZE XMCDMA_BD_CTRL_LENGTH_MASK
+#define LPD_DMA_MAX_TRANSFER_SIZE   0x3FFFFFFF  /* 1GB - 1 */
+
+/*******************************************************************************
+ * AXI DMA Adapter
+ ******************************************************************************/
+
+static void axi_dma_ops_get_caps(DmaCaps_t* caps)
+{
+    AxiDmaInst_t* inst = axi_dma_get_instance();
+
+    caps->num_channels = 1;
+    caps->max_transfer_len = inst->max_transfer_len;
+    caps->has_simple = true;
+    caps->has_sg = inst->sg_mode;
+    caps->has_irq = false;
+    caps->needs_cache_maint = true;
+    caps->queue_depth = inst->sg_mode ? MIN(inst->tx_ring.count, inst->rx_ring.count) : 0;
+    caps->addr_width = inst->addr_width;
+}
+
+static int axi_dma_ops_submit(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                              uint32_t length, bool use_sg)
+{
+    if (channel != 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (use_sg) {
+        return axi_dma_sg_transfer(src_addr, dst_addr, length);
+    }
+    return axi_dma_simple_transfer(src_addr, dst_addr, length);
+}
+
+static int axi_dma_ops_poll(uint32_t channel)
+{
+    const uint32_t done_mask = XAXIDMA_SR_IDLE_MASK | XAXIDMA_SR_IOC_IRQ_MASK;
+    uint32_t tx_sr = axi_dma_get_tx_status();
+    uint32_t rx_sr = axi_dma_get_rx_status();
+
+    if (((tx_sr | rx_sr) & XAXIDMA_SR_ALL_ERR_MASK) == 0 &&
+        (!(tx_sr & done_mask) || !(rx_sr & done_mask))) {
+        return DMA_ERROR_BUSY;
+    }
+    return axi_dma_wait_complete(DMA_TIMEOUT_US);
+}
+
+static int axi_dma_ops_wait(uint32_t channel, uint32_t timeout_us)
+{
+    return axi_dma_wait_complete(timeout_us);
+}
+
+static int axi_dma_ops_enqueue(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                               uint32_t length)
+{
+    DmaXfer_t xfer = { src_addr, dst_addr, length };
+
+    if (channel != 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    return axi_dma_sg_transfer_batch(&xfer, 1, false);
+}
+
+static int axi_dma_ops_reap(uint32_t channel)
+{
+    if (channel != 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    return axi_dma_sg_reap();
+}
+
+/*******************************************************************************
+ * AXI CDMA Adapter
+ ******************************************************************************/
+
+static void axi_cdma_ops_get_caps(DmaCaps_t* caps)
+{
+    AxiCdmaInst_t* inst = axi_cdma_get_instance();
+
+    caps->num_channels = 1;
+    caps->max_transfer_len = AXI_CDMA_MAX_TRANSFER_SIZE;
+    caps->has_simple = true;
+    caps->has_sg = inst->sg_mode;
+    caps->has_irq = false;
+    caps->needs_cache_maint = true;
+    caps->queue_depth = inst->sg_mode ? inst->desc_ring.count : 0;
+    caps->addr_width = inst->addr_width;
+}
+
+static int axi_cdma_ops_submit(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                               uint32_t length, bool use_sg)
+{
+    if (channel != 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (use_sg) {
+        return axi_cdma_sg_transfer(src_addr, dst_addr, length);
+    }
+    return axi_cdma_simple_transfer(src_addr, dst_addr, length);
+}
+
+static int axi_cdma_ops_poll(uint32_t channel)
+{
+    uint32_t sr = axi_cdma_get_status();
+
+    if (!(sr & XAXICDMA_SR_ALL_ERR_MASK) &&
+        !(sr & (XAXICDMA_SR_IDLE_MASK | XAXICDMA_SR_IOC_IRQ_MASK))) {
+        return DMA_ERROR_BUSY;
+    }
+    return axi_cdma_wait_complete(DMA_TIMEOUT_US);
+}
+
+static int axi_cdma_ops_wait(uint32_t channel, uint32_t timeout_us)
+{
+    return axi_cdma_wait_complete(timeout_us);
+}
+
+static int axi_cdma_ops_enqueue(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                                uint32_t length)
+{
+    DmaXfer_t xfer = { src_addr, dst_addr, length };
+
+    if (channel != 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    return axi_cdma_sg_transfer_batch(&xfer, 1, false);
+}
+
+static int axi_cdma_ops_reap(uint32_t channel)
+{
+    if (channel != 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    return axi_cdma_sg_reap();
+}
+
+/*******************************************************************************
+ * AXI MCDMA Adapter
+ ******************************************************************************/
+
+static void axi_mcdma_ops_get_caps(DmaCaps_t* caps)
+{
+    DescRingConfig_t ring;
+
+    axi_mcdma_get_ring_config(&ring);
+    caps->num_channels = MIN(axi_mcdma_get_mm2s_channel_count(),
+                             axi_mcdma_get_s2mm_channel_count());
+    caps->max_transfer_len = AXI_MCDMA_MAX_TRANSFER_SIZE;
+    caps->has_simple = false;
+    caps->has_sg = true;
+    caps->has_irq = false;
+    caps->needs_cache_maint = true;
+    caps->queue_depth = ring.depth;
+    caps->addr_width = AXI_MCDMA_ADDR_WIDTH;
+}
+
+static int axi_mcdma_ops_open_channel(uint32_t channel)
+{
+    int status;
+
+    status = axi_mcdma_enable_mm2s_channel(channel, false);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+    return axi_mcdma_enable_s2mm_channel(channel, false);
+}
+
+static void axi_mcdma_ops_close_channel(uint32_t channel)
+{
+    axi_mcdma_disable_mm2s_channel(channel);
+    axi_mcdma_disable_s2mm_channel(channel);
+}
+
+static int axi_mcdma_ops_submit(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                                uint32_t length, bool use_sg)
+{
+    /* MCDMA is descriptor-only */
+    if (!use_sg) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    return axi_mcdma_transfer(channel, src_addr, dst_addr, length);
+}
+
+static int axi_mcdma_ops_poll(uint32_t channel)
+{
+    if (axi_mcdma_mm2s_busy(channel) || axi_mcdma_s2mm_busy(channel)) {
+        return DMA_ERROR_BUSY;
+    }
+    return axi_mcdma_wait_complete(channel, DMA_TIMEOUT_US);
+}
+
+static int axi_mcdma_ops_wait(uint32_t channel, uint32_t timeout_us)
+{
+    return axi_mcdma_wait_complete(channel, timeout_us);
+}
+
+static int axi_mcdma_ops_enqueue(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                                 uint32_t length)
+{
+    DmaXfer_t xfer = { src_addr, dst_addr, length };
+
+    return axi_mcdma_transfer_batch(channel, &xfer, 1, false);
+}
+
+/*******************************************************************************
+ * LPD DMA Adapter
+ ******************************************************************************/
+
+/* Register mode: a queue of one transfer per channel */
+static bool g_LpdQueued[LPD_DMA_NUM_CHANNELS];
+
+static int lpd_dma_ops_reset(void)
+{
+    int status = DMA_SUCCESS;
+
+    for (uint32_t ch = 0; ch < LPD_DMA_NUM_CHANNELS; ch++) {
+        /* Whatever was queued is gone with the reset */
+        g_LpdQueued[ch] = false;
+        if (lpd_dma_reset_channel(ch) != DMA_SUCCESS) {
+            status = DMA_ERROR_DMA_FAIL;
+        }
+    }
+    return status;
+}
+
+static void lpd_dma_ops_get_caps(DmaCaps_t* caps)
+{
+    caps->num_channels = LPD_DMA_NUM_CHANNELS;
+    caps->max_transfer_len = LPD_DMA_MAX_TRANSFER_SIZE;
+    caps->has_simple = true;
+    caps->has_sg = false;
+    caps->has_irq = false;
+    caps->needs_cache_maint = true;
+    caps->queue_depth = 1;
+    caps->addr_width = LPD_DMA_ADDR_WIDTH;
+}
+
+static int lpd_dma_ops_submit(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                              uint32_t length, bool use_sg)
+{
+    /* Driver only implements register-mode (simple) descriptors */
+    if (use_sg) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    return lpd_dma_transfer(channel, src_addr, dst_addr, length);
+}
+
+static int lpd_dma_ops_poll(uint32_t channel)
+{
+    if (lpd_dma_is_busy(channel)) {
+        return DMA_ERROR_BUSY;
+    }
+    return lpd_dma_wait_complete(channel, DMA_TIMEOUT_US);
+}
+
+static int lpd_dma_ops_enqueue(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                               uint32_t length)
+{
+    int status;
+
+    if (channel >= LPD_DMA_NUM_CHANNELS) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (g_LpdQueued[channel]) {
+        return DMA_ERROR_BUSY;
+    }
+
+    status = lpd_dma_transfer(channel, src_addr, dst_addr, length);
+    if (status == DMA_SUCCESS) {
+        g_LpdQueued[channel] = true;
+    }
+    return status;
+}
+
+static int lpd_dma_ops_reap(uint32_t channel)
+{
+    int status;
+
+    if (channel >= LPD_DMA_NUM_CHANNELS) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (!g_LpdQueued[channel] || lpd_dma_is_busy(channel)) {
+        return 0;
+    }
+
+    g_LpdQueued[channel] = false;
+    status = lpd_dma_wait_complete(channel, DMA_TIMEOUT_US);
+    return (status == DMA_SUCCESS) ? 1 : status;
+}
+
+/*******************************************************************************
+ * CPU memcpy Adapter
+ ******************************************************************************/
+
+static int cpu_ops_init(void)
+{
+    return DMA_SUCCESS;
+}
+
+static void cpu_ops_get_caps(DmaCaps_t* caps)
+{
+    caps->num_channels = 1;
+    caps->max_transfer_len = 0xFFFFFFFF;
+    caps->has_simple = true;
+    caps->has_sg = false;
+    caps->has_irq = false;
+    caps->needs_cache_maint = false;
+    caps->queue_depth = 0;
+    caps->addr_width = 64;
+}
+
+static int cpu_ops_submit(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                          uint32_t length, bool use_sg)
+{
+    if (channel != 0 || use_sg) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    memcpy((void*)(uintptr_t)dst_addr, (const void*)(uintptr_t)src_addr, length);
+    return DMA_SUCCESS;
+}
+
+static int cpu_ops_poll(uint32_t channel)
+{
+    return DMA_SUCCESS;
+}
+
+static int cpu_ops_wait(uint32_t channel, uint32_t timeout_us)
+{
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Operations Tables
+ ******************************************************************************/
+
+static const DmaOps_t g_DmaOps[DMA_TYPE_COUNT] = {
+    [DMA_TYPE_AXI_DMA] = {
+        .type = DMA_TYPE_AXI_DMA,
+        .name = "AXI_DMA",
+        .init = axi_dma_init,
+        .reset = axi_dma_reset,
+        .get_caps = axi_dma_ops_get_caps,
+        .open_channel = NULL,
+        .close_channel = NULL,
+        .submit = axi_dma_ops_submit,
+        .poll = axi_dma_ops_poll,
+        .wait = axi_dma_ops_wait,
+        .enqueue = axi_dma_ops_enqueue,
+        .reap = axi_dma_ops_reap,
+        .set_ring_config = axi_dma_set_ring_config,
+        .get_ring_config = axi_dma_get_ring_config
+    },
+    [DMA_TYPE_AXI_CDMA] = {
+        .type = DMA_TYPE_AXI_CDMA,
+        .name = "AXI_CDMA",
+        .init = axi_cdma_init,
+        .reset = axi_cdma_reset,
+        .get_caps = axi_cdma_ops_get_caps,
+        .open_channel = NULL,
+        .close_channel = NULL,
+        .submit = axi_cdma_ops_submit,
+        .poll = axi_cdma_ops_poll,
+        .wait = axi_cdma_ops_wait,
+        .enqueue = axi_cdma_ops_enqueue,
+        .reap = axi_cdma_ops_reap,
+        .set_ring_config = axi_cdma_set_ring_config,
+        .get_ring_config = axi_cdma_get_ring_config
+    },
+    [DMA_TYPE_AXI_MCDMA] = {
+        .type = DMA_TYPE_AXI_MCDMA,
+        .name = "AXI_MCDMA",
+        .init = axi_mcdma_init,
+        .reset = axi_mcdma_reset,
+        .get_caps = axi_mcdma_ops_get_caps,
+        .open_channel = axi_mcdma_ops_open_channel,
+        .close_channel = axi_mcdma_ops_close_channel,
+        .submit = axi_mcdma_ops_submit,
+        .poll = axi_mcdma_ops_poll,
+        .wait = axi_mcdma_ops_wait,
+        .enqueue = axi_mcdma_ops_enqueue,
+        .reap = axi_mcdma_reap,
+        .set_ring_config = axi_mcdma_set_ring_config,
+        .get_ring_config = axi_mcdma_get_ring_config
+    },
+    [DMA_TYPE_LPD_DMA] = {
+        .type = DMA_TYPE_LPD_DMA,
+        .name = "LPD_DMA",
+        .init = lpd_dma_init,
+        .reset = lpd_dma_ops_reset,
+        .get_caps = lpd_dma_ops_get_caps,
+        .open_channel = NULL,
+        .close_channel = NULL,
+        .submit = lpd_dma_ops_submit,
+        .poll = lpd_dma_ops_poll,
+        .wait = lpd_dma_wait_complete,
+        .enqueue = lpd_dma_ops_enqueue,
+        .reap = lpd_dma_ops_reap,
+        .set_ring_config = NULL,
+        .get_ring_config = NULL
+    },
+    /* DMA_TYPE_QDMA: no PCIe endpoint on this design, left empty */
+    [DMA_TYPE_CPU_MEMCPY] = {
+        .type = DMA_TYPE_CPU_MEMCPY,
+        .name = "CPU_MEMCPY",
+        .init = cpu_ops_init,
+        .reset = cpu_ops_init,
+        .get_caps = cpu_ops_get_caps,
+        .open_channel = NULL,
+        .close_channel = NULL,
+        .submit = cpu_ops_submit,
+        .poll = cpu_ops_poll,
+        .wait = cpu_ops_wait,
+        .enqueue = NULL,
+        .reap = NULL,
+        .set_ring_config = NULL,
+        .get_ring_config = NULL
+    }
+};
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+const DmaOps_t* dma_ops_get(DmaType_t type)
+{
+    if (type >= DMA_TYPE_COUNT || g_DmaOps[type].submit == NULL) {
+        return NULL;
+    }
+    return &g_DmaOps[type];
+}
+
+int dma_ops_get_caps(DmaType_t type, DmaCaps_t* caps)
+{
+    const DmaOps_t* ops = dma_ops_get(type);
+
+    if (ops == NULL || caps == NULL) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    memset(caps, 0, sizeof(*caps));
+    ops->get_caps(caps);
+    return DMA_SUCCESS;
+}
+
+int dma_ops_transfer(const DmaOps_t* ops, uint32_t channel, uint64_t src_addr,
+                     uint64_t dst_addr, uint32_t length, bool use_sg)
+{
+    int status;
+
+    if (ops == NULL) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    status = ops->submit(channel, src_addr, dst_addr, length, use_sg);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+    return ops->wait(channel, DMA_TIMEOUT_US);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file dma_ops.h
+ * @brief Engine-Agnostic DMA Operations Table Header
+ *
+ * Uniform init/submit/poll/wait/reset/capabilities interface over the
+ * AXI DMA, AXI CDMA, AXI MCDMA, LPD DMA drivers and a CPU memcpy engine,
+ * so scenarios can be written once for every engine.
+ *
+ * Engines that can hold several transfers in flight on one channel also
+ * provide enqueue/reap: enqueue() appends one transfer without waiting
+ * and reap() retires completions in submission order.
+ */
+
+#ifndef DMA_OPS_H
+#define DMA_OPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../dma_benchmark.h"
+#include "../utils/memory_utils.h"
+
+/*******************************************************************************
+ * Engine Capabilities
+ ******************************************************************************/
+
+typedef struct {
+    uint32_t num_channels;          /* Channels usable concurrently */
+    uint32_t max_transfer_len;      /* Largest single transfer (bytes) */
+    bool     has_simple;            /* Register (direct) mode available */
+    bool     has_sg;                /* Scatter-Gather mode available */
+    bool     has_irq;               /* Interrupt completion wired up */
+    bool     needs_cache_maint;     /* Non-coherent: buffers need flush/invalidate */
+    uint32_t queue_depth;           /* Transfers in flight per channel (0 = no enqueue) */
+    uint32_t addr_width;            /* Bits of buffer address the engine drives */
+} DmaCaps_t;
+
+/*******************************************************************************
+ * Operations Table
+ ******************************************************************************/
+
+typedef struct {
+    DmaType_t type;
+    const char* name;
+
+    /* Engine control */
+    int  (*init)(void);
+    int  (*reset)(void);
+    void (*get_caps)(DmaCaps_t* caps);
+
+    /* Channel control (NULL if the engine has no per-channel setup) */
+    int  (*open_channel)(uint32_t channel);
+    void (*close_channel)(uint32_t channel);
+
+    /* Transfer control */
+    int  (*submit)(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                   uint32_t length, bool use_sg);
+    int  (*poll)(uint32_t channel);     /* DMA_SUCCESS done, DMA_ERROR_BUSY pending */
+    int  (*wait)(uint32_t channel, uint32_t timeout_us);
+
+    /* Queued transfer control (NULL if the engine cannot queue) */
+    int  (*enqueue)(uint32_t channel, uint64_t src_addr, uint64_t dst_addr,
+                    uint32_t length);   /* DMA_ERROR_BUSY if the queue is full */
+    int  (*reap)(uint32_t channel);     /* Completed count (FIFO order), <0 on error */
+
+    /* Descriptor ring placement and depth (NULL if the engine has no rings) */
+    int  (*set_ring_config)(const DescRingConfig_t* config);
+    void (*get_ring_config)(DescRingConfig_t* config);
+} DmaOps_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Get operations table for a DMA engine
+ * @param type DMA type
+ * @return Operations table, or NULL if the engine is not available
+ */
+const DmaOps_t* dma_ops_get(DmaType_t type);
+
+/**
+ * @brief Get engine capabilities
+ * @param type DMA type
+ * @param caps Capabilities output
+ * @return 0 on success, negative error code on failure
+ */
+int dma_ops_get_caps(DmaType_t type, DmaCaps_t* caps);
+
+/**
+ * @brief Submit a transfer and wait for it to complete
+ * @param ops Operations table
+ * @param channel Channel number
+ * @param src_addr Source address
+ * @param dst_addr Destination address
+ * @param length Transfer length in bytes
+ * @param use_sg Use Scatter-Gather mode
+ * @return 0 on success, negative error code on failure
+ */
+int dma_ops_transfer(const DmaOps_t* ops, uint32_t channel, uint64_t src_addr,
+                     uint64_t dst_addr, uint32_t length, bool use_sg);
+
+#endif /* DMA_OPS_H */
@@ -0,0 +1,367 @@
+/**
+ * @file dma_stripe.c
+ * @brief Heterogeneous DMA Striping Copy Service Implementation
+ *
+ * All slices are submitted back to back, then the lanes are polled
+ * round-robin through the ops table. Each lane's finish time gives its
+ * effective bandwidth under contention, which becomes its new weight.
+ */
+
+#include <string.h>
+#include "dma_stripe.h"
+#include "../platform_config.h"
+#include "../utils/timer_utils.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+/* Engines in lane order; AXI DMA (stream loopback) only when asked for */
+static const DmaType_t g_StripeEngines[] = {
+    DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA, DMA_TYPE_AXI_DMA
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Split size over the weighted lanes; returns lanes used, 0 if it cannot fit */
+static uint32_t stripe_assign_slices(DmaStripe_t* stripe, uint64_t size)
+{
+    uint64_t total_weight = 0;
+    uint64_t offset = 0;
+    uint32_t used = 0;
+    int32_t last = -1;
+    uint32_t i;
+
+    for (i = 0; i < stripe->num_lanes; i++) {
+        stripe->lanes[i].offset = 0;
+        stripe->lanes[i].length = 0;
+        if (stripe->lanes[i].weight_mbps > 0) {
+            total_weight += stripe->lanes[i].weight_mbps;
+            last = (int32_t)i;
+        }
+    }
+    if (last < 0) {
+        return 0;
+    }
+
+    for (i = 0; i < stripe->num_lanes && offset < size; i++) {
+        DmaStripeLane_t* lane = &stripe->lanes[i];
+        uint64_t share;
+
+        if (lane->weight_mbps == 0) {
+            continue;
+        }
+
+        if ((int32_t)i == last) {
+            share = size - offset;
+        } else {
+            share = (size * lane->weight_mbps) / total_weight;
+            share &= ~((uint64_t)DMA_STRIPE_SLICE_ALIGN - 1);
+        }
+
+        /* Clamp to the engine limit; the excess moves to later lanes */
+        if (share > lane->max_len) {
+            share = lane->max_len & ~(DMA_STRIPE_SLICE_ALIGN - 1);
+        }
+        if (share == 0) {
+            continue;
+        }
+
+        lane->offset = offset;
+        lane->length = (uint32_t)share;
+        offset += share;
+        used++;
+    }
+
+    return (offset == size) ? used : 0;
+}
+
+/* New weight: average of the old weight and the bandwidth just observed */
+static void stripe_rebalance(DmaStripe_t* stripe)
+{
+    for (uint32_t i = 0; i < stripe->num_lanes; i++) {
+        DmaStripeLane_t* lane = &stripe->lanes[i];
+        uint32_t observed;
+
+        if (lane->length == 0 || lane->status != DMA_SUCCESS) {
+            continue;
+        }
+
+        observed = CALC_THROUGHPUT_MBPS(lane->length, MAX(lane->finish_us, 1));
+        lane->weight_mbps = MAX((lane->weight_mbps + observed) / 2, 1);
+    }
+}
+
+/*
+ * Reset every engine with a lane still in flight, once per engine, and
+ * re-open that engine's channels so the next stripe can submit to them.
+ */
+static void stripe_reset_unfinished(DmaStripe_t* stripe)
+{
+    for (uint32_t i = 0; i < stripe->num_lanes; i++) {
+        const DmaOps_t* ops = stripe->lanes[i].ops;
+        bool seen = false;
+
+        if (stripe->lanes[i].length == 0 || stripe->lanes[i].finish_us != 0) {
+            continue;
+        }
+        for (uint32_t j = 0; j < i; j++) {
+            if (stripe->lanes[j].ops == ops && stripe->lanes[j].length != 0 &&
+                stripe->lanes[j].finish_us == 0) {
+                seen = true;
+                break;
+            }
+        }
+        if (seen || ops->reset == NULL) {
+            continue;
+        }
+
+        ops->reset();
+        if (ops->open_channel != NULL) {
+            for (uint32_t j = 0; j < stripe->num_lanes; j++) {
+                if (stripe->lanes[j].ops == ops) {
+                    ops->open_channel(stripe->lanes[j].channel);
+                }
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int dma_stripe_init(DmaStripe_t* stripe, uint32_t engine_mask)
+{
+    DmaCaps_t caps;
+
+    if (stripe == NULL) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    memset(stripe, 0, sizeof(*stripe));
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_StripeEngines); e++) {
+        const DmaOps_t* ops = dma_ops_get(g_StripeEngines[e]);
+
+        if (!(engine_mask & DMA_STRIPE_ENGINE(g_StripeEngines[e])) || ops == NULL ||
+            dma_ops_get_caps(g_StripeEngines[e], &caps) != DMA_SUCCESS) {
+            continue;
+        }
+
+        for (uint32_t ch = 0; ch < caps.num_channels; ch++) {
+            DmaStripeLane_t* lane;
+
+            if (stripe->num_lanes >= DMA_STRIPE_MAX_LANES) {
+                break;
+            }
+            if (ops->open_channel != NULL && ops->open_channel(ch) != DMA_SUCCESS) {
+                LOG_WARNING("Stripe: %s channel %lu unavailable\r\n",
+                            ops->name, (unsigned long)ch);
+                continue;
+            }
+
+            lane = &stripe->lanes[stripe->num_lanes++];
+            lane->ops = ops;
+            lane->channel = ch;
+            lane->use_sg = !caps.has_simple;
+            lane->max_len = caps.max_transfer_len;
+            lane->weight_mbps = 1;      /* Equal shares until calibrated */
+            lane->status = DMA_SUCCESS;
+        }
+    }
+
+    return (stripe->num_lanes > 0) ? DMA_SUCCESS : DMA_ERROR_NOT_SUPPORTED;
+}
+
+void dma_stripe_deinit(DmaStripe_t* stripe)
+{
+    for (uint32_t i = 0; i < stripe->num_lanes; i++) {
+        DmaStripeLane_t* lane = &stripe->lanes[i];
+        if (lane->ops->close_channel != NULL) {
+            lane->ops->close_channel(lane->channel);
+        }
+    }
+    stripe->num_lanes = 0;
+}
+
+int dma_stripe_calibrate(DmaStripe_t* stripe, uint64_t src_addr,
+                         uint64_t dst_addr, uint32_t size)
+{
+    uint32_t good = 0;
+
+    for (uint32_t i = 0; i < stripe->num_lanes; i++) {
+        DmaStripeLane_t* lane = &stripe->lanes[i];
+        uint32_t len = MIN(size, lane->max_len);
+        uint64_t start, elapsed_us;
+
+        /* One untimed pass to settle caches and descriptors */
+        lane->status = dma_ops_transfer(lane->ops, lane->channel, src_addr, dst_addr,
+                                        len, lane->use_sg);
+        if (lane->status == DMA_SUCCESS) {
+            start = timer_start();
+            lane->status = dma_ops_transfer(lane->ops, lane->channel, src_addr, dst_addr,
+                                            len, lane->use_sg);
+            elapsed_us = timer_stop_us(start);
+        }
+
+        if (lane->status != DMA_SUCCESS) {
+            LOG_WARNING("Stripe: %s channel %lu calibration failed (%d)\r\n",
+                        lane->ops->name, (unsigned long)lane->channel, lane->status);
+            lane->weight_mbps = 0;
+            continue;
+        }
+
+        lane->weight_mbps = MAX(CALC_THROUGHPUT_MBPS(len, MAX(elapsed_us, 1)), 1);
+        good++;
+    }
+
+    stripe->copies = 0;
+    return (good > 0) ? DMA_SUCCESS : DMA_ERROR_DMA_FAIL;
+}
+
+int dma_stripe_copy(DmaStripe_t* stripe, uint64_t src_addr, uint64_t dst_addr,
+                    uint64_t size, DmaStripeResult_t* result)
+{
+    int status = dma_stripe_start(stripe, src_addr, dst_addr, size);
+
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+    return dma_stripe_finish(stripe, result);
+}
+
+int dma_stripe_start(DmaStripe_t* stripe, uint64_t src_addr, uint64_t dst_addr,
+                     uint64_t size)
+{
+    uint32_t used;
+
+    if (stripe == NULL || size == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    used = stripe_assign_slices(stripe, size);
+    if (used == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    stripe->size = size;
+    stripe->lanes_used = used;
+    stripe->pending = 0;
+    stripe->submit_status = DMA_SUCCESS;
+
+    /* Submit every slice back to back */
+    stripe->start = timer_start();
+
+    for (uint32_t i = 0; i < stripe->num_lanes; i++) {
+        DmaStripeLane_t* lane = &stripe->lanes[i];
+
+        lane->finish_us = 0;
+        if (lane->length == 0) {
+            lane->status = DMA_SUCCESS;
+            continue;
+        }
+
+        lane->status = lane->ops->submit(lane->channel, src_addr + lane->offset,
+                                         dst_addr + lane->offset, lane->length,
+                                         lane->use_sg);
+        if (lane->status != DMA_SUCCESS) {
+            stripe->submit_status = lane->status;
+            lane->length = 0;
+            continue;
+        }
+        stripe->pending++;
+    }
+
+    return (stripe->pending > 0) ? DMA_SUCCESS : stripe->submit_status;
+}
+
+int dma_stripe_finish(DmaStripe_t* stripe, DmaStripeResult_t* result)
+{
+    uint64_t now_us;
+    uint64_t first_us = UINT64_MAX;
+    uint64_t last_us = 0;
+    uint32_t i;
+    int status;
+
+    if (stripe == NULL) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    status = stripe->submit_status;
+
+    /* Reap completions round-robin, timestamping each lane */
+    while (stripe->pending > 0) {
+        for (i = 0; i < stripe->num_lanes; i++) {
+            DmaStripeLane_t* lane = &stripe->lanes[i];
+            int poll_status;
+
+            if (lane->length == 0 || lane->finish_us != 0) {
+                continue;
+            }
+
+            poll_status = lane->ops->poll(lane->channel);
+            if (poll_status == DMA_ERROR_BUSY) {
+                continue;
+            }
+
+            now_us = timer_stop_us(stripe->start);
+            lane->finish_us = MAX(now_us, 1);
+            lane->status = poll_status;
+            if (poll_status != DMA_SUCCESS) {
+                status = poll_status;
+            }
+            first_us = MIN(first_us, lane->finish_us);
+            last_us = MAX(last_us, lane->finish_us);
+            stripe->pending--;
+        }
+
+        if (stripe->pending > 0 && timer_stop_us(stripe->start) > DMA_TIMEOUT_US) {
+            LOG_ERROR("Stripe: %lu lane(s) timed out\r\n", (unsigned long)stripe->pending);
+            for (i = 0; i < stripe->num_lanes; i++) {
+                if (stripe->lanes[i].length != 0 && stripe->lanes[i].finish_us == 0) {
+                    stripe->lanes[i].status = DMA_ERROR_TIMEOUT;
+                }
+            }
+            /* Stop the engines before the buffers go back to the caller */
+            stripe_reset_unfinished(stripe);
+            stripe->pending = 0;
+            return DMA_ERROR_TIMEOUT;
+        }
+    }
+
+    if (result != NULL) {
+        memset(result, 0, sizeof(*result));
+        result->total_bytes = stripe->size;
+        result->elapsed_us = last_us;
+        result->first_finish_us = (first_us == UINT64_MAX) ? 0 : first_us;
+        result->straggler_us = (uint32_t)(last_us - result->first_finish_us);
+        result->throughput_mbps = CALC_THROUGHPUT_MBPS(stripe->size, last_us);
+        result->lanes_used = stripe->lanes_used;
+    }
+
+    if (status == DMA_SUCCESS) {
+        stripe_rebalance(stripe);
+        stripe->copies++;
+    }
+
+    return status;
+}
+
+void dma_stripe_print_lanes(const DmaStripe_t* stripe)
+{
+    LOG_RESULT("  Engine     | Ch | Weight (MB/s) | Slice (KB) | Finish (us)\r\n");
+    LOG_RESULT("  -----------|----|---------------|------------|------------\r\n");
+
+    for (uint32_t i = 0; i < stripe->num_lanes; i++) {
+        const DmaStripeLane_t* lane = &stripe->lanes[i];
+
+        LOG_RESULT("  %-10s | %2lu | %13lu | %10lu | %11lu\r\n",
+                   lane->ops->name, (unsigned long)lane->channel,
+                   (unsigned long)lane->weight_mbps,
+                   (unsigned long)(lane->length / 1024),
+                   (unsigned long)lane->finish_us);
+    }
+}
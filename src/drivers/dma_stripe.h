@@ -0,0 +1,151 @@
+/**
+ * @file dma_stripe.h
+ * @brief Heterogeneous DMA Striping Copy Service Header
+ *
+ * Splits one large copy across every available engine and channel
+ * (AXI CDMA, AXI MCDMA, LPD DMA) at once. Slice sizes follow per-lane
+ * bandwidth weights, calibrated once and then rebalanced after every
+ * copy from the observed finish times so all lanes end together.
+ */
+
+#ifndef DMA_STRIPE_H
+#define DMA_STRIPE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dma_ops.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define DMA_STRIPE_MAX_LANES        32
+#define DMA_STRIPE_SLICE_ALIGN      64      /* Slice boundaries (cache line) */
+
+/* Engine mask bits for dma_stripe_init() */
+#define DMA_STRIPE_ENGINE(type)     (1U << (type))
+#define DMA_STRIPE_ENGINES_DEFAULT  (DMA_STRIPE_ENGINE(DMA_TYPE_AXI_CDMA) | \
+                                     DMA_STRIPE_ENGINE(DMA_TYPE_AXI_MCDMA) | \
+                                     DMA_STRIPE_ENGINE(DMA_TYPE_LPD_DMA))
+
+/**
+ * @brief One engine channel taking part in a striped copy
+ */
+typedef struct {
+    const DmaOps_t* ops;
+    uint32_t channel;
+    bool     use_sg;                /* Descriptor mode (engine has no simple mode) */
+    uint32_t max_len;               /* Largest slice the engine accepts */
+    uint32_t weight_mbps;           /* Bandwidth share used to size slices */
+
+    /* Last copy */
+    uint64_t offset;                /* Slice offset within the copy */
+    uint32_t length;                /* Slice length (0 = lane idle) */
+    uint64_t finish_us;             /* Completion time relative to first submit */
+    int      status;
+} DmaStripeLane_t;
+
+/**
+ * @brief Striping context
+ */
+typedef struct {
+    DmaStripeLane_t lanes[DMA_STRIPE_MAX_LANES];
+    uint32_t num_lanes;
+    uint32_t copies;                /* Copies completed (rebalance rounds) */
+
+    /* Copy in flight (dma_stripe_start() to dma_stripe_finish()) */
+    uint64_t start;                 /* Timer value at first submit */
+    uint64_t size;
+    uint32_t lanes_used;
+    uint32_t pending;               /* Lanes not yet reaped */
+    int      submit_status;         /* First submit error, reported by finish */
+} DmaStripe_t;
+
+/**
+ * @brief Striped copy result
+ */
+typedef struct {
+    uint64_t total_bytes;
+    uint64_t elapsed_us;            /* First submit to last completion */
+    uint64_t first_finish_us;       /* Earliest lane completion */
+    uint32_t straggler_us;          /* Last minus first lane completion */
+    uint32_t throughput_mbps;       /* Aggregate MB/s */
+    uint32_t lanes_used;
+} DmaStripeResult_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Build the lane list and open every channel
+ * @param stripe Striping context
+ * @param engine_mask DMA_STRIPE_ENGINE() bits of the engines to use
+ * @return 0 on success, negative error code if no lane is available
+ */
+int dma_stripe_init(DmaStripe_t* stripe, uint32_t engine_mask);
+
+/**
+ * @brief Close every channel opened by dma_stripe_init()
+ * @param stripe Striping context
+ */
+void dma_stripe_deinit(DmaStripe_t* stripe);
+
+/**
+ * @brief Measure each lane alone and use the result as its weight
+ *
+ * Lanes whose calibration transfer fails are given weight 0 and are left
+ * out of later copies.
+ *
+ * @param stripe Striping context
+ * @param src_addr Source buffer (at least size bytes)
+ * @param dst_addr Destination buffer (at least size bytes)
+ * @param size Calibration transfer size per lane
+ * @return 0 on success, negative error code if every lane failed
+ */
+int dma_stripe_calibrate(DmaStripe_t* stripe, uint64_t src_addr,
+                         uint64_t dst_addr, uint32_t size);
+
+/**
+ * @brief Copy using every weighted lane concurrently, then rebalance
+ * @param stripe Striping context
+ * @param src_addr Source address
+ * @param dst_addr Destination address
+ * @param size Copy size in bytes
+ * @param result Result output (may be NULL)
+ * @return 0 on success, negative error code on failure
+ */
+int dma_stripe_copy(DmaStripe_t* stripe, uint64_t src_addr, uint64_t dst_addr,
+                    uint64_t size, DmaStripeResult_t* result);
+
+/**
+ * @brief Submit a striped copy and return without waiting
+ *
+ * The CPU is free until dma_stripe_finish(), which must be called before
+ * the next copy on this context. A lane whose submit fails is left out
+ * and its error is returned by dma_stripe_finish().
+ *
+ * @param stripe Striping context
+ * @param src_addr Source address
+ * @param dst_addr Destination address
+ * @param size Copy size in bytes
+ * @return 0 if at least one slice is in flight, negative error code otherwise
+ */
+int dma_stripe_start(DmaStripe_t* stripe, uint64_t src_addr, uint64_t dst_addr,
+                     uint64_t size);
+
+/**
+ * @brief Wait for the copy started by dma_stripe_start(), then rebalance
+ * @param stripe Striping context
+ * @param result Result output (may be NULL)
+ * @return 0 on success, negative error code on failure
+ */
+int dma_stripe_finish(DmaStripe_t* stripe, DmaStripeResult_t* result);
+
+/**
+ * @brief Print lane weights and the slices of the last copy
+ * @param stripe Striping context
+ */
+void dma_stripe_print_lanes(const DmaStripe_t* stripe);
+
+#endif /* DMA_STRIPE_H */
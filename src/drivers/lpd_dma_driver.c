@@ -13,6 +13,9 @@
 #include "../platform_config.h"
 #include "../utils/timer_utils.h"
 #include "../utils/debug_print.h"
+#include "../utils/dma_wait.h"
+#include "../utils/dma_buf.h"
+#include "../utils/dma_phase.h"
 
 /*******************************************************************************
  * Local Variables
@@ -20,6 +23,10 @@
 
 static LpdDmaInst_t g_LpdDma = {0};
 
+/* Linked-list descriptor lists, one source and one destination per channel */
+static LpdDmaLlDesc_t g_LpdSrcList[LPD_DMA_NUM_CHANNELS][LPD_DMA_LL_MAX_DESCS];
+static LpdDmaLlDesc_t g_LpdDstList[LPD_DMA_NUM_CHANNELS][LPD_DMA_LL_MAX_DESCS];
+
 /* Channel base addresses */
 static const uint64_t g_ChannelBaseAddrs[LPD_DMA_NUM_CHANNELS] = {
     LPD_DMA_CH0_BASE_ADDR,
@@ -51,6 +58,12 @@ static inline uint32_t lpd_dma_read_reg(uint32_t channel, uint32_t offset)
     return 0;
 }
 
+/* Status reads from the wait loop are counted by the wait layer */
+static inline uint32_t lpd_dma_poll_reg(uint32_t channel, uint32_t offset)
+{
+    return dma_wait_mmio_read(g_ChannelBaseAddrs[channel] + offset);
+}
+
 /*******************************************************************************
  * Initialization Functions
  ******************************************************************************/
@@ -181,6 +194,7 @@ int lpd_dma_transfer(uint32_t channel, uint64_t src_addr, uint64_t dst_addr, uin
 {
     uint32_t ctrl0;
     uint32_t status, isr;
+    uint64_t phase_start;
 
     if (channel >= LPD_DMA_NUM_CHANNELS) {
         return DMA_ERROR_INVALID_PARAM;
@@ -196,13 +210,16 @@ int lpd_dma_transfer(uint32_t channel, uint64_t src_addr, uint64_t dst_addr, uin
     }
 
     /* Flush source, invalidate destination */
-    Xil_DCacheFlushRange(src_addr, length);
-    Xil_DCacheInvalidateRange(dst_addr, length);
+    dma_buf_sync_for_device(src_addr, length, DMA_DIR_TO_DEVICE);
+    dma_buf_sync_for_device(dst_addr, length, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
 
     /* Clear completion flags */
     g_LpdDma.channels[channel].transfer_complete = false;
     g_LpdDma.channels[channel].transfer_error = 0;
     g_LpdDma.channels[channel].busy = true;
+    g_LpdDma.channels[channel].transfer_length = length;
 
     /* Step 1: Disable channel first */
     lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_CTRL2, 0);
@@ -245,13 +262,107 @@ int lpd_dma_transfer(uint32_t channel, uint64_t src_addr, uint64_t dst_addr, uin
 
     /* Step 7: Start transfer by enabling channel */
     lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_CTRL2, 1);
+    dma_phase_kick(phase_start);
 
-    /* Small delay then check if started */
-    usleep(10);
-    status = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_STATUS);
-    isr = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_ISR);
-    LOG_DEBUG("LPD DMA ch%lu: After start - STATUS=0x%08lX, ISR=0x%08lX\r\n",
-              (unsigned long)channel, (unsigned long)status, (unsigned long)isr);
+    /* Check the channel started; only when debugging, it costs two MMIO reads */
+    if (debug_get_level() >= LOG_LEVEL_DEBUG) {
+        status = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_STATUS);
+        isr = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_ISR);
+        LOG_DEBUG("LPD DMA ch%lu: After start - STATUS=0x%08lX, ISR=0x%08lX\r\n",
+                  (unsigned long)channel, (unsigned long)status, (unsigned long)isr);
+    }
+
+    return DMA_SUCCESS;
+}
+
+static uint64_t lpd_dma_seg_total(const LpdDmaSeg_t* segs, uint32_t count)
+{
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += segs[i].length;
+    }
+    return total;
+}
+
+static void lpd_dma_build_list(LpdDmaLlDesc_t* list, const LpdDmaSeg_t* segs,
+                               uint32_t count, DmaDir_t dir)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        list[i].addr = segs[i].addr;
+        list[i].size = segs[i].length;
+        list[i].ctrl = XLPDDMA_DESC_CTRL_TYPE_LINKED;
+        list[i].next = 0;
+        list[i].reserved = 0;
+        if (i + 1 < count) {
+            list[i].next = (uint64_t)(uintptr_t)&list[i + 1];
+        } else {
+            list[i].ctrl |= XLPDDMA_DESC_CTRL_STOP;
+        }
+        dma_buf_sync_for_device(segs[i].addr, segs[i].length, dir);
+    }
+
+    /* The engine fetches the list from memory */
+    Xil_DCacheFlushRange((UINTPTR)list, count * sizeof(LpdDmaLlDesc_t));
+}
+
+int lpd_dma_ll_transfer(uint32_t channel, const LpdDmaSeg_t* src, uint32_t src_count,
+                        const LpdDmaSeg_t* dst, uint32_t dst_count)
+{
+    LpdDmaChannel_t* ch;
+    uint64_t total;
+    uint64_t phase_start;
+
+    if (channel >= LPD_DMA_NUM_CHANNELS || src == NULL || dst == NULL ||
+        src_count == 0 || src_count > LPD_DMA_LL_MAX_DESCS ||
+        dst_count == 0 || dst_count > LPD_DMA_LL_MAX_DESCS) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    total = lpd_dma_seg_total(src, src_count);
+    if (total == 0 || total > UINT32_MAX || total != lpd_dma_seg_total(dst, dst_count)) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    ch = &g_LpdDma.channels[channel];
+    if (!ch->initialized) {
+        return DMA_ERROR_NOT_INIT;
+    }
+    if (lpd_dma_is_busy(channel)) {
+        return DMA_ERROR_BUSY;
+    }
+
+    lpd_dma_build_list(g_LpdSrcList[channel], src, src_count, DMA_DIR_TO_DEVICE);
+    lpd_dma_build_list(g_LpdDstList[channel], dst, dst_count, DMA_DIR_FROM_DEVICE);
+
+    phase_start = dma_phase_begin();
+
+    ch->transfer_complete = false;
+    ch->transfer_error = 0;
+    ch->busy = true;
+    ch->transfer_length = (uint32_t)total;
+
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_CTRL2, 0);
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, XLPDDMA_IXR_ALL_MASK);
+
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_SRC_START_LSB,
+                      (uint32_t)((uintptr_t)g_LpdSrcList[channel] & 0xFFFFFFFF));
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_SRC_START_MSB,
+                      (uint32_t)((uint64_t)(uintptr_t)g_LpdSrcList[channel] >> 32));
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_DST_START_LSB,
+                      (uint32_t)((uintptr_t)g_LpdDstList[channel] & 0xFFFFFFFF));
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_DST_START_MSB,
+                      (uint32_t)((uint64_t)(uintptr_t)g_LpdDstList[channel] >> 32));
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_TOTAL_BYTE, (uint32_t)total);
+
+    /* Normal read-write mode, descriptors fetched from memory */
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_CTRL0,
+                      XLPDDMA_CTRL0_MODE_NORMAL | XLPDDMA_CTRL0_POINT_TYPE);
+
+    __asm__ __volatile__("dsb sy" ::: "memory");
+
+    lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_CTRL2, 1);
+    dma_phase_kick(phase_start);
 
     return DMA_SUCCESS;
 }
@@ -269,11 +380,12 @@ int lpd_dma_start_src(uint32_t channel, uint64_t src_addr, uint32_t length)
     }
 
     /* Flush source buffer */
-    Xil_DCacheFlushRange(src_addr, length);
+    dma_buf_sync_for_device(src_addr, length, DMA_DIR_TO_DEVICE);
 
     /* Clear completion flags */
     g_LpdDma.channels[channel].transfer_complete = false;
     g_LpdDma.channels[channel].busy = true;
+    g_LpdDma.channels[channel].transfer_length = length;
 
     /* Clear interrupts */
     lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, XLPDDMA_IXR_ALL_MASK);
@@ -307,11 +419,12 @@ int lpd_dma_start_dst(uint32_t channel, uint64_t dst_addr, uint32_t length, uint
     }
 
     /* Invalidate destination buffer */
-    Xil_DCacheInvalidateRange(dst_addr, length);
+    dma_buf_sync_for_device(dst_addr, length, DMA_DIR_FROM_DEVICE);
 
     /* Clear completion flags */
     g_LpdDma.channels[channel].transfer_complete = false;
     g_LpdDma.channels[channel].busy = true;
+    g_LpdDma.channels[channel].transfer_length = length;
 
     /* Clear interrupts */
     lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, XLPDDMA_IXR_ALL_MASK);
@@ -344,17 +457,20 @@ int lpd_dma_wait_complete(uint32_t channel, uint32_t timeout_us)
     uint32_t status;
     uint32_t isr;
     uint32_t total_bytes;
-    uint32_t elapsed_us = 0;
-    uint32_t poll_interval_us = 10;
+    DmaWait_t wait;
 
     if (channel >= LPD_DMA_NUM_CHANNELS) {
         return DMA_ERROR_INVALID_PARAM;
     }
 
-    while (elapsed_us < timeout_us) {
+    /* Register-mode descriptors: BD polling falls back to a status spin */
+    dma_wait_begin(&wait, timeout_us,
+                   dma_wait_expected_ns(DMA_TYPE_LPD_DMA, g_LpdDma.channels[channel].transfer_length));
+
+    do {
         /* Check interrupt status register */
-        isr = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_ISR);
-        status = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_STATUS);
+        isr = lpd_dma_poll_reg(channel, XLPDDMA_ZDMA_CH_ISR);
+        status = lpd_dma_poll_reg(channel, XLPDDMA_ZDMA_CH_STATUS);
 
         /* Check for errors */
         if (isr & XLPDDMA_IXR_ERR_MASK) {
@@ -384,6 +500,7 @@ int lpd_dma_wait_complete(uint32_t channel, uint32_t timeout_us)
             }
             /* Clear interrupt */
             lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, isr);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
@@ -397,6 +514,7 @@ int lpd_dma_wait_complete(uint32_t channel, uint32_t timeout_us)
             g_LpdDma.channels[channel].busy = false;
             /* Clear interrupt */
             lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, isr);
+            dma_wait_end(&wait, false);
             return DMA_SUCCESS;
         }
 
@@ -416,6 +534,7 @@ int lpd_dma_wait_complete(uint32_t channel, uint32_t timeout_us)
                 LOG_ERROR("  -> AXI Read Error: ADMA cannot read from src address!\r\n");
             }
             lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, isr);
+            dma_wait_end(&wait, false);
             return DMA_ERROR_DMA_FAIL;
         }
 
@@ -430,14 +549,14 @@ int lpd_dma_wait_complete(uint32_t channel, uint32_t timeout_us)
                 g_LpdDma.channels[channel].num_transfers++;
                 g_LpdDma.channels[channel].busy = false;
                 lpd_dma_write_reg(channel, XLPDDMA_ZDMA_CH_ISR, isr);
+                dma_wait_end(&wait, false);
                 return DMA_SUCCESS;
             }
         }
 
-        usleep(poll_interval_us);
-        elapsed_us += poll_interval_us;
-    }
+    } while (dma_wait_continue(&wait));
 
+    dma_wait_end(&wait, true);
     g_LpdDma.channels[channel].busy = false;
     status = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_STATUS);
     isr = lpd_dma_read_reg(channel, XLPDDMA_ZDMA_CH_ISR);
@@ -18,6 +18,7 @@
 
 #define LPD_DMA_NUM_CHANNELS       8
 #define LPD_DMA_CHANNEL_SPACING    0x10000
+#define LPD_DMA_LL_MAX_DESCS       MAX_SG_DESCRIPTORS  /* Per side of a linked-list transfer */
 
 /*******************************************************************************
  * LPD DMA Register Offsets
@@ -64,7 +65,7 @@
  ******************************************************************************/
 
 #define XLPDDMA_CTRL0_OVR_FETCH    0x00000080  /* Overflow fetch */
-#define XLPDDMA_CTRL0_POINT_TYPE   0x00000040  /* Pointer type (0=simple, 1=linear) */
+#define XLPDDMA_CTRL0_POINT_TYPE   0x00000040  /* Pointer type (0=simple, 1=descriptors in memory) */
 #define XLPDDMA_CTRL0_MODE_MASK    0x00000030  /* Mode mask */
 #define XLPDDMA_CTRL0_MODE_NORMAL  0x00000000  /* Normal mode */
 #define XLPDDMA_CTRL0_MODE_WONLY   0x00000010  /* Write-only mode */
@@ -118,12 +119,29 @@ typedef struct __attribute__((aligned(64))) {
     uint32_t ctrl;             /* Control */
 } LpdDmaDesc_t;
 
-/* Descriptor control bits */
-#define XLPDDMA_DESC_CTRL_INTR_EN  0x00000008  /* Interrupt enable */
-#define XLPDDMA_DESC_CTRL_PAUSE    0x00000010  /* Pause after this descriptor */
-#define XLPDDMA_DESC_CTRL_TYPE_MASK 0x00000006 /* Type mask */
+/* Linked-list descriptor (one per element, source and destination lists) */
+typedef struct __attribute__((aligned(32))) {
+    uint64_t addr;             /* 0x00: Address */
+    uint32_t size;             /* 0x08: Size */
+    uint32_t ctrl;             /* 0x0C: Control */
+    uint64_t next;             /* 0x10: Next descriptor address */
+    uint64_t reserved;         /* 0x18 */
+} LpdDmaLlDesc_t;
+
+/* Descriptor control bits (word 3, from Xilinx xzdma_hw.h) */
+#define XLPDDMA_DESC_CTRL_COHERENT 0x00000001  /* Coherent access */
+#define XLPDDMA_DESC_CTRL_TYPE_MASK 0x00000002 /* Type mask */
 #define XLPDDMA_DESC_CTRL_TYPE_LINEAR 0x00000000  /* Linear descriptor */
 #define XLPDDMA_DESC_CTRL_TYPE_LINKED 0x00000002  /* Linked list descriptor */
+#define XLPDDMA_DESC_CTRL_INTR_EN  0x00000004  /* Interrupt enable */
+#define XLPDDMA_DESC_CTRL_PAUSE    0x00000008  /* Pause after this descriptor */
+#define XLPDDMA_DESC_CTRL_STOP     0x00000010  /* Stop after this descriptor */
+
+/* One element of a linked-list transfer side */
+typedef struct {
+    uint64_t addr;
+    uint32_t length;
+} LpdDmaSeg_t;
 
 /*******************************************************************************
  * LPD DMA Channel Structure
@@ -136,6 +154,7 @@ typedef struct {
     bool busy;
     volatile bool transfer_complete;
     volatile uint32_t transfer_error;
+    uint32_t transfer_length;        /* In-flight length (wait prediction) */
     uint64_t bytes_transferred;
     uint32_t num_transfers;
     uint32_t errors;
@@ -193,6 +212,24 @@ int lpd_dma_configure_channel(uint32_t channel, bool use_irq);
  */
 int lpd_dma_transfer(uint32_t channel, uint64_t src_addr, uint64_t dst_addr, uint32_t length);
 
+/**
+ * @brief Start a linked-list (scatter/gather) transfer
+ *
+ * The source and destination lists are walked independently, so N
+ * scattered source elements can be gathered into one contiguous
+ * destination and the reverse. Both lists must cover the same number of
+ * bytes. Wait with lpd_dma_wait_complete().
+ *
+ * @param channel Channel number (0-7)
+ * @param src Source elements
+ * @param src_count Number of source elements (1..LPD_DMA_LL_MAX_DESCS)
+ * @param dst Destination elements
+ * @param dst_count Number of destination elements (1..LPD_DMA_LL_MAX_DESCS)
+ * @return 0 on success, negative error code on failure
+ */
+int lpd_dma_ll_transfer(uint32_t channel, const LpdDmaSeg_t* src, uint32_t src_count,
+                        const LpdDmaSeg_t* dst, uint32_t dst_count);
+
 /**
  * @brief Start source-only transfer (read from memory)
  * @param channel Channel number
@@ -19,12 +19,14 @@
 #include "drivers/axi_cdma_driver.h"
 #include "drivers/axi_mcdma_driver.h"
 #include "drivers/lpd_dma_driver.h"
+#include "drivers/dma_memcpy.h"
 #include "utils/timer_utils.h"
 #include "utils/memory_utils.h"
 #include "utils/data_patterns.h"
 #include "utils/results_logger.h"
 #include "utils/cache_utils.h"
 #include "utils/debug_print.h"
+#include "utils/dma_wait.h"
 #include "tests/axi_dma_test.h"
 #include "tests/axi_cdma_test.h"
 #include "tests/axi_mcdma_test.h"
@@ -33,7 +35,22 @@
 #include "scenarios/throughput_test.h"
 #include "scenarios/latency_test.h"
 #include "scenarios/multichannel_test.h"
+#include "scenarios/doorbell_test.h"
+#include "scenarios/queue_depth_test.h"
+#include "scenarios/cache_maint_test.h"
+#include "scenarios/mem_attr_test.h"
+#include "scenarios/high_mem_test.h"
+#include "scenarios/placement_test.h"
+#include "scenarios/random_io_test.h"
+#include "scenarios/ring_place_test.h"
+#include "scenarios/bounce_test.h"
+#include "scenarios/dram_test.h"
+#include "scenarios/stream_test.h"
+#include "scenarios/smp_test.h"
+#include "scenarios/pattern_test.h"
 #include "scenarios/stress_test.h"
+#include "scenarios/wait_strategy_test.h"
+#include "scenarios/bd_ring_test.h"
 
 /*******************************************************************************
  * Global Variables
@@ -60,6 +77,14 @@ const MemoryRegionInfo_t g_MemoryRegions[MEM_REGION_COUNT] = {
         .test_size = LPDDR4_TEST_REGION_SIZE,
         .cacheable = 1
     },
+    [MEM_REGION_DDR_HIGH] = {
+        .name = "DDR_HIGH",
+        .base_addr = DDR_HIGH_BASE_ADDR,
+        .size = DDR_HIGH_SIZE,
+        .test_base = DDR_HIGH_TEST_REGION_BASE,
+        .test_size = DDR_HIGH_TEST_REGION_SIZE,
+        .cacheable = 1
+    },
     [MEM_REGION_OCM] = {
         .name = "OCM",
         .base_addr = OCM_BASE_ADDR,
@@ -129,7 +154,8 @@ const char* pattern_to_string(DataPattern_t pattern)
         [PATTERN_ALL_ONES]     = "ALL_ONES",
         [PATTERN_ALL_ZEROS]    = "ALL_ZEROS",
         [PATTERN_RANDOM]       = "RANDOM",
-        [PATTERN_CHECKERBOARD] = "CHECKERBOARD"
+        [PATTERN_CHECKERBOARD] = "CHECKERBOARD",
+        [PATTERN_RANDOM_CTR]   = "RANDOM_CTR"
     };
     if (pattern < PATTERN_COUNT) {
         return names[pattern];
@@ -247,6 +273,7 @@ static void print_banner(void)
     LOG_ALWAYS("Memory Types:\r\n");
     LOG_ALWAYS("  - DDR4:   8GB @ 3200 MT/s\r\n");
     LOG_ALWAYS("  - LPDDR4: 2GB @ 4267 MT/s\r\n");
+    LOG_ALWAYS("  - DDR high window: 2GB @ 0x8_0000_0000\r\n");
     LOG_ALWAYS("  - OCM:    256KB (on-chip)\r\n");
     LOG_ALWAYS("  - BRAM:   128KB (PL)\r\n");
     LOG_ALWAYS("  - URAM:   64KB (PL)\r\n");
@@ -272,6 +299,26 @@ static void print_menu(void)
     LOG_ALWAYS("9. Stress Test (1 hour)\r\n");
     LOG_ALWAYS("A. Memory-to-Memory Matrix Test\r\n");
     LOG_ALWAYS("C. CPU memcpy Baseline\r\n");
+    LOG_ALWAYS("M. Engine/Mode Matrix (Generic Runner)\r\n");
+    LOG_ALWAYS("B. Descriptor Preparation Cost\r\n");
+    LOG_ALWAYS("K. Doorbell Batching (K = 1..256)\r\n");
+    LOG_ALWAYS("O. Buffer Ownership Cache Elision\r\n");
+    LOG_ALWAYS("H. Heterogeneous Engine Striping\r\n");
+    LOG_ALWAYS("G. Copy Dispatcher (Mixed Workload)\r\n");
+    LOG_ALWAYS("N. Queue Depth Sweep (QD 1..128)\r\n");
+    LOG_ALWAYS("F. Size Cost Model (Fixed + Per-Byte Fit)\r\n");
+    LOG_ALWAYS("E. Cache Maintenance Cost (Range vs Set/Way)\r\n");
+    LOG_ALWAYS("U. Cacheable vs Non-Cacheable vs Write-Combining Buffers\r\n");
+    LOG_ALWAYS("X. High DDR Window (above 4GB) vs Low\r\n");
+    LOG_ALWAYS("P. Buffer Placement Sweep (Bank / L2 Color)\r\n");
+    LOG_ALWAYS("I. Random Scatter/Gather IOPS (512B..64KB blocks)\r\n");
+    LOG_ALWAYS("L. Descriptor Ring Placement (OCM vs DDR) and Depth\r\n");
+    LOG_ALWAYS("J. OCM Bounce Buffers vs Direct DMA (1B..8KB, all offsets)\r\n");
+    LOG_ALWAYS("T. Full DRAM Test and Scrub (destructive outside the arenas)\r\n");
+    LOG_ALWAYS("V. STREAM CPU Bandwidth per Region (CSV)\r\n");
+    LOG_ALWAYS("Y. Dual-Core Pipeline (core 1 fills and verifies)\r\n");
+    LOG_ALWAYS("Z. Pattern Fill/Verify Throughput (GB/s)\r\n");
+    LOG_ALWAYS("W. Completion-Wait Strategy Comparison\r\n");
     LOG_ALWAYS("D. Set Debug Level\r\n");
     LOG_ALWAYS("S. Print Statistics\r\n");
     LOG_ALWAYS("R. Reset Statistics\r\n");
@@ -353,9 +400,130 @@ static int run_cpu_baseline(void)
     return throughput_test_run_cpu_baseline();
 }
 
+static int run_mode_matrix_test(void)
+{
+    LOG_ALWAYS("\r\n=== Running Engine/Mode Matrix ===\r\n\r\n");
+    return throughput_test_mode_matrix(KB(64));
+}
+
+static int run_cache_elision_test(void)
+{
+    LOG_ALWAYS("\r\n=== Running Buffer Ownership Cache Elision ===\r\n\r\n");
+    return throughput_test_cache_elision();
+}
+
+static int run_stripe_test(void)
+{
+    LOG_ALWAYS("\r\n=== Running Heterogeneous Engine Striping ===\r\n\r\n");
+    return multichannel_test_stripe();
+}
+
+static int run_dispatch_test(void)
+{
+    LOG_ALWAYS("\r\n=== Running Copy Dispatcher (Mixed Workload) ===\r\n\r\n");
+    return throughput_test_dispatch_mixed();
+}
+
+static int run_doorbell_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Doorbell Batching ===\r\n\r\n");
+    return doorbell_test_run_all();
+}
+
+static int run_size_model_test(void)
+{
+    LOG_ALWAYS("\r\n=== Running Size Cost Model ===\r\n\r\n");
+    return throughput_test_size_model();
+}
+
+static int run_queue_depth_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Queue Depth Sweep ===\r\n\r\n");
+    return queue_depth_test_run_all();
+}
+
+static int run_cache_maint_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Cache Maintenance Cost ===\r\n\r\n");
+    return cache_maint_test_run_all();
+}
+
+static int run_mem_attr_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Memory Attribute Comparison ===\r\n\r\n");
+    return mem_attr_test_run_all();
+}
+
+static int run_high_mem_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running High DDR Window Test ===\r\n\r\n");
+    return high_mem_test_run_all();
+}
+
+static int run_placement_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Buffer Placement Sweep ===\r\n\r\n");
+    return placement_test_run_all();
+}
+
+static int run_random_io_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Random Scatter/Gather IOPS ===\r\n\r\n");
+    return random_io_test_run_all();
+}
+
+static int run_ring_place_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Descriptor Ring Placement ===\r\n\r\n");
+    return ring_place_test_run_all();
+}
+
+static int run_bounce_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running OCM Bounce Buffer Comparison ===\r\n\r\n");
+    return bounce_test_run_all();
+}
+
+static int run_dram_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Full DRAM Test and Scrub ===\r\n\r\n");
+    return dram_test_run_all();
+}
+
+static int run_stream_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running STREAM CPU Bandwidth ===\r\n\r\n");
+    return stream_test_run_all();
+}
+
+static int run_smp_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Dual-Core Pipeline ===\r\n\r\n");
+    return smp_test_run_all();
+}
+
+static int run_pattern_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Pattern Fill/Verify Throughput ===\r\n\r\n");
+    return pattern_test_run_all();
+}
+
+static int run_bd_prep_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Descriptor Preparation Cost ===\r\n\r\n");
+    return bd_ring_test_run_all();
+}
+
+static int run_wait_strategy_tests(void)
+{
+    LOG_ALWAYS("\r\n=== Running Completion-Wait Strategy Comparison ===\r\n\r\n");
+    return wait_strategy_test_run_all();
+}
+
 static void print_statistics(void)
 {
     benchmark_print_summary();
+    memory_print_alloc_stats();
 }
 
 static void reset_statistics(void)
@@ -420,6 +588,9 @@ int benchmark_init(void)
         return status;
     }
 
+    /* Initialize completion-wait layer (needs the cycle counter) */
+    dma_wait_init();
+
     /* Initialize results logger */
     status = results_logger_init();
     if (status != 0) {
@@ -448,6 +619,21 @@ int benchmark_init(void)
         LOG_WARNING("LPD DMA init failed\r\n");
     }
 
+    /* Pick range vs set/way cache maintenance per size */
+    LOG_INFO("Calibrating cache maintenance...\r\n");
+    status = cache_maint_calibrate();
+    if (status != 0) {
+        LOG_WARNING("Cache maintenance calibration failed, using defaults\r\n");
+    }
+
+    /* Calibrate the copy dispatcher against the engines that came up */
+    dma_memcpy_init();
+    LOG_INFO("Calibrating copy dispatcher...\r\n");
+    status = dma_memcpy_calibrate();
+    if (status != 0) {
+        LOG_WARNING("Copy dispatcher calibration failed, using defaults\r\n");
+    }
+
     /* Reset statistics */
     memset(&g_BenchmarkStats, 0, sizeof(g_BenchmarkStats));
     g_TestAbort = false;
@@ -652,6 +838,106 @@ int main(void)
                 run_cpu_baseline();
                 break;
 
+            case 'M':
+            case 'm':
+                run_mode_matrix_test();
+                break;
+
+            case 'B':
+            case 'b':
+                run_bd_prep_tests();
+                break;
+
+            case 'O':
+            case 'o':
+                run_cache_elision_test();
+                break;
+
+            case 'H':
+            case 'h':
+                run_stripe_test();
+                break;
+
+            case 'G':
+            case 'g':
+                run_dispatch_test();
+                break;
+
+            case 'K':
+            case 'k':
+                run_doorbell_tests();
+                break;
+
+            case 'N':
+            case 'n':
+                run_queue_depth_tests();
+                break;
+
+            case 'F':
+            case 'f':
+                run_size_model_test();
+                break;
+
+            case 'E':
+            case 'e':
+                run_cache_maint_tests();
+                break;
+
+            case 'U':
+            case 'u':
+                run_mem_attr_tests();
+                break;
+
+            case 'X':
+            case 'x':
+                run_high_mem_tests();
+                break;
+
+            case 'P':
+            case 'p':
+                run_placement_tests();
+                break;
+
+            case 'I':
+            case 'i':
+                run_random_io_tests();
+                break;
+
+            case 'L':
+            case 'l':
+                run_ring_place_tests();
+                break;
+
+            case 'J':
+            case 'j':
+                run_bounce_tests();
+                break;
+
+            case 'T':
+            case 't':
+                run_dram_tests();
+                break;
+
+            case 'V':
+            case 'v':
+                run_stream_tests();
+                break;
+
+            case 'Y':
+            case 'y':
+                run_smp_tests();
+                break;
+
+            case 'Z':
+            case 'z':
+                run_pattern_tests();
+                break;
+
+            case 'W':
+            case 'w':
+                run_wait_strategy_tests();
+                break;
+
             case 'D':
             case 'd':
                 set_debug_level();
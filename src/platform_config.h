@@ -29,6 +29,17 @@
 #define LPDDR4_TEST_REGION_BASE     (LPDDR4_BASE_ADDR + 0x10000000ULL)  /* 256MB offset */
 #define LPDDR4_TEST_REGION_SIZE     0x10000000ULL   /* 256MB test region */
 
+/* High DDR window (2GB via NoC DDR_LOW1, above the 32-bit address space) */
+#ifdef XPAR_AXI_NOC_0_C3_DDR_LOW1_BASEADDR
+    #define DDR_HIGH_BASE_ADDR      XPAR_AXI_NOC_0_C3_DDR_LOW1_BASEADDR
+#else
+    #define DDR_HIGH_BASE_ADDR      0x800000000ULL
+#endif
+
+#define DDR_HIGH_SIZE               0x80000000ULL  /* 2GB */
+#define DDR_HIGH_TEST_REGION_BASE   (DDR_HIGH_BASE_ADDR + 0x10000000ULL)  /* 256MB offset */
+#define DDR_HIGH_TEST_REGION_SIZE   0x10000000ULL   /* 256MB test region */
+
 /* OCM (On-Chip Memory - 256KB) */
 #define OCM_BASE_ADDR               0xFFFC0000ULL
 #define OCM_SIZE                    0x00040000ULL   /* 256KB */
@@ -251,6 +262,7 @@
 
 /* LPD DMA configuration */
 #define LPD_DMA_DATA_WIDTH          128   /* bits */
+#define LPD_DMA_ADDR_WIDTH          48    /* bits */
 #define LPD_DMA_MAX_BURST_LEN       16    /* beats */
 
 /*******************************************************************************
@@ -266,6 +278,35 @@
 #define DMA_SG_DESC_BASE            (LPDDR4_BASE_ADDR + 0x30000000ULL)  /* 768MB offset */
 #define DMA_SG_DESC_SIZE            0x00100000ULL  /* 1MB for descriptors */
 
+/* Attribute-remapped buffer pools (2MB-aligned, one 16MB pool per type) */
+#define DMA_POOL_REGION_BASE        (LPDDR4_BASE_ADDR + 0x38000000ULL)  /* 896MB offset */
+#define DMA_POOL_REGION_SIZE        0x03000000ULL  /* 48MB */
+
+/*******************************************************************************
+ * DDR Address Mapping and Cache Geometry (buffer coloring)
+ ******************************************************************************/
+
+/*
+ * DDRMC address mapping of the LPDDR4 interface as configured in the NoC IP
+ * (row-bank-column): column in address bits [12:0], 8 banks selected by
+ * bits [15:13], row above. Adjust if the NoC address map is changed.
+ */
+#define DDR_BANK_SHIFT              13
+#define DDR_NUM_BANKS               8
+#define DDR_PAGE_SIZE               (1ULL << DDR_BANK_SHIFT)    /* One row, all columns */
+#define DDR_BANK_SPAN               ((uint64_t)DDR_NUM_BANKS << DDR_BANK_SHIFT)
+
+/* Cortex-A72 cluster L2: 1MB, 16-way, 64B lines */
+#define CPU_CACHE_LINE_SIZE         64
+#define CPU_L2_CACHE_SIZE           0x00100000ULL   /* 1MB */
+#define CPU_L2_CACHE_WAYS           16
+#define CPU_L2_WAY_SIZE             (CPU_L2_CACHE_SIZE / CPU_L2_CACHE_WAYS)
+#define CPU_L2_NUM_SETS             (CPU_L2_WAY_SIZE / CPU_CACHE_LINE_SIZE)
+
+/* Addresses a multiple of this apart share DDR bank and L2 set */
+#define MEM_COLOR_PERIOD            ((DDR_BANK_SPAN > CPU_L2_WAY_SIZE) ? \
+                                     DDR_BANK_SPAN : CPU_L2_WAY_SIZE)
+
 /*******************************************************************************
  * Test Configuration
  ******************************************************************************/
@@ -292,6 +333,7 @@
 typedef enum {
     MEM_REGION_DDR4 = 0,
     MEM_REGION_LPDDR4,
+    MEM_REGION_DDR_HIGH,
     MEM_REGION_OCM,
     MEM_REGION_BRAM,
     MEM_REGION_URAM,
@@ -0,0 +1,36 @@
+/**
+ * @file bd_ring_test.h
+ * @brief Descriptor Preparation Cost Test Header
+ */
+
+#ifndef BD_RING_TEST_H
+#define BD_RING_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Result of one descriptor-preparation measurement
+ */
+typedef struct {
+    uint32_t batch;             /* Descriptors per batch */
+    uint32_t legacy_ns_x10;     /* Per-BD cost, one flush per BD (ns x10) */
+    uint32_t batched_ns_x10;    /* Per-BD cost, one flush per batch (ns x10) */
+    uint32_t legacy_flush_ops;  /* Cache range ops per batch */
+    uint32_t batched_flush_ops;
+} BdPrepResult_t;
+
+/**
+ * @brief Compare per-BD preparation cost over a range of batch sizes
+ * @return 0 on success, negative error code on failure
+ */
+int bd_ring_test_run_all(void);
+
+/**
+ * @brief Measure per-BD preparation cost for one batch size
+ * @param batch Descriptors per batch (1..MAX_SG_DESCRIPTORS)
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int bd_ring_test_prep_cost(uint32_t batch, BdPrepResult_t* result);
+
+#endif /* BD_RING_TEST_H */
@@ -0,0 +1,42 @@
+/**
+ * @file bounce_test.h
+ * @brief OCM Bounce-Buffer vs Direct DMA Test Header
+ */
+
+#ifndef BOUNCE_TEST_H
+#define BOUNCE_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Result of one engine/size/offset/path point
+ */
+typedef struct {
+    uint32_t avg_ns;                /* Per copy, including cache maintenance */
+    uint32_t throughput_mbps;
+    bool data_integrity;            /* Copy correct and neighbouring bytes intact */
+} BounceResult_t;
+
+/**
+ * @brief Compare direct DMA with the OCM staging path for 1B..8KB copies
+ *        at every destination byte offset within a cache line
+ * @return 0 on success, negative error code on failure
+ */
+int bounce_test_run_all(void);
+
+/**
+ * @brief Measure one size, destination offset and path
+ *
+ * Only valid while bounce_test_run_all() holds the test buffers and has
+ * initialised the bounce path for the engine under test.
+ *
+ * @param size Copy size in bytes
+ * @param dst_offset Destination offset from a cache-line boundary
+ * @param flags DMA_BOUNCE_F_DIRECT or DMA_BOUNCE_F_STAGED
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int bounce_test_measure(uint32_t size, uint32_t dst_offset, uint32_t flags,
+                        BounceResult_t* result);
+
+#endif /* BOUNCE_TEST_H */
@@ -0,0 +1,203 @@
+/**
+ * @file cache_maint_test.c
+ * @brief Cache Maintenance Cost Test Implementation
+ *
+ * Times clean/invalidate by VA range against a whole-cache set/way clean
+ * for growing buffer sizes, and the adaptive cache_maint_flush() that picks
+ * between them. Every timed operation starts from a freshly written buffer
+ * so it pays for the dirty-line write-back a DMA source flush would.
+ */
+
+#include <string.h>
+#include "cache_maint_test.h"
+#include "../utils/timer_utils.h"
+#include "../utils/memory_utils.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define CACHE_TEST_MIN_SIZE     KB(4)
+#define CACHE_TEST_MAX_SIZE     MB(16)
+#define CACHE_TEST_REPS         3
+
+static const MemoryRegion_t g_CacheTestRegions[] = {
+    MEM_REGION_DDR4,
+    MEM_REGION_LPDDR4,
+    MEM_REGION_OCM
+};
+
+typedef enum {
+    CACHE_TEST_OP_RANGE_FLUSH = 0,
+    CACHE_TEST_OP_RANGE_INVAL,
+    CACHE_TEST_OP_SET_WAY,
+    CACHE_TEST_OP_ADAPTIVE
+} CacheTestOp_t;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Largest size swept in a region, 0 if it has no test area */
+static uint32_t cache_test_max_size(MemoryRegion_t region)
+{
+    return (uint32_t)MIN(g_MemoryRegions[region].test_size, (uint64_t)CACHE_TEST_MAX_SIZE);
+}
+
+static uint32_t cache_test_time(uint64_t addr, uint32_t size, CacheTestOp_t op,
+                                CacheMethod_t* method)
+{
+    uint64_t start, ns;
+    uint32_t best = UINT32_MAX;
+
+    for (uint32_t rep = 0; rep < CACHE_TEST_REPS; rep++) {
+        memset((void*)(uintptr_t)addr, (int)(rep + 1), size);
+        cache_memory_barrier();
+
+        start = timer_start();
+        switch (op) {
+            case CACHE_TEST_OP_RANGE_FLUSH:
+                cache_flush_range(addr, size);
+                break;
+            case CACHE_TEST_OP_RANGE_INVAL:
+                cache_invalidate_range(addr, size);
+                break;
+            case CACHE_TEST_OP_SET_WAY:
+                cache_flush_all();
+                break;
+            case CACHE_TEST_OP_ADAPTIVE:
+                *method = cache_maint_flush(addr, size);
+                break;
+        }
+        ns = timer_stop_ns(start);
+
+        if (ns < best) {
+            best = (uint32_t)MIN(ns, (uint64_t)UINT32_MAX);
+        }
+    }
+    return best;
+}
+
+static uint32_t cache_test_mbps(uint32_t size, uint32_t ns)
+{
+    if (ns == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)size * 1000000000ULL) / ((uint64_t)ns * 1048576ULL));
+}
+
+static void print_model(void)
+{
+    CacheCostModel_t model;
+
+    cache_maint_get_model(&model);
+
+    LOG_RESULT("Cost curve (DDR4, dirty buffer):\r\n");
+    LOG_RESULT("  Size     | Range flush (ns) | Range inval (ns) | Set/way (ns)\r\n");
+    LOG_RESULT("  ---------|------------------|------------------|-------------\r\n");
+    for (uint32_t i = 0; i < model.num_points; i++) {
+        const CacheCostPoint_t* pt = &model.points[i];
+        LOG_RESULT("  %6luKB | %16lu | %16lu | %12lu\r\n",
+                   (unsigned long)(pt->size / 1024), (unsigned long)pt->range_flush_ns,
+                   (unsigned long)pt->range_inval_ns, (unsigned long)pt->setway_ns);
+    }
+
+    if (model.flush_threshold == CACHE_SETWAY_NEVER) {
+        LOG_RESULT("\r\n  Flush:      range at every size\r\n");
+    } else {
+        LOG_RESULT("\r\n  Flush:      set/way from %lu KB\r\n",
+                   (unsigned long)(model.flush_threshold / 1024));
+    }
+    if (model.inval_threshold == CACHE_SETWAY_NEVER) {
+        LOG_RESULT("  Invalidate: range at every size\r\n\r\n");
+    } else {
+        LOG_RESULT("  Invalidate: set/way from %lu KB\r\n\r\n",
+                   (unsigned long)(model.inval_threshold / 1024));
+    }
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int cache_maint_test_run_all(void)
+{
+    CacheMaintResult_t result;
+    uint32_t max_size;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("              Cache Maintenance Cost (Range vs Set/Way)\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    status = cache_maint_calibrate();
+    if (status != DMA_SUCCESS) {
+        LOG_RESULT("  ERROR: Calibration failed: %d\r\n", status);
+        return status;
+    }
+    print_model();
+
+    for (uint32_t r = 0; r < ARRAY_SIZE(g_CacheTestRegions); r++) {
+        MemoryRegion_t region = g_CacheTestRegions[r];
+
+        max_size = cache_test_max_size(region);
+        if (max_size == 0) {
+            continue;
+        }
+
+        LOG_RESULT("%s throughput (MB/s):\r\n", memory_region_to_string(region));
+        LOG_RESULT("  Size     | Range flush | Range inval | Set/way | Adaptive | Method\r\n");
+        LOG_RESULT("  ---------|-------------|-------------|---------|----------|--------\r\n");
+
+        for (uint32_t size = CACHE_TEST_MIN_SIZE; size <= max_size; size *= 2) {
+            if (g_TestAbort) {
+                return DMA_SUCCESS;
+            }
+
+            status = cache_maint_test_measure(region, size, &result);
+            if (status != DMA_SUCCESS) {
+                LOG_RESULT("  %6luKB | ERROR %d\r\n", (unsigned long)(size / 1024), status);
+                break;
+            }
+
+            LOG_RESULT("  %6luKB | %11lu | %11lu | %7lu | %8lu | %s\r\n",
+                       (unsigned long)(size / 1024),
+                       (unsigned long)cache_test_mbps(size, result.range_flush_ns),
+                       (unsigned long)cache_test_mbps(size, result.range_inval_ns),
+                       (unsigned long)cache_test_mbps(size, result.setway_ns),
+                       (unsigned long)cache_test_mbps(size, result.adaptive_ns),
+                       cache_method_to_string(result.adaptive_method));
+        }
+        LOG_RESULT("\r\n");
+    }
+
+    LOG_RESULT("Cache maintenance test complete.\r\n");
+    return DMA_SUCCESS;
+}
+
+int cache_maint_test_measure(MemoryRegion_t region, uint32_t size, CacheMaintResult_t* result)
+{
+    uint64_t addr;
+
+    if (result == NULL || size == 0 || region >= MEM_REGION_COUNT || region == MEM_REGION_HOST) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    addr = memory_alloc_dma_buffer(region, size);
+    if (addr == 0) {
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->size = size;
+    result->range_flush_ns = cache_test_time(addr, size, CACHE_TEST_OP_RANGE_FLUSH, NULL);
+    result->range_inval_ns = cache_test_time(addr, size, CACHE_TEST_OP_RANGE_INVAL, NULL);
+    result->setway_ns = cache_test_time(addr, size, CACHE_TEST_OP_SET_WAY, NULL);
+    result->adaptive_ns = cache_test_time(addr, size, CACHE_TEST_OP_ADAPTIVE,
+                                          &result->adaptive_method);
+
+    memory_free_dma_buffer(addr);
+    return DMA_SUCCESS;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file cache_maint_test.h
+ * @brief Cache Maintenance Cost Test Header
+ */
+
+#ifndef CACHE_MAINT_TEST_H
+#define CACHE_MAINT_TEST_H
+
+#include "../dma_benchmark.h"
+#include "../utils/cache_utils.h"
+
+/**
+ * @brief Result of one region/size measurement (best of a few runs, each
+ *        starting from a dirty buffer)
+ */
+typedef struct {
+    uint32_t size;
+    uint32_t range_flush_ns;
+    uint32_t range_inval_ns;
+    uint32_t setway_ns;
+    uint32_t adaptive_ns;       /* cache_maint_flush() */
+    CacheMethod_t adaptive_method;
+} CacheMaintResult_t;
+
+/**
+ * @brief Recalibrate the adaptive layer and report maintenance throughput
+ *        per method and size on every test region
+ * @return 0 on success, negative error code on failure
+ */
+int cache_maint_test_run_all(void);
+
+/**
+ * @brief Time every maintenance method on one region and size
+ * @param region Memory region
+ * @param size Bytes to maintain
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int cache_maint_test_measure(MemoryRegion_t region, uint32_t size, CacheMaintResult_t* result);
+
+#endif /* CACHE_MAINT_TEST_H */
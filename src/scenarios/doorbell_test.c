@@ -0,0 +1,277 @@
+/**
+ * @file doorbell_test.c
+ * @brief Doorbell Batching Test Implementation
+ *
+ * Submits K descriptors through the driver rings either with a single
+ * tail-pointer write for the whole chain or with a commit and tail-pointer
+ * write per descriptor, then waits for the chain. Buffers are registered
+ * with dma_buf and handed to the device once, so per-BD cache maintenance
+ * is elided and the numbers isolate descriptor and doorbell cost.
+ */
+
+#include <string.h>
+#include "doorbell_test.h"
+#include "../drivers/axi_dma_driver.h"
+#include "../drivers/axi_cdma_driver.h"
+#include "../drivers/axi_mcdma_driver.h"
+#include "../drivers/dma_ops.h"
+#include "../utils/dma_buf.h"
+#include "../utils/timer_utils.h"
+#include "../utils/memory_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define DOORBELL_XFER_SIZE      KB(4)
+#define DOORBELL_BDS_PER_POINT  2048        /* Descriptors timed per K */
+#define DOORBELL_MIN_ROUNDS     8
+#define DOORBELL_PLATEAU_PCT    95          /* Within 5% of the best rate */
+#define DOORBELL_SPAN           ((uint32_t)(MAX_SG_DESCRIPTORS * DOORBELL_XFER_SIZE))
+
+static const uint32_t g_DoorbellBatches[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+
+static DmaXfer_t g_DoorbellXfers[MAX_SG_DESCRIPTORS];
+static uint64_t g_DoorbellSrc;
+static uint64_t g_DoorbellDst;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int doorbell_submit(DmaType_t dma_type, uint32_t channel, uint32_t batch,
+                           bool doorbell_per_bd)
+{
+    switch (dma_type) {
+        case DMA_TYPE_AXI_DMA:
+            return axi_dma_sg_transfer_batch(g_DoorbellXfers, batch, doorbell_per_bd);
+        case DMA_TYPE_AXI_CDMA:
+            return axi_cdma_sg_transfer_batch(g_DoorbellXfers, batch, doorbell_per_bd);
+        case DMA_TYPE_AXI_MCDMA:
+            return axi_mcdma_transfer_batch(channel, g_DoorbellXfers, batch, doorbell_per_bd);
+        default:
+            return DMA_ERROR_NOT_SUPPORTED;
+    }
+}
+
+/* Total ns for rounds of K-descriptor chains; submit-only ns in *submit_ns */
+static int doorbell_time(const DmaOps_t* ops, uint32_t channel, uint32_t batch,
+                         uint32_t rounds, bool doorbell_per_bd,
+                         uint64_t* total_ns, uint64_t* submit_ns)
+{
+    uint64_t start;
+    int status;
+
+    *total_ns = 0;
+    *submit_ns = 0;
+
+    for (uint32_t r = 0; r < rounds; r++) {
+        start = timer_start();
+
+        status = doorbell_submit(ops->type, channel, batch, doorbell_per_bd);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+        *submit_ns += timer_stop_ns(start);
+
+        status = ops->wait(channel, DMA_TIMEOUT_US);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+        *total_ns += timer_stop_ns(start);
+    }
+
+    return DMA_SUCCESS;
+}
+
+/* Returns the number of batch sizes measured */
+static uint32_t doorbell_sweep(DmaType_t dma_type, uint32_t channel)
+{
+    DoorbellResult_t results[ARRAY_SIZE(g_DoorbellBatches)];
+    uint32_t best_mbps = 0;
+    uint32_t plateau = 0;
+    uint32_t count = 0;
+    int status;
+
+    LOG_RESULT("  K    | 1 doorbell (ns/BD) | K doorbells (ns/BD) | Submit (ns/BD) | MB/s\r\n");
+    LOG_RESULT("  -----|--------------------|---------------------|----------------|------\r\n");
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(g_DoorbellBatches) && !g_TestAbort; i++) {
+        DoorbellResult_t* res = &results[count];
+
+        status = doorbell_test_measure(dma_type, channel, g_DoorbellBatches[i], res);
+        if (status != DMA_SUCCESS) {
+            LOG_RESULT("  %4lu | %18s | %19s | %14s | %s\r\n",
+                       (unsigned long)g_DoorbellBatches[i], "---", "---", "---",
+                       (status == DMA_ERROR_NOT_INIT) ? "n/a" : "ERR");
+            break;
+        }
+
+        LOG_RESULT("  %4lu | %18lu | %19lu | %14lu | %lu\r\n",
+                   (unsigned long)res->batch,
+                   (unsigned long)res->single_ns_per_bd,
+                   (unsigned long)res->per_bd_ns_per_bd,
+                   (unsigned long)res->submit_ns_per_bd,
+                   (unsigned long)res->throughput_mbps);
+
+        best_mbps = MAX(best_mbps, res->throughput_mbps);
+        count++;
+    }
+
+    if (count > 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            if ((uint64_t)results[i].throughput_mbps * 100 >=
+                (uint64_t)best_mbps * DOORBELL_PLATEAU_PCT) {
+                plateau = results[i].batch;
+                break;
+            }
+        }
+
+        uint32_t first_ns = results[0].single_ns_per_bd;
+        uint32_t last_ns = results[count - 1].single_ns_per_bd;
+
+        LOG_RESULT("\r\n  Amortized per-BD cost: %lu ns at K=%lu, %lu ns at K=%lu (%lu ns less)\r\n",
+                   (unsigned long)first_ns, (unsigned long)results[0].batch,
+                   (unsigned long)last_ns, (unsigned long)results[count - 1].batch,
+                   (unsigned long)((first_ns > last_ns) ? (first_ns - last_ns) : 0));
+        LOG_RESULT("  Throughput plateau (>= %lu%% of %lu MB/s) from K=%lu\r\n",
+                   (unsigned long)DOORBELL_PLATEAU_PCT, (unsigned long)best_mbps,
+                   (unsigned long)plateau);
+
+        g_BenchmarkStats.tests_run++;
+        g_BenchmarkStats.tests_passed++;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int doorbell_test_measure(DmaType_t dma_type, uint32_t channel, uint32_t batch,
+                          DoorbellResult_t* result)
+{
+    const DmaOps_t* ops = dma_ops_get(dma_type);
+    uint32_t rounds = MAX(DOORBELL_BDS_PER_POINT / batch, DOORBELL_MIN_ROUNDS);
+    uint64_t single_ns, per_bd_ns, submit_ns, unused_ns;
+    uint64_t bds = (uint64_t)rounds * batch;
+    int status;
+
+    if (ops == NULL || result == NULL || batch == 0 || batch > MAX_SG_DESCRIPTORS ||
+        g_DoorbellSrc == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    /* Warmup both paths */
+    status = doorbell_time(ops, channel, batch, 1, false, &single_ns, &submit_ns);
+    if (status == DMA_SUCCESS) {
+        status = doorbell_time(ops, channel, batch, 1, true, &per_bd_ns, &unused_ns);
+    }
+    if (status == DMA_SUCCESS) {
+        status = doorbell_time(ops, channel, batch, rounds, false, &single_ns, &submit_ns);
+    }
+    if (status == DMA_SUCCESS) {
+        status = doorbell_time(ops, channel, batch, rounds, true, &per_bd_ns, &unused_ns);
+    }
+    if (status != DMA_SUCCESS) {
+        ops->reset();
+        return status;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->batch = batch;
+    result->single_ns_per_bd = (uint32_t)(single_ns / bds);
+    result->per_bd_ns_per_bd = (uint32_t)(per_bd_ns / bds);
+    result->submit_ns_per_bd = (uint32_t)(submit_ns / bds);
+    result->throughput_mbps = CALC_THROUGHPUT_MBPS(bds * DOORBELL_XFER_SIZE,
+                                                   MAX(single_ns / 1000, 1));
+
+    g_BenchmarkStats.total_bytes_transferred += bds * DOORBELL_XFER_SIZE * 2;
+    g_BenchmarkStats.total_time_us += (single_ns + per_bd_ns) / 1000;
+    return DMA_SUCCESS;
+}
+
+int doorbell_test_run_all(void)
+{
+    bool saved_tracking = dma_buf_get_tracking();
+    DmaBuf_t* src_buf;
+    DmaBuf_t* dst_buf;
+    DmaCaps_t caps;
+    uint32_t measured = 0;
+    uint32_t first_diff;
+    int status = DMA_SUCCESS;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("           Doorbell Batching (%lu KB per descriptor)\r\n",
+               (unsigned long)(DOORBELL_XFER_SIZE / 1024));
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    g_DoorbellSrc = memory_alloc_dma_buffer(MEM_REGION_DDR4, DOORBELL_SPAN);
+    g_DoorbellDst = memory_alloc_dma_buffer(MEM_REGION_DDR4, DOORBELL_SPAN);
+    if (g_DoorbellSrc == 0 || g_DoorbellDst == 0) {
+        LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        memory_free_dma_buffer(g_DoorbellSrc);
+        memory_free_dma_buffer(g_DoorbellDst);
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < MAX_SG_DESCRIPTORS; i++) {
+        g_DoorbellXfers[i].src_addr = g_DoorbellSrc + (uint64_t)i * DOORBELL_XFER_SIZE;
+        g_DoorbellXfers[i].dst_addr = g_DoorbellDst + (uint64_t)i * DOORBELL_XFER_SIZE;
+        g_DoorbellXfers[i].length = DOORBELL_XFER_SIZE;
+    }
+
+    pattern_fill((void*)(uintptr_t)g_DoorbellSrc, DOORBELL_SPAN, PATTERN_INCREMENTAL, 0);
+    memset((void*)(uintptr_t)g_DoorbellDst, 0, DOORBELL_SPAN);
+
+    /* Hand both spans to the device once; per-BD syncs are then elided */
+    dma_buf_set_tracking(true);
+    src_buf = dma_buf_register(g_DoorbellSrc, DOORBELL_SPAN);
+    dst_buf = dma_buf_register(g_DoorbellDst, DOORBELL_SPAN);
+    dma_buf_sync_for_device(g_DoorbellSrc, DOORBELL_SPAN, DMA_DIR_TO_DEVICE);
+    dma_buf_sync_for_device(g_DoorbellDst, DOORBELL_SPAN, DMA_DIR_FROM_DEVICE);
+
+    LOG_RESULT("AXI DMA (loopback):\r\n\r\n");
+    measured += doorbell_sweep(DMA_TYPE_AXI_DMA, 0);
+
+    LOG_RESULT("\r\nAXI CDMA:\r\n\r\n");
+    measured += doorbell_sweep(DMA_TYPE_AXI_CDMA, 0);
+
+    if (dma_ops_get_caps(DMA_TYPE_AXI_MCDMA, &caps) == DMA_SUCCESS) {
+        const DmaOps_t* ops = dma_ops_get(DMA_TYPE_AXI_MCDMA);
+
+        for (uint32_t ch = 0; ch < caps.num_channels && !g_TestAbort; ch++) {
+            LOG_RESULT("\r\nAXI MCDMA channel %lu:\r\n\r\n", (unsigned long)ch);
+            if (ops->open_channel(ch) != DMA_SUCCESS) {
+                LOG_RESULT("  Channel unavailable\r\n");
+                continue;
+            }
+            measured += doorbell_sweep(DMA_TYPE_AXI_MCDMA, ch);
+            ops->close_channel(ch);
+        }
+    }
+
+    /* Every chain copied the same spans: check the last result */
+    dma_buf_sync_for_cpu(g_DoorbellDst, DOORBELL_SPAN, DMA_DIR_FROM_DEVICE);
+    dma_buf_sync_for_cpu(g_DoorbellSrc, DOORBELL_SPAN, DMA_DIR_TO_DEVICE);
+    if (measured > 0 &&
+        !memory_compare((void*)(uintptr_t)g_DoorbellDst, (void*)(uintptr_t)g_DoorbellSrc,
+                        DOORBELL_SPAN, &first_diff)) {
+        LOG_RESULT("\r\n  Data verification FAILED at offset 0x%08lX\r\n",
+                   (unsigned long)first_diff);
+        status = DMA_ERROR_VERIFY_FAIL;
+    }
+
+    dma_buf_unregister(src_buf);
+    dma_buf_unregister(dst_buf);
+    dma_buf_set_tracking(saved_tracking);
+    memory_free_dma_buffer(g_DoorbellSrc);
+    memory_free_dma_buffer(g_DoorbellDst);
+
+    LOG_RESULT("\r\n");
+    return status;
+}
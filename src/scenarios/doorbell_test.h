@@ -0,0 +1,39 @@
+/**
+ * @file doorbell_test.h
+ * @brief Doorbell Batching Test Header
+ */
+
+#ifndef DOORBELL_TEST_H
+#define DOORBELL_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Result of one doorbell-batching measurement
+ */
+typedef struct {
+    uint32_t batch;             /* Descriptors (K) per submission */
+    uint32_t single_ns_per_bd;  /* End-to-end per BD, one tail write per K */
+    uint32_t per_bd_ns_per_bd;  /* End-to-end per BD, one tail write per BD */
+    uint32_t submit_ns_per_bd;  /* CPU submit cost per BD, one tail write */
+    uint32_t throughput_mbps;   /* Data rate with one tail write */
+} DoorbellResult_t;
+
+/**
+ * @brief Sweep K = 1..256 on AXI DMA, AXI CDMA and every MCDMA channel
+ * @return 0 on success, negative error code on failure
+ */
+int doorbell_test_run_all(void);
+
+/**
+ * @brief Measure one batch size on one engine channel
+ * @param dma_type DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA or DMA_TYPE_AXI_MCDMA
+ * @param channel Channel (MCDMA only, 0 otherwise)
+ * @param batch Descriptors per submission (1..MAX_SG_DESCRIPTORS)
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int doorbell_test_measure(DmaType_t dma_type, uint32_t channel, uint32_t batch,
+                          DoorbellResult_t* result);
+
+#endif /* DOORBELL_TEST_H */
@@ -0,0 +1,444 @@
+/**
+ * @file dram_test.c
+ * @brief Full-Memory DRAM Test and Scrub Implementation
+ *
+ * The window is walked in 4MB chunks, each striped over every engine
+ * channel that can reach it (dma_stripe). A pattern pass first writes
+ * every chunk from a set of pattern sources, then copies each chunk back
+ * into one of two staging buffers; the CPU compares chunk n-1 while the
+ * engines fetch chunk n. Pass p picks chunk n's source by the p-th octal
+ * digit of n, with one pass per digit of the highest chunk index, so any
+ * two chunks differ in at least one pass and an aliased or stuck address
+ * bit anywhere in the window reads back wrong. Odd passes write the
+ * complemented sources and there are at least two passes, so every bit
+ * is written both ways.
+ *
+ * A scrub pass copies each chunk to staging and back, touching every line
+ * without changing the contents.
+ *
+ * Buffers and the tested ranges are registered with dma_buf and handed to
+ * the device once, so the only cache maintenance per chunk is the
+ * invalidate the CPU needs to read a staging buffer.
+ */
+
+#include <string.h>
+#include "dram_test.h"
+#include "../drivers/dma_stripe.h"
+#include "../utils/memory_utils.h"
+#include "../utils/dma_buf.h"
+#include "../utils/timer_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define DRAM_CHUNK_SIZE             MB(4)
+#define DRAM_NUM_SOURCES            8
+#define DRAM_MIN_PASSES             2           /* Patterns, then complements */
+#define DRAM_SOURCE_SPAN            ((uint32_t)(DRAM_NUM_SOURCES * DRAM_CHUNK_SIZE))
+#define DRAM_MAX_FAILED_XFERS       8
+#define DRAM_SEED                   0x4D454D54
+
+typedef struct {
+    uint64_t base;
+    uint64_t size;
+} DramRange_t;
+
+static const DmaType_t g_DramEngines[] = {
+    DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA
+};
+
+/*
+ * Low window: the image, heap and stacks sit below the DDR4 test region,
+ * the region arenas inside it, and the attribute pools have their own
+ * mapping; everything else is tested.
+ */
+#define DRAM_LOW_ARENA_END          (LPDDR4_TEST_REGION_BASE + LPDDR4_TEST_REGION_SIZE)
+#define DRAM_LOW_POOL_END           (DMA_POOL_REGION_BASE + DMA_POOL_REGION_SIZE)
+#define DRAM_HIGH_ARENA_END         (DDR_HIGH_TEST_REGION_BASE + DDR_HIGH_TEST_REGION_SIZE)
+
+static const DramRange_t g_DramLowRanges[] = {
+    { DRAM_LOW_ARENA_END, DMA_POOL_REGION_BASE - DRAM_LOW_ARENA_END },
+    { DRAM_LOW_POOL_END,  LPDDR4_BASE_ADDR + LPDDR4_SIZE - DRAM_LOW_POOL_END }
+};
+
+/* High window: all but the DDR_HIGH region arena */
+static const DramRange_t g_DramHighRanges[] = {
+    { DDR_HIGH_BASE_ADDR,  DDR_HIGH_TEST_REGION_BASE - DDR_HIGH_BASE_ADDR },
+    { DRAM_HIGH_ARENA_END, DDR_HIGH_BASE_ADDR + DDR_HIGH_SIZE - DRAM_HIGH_ARENA_END }
+};
+
+static const char* const g_DramModeNames[DRAM_TEST_MODE_COUNT] = {
+    [DRAM_TEST_MODE_PATTERN] = "pattern",
+    [DRAM_TEST_MODE_SCRUB]   = "scrub"
+};
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static DmaStripe_t g_DramStripe;
+static const DramRange_t* g_DramRanges;
+static uint32_t g_DramNumRanges;
+static uint32_t g_DramNumChunks;
+static uint32_t g_DramNumPasses;
+static uint64_t g_DramSources;
+static uint64_t g_DramStaging[2];
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint64_t dram_chunk_addr(uint32_t n)
+{
+    for (uint32_t r = 0; r < g_DramNumRanges; r++) {
+        uint32_t chunks = (uint32_t)(g_DramRanges[r].size / DRAM_CHUNK_SIZE);
+
+        if (n < chunks) {
+            return g_DramRanges[r].base + (uint64_t)n * DRAM_CHUNK_SIZE;
+        }
+        n -= chunks;
+    }
+    return 0;
+}
+
+/* Source for chunk n in a pass: the pass-th octal digit of n */
+static uint64_t dram_source(uint32_t pass, uint32_t n)
+{
+    uint32_t k = n;
+
+    for (uint32_t p = 0; p < pass; p++) {
+        k /= DRAM_NUM_SOURCES;
+    }
+    k %= DRAM_NUM_SOURCES;
+
+    return g_DramSources + (uint64_t)k * DRAM_CHUNK_SIZE;
+}
+
+/* One pass per octal digit of the highest chunk index, at least two */
+static uint32_t dram_num_passes(uint32_t num_chunks)
+{
+    uint32_t passes = 0;
+
+    for (uint64_t span = 1; span < num_chunks; span *= DRAM_NUM_SOURCES) {
+        passes++;
+    }
+    return MAX(passes, DRAM_MIN_PASSES);
+}
+
+/* Engines whose address width reaches the top of the window */
+static uint32_t dram_engine_mask(uint64_t top)
+{
+    DmaCaps_t caps;
+    uint32_t mask = 0;
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_DramEngines); e++) {
+        if (dma_ops_get_caps(g_DramEngines[e], &caps) == DMA_SUCCESS &&
+            (caps.addr_width >= 64 || (top >> caps.addr_width) == 0)) {
+            mask |= DMA_STRIPE_ENGINE(g_DramEngines[e]);
+        }
+    }
+    return mask;
+}
+
+static void dram_record_error(DramTestResult_t* result, uint64_t addr)
+{
+    if (result->num_errors < DRAM_TEST_MAX_ERRORS) {
+        result->error_addr[result->num_errors++] = addr;
+    }
+}
+
+/* Returns false once too many transfers have failed to carry on */
+static bool dram_xfer_failed(DramTestResult_t* result, uint64_t chunk)
+{
+    result->failed_transfers++;
+    result->error_chunks++;
+    dram_record_error(result, chunk);
+    return result->failed_transfers < DRAM_MAX_FAILED_XFERS;
+}
+
+static void dram_fill_sources(uint32_t pass)
+{
+    uint64_t* words = (uint64_t*)(uintptr_t)g_DramSources;
+
+    dma_buf_sync_for_cpu(g_DramSources, DRAM_SOURCE_SPAN, DMA_DIR_TO_DEVICE);
+    for (uint32_t k = 0; k < DRAM_NUM_SOURCES; k++) {
+        pattern_fill((void*)(uintptr_t)(g_DramSources + (uint64_t)k * DRAM_CHUNK_SIZE),
+                     DRAM_CHUNK_SIZE, PATTERN_RANDOM, DRAM_SEED + pass * DRAM_NUM_SOURCES + k);
+    }
+    if (pass & 1) {
+        for (uint32_t i = 0; i < DRAM_SOURCE_SPAN / sizeof(uint64_t); i++) {
+            words[i] = ~words[i];
+        }
+    }
+    dma_buf_sync_for_device(g_DramSources, DRAM_SOURCE_SPAN, DMA_DIR_TO_DEVICE);
+}
+
+static void dram_verify(uint64_t data, uint64_t expected, uint64_t chunk,
+                        DramTestResult_t* result)
+{
+    const uint64_t* d = (const uint64_t*)(uintptr_t)data;
+    const uint64_t* e = (const uint64_t*)(uintptr_t)expected;
+    uint32_t bad = 0;
+
+    for (uint32_t i = 0; i < DRAM_CHUNK_SIZE / sizeof(uint64_t); i++) {
+        if (d[i] != e[i]) {
+            dram_record_error(result, chunk + (uint64_t)i * sizeof(uint64_t));
+            bad++;
+        }
+    }
+
+    if (bad > 0) {
+        result->error_words += bad;
+        result->error_chunks++;
+    }
+}
+
+static int dram_pattern_pass(uint32_t pass, DramTestResult_t* result)
+{
+    bool prev_ok = false;
+    int status;
+
+    dram_fill_sources(pass);
+
+    /* Write every chunk before reading any back, so an alias is overwritten */
+    for (uint32_t n = 0; n < g_DramNumChunks && !g_TestAbort; n++) {
+        status = dma_stripe_copy(&g_DramStripe, dram_source(pass, n), dram_chunk_addr(n),
+                                 DRAM_CHUNK_SIZE, NULL);
+        if (status != DMA_SUCCESS && !dram_xfer_failed(result, dram_chunk_addr(n))) {
+            return status;
+        }
+    }
+
+    /* Compare chunk n-1 while chunk n is copied into the other staging buffer */
+    for (uint32_t n = 0; n <= g_DramNumChunks && !g_TestAbort; n++) {
+        uint64_t staging = g_DramStaging[n & 1];
+        bool started = false;
+
+        if (n < g_DramNumChunks) {
+            dma_buf_sync_for_device(staging, DRAM_CHUNK_SIZE, DMA_DIR_FROM_DEVICE);
+            status = dma_stripe_start(&g_DramStripe, dram_chunk_addr(n), staging,
+                                      DRAM_CHUNK_SIZE);
+            started = (status == DMA_SUCCESS);
+        }
+
+        if (n > 0 && prev_ok) {
+            dram_verify(g_DramStaging[(n - 1) & 1], dram_source(pass, n - 1),
+                        dram_chunk_addr(n - 1), result);
+        }
+
+        if (n < g_DramNumChunks) {
+            if (started) {
+                status = dma_stripe_finish(&g_DramStripe, NULL);
+            }
+            prev_ok = (status == DMA_SUCCESS);
+            dma_buf_sync_for_cpu(staging, DRAM_CHUNK_SIZE, DMA_DIR_FROM_DEVICE);
+            if (!prev_ok && !dram_xfer_failed(result, dram_chunk_addr(n))) {
+                return status;
+            }
+        }
+    }
+
+    return DMA_SUCCESS;
+}
+
+static int dram_scrub_pass(DramTestResult_t* result)
+{
+    uint64_t staging = g_DramStaging[0];
+    uint64_t chunk;
+    int status;
+
+    dma_buf_sync_for_device(staging, DRAM_CHUNK_SIZE, DMA_DIR_FROM_DEVICE);
+
+    for (uint32_t n = 0; n < g_DramNumChunks && !g_TestAbort; n++) {
+        chunk = dram_chunk_addr(n);
+        status = dma_stripe_copy(&g_DramStripe, chunk, staging, DRAM_CHUNK_SIZE, NULL);
+        if (status == DMA_SUCCESS) {
+            status = dma_stripe_copy(&g_DramStripe, staging, chunk, DRAM_CHUNK_SIZE, NULL);
+        }
+        if (status != DMA_SUCCESS && !dram_xfer_failed(result, chunk)) {
+            return status;
+        }
+    }
+
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int dram_test_run_all(void)
+{
+    static const MemoryRegion_t windows[] = { MEM_REGION_DDR4, MEM_REGION_DDR_HIGH };
+    DramTestResult_t result;
+    uint32_t failures = 0;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("          Full DRAM Test and Scrub (all engines striped)\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    LOG_RESULT("  %lu MB chunks, one pattern pass per octal digit of the chunk index\r\n",
+               (unsigned long)(DRAM_CHUNK_SIZE / MB(1)));
+    LOG_RESULT("  (at least %d), read-back verified while the next chunk is in flight\r\n\r\n",
+               DRAM_MIN_PASSES);
+
+    LOG_RESULT("  Window   | Mode    | Covered (MB) | Of window | Time (ms) | GB/s  | Bad words\r\n");
+    LOG_RESULT("  ---------|---------|--------------|-----------|-----------|-------|----------\r\n");
+
+    for (uint32_t w = 0; w < ARRAY_SIZE(windows) && !g_TestAbort; w++) {
+        if (memory_get_max_size(windows[w]) == 0) {
+            continue;
+        }
+
+        for (uint32_t m = 0; m < DRAM_TEST_MODE_COUNT && !g_TestAbort; m++) {
+            LOG_RESULT("  %-8s | %-7s |", (windows[w] == MEM_REGION_DDR4) ? "low" : "high",
+                       g_DramModeNames[m]);
+
+            status = dram_test_run((DramTestMode_t)m, windows[w], &result);
+            if (status != DMA_SUCCESS) {
+                LOG_RESULT(" %12s | %9s | %9s | %5s | (%d)\r\n", "ERROR", "---", "---", "---",
+                           status);
+                failures++;
+                continue;
+            }
+
+            LOG_RESULT(" %12lu | %8lu%% | %9lu | %2lu.%02lu | %lu%s\r\n",
+                       (unsigned long)(result.bytes_covered / MB(1)),
+                       (unsigned long)CALC_EFFICIENCY(result.bytes_covered, result.window_bytes),
+                       (unsigned long)(result.elapsed_us / 1000),
+                       (unsigned long)(result.bytes_covered / MAX(result.elapsed_us, 1) / 1000),
+                       (unsigned long)((result.bytes_covered / MAX(result.elapsed_us, 1) / 10) % 100),
+                       (unsigned long)result.error_words,
+                       (result.failed_transfers > 0) ? " (transfer errors)" : "");
+
+            if (result.error_chunks > 0) {
+                failures++;
+                for (uint32_t i = 0; i < result.num_errors; i++) {
+                    LOG_RESULT("             error at 0x%09llX\r\n",
+                               (unsigned long long)result.error_addr[i]);
+                }
+                if (result.error_words > result.num_errors) {
+                    LOG_RESULT("             ... %lu bad word(s) in %lu chunk(s)\r\n",
+                               (unsigned long)result.error_words,
+                               (unsigned long)result.error_chunks);
+                }
+            }
+        }
+    }
+
+    LOG_RESULT("\r\n  Of window = tested share; the image, region arenas and\r\n");
+    LOG_RESULT("  attribute pools are left out\r\n\r\n");
+    LOG_RESULT("DRAM test complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int dram_test_run(DramTestMode_t mode, MemoryRegion_t window, DramTestResult_t* result)
+{
+    bool saved_tracking = dma_buf_get_tracking();
+    DmaBuf_t* bufs[5] = { NULL };
+    uint32_t num_bufs = 0;
+    uint64_t start;
+    uint32_t mask;
+    int status;
+
+    if (result == NULL || mode >= DRAM_TEST_MODE_COUNT) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    if (window == MEM_REGION_DDR4) {
+        g_DramRanges = g_DramLowRanges;
+        g_DramNumRanges = ARRAY_SIZE(g_DramLowRanges);
+    } else if (window == MEM_REGION_DDR_HIGH && memory_get_max_size(MEM_REGION_DDR_HIGH) != 0) {
+        g_DramRanges = g_DramHighRanges;
+        g_DramNumRanges = ARRAY_SIZE(g_DramHighRanges);
+    } else {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->window_bytes = (window == MEM_REGION_DDR4) ? LPDDR4_SIZE : DDR_HIGH_SIZE;
+    g_DramNumChunks = 0;
+    for (uint32_t r = 0; r < g_DramNumRanges; r++) {
+        g_DramNumChunks += (uint32_t)(g_DramRanges[r].size / DRAM_CHUNK_SIZE);
+    }
+    g_DramNumPasses = dram_num_passes(g_DramNumChunks);
+
+    mask = dram_engine_mask(g_DramRanges[g_DramNumRanges - 1].base +
+                            g_DramRanges[g_DramNumRanges - 1].size - 1);
+    status = dma_stripe_init(&g_DramStripe, mask);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    g_DramSources = memory_alloc_dma_buffer(MEM_REGION_DDR4, DRAM_SOURCE_SPAN);
+    g_DramStaging[0] = memory_alloc_dma_buffer(MEM_REGION_DDR4, DRAM_CHUNK_SIZE);
+    g_DramStaging[1] = memory_alloc_dma_buffer(MEM_REGION_DDR4, DRAM_CHUNK_SIZE);
+    if (g_DramSources == 0 || g_DramStaging[0] == 0 || g_DramStaging[1] == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    status = dma_stripe_calibrate(&g_DramStripe, g_DramSources, g_DramStaging[0], MB(1));
+    if (status != DMA_SUCCESS) {
+        goto out;
+    }
+
+    /* Hand everything to the device once; per-slice syncs are then elided */
+    dma_buf_set_tracking(true);
+    bufs[num_bufs++] = dma_buf_register(g_DramSources, DRAM_SOURCE_SPAN);
+    bufs[num_bufs++] = dma_buf_register(g_DramStaging[0], DRAM_CHUNK_SIZE);
+    bufs[num_bufs++] = dma_buf_register(g_DramStaging[1], DRAM_CHUNK_SIZE);
+    for (uint32_t r = 0; r < g_DramNumRanges; r++) {
+        bufs[num_bufs] = dma_buf_register(g_DramRanges[r].base, (uint32_t)g_DramRanges[r].size);
+        if (bufs[num_bufs] != NULL) {
+            dma_buf_sync_for_device(g_DramRanges[r].base, (uint32_t)g_DramRanges[r].size,
+                                    DMA_DIR_BIDIRECTIONAL);
+        }
+        num_bufs++;
+    }
+
+    start = timer_start();
+    if (mode == DRAM_TEST_MODE_PATTERN) {
+        for (uint32_t pass = 0; pass < g_DramNumPasses && status == DMA_SUCCESS; pass++) {
+            status = dram_pattern_pass(pass, result);
+        }
+    } else {
+        status = dram_scrub_pass(result);
+    }
+    result->elapsed_us = MAX(timer_stop_us(start), 1);
+
+    if (status == DMA_SUCCESS && g_TestAbort) {
+        status = DMA_ERROR_BUSY;
+    }
+
+    result->bytes_covered = (uint64_t)g_DramNumChunks * DRAM_CHUNK_SIZE;
+    result->coverage_mbps = CALC_THROUGHPUT_MBPS(result->bytes_covered, result->elapsed_us);
+
+    g_BenchmarkStats.tests_run++;
+    if (status == DMA_SUCCESS && result->error_chunks == 0) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+    g_BenchmarkStats.total_bytes_transferred += result->bytes_covered *
+        ((mode == DRAM_TEST_MODE_PATTERN) ? 2 * g_DramNumPasses : 2);
+    g_BenchmarkStats.total_time_us += result->elapsed_us;
+
+    for (uint32_t i = 0; i < num_bufs; i++) {
+        dma_buf_unregister(bufs[i]);
+    }
+    dma_buf_set_tracking(saved_tracking);
+
+out:
+    dma_stripe_deinit(&g_DramStripe);
+    memory_free_dma_buffer(g_DramSources);
+    memory_free_dma_buffer(g_DramStaging[0]);
+    memory_free_dma_buffer(g_DramStaging[1]);
+    g_DramSources = g_DramStaging[0] = g_DramStaging[1] = 0;
+    return status;
+}
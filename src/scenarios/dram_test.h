@@ -0,0 +1,59 @@
+/**
+ * @file dram_test.h
+ * @brief Full-Memory DRAM Test and Scrub Header
+ */
+
+#ifndef DRAM_TEST_H
+#define DRAM_TEST_H
+
+#include "../dma_benchmark.h"
+
+#define DRAM_TEST_MAX_ERRORS    16      /* Error addresses kept per run */
+
+/**
+ * @brief What a run does to each chunk
+ */
+typedef enum {
+    DRAM_TEST_MODE_PATTERN = 0,         /* Write patterns, read back and compare (destructive) */
+    DRAM_TEST_MODE_SCRUB,               /* Read every chunk and write it back unchanged */
+    DRAM_TEST_MODE_COUNT
+} DramTestMode_t;
+
+/**
+ * @brief Result of one window/mode run
+ */
+typedef struct {
+    uint64_t bytes_covered;             /* Bytes of the window tested */
+    uint64_t window_bytes;              /* Size of the whole window */
+    uint64_t elapsed_us;                /* Wall time for every pass */
+    uint32_t coverage_mbps;             /* bytes_covered per second of wall time */
+    uint32_t error_words;               /* 64-bit words that read back wrong */
+    uint32_t error_chunks;
+    uint32_t failed_transfers;
+    uint32_t num_errors;                /* Entries used in error_addr[] */
+    uint64_t error_addr[DRAM_TEST_MAX_ERRORS];
+} DramTestResult_t;
+
+/**
+ * @brief Pattern-test then scrub the low DDR window and, when present,
+ *        the high window, striping every chunk over all engines
+ * @return 0 on success, negative error code on failure
+ */
+int dram_test_run_all(void);
+
+/**
+ * @brief Run one mode over one DDR window
+ *
+ * Ranges holding the running image, the region arenas and the attribute
+ * pools are left out; bytes_covered against window_bytes shows how much
+ * of the window that is.
+ *
+ * @param mode Pattern test or scrub
+ * @param window MEM_REGION_DDR4 (low window) or MEM_REGION_DDR_HIGH
+ * @param result Result output
+ * @return 0 on success (errors are reported in result), negative error
+ *         code if the run could not be completed
+ */
+int dram_test_run(DramTestMode_t mode, MemoryRegion_t window, DramTestResult_t* result);
+
+#endif /* DRAM_TEST_H */
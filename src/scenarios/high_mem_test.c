@@ -0,0 +1,275 @@
+/**
+ * @file high_mem_test.c
+ * @brief High DDR Window (above 4GB) Test Implementation
+ *
+ * The DDR behind the NoC is split into a 2GB window at 0 (DDR_LOW0) and a
+ * 2GB window at 0x8_0000_0000 (DDR_LOW1). Buffers in the upper window need
+ * the engines' address MSB registers and descriptor words and take a
+ * different NoC route, so every engine copies low->low, low->high,
+ * high->low, high->high and alternating low/high, and the high->high rate
+ * is reported against the low->low reference.
+ */
+
+#include <string.h>
+#include "high_mem_test.h"
+#include "../drivers/dma_ops.h"
+#include "../utils/memory_utils.h"
+#include "../utils/cache_utils.h"
+#include "../utils/timer_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define HIGH_MEM_BYTES_PER_POINT    MB(32)
+#define HIGH_MEM_MIN_ITERATIONS     8
+#define HIGH_MEM_MAX_ITERATIONS     1000
+#define HIGH_MEM_WARMUP             2
+#define HIGH_MEM_SEED               0x4D454D48
+
+static const DmaType_t g_HighMemEngines[] = {
+    DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA,
+    DMA_TYPE_CPU_MEMCPY
+};
+
+static const uint32_t g_HighMemSizes[] = { KB(4), KB(64), MB(1), MB(4) };
+
+static const char* const g_PlacementNames[HIGH_MEM_PLACEMENT_COUNT] = {
+    [HIGH_MEM_LOW_TO_LOW]   = "low->low",
+    [HIGH_MEM_LOW_TO_HIGH]  = "low->high",
+    [HIGH_MEM_HIGH_TO_LOW]  = "high->low",
+    [HIGH_MEM_HIGH_TO_HIGH] = "high->high",
+    [HIGH_MEM_INTERLEAVED]  = "interleaved"
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Whether an engine's address width covers the whole high test area */
+static bool high_mem_reachable(const DmaCaps_t* caps)
+{
+    uint64_t top = DDR_HIGH_TEST_REGION_BASE + DDR_HIGH_TEST_REGION_SIZE - 1;
+
+    return caps->addr_width >= 64 || (top >> caps->addr_width) == 0;
+}
+
+/* Source and destination of iteration i */
+static void high_mem_pick(HighMemPlacement_t placement, uint32_t i,
+                          const uint64_t low[2], const uint64_t high[2],
+                          uint64_t* src, uint64_t* dst)
+{
+    bool src_high, dst_high;
+
+    switch (placement) {
+        case HIGH_MEM_LOW_TO_HIGH:  src_high = false; dst_high = true;  break;
+        case HIGH_MEM_HIGH_TO_LOW:  src_high = true;  dst_high = false; break;
+        case HIGH_MEM_HIGH_TO_HIGH: src_high = true;  dst_high = true;  break;
+        case HIGH_MEM_INTERLEAVED:  src_high = (i & 1); dst_high = !(i & 1); break;
+        default:                    src_high = false; dst_high = false; break;
+    }
+
+    *src = src_high ? high[0] : low[0];
+    *dst = dst_high ? high[1] : low[1];
+}
+
+static bool high_mem_verify(uint64_t dst, uint32_t size, bool needs_cache_maint)
+{
+    if (needs_cache_maint) {
+        cache_complete_dma_dst(dst, size);
+    }
+    return pattern_verify((void*)(uintptr_t)dst, size, PATTERN_RANDOM, HIGH_MEM_SEED,
+                          NULL, NULL, NULL);
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int high_mem_test_run_all(void)
+{
+    HighMemResult_t results[HIGH_MEM_PLACEMENT_COUNT];
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    uint32_t failures = 0;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("          High DDR Window (DDR_LOW1 above 4GB) vs Low\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    if (memory_get_max_size(MEM_REGION_DDR_HIGH) == 0) {
+        LOG_RESULT("  High DDR window not available\r\n");
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    LOG_RESULT("  Low test area:  0x%09llX (+%lu MB)\r\n",
+               (unsigned long long)DDR4_TEST_REGION_BASE,
+               (unsigned long)(DDR4_TEST_REGION_SIZE / MB(1)));
+    LOG_RESULT("  High test area: 0x%09llX (+%lu MB)\r\n\r\n",
+               (unsigned long long)DDR_HIGH_TEST_REGION_BASE,
+               (unsigned long)(DDR_HIGH_TEST_REGION_SIZE / MB(1)));
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_HighMemEngines) && !g_TestAbort; e++) {
+        ops = dma_ops_get(g_HighMemEngines[e]);
+        if (ops == NULL || dma_ops_get_caps(g_HighMemEngines[e], &caps) != DMA_SUCCESS) {
+            continue;
+        }
+
+        LOG_RESULT("%s (%lu-bit addressing), MB/s:\r\n\r\n", ops->name,
+                   (unsigned long)caps.addr_width);
+        if (!high_mem_reachable(&caps)) {
+            LOG_RESULT("  Cannot reach the high window\r\n\r\n");
+            continue;
+        }
+
+        LOG_RESULT("  Size   |");
+        for (uint32_t p = 0; p < HIGH_MEM_PLACEMENT_COUNT; p++) {
+            LOG_RESULT(" %11s |", g_PlacementNames[p]);
+        }
+        LOG_RESULT(" High/low\r\n");
+        LOG_RESULT("  -------|-------------|-------------|-------------|-------------|-------------|---------\r\n");
+
+        for (uint32_t s = 0; s < ARRAY_SIZE(g_HighMemSizes) && !g_TestAbort; s++) {
+            uint32_t size = g_HighMemSizes[s];
+
+            if (size > caps.max_transfer_len) {
+                continue;
+            }
+
+            LOG_RESULT("  %5luK |", (unsigned long)(size / 1024));
+            for (uint32_t p = 0; p < HIGH_MEM_PLACEMENT_COUNT; p++) {
+                status = high_mem_test_measure(g_HighMemEngines[e], (HighMemPlacement_t)p,
+                                               size, &results[p]);
+                if (status != DMA_SUCCESS) {
+                    memset(&results[p], 0, sizeof(results[p]));
+                    LOG_RESULT(" %11s |", "ERROR");
+                    failures++;
+                    continue;
+                }
+                if (!results[p].data_integrity) {
+                    failures++;
+                }
+                LOG_RESULT(" %10lu%s |", (unsigned long)results[p].throughput_mbps,
+                           results[p].data_integrity ? " " : "!");
+            }
+            LOG_RESULT(" %7lu%%\r\n",
+                       (unsigned long)CALC_EFFICIENCY(results[HIGH_MEM_HIGH_TO_HIGH].throughput_mbps,
+                                                      results[HIGH_MEM_LOW_TO_LOW].throughput_mbps));
+        }
+        LOG_RESULT("\r\n");
+    }
+
+    LOG_RESULT("  '!' = data verification failed\r\n\r\n");
+    LOG_RESULT("High DDR window test complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int high_mem_test_measure(DmaType_t dma_type, HighMemPlacement_t placement,
+                          uint32_t size, HighMemResult_t* result)
+{
+    const DmaOps_t* ops = dma_ops_get(dma_type);
+    uint64_t low[2], high[2];
+    uint64_t src, dst, start, elapsed_ns;
+    uint32_t iterations, i;
+    DmaCaps_t caps;
+    bool use_sg;
+    int status;
+
+    if (result == NULL || size == 0 || placement >= HIGH_MEM_PLACEMENT_COUNT) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (ops == NULL || dma_ops_get_caps(dma_type, &caps) != DMA_SUCCESS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    if (size > caps.max_transfer_len || !high_mem_reachable(&caps)) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    use_sg = !caps.has_simple;
+
+    low[0] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    low[1] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    high[0] = memory_alloc_dma_buffer(MEM_REGION_DDR_HIGH, size);
+    high[1] = memory_alloc_dma_buffer(MEM_REGION_DDR_HIGH, size);
+    if (low[0] == 0 || low[1] == 0 || high[0] == 0 || high[1] == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    /* Both sources hold the same data, so any destination checks the same */
+    pattern_fill((void*)(uintptr_t)low[0], size, PATTERN_RANDOM, HIGH_MEM_SEED);
+    pattern_fill((void*)(uintptr_t)high[0], size, PATTERN_RANDOM, HIGH_MEM_SEED);
+    memset((void*)(uintptr_t)low[1], 0, size);
+    memset((void*)(uintptr_t)high[1], 0, size);
+
+    iterations = MIN(MAX(HIGH_MEM_BYTES_PER_POINT / size, HIGH_MEM_MIN_ITERATIONS),
+                     HIGH_MEM_MAX_ITERATIONS);
+
+    if (ops->open_channel != NULL) {
+        status = ops->open_channel(0);
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+    }
+
+    for (i = 0; i < HIGH_MEM_WARMUP; i++) {
+        high_mem_pick(placement, i, low, high, &src, &dst);
+        status = dma_ops_transfer(ops, 0, src, dst, size, use_sg);
+        if (status != DMA_SUCCESS) {
+            goto close;
+        }
+    }
+
+    start = timer_start();
+    for (i = 0; i < iterations; i++) {
+        high_mem_pick(placement, i, low, high, &src, &dst);
+        status = dma_ops_transfer(ops, 0, src, dst, size, use_sg);
+        if (status != DMA_SUCCESS) {
+            goto close;
+        }
+    }
+    elapsed_ns = timer_stop_ns(start);
+
+    memset(result, 0, sizeof(*result));
+    result->iterations = iterations;
+    result->avg_latency_ns = (uint32_t)(elapsed_ns / iterations);
+    result->throughput_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * iterations,
+                                                   MAX(elapsed_ns / 1000, 1));
+
+    /* Interleaved runs wrote both windows */
+    high_mem_pick(placement, 0, low, high, &src, &dst);
+    result->data_integrity = high_mem_verify(dst, size, caps.needs_cache_maint);
+    if (placement == HIGH_MEM_INTERLEAVED) {
+        high_mem_pick(placement, 1, low, high, &src, &dst);
+        result->data_integrity = result->data_integrity &&
+                                 high_mem_verify(dst, size, caps.needs_cache_maint);
+    }
+
+    g_BenchmarkStats.tests_run++;
+    if (result->data_integrity) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+    g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * iterations;
+    g_BenchmarkStats.total_time_us += elapsed_ns / 1000;
+
+close:
+    if (ops->close_channel != NULL) {
+        ops->close_channel(0);
+    }
+out:
+    memory_free_dma_buffer(low[0]);
+    memory_free_dma_buffer(low[1]);
+    memory_free_dma_buffer(high[0]);
+    memory_free_dma_buffer(high[1]);
+    return status;
+}
+
+const char* high_mem_placement_to_string(HighMemPlacement_t placement)
+{
+    return (placement < HIGH_MEM_PLACEMENT_COUNT) ? g_PlacementNames[placement] : "unknown";
+}
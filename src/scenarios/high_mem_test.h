@@ -0,0 +1,57 @@
+/**
+ * @file high_mem_test.h
+ * @brief High DDR Window (above 4GB) Test Header
+ */
+
+#ifndef HIGH_MEM_TEST_H
+#define HIGH_MEM_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Placement of the source and destination buffers
+ */
+typedef enum {
+    HIGH_MEM_LOW_TO_LOW = 0,        /* Reference: both in DDR_LOW0 */
+    HIGH_MEM_LOW_TO_HIGH,
+    HIGH_MEM_HIGH_TO_LOW,
+    HIGH_MEM_HIGH_TO_HIGH,
+    HIGH_MEM_INTERLEAVED,           /* Alternates low->high and high->low */
+    HIGH_MEM_PLACEMENT_COUNT
+} HighMemPlacement_t;
+
+/**
+ * @brief Result of one engine/placement/size measurement
+ */
+typedef struct {
+    uint32_t throughput_mbps;
+    uint32_t avg_latency_ns;        /* Per transfer, including cache maintenance */
+    uint32_t iterations;
+    bool data_integrity;
+} HighMemResult_t;
+
+/**
+ * @brief Compare every engine across the low and high DDR windows
+ * @return 0 on success, negative error code on failure
+ */
+int high_mem_test_run_all(void);
+
+/**
+ * @brief Measure one engine, placement and transfer size
+ * @param dma_type Engine
+ * @param placement Buffer placement
+ * @param size Transfer size in bytes
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int high_mem_test_measure(DmaType_t dma_type, HighMemPlacement_t placement,
+                          uint32_t size, HighMemResult_t* result);
+
+/**
+ * @brief Get placement name
+ * @param placement Placement
+ * @return Name string
+ */
+const char* high_mem_placement_to_string(HighMemPlacement_t placement);
+
+#endif /* HIGH_MEM_TEST_H */
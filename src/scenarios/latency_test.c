@@ -6,9 +6,7 @@
 #include <string.h>
 #include "latency_test.h"
 #include "../utils/debug_print.h"
-#include "../drivers/axi_dma_driver.h"
-#include "../drivers/axi_cdma_driver.h"
-#include "../drivers/lpd_dma_driver.h"
+#include "../drivers/dma_ops.h"
 #include "../utils/timer_utils.h"
 #include "../utils/memory_utils.h"
 #include "../utils/data_patterns.h"
@@ -95,40 +93,42 @@ int latency_test_first_byte(DmaType_t dma_type, TestResult_t* result)
     uint64_t total_ns = 0;
     uint64_t min_ns = UINT64_MAX;
     uint64_t max_ns = 0;
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    bool use_sg;
     int status;
 
+    /* Register mode where available, descriptor mode otherwise */
+    ops = dma_ops_get(dma_type);
+    if (ops == NULL || dma_ops_get_caps(dma_type, &caps) != DMA_SUCCESS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    use_sg = !caps.has_simple;
+
     /* Get test addresses */
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, 0, LATENCY_TEST_SIZE);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, KB(1), LATENCY_TEST_SIZE);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, LATENCY_TEST_SIZE);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, LATENCY_TEST_SIZE);
 
     if (src_addr == 0 || dst_addr == 0) {
-        return DMA_ERROR_INVALID_PARAM;
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
     }
 
     /* Prepare source buffer */
     pattern_fill((void*)(uintptr_t)src_addr, LATENCY_TEST_SIZE, PATTERN_INCREMENTAL, 0);
     cache_prep_dma_src(src_addr, LATENCY_TEST_SIZE);
 
+    if (ops->open_channel != NULL) {
+        status = ops->open_channel(0);
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+    }
+
     /* Warmup */
     for (uint32_t i = 0; i < 10; i++) {
         cache_prep_dma_dst(dst_addr, LATENCY_TEST_SIZE);
-
-        switch (dma_type) {
-            case DMA_TYPE_AXI_DMA:
-                axi_dma_simple_transfer(src_addr, dst_addr, LATENCY_TEST_SIZE);
-                axi_dma_wait_complete(DMA_TIMEOUT_US);
-                break;
-            case DMA_TYPE_AXI_CDMA:
-                axi_cdma_simple_transfer(src_addr, dst_addr, LATENCY_TEST_SIZE);
-                axi_cdma_wait_complete(DMA_TIMEOUT_US);
-                break;
-            case DMA_TYPE_LPD_DMA:
-                lpd_dma_transfer(0, src_addr, dst_addr, LATENCY_TEST_SIZE);
-                lpd_dma_wait_complete(0, DMA_TIMEOUT_US);
-                break;
-            default:
-                return DMA_ERROR_NOT_SUPPORTED;
-        }
+        dma_ops_transfer(ops, 0, src_addr, dst_addr, LATENCY_TEST_SIZE, use_sg);
     }
 
     /* Measure latency */
@@ -137,29 +137,7 @@ int latency_test_first_byte(DmaType_t dma_type, TestResult_t* result)
 
         uint64_t start = timer_start();
 
-        switch (dma_type) {
-            case DMA_TYPE_AXI_DMA:
-                status = axi_dma_simple_transfer(src_addr, dst_addr, LATENCY_TEST_SIZE);
-                if (status == DMA_SUCCESS) {
-                    status = axi_dma_wait_complete(DMA_TIMEOUT_US);
-                }
-                break;
-            case DMA_TYPE_AXI_CDMA:
-                status = axi_cdma_simple_transfer(src_addr, dst_addr, LATENCY_TEST_SIZE);
-                if (status == DMA_SUCCESS) {
-                    status = axi_cdma_wait_complete(DMA_TIMEOUT_US);
-                }
-                break;
-            case DMA_TYPE_LPD_DMA:
-                status = lpd_dma_transfer(0, src_addr, dst_addr, LATENCY_TEST_SIZE);
-                if (status == DMA_SUCCESS) {
-                    status = lpd_dma_wait_complete(0, DMA_TIMEOUT_US);
-                }
-                break;
-            default:
-                status = DMA_ERROR_NOT_SUPPORTED;
-                break;
-        }
+        status = dma_ops_transfer(ops, 0, src_addr, dst_addr, LATENCY_TEST_SIZE, use_sg);
 
         uint64_t elapsed = timer_stop_ns(start);
 
@@ -170,6 +148,10 @@ int latency_test_first_byte(DmaType_t dma_type, TestResult_t* result)
         }
     }
 
+    if (ops->close_channel != NULL) {
+        ops->close_channel(0);
+    }
+
     /* Calculate results */
     result->dma_type = dma_type;
     result->test_type = TEST_LATENCY;
@@ -183,8 +165,12 @@ int latency_test_first_byte(DmaType_t dma_type, TestResult_t* result)
 
     g_BenchmarkStats.tests_run++;
     g_BenchmarkStats.tests_passed++;
+    status = DMA_SUCCESS;
 
-    return DMA_SUCCESS;
+out:
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
 }
 
 double latency_test_setup_time(DmaType_t dma_type)
@@ -192,11 +178,23 @@ double latency_test_setup_time(DmaType_t dma_type)
     uint64_t src_addr, dst_addr;
     uint64_t total_ns = 0;
     uint32_t iterations = 10000;
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    bool use_sg;
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, 0, 64);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, 1024, 64);
+    ops = dma_ops_get(dma_type);
+    if (ops == NULL || dma_ops_get_caps(dma_type, &caps) != DMA_SUCCESS) {
+        return 0.0;
+    }
+    use_sg = !caps.has_simple;
 
-    if (src_addr == 0 || dst_addr == 0) {
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, 64);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, 64);
+
+    if (src_addr == 0 || dst_addr == 0 ||
+        (ops->open_channel != NULL && ops->open_channel(0) != DMA_SUCCESS)) {
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
         return 0.0;
     }
 
@@ -204,40 +202,23 @@ double latency_test_setup_time(DmaType_t dma_type)
     for (uint32_t i = 0; i < iterations; i++) {
         uint64_t start = timer_start();
 
-        switch (dma_type) {
-            case DMA_TYPE_AXI_DMA:
-                /* Just configure, don't wait */
-                axi_dma_start_rx(dst_addr, 64);
-                axi_dma_start_tx(src_addr, 64);
-                break;
-            case DMA_TYPE_AXI_CDMA:
-                axi_cdma_simple_transfer(src_addr, dst_addr, 64);
-                break;
-            case DMA_TYPE_LPD_DMA:
-                lpd_dma_transfer(0, src_addr, dst_addr, 64);
-                break;
-            default:
-                return 0.0;
+        /* Just configure, don't wait */
+        if (ops->submit(0, src_addr, dst_addr, 64, use_sg) != DMA_SUCCESS) {
+            break;
         }
 
         total_ns += timer_stop_ns(start);
 
         /* Wait for completion before next iteration */
-        switch (dma_type) {
-            case DMA_TYPE_AXI_DMA:
-                axi_dma_wait_complete(DMA_TIMEOUT_US);
-                break;
-            case DMA_TYPE_AXI_CDMA:
-                axi_cdma_wait_complete(DMA_TIMEOUT_US);
-                break;
-            case DMA_TYPE_LPD_DMA:
-                lpd_dma_wait_complete(0, DMA_TIMEOUT_US);
-                break;
-            default:
-                break;
-        }
+        ops->wait(0, DMA_TIMEOUT_US);
+    }
+
+    if (ops->close_channel != NULL) {
+        ops->close_channel(0);
     }
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return (double)total_ns / iterations / 1000.0;  /* ns to us */
 }
 
@@ -0,0 +1,39 @@
+/**
+ * @file mem_attr_test.h
+ * @brief Memory Attribute Comparison Test Header
+ */
+
+#ifndef MEM_ATTR_TEST_H
+#define MEM_ATTR_TEST_H
+
+#include "../dma_benchmark.h"
+#include "../utils/dma_pool.h"
+
+/**
+ * @brief Result of one pool/size measurement (averages per iteration)
+ */
+typedef struct {
+    uint32_t fill_mbps;         /* CPU pattern fill of the source */
+    uint32_t verify_mbps;       /* CPU pattern check of the destination */
+    uint32_t dma_ns;            /* Cache maintenance + CDMA copy */
+    uint32_t full_ns;           /* Fill + DMA + verify */
+    uint32_t sparse_ns;         /* One word written/read per 4KB + DMA */
+} MemAttrResult_t;
+
+/**
+ * @brief Compare cacheable, non-cacheable and write-combining pools over a
+ *        range of sizes
+ * @return 0 on success, negative error code on failure
+ */
+int mem_attr_test_run_all(void);
+
+/**
+ * @brief Measure one pool type and size (the pool must be created)
+ * @param type Pool type
+ * @param size Transfer size in bytes
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int mem_attr_test_measure(DmaPoolType_t type, uint32_t size, MemAttrResult_t* result);
+
+#endif /* MEM_ATTR_TEST_H */
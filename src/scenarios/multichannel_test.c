@@ -8,6 +8,7 @@
 #include "../utils/debug_print.h"
 #include "../drivers/axi_mcdma_driver.h"
 #include "../drivers/lpd_dma_driver.h"
+#include "../drivers/dma_stripe.h"
 #include "../utils/timer_utils.h"
 #include "../utils/memory_utils.h"
 #include "../utils/data_patterns.h"
@@ -42,6 +43,10 @@ int multichannel_test_run_all(void)
     LOG_RESULT("\r\n4. Channel Fairness Test:\r\n\r\n");
     multichannel_test_fairness();
 
+    /* Striping across every engine */
+    LOG_RESULT("\r\n5. Heterogeneous Engine Striping:\r\n\r\n");
+    multichannel_test_stripe();
+
     LOG_RESULT("\r\nMulti-channel tests complete.\r\n");
     return DMA_SUCCESS;
 }
@@ -156,15 +161,19 @@ int multichannel_test_concurrent_dma(void)
     uint32_t iterations = 50;
 
     /* Setup addresses for MCDMA */
-    uint64_t mcdma_src = memory_get_test_addr(MEM_REGION_DDR4, MB(64), size);
-    uint64_t mcdma_dst = memory_get_test_addr(MEM_REGION_DDR4, MB(65), size);
+    uint64_t mcdma_src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t mcdma_dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
     /* Setup addresses for LPD DMA */
-    uint64_t lpd_src = memory_get_test_addr(MEM_REGION_DDR4, MB(66), size);
-    uint64_t lpd_dst = memory_get_test_addr(MEM_REGION_DDR4, MB(67), size);
+    uint64_t lpd_src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t lpd_dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
     if (!mcdma_src || !mcdma_dst || !lpd_src || !lpd_dst) {
         LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        memory_free_dma_buffer(mcdma_src);
+        memory_free_dma_buffer(mcdma_dst);
+        memory_free_dma_buffer(lpd_src);
+        memory_free_dma_buffer(lpd_dst);
         return DMA_ERROR_NO_MEMORY;
     }
 
@@ -224,6 +233,10 @@ int multichannel_test_concurrent_dma(void)
     g_BenchmarkStats.tests_passed++;
     g_BenchmarkStats.total_bytes_transferred += total_bytes;
 
+    memory_free_dma_buffer(mcdma_src);
+    memory_free_dma_buffer(mcdma_dst);
+    memory_free_dma_buffer(lpd_src);
+    memory_free_dma_buffer(lpd_dst);
     return DMA_SUCCESS;
 }
 
@@ -248,8 +261,16 @@ int multichannel_test_fairness(void)
     /* Prepare per-channel buffers */
     uint64_t src_addrs[4], dst_addrs[4];
     for (uint32_t ch = 0; ch < num_channels; ch++) {
-        src_addrs[ch] = memory_get_test_addr(MEM_REGION_DDR4, MB(80) + ch * size * 4, size);
-        dst_addrs[ch] = memory_get_test_addr(MEM_REGION_DDR4, MB(80) + ch * size * 4 + size * 2, size);
+        src_addrs[ch] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        dst_addrs[ch] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        if (src_addrs[ch] == 0 || dst_addrs[ch] == 0) {
+            LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+            for (uint32_t c = 0; c <= ch; c++) {
+                memory_free_dma_buffer(src_addrs[c]);
+                memory_free_dma_buffer(dst_addrs[c]);
+            }
+            return DMA_ERROR_NO_MEMORY;
+        }
         pattern_fill((void*)(uintptr_t)src_addrs[ch], size, PATTERN_INCREMENTAL, ch);
         cache_prep_dma_src(src_addrs[ch], size);
     }
@@ -295,10 +316,12 @@ int multichannel_test_fairness(void)
     LOG_RESULT("\r\n  Average: %.2f MB/s\r\n", avg_tp);
     LOG_RESULT("  Fairness: Good if all deviations are within +/-10%%\r\n");
 
-    /* Disable channels */
+    /* Disable channels and release buffers */
     for (uint32_t ch = 0; ch < num_channels; ch++) {
         axi_mcdma_disable_mm2s_channel(ch);
         axi_mcdma_disable_s2mm_channel(ch);
+        memory_free_dma_buffer(src_addrs[ch]);
+        memory_free_dma_buffer(dst_addrs[ch]);
     }
 
     g_BenchmarkStats.tests_run++;
@@ -306,3 +329,95 @@ int multichannel_test_fairness(void)
 
     return DMA_SUCCESS;
 }
+
+int multichannel_test_stripe(void)
+{
+    const uint64_t size = MB(32);
+    const uint32_t rounds = 8;
+    DmaStripe_t stripe;
+    DmaStripeResult_t result;
+    uint32_t error_offset;
+    int status;
+
+    uint64_t src = memory_alloc_dma_buffer(MEM_REGION_DDR4, (uint32_t)size);
+    uint64_t dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, (uint32_t)size);
+
+    if (!src || !dst) {
+        LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    status = dma_stripe_init(&stripe, DMA_STRIPE_ENGINES_DEFAULT);
+    if (status != DMA_SUCCESS) {
+        LOG_RESULT("  ERROR: No DMA engine available for striping\r\n");
+        goto out;
+    }
+
+    pattern_fill((void*)(uintptr_t)src, (uint32_t)size, PATTERN_INCREMENTAL, 0);
+    cache_prep_dma_src(src, (uint32_t)size);
+
+    /* Solo bandwidth of every lane seeds the slice sizes */
+    status = dma_stripe_calibrate(&stripe, src, dst, (uint32_t)MB(1));
+    if (status != DMA_SUCCESS) {
+        LOG_RESULT("  ERROR: Calibration failed on every lane\r\n");
+        dma_stripe_deinit(&stripe);
+        goto out;
+    }
+
+    LOG_RESULT("  %lu lanes, %lu MB copy, calibrated weights:\r\n\r\n",
+               (unsigned long)stripe.num_lanes, (unsigned long)(size / MB(1)));
+    dma_stripe_print_lanes(&stripe);
+
+    LOG_RESULT("\r\n  Round | Lanes | Aggregate (GB/s) | Elapsed (us) | Straggler (us)\r\n");
+    LOG_RESULT("  ------|-------|------------------|--------------|---------------\r\n");
+
+    for (uint32_t r = 0; r < rounds && !g_TestAbort; r++) {
+        memset((void*)(uintptr_t)dst, 0, (size_t)size);
+        cache_prep_dma_dst(dst, (uint32_t)size);
+
+        status = dma_stripe_copy(&stripe, src, dst, size, &result);
+        if (status != DMA_SUCCESS) {
+            LOG_RESULT("  %5lu | %5s | %16s | %12s | %s\r\n",
+                       (unsigned long)(r + 1), "---", "ERROR", "---", "---");
+            break;
+        }
+
+        LOG_RESULT("  %5lu | %5lu | %12lu.%03lu | %12lu | %14lu\r\n",
+                   (unsigned long)(r + 1), (unsigned long)result.lanes_used,
+                   (unsigned long)(result.throughput_mbps / 1024),
+                   (unsigned long)(((result.throughput_mbps % 1024) * 1000) / 1024),
+                   (unsigned long)result.elapsed_us,
+                   (unsigned long)result.straggler_us);
+
+        g_BenchmarkStats.total_bytes_transferred += result.total_bytes;
+        g_BenchmarkStats.total_time_us += result.elapsed_us;
+    }
+
+    if (status == DMA_SUCCESS) {
+        LOG_RESULT("\r\n  After rebalancing:\r\n\r\n");
+        dma_stripe_print_lanes(&stripe);
+
+        cache_complete_dma_dst(dst, (uint32_t)size);
+        if (!pattern_verify((void*)(uintptr_t)dst, (uint32_t)size, PATTERN_INCREMENTAL, 0,
+                            &error_offset, NULL, NULL)) {
+            LOG_RESULT("\r\n  Data verification FAILED at offset 0x%08lX\r\n",
+                       (unsigned long)error_offset);
+            status = DMA_ERROR_VERIFY_FAIL;
+        }
+    }
+
+    dma_stripe_deinit(&stripe);
+
+    g_BenchmarkStats.tests_run++;
+    if (status == DMA_SUCCESS) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+
+out:
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
+    return status;
+}
@@ -38,4 +38,11 @@ int multichannel_test_concurrent_dma(void);
  */
 int multichannel_test_fairness(void);
 
+/**
+ * @brief Split one large copy across CDMA, MCDMA and LPD DMA at once,
+ *        rebalancing slices each round; reports GB/s and straggler gap
+ * @return 0 on success, negative error code on failure
+ */
+int multichannel_test_stripe(void);
+
 #endif /* MULTICHANNEL_TEST_H */
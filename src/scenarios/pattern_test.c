@@ -0,0 +1,241 @@
+/**
+ * @file pattern_test.c
+ * @brief Pattern Fill/Verify Speed Test Implementation
+ *
+ * Fill and verify throughput bound how often a soak test can afford to
+ * check integrity. Both are timed per pattern on an L2-resident buffer and
+ * on a 16MB buffer, next to memset() and memcmp() on the same sizes.
+ * A spot check of small slices at the end of a large buffer then shows
+ * what a counter-based random pattern saves over the sequential one.
+ */
+
+#include <string.h>
+#include "pattern_test.h"
+#include "../utils/memory_utils.h"
+#include "../utils/timer_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/results_logger.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define PATTERN_TEST_BYTES_PER_POINT    MB(256)
+#define PATTERN_TEST_MIN_ITERATIONS     4
+#define PATTERN_TEST_MAX_ITERATIONS     4096
+#define PATTERN_TEST_SEED               0x50415454
+#define PATTERN_TEST_SPOT_BUFFER        MB(16)
+#define PATTERN_TEST_SPOT_SLICE         KB(4)
+#define PATTERN_TEST_SPOT_COUNT         16
+
+static const uint32_t g_PatternTestSizes[] = { KB(256), MB(16) };
+
+static const DataPattern_t g_PatternSpotPatterns[] = { PATTERN_RANDOM, PATTERN_RANDOM_CTR };
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint32_t pattern_test_iterations(uint32_t size)
+{
+    return MIN(MAX(PATTERN_TEST_BYTES_PER_POINT / size, PATTERN_TEST_MIN_ITERATIONS),
+               PATTERN_TEST_MAX_ITERATIONS);
+}
+
+/* MB/s printed as GB/s with two decimals */
+static void pattern_test_print_gbps(uint32_t mbps)
+{
+    LOG_RESULT(" %5lu.%02lu", (unsigned long)(mbps / 1024),
+               (unsigned long)(((mbps % 1024) * 100) / 1024));
+}
+
+/* memset() and memcmp() on the same size, for scale */
+static int pattern_test_reference(uint32_t size, uint32_t* set_mbps, uint32_t* cmp_mbps)
+{
+    uint64_t a = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t b = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint32_t iterations = pattern_test_iterations(size);
+    uint64_t start, elapsed_ns;
+    volatile int sink = 0;
+    int status = DMA_SUCCESS;
+
+    if (a == 0 || b == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    memset((void*)(uintptr_t)b, 0x5A, size);
+    start = timer_start();
+    for (uint32_t i = 0; i < iterations; i++) {
+        memset((void*)(uintptr_t)a, 0x5A, size);
+    }
+    elapsed_ns = timer_stop_ns(start);
+    *set_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * iterations, MAX(elapsed_ns / 1000, 1));
+
+    start = timer_start();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink += memcmp((void*)(uintptr_t)a, (void*)(uintptr_t)b, size);
+    }
+    elapsed_ns = timer_stop_ns(start);
+    *cmp_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * iterations, MAX(elapsed_ns / 1000, 1));
+    (void)sink;
+
+out:
+    memory_free_dma_buffer(a);
+    memory_free_dma_buffer(b);
+    return status;
+}
+
+/* Verify PATTERN_TEST_SPOT_COUNT slices spread over a large buffer */
+static int pattern_test_spot_check(DataPattern_t pattern, uint64_t* elapsed_us, bool* ok)
+{
+    uint64_t buf = memory_alloc_dma_buffer(MEM_REGION_DDR4, PATTERN_TEST_SPOT_BUFFER);
+    uint64_t start, offset;
+
+    if (buf == 0) {
+        return DMA_ERROR_NO_MEMORY;
+    }
+    pattern_fill((void*)(uintptr_t)buf, PATTERN_TEST_SPOT_BUFFER, pattern, PATTERN_TEST_SEED);
+
+    *ok = true;
+    start = timer_start();
+    for (uint32_t i = 0; i < PATTERN_TEST_SPOT_COUNT; i++) {
+        offset = (uint64_t)(i + 1) * (PATTERN_TEST_SPOT_BUFFER / PATTERN_TEST_SPOT_COUNT) -
+                 PATTERN_TEST_SPOT_SLICE;
+        *ok = pattern_verify_range((void*)(uintptr_t)(buf + offset), offset,
+                                   PATTERN_TEST_SPOT_SLICE, pattern, PATTERN_TEST_SEED,
+                                   NULL, NULL, NULL) && *ok;
+    }
+    *elapsed_us = timer_stop_us(start);
+
+    memory_free_dma_buffer(buf);
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int pattern_test_run_all(void)
+{
+    PatternTestResult_t result;
+    uint32_t failures = 0;
+    uint32_t set_mbps, cmp_mbps;
+    uint64_t spot_us;
+    char size_str[16];
+    bool ok;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("          Pattern Fill / Verify Throughput (GB/s)\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    for (uint32_t s = 0; s < ARRAY_SIZE(g_PatternTestSizes) && !g_TestAbort; s++) {
+        uint32_t size = g_PatternTestSizes[s];
+
+        results_logger_format_size(size, size_str, sizeof(size_str));
+        LOG_RESULT("%s buffer:\r\n\r\n", size_str);
+        LOG_RESULT("  Pattern        |   Fill   |  Verify\r\n");
+        LOG_RESULT("  ---------------|----------|----------\r\n");
+
+        for (uint32_t p = 0; p < PATTERN_COUNT && !g_TestAbort; p++) {
+            LOG_RESULT("  %-14s |", pattern_to_string((DataPattern_t)p));
+
+            status = pattern_test_measure((DataPattern_t)p, size, &result);
+            if (status != DMA_SUCCESS) {
+                LOG_RESULT(" %8s |\r\n", "ERROR");
+                failures++;
+                continue;
+            }
+            if (!result.data_integrity) {
+                failures++;
+            }
+            pattern_test_print_gbps(result.fill_mbps);
+            LOG_RESULT(" |");
+            pattern_test_print_gbps(result.verify_mbps);
+            LOG_RESULT("%s\r\n", result.data_integrity ? "" : " !");
+        }
+
+        if (pattern_test_reference(size, &set_mbps, &cmp_mbps) == DMA_SUCCESS) {
+            LOG_RESULT("  %-14s |", "memset/memcmp");
+            pattern_test_print_gbps(set_mbps);
+            LOG_RESULT(" |");
+            pattern_test_print_gbps(cmp_mbps);
+            LOG_RESULT("\r\n");
+        }
+        LOG_RESULT("\r\n");
+    }
+
+    LOG_RESULT("Spot check: %d x %luK slices spread over %luMB\r\n\r\n",
+               PATTERN_TEST_SPOT_COUNT, (unsigned long)(PATTERN_TEST_SPOT_SLICE / 1024),
+               (unsigned long)(PATTERN_TEST_SPOT_BUFFER / MB(1)));
+    LOG_RESULT("  Pattern        | Time (us)\r\n");
+    LOG_RESULT("  ---------------|----------\r\n");
+    for (uint32_t p = 0; p < ARRAY_SIZE(g_PatternSpotPatterns) && !g_TestAbort; p++) {
+        LOG_RESULT("  %-14s |", pattern_to_string(g_PatternSpotPatterns[p]));
+        if (pattern_test_spot_check(g_PatternSpotPatterns[p], &spot_us, &ok) != DMA_SUCCESS) {
+            LOG_RESULT(" %9s\r\n", "ERROR");
+            failures++;
+            continue;
+        }
+        if (!ok) {
+            failures++;
+        }
+        LOG_RESULT(" %9lu%s\r\n", (unsigned long)spot_us, ok ? "" : " !");
+    }
+    LOG_RESULT("\r\n");
+
+    LOG_RESULT("  RANDOM regenerates everything before each slice; RANDOM_CTR does not\r\n");
+    LOG_RESULT("  '!' = data verification failed\r\n\r\n");
+    LOG_RESULT("Pattern throughput test complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int pattern_test_measure(DataPattern_t pattern, uint32_t size, PatternTestResult_t* result)
+{
+    uint64_t buf, start, elapsed_ns;
+    uint32_t iterations, i;
+    bool ok = true;
+
+    if (result == NULL || size == 0 || pattern >= PATTERN_COUNT) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    buf = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (buf == 0) {
+        return DMA_ERROR_NO_MEMORY;
+    }
+    iterations = pattern_test_iterations(size);
+
+    memset(result, 0, sizeof(*result));
+
+    start = timer_start();
+    for (i = 0; i < iterations; i++) {
+        pattern_fill((void*)(uintptr_t)buf, size, pattern, PATTERN_TEST_SEED);
+    }
+    elapsed_ns = timer_stop_ns(start);
+    result->fill_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * iterations,
+                                             MAX(elapsed_ns / 1000, 1));
+
+    start = timer_start();
+    for (i = 0; i < iterations; i++) {
+        ok = pattern_verify((void*)(uintptr_t)buf, size, pattern, PATTERN_TEST_SEED,
+                            NULL, NULL, NULL) && ok;
+    }
+    elapsed_ns = timer_stop_ns(start);
+    result->verify_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * iterations,
+                                               MAX(elapsed_ns / 1000, 1));
+    result->data_integrity = ok;
+
+    g_BenchmarkStats.tests_run++;
+    if (ok) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+
+    memory_free_dma_buffer(buf);
+    return DMA_SUCCESS;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file pattern_test.h
+ * @brief Pattern Fill/Verify Speed Test Header
+ */
+
+#ifndef PATTERN_TEST_H
+#define PATTERN_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Result of one pattern/size measurement
+ */
+typedef struct {
+    uint32_t fill_mbps;
+    uint32_t verify_mbps;
+    bool data_integrity;            /* Every verify pass matched */
+} PatternTestResult_t;
+
+/**
+ * @brief Time pattern_fill() and pattern_verify() for every pattern,
+ *        cache-resident and from DDR
+ * @return 0 on success, negative error code on failure
+ */
+int pattern_test_run_all(void);
+
+/**
+ * @brief Measure one pattern at one buffer size (DDR4 test region)
+ * @param pattern Pattern
+ * @param size Buffer size in bytes
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int pattern_test_measure(DataPattern_t pattern, uint32_t size, PatternTestResult_t* result);
+
+#endif /* PATTERN_TEST_H */
@@ -0,0 +1,266 @@
+/**
+ * @file placement_test.c
+ * @brief Buffer Placement (Bank / Cache Color) Test Implementation
+ *
+ * Sweeps the destination offset relative to the source from 0 to 1MB in
+ * 4KB..1MB steps. Offsets decide whether reads and writes of a copy land in
+ * the same DDR bank (row conflicts) and whether source and destination
+ * lines compete for the same L2 sets. Every point runs several times, so
+ * the run-to-run spread at one placement can be told apart from the spread
+ * across placements.
+ */
+
+#include <string.h>
+#include "placement_test.h"
+#include "../drivers/dma_ops.h"
+#include "../utils/memory_utils.h"
+#include "../utils/cache_utils.h"
+#include "../utils/timer_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define PLACEMENT_BYTES_PER_RUN     MB(16)
+#define PLACEMENT_MIN_ITERATIONS    8
+#define PLACEMENT_MAX_ITERATIONS    1000
+#define PLACEMENT_WARMUP            2
+#define PLACEMENT_RUNS              3
+#define PLACEMENT_SEED              0x434F4C52
+
+static const DmaType_t g_PlacementEngines[] = {
+    DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA,
+    DMA_TYPE_CPU_MEMCPY
+};
+
+static const uint32_t g_PlacementSizes[] = { KB(64), MB(1) };
+
+static const uint64_t g_PlacementOffsets[] = {
+    0, KB(4), KB(8), KB(12), KB(16), KB(24), KB(32), KB(48),
+    KB(64), KB(128), KB(256), KB(512), MB(1)
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Named placement mode an offset implements, or an empty string */
+static const char* placement_mode_name(uint64_t offset)
+{
+    for (uint32_t m = 0; m < MEM_PLACE_COUNT; m++) {
+        if (memory_placement_offset((MemPlacement_t)m) == offset) {
+            return memory_placement_to_string((MemPlacement_t)m);
+        }
+    }
+    return "";
+}
+
+/* One timed run over a buffer pair, in MB/s */
+static int placement_run_once(const DmaOps_t* ops, const MemBufferPair_t* pair,
+                              uint32_t size, bool use_sg, uint32_t* mbps)
+{
+    uint64_t start, elapsed_ns;
+    uint32_t iterations, i;
+    int status;
+
+    iterations = MIN(MAX(PLACEMENT_BYTES_PER_RUN / size, PLACEMENT_MIN_ITERATIONS),
+                     PLACEMENT_MAX_ITERATIONS);
+
+    for (i = 0; i < PLACEMENT_WARMUP; i++) {
+        status = dma_ops_transfer(ops, 0, pair->src, pair->dst, size, use_sg);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+    }
+
+    start = timer_start();
+    for (i = 0; i < iterations; i++) {
+        status = dma_ops_transfer(ops, 0, pair->src, pair->dst, size, use_sg);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+    }
+    elapsed_ns = timer_stop_ns(start);
+
+    *mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * iterations, MAX(elapsed_ns / 1000, 1));
+
+    g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * iterations;
+    g_BenchmarkStats.total_time_us += elapsed_ns / 1000;
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int placement_test_run_all(void)
+{
+    PlacementResult_t result;
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    MemAddrColor_t src_color, dst_color;
+    uint32_t failures = 0;
+    uint32_t best, worst, worst_noise;
+    uint64_t dst;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("        Buffer Placement: Source/Destination Offset Sweep\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    LOG_RESULT("  DDR: %lu banks at bit %lu, L2: %lu sets x %lu ways\r\n",
+               (unsigned long)DDR_NUM_BANKS, (unsigned long)DDR_BANK_SHIFT,
+               (unsigned long)CPU_L2_NUM_SETS, (unsigned long)CPU_L2_CACHE_WAYS);
+    LOG_RESULT("  Offset = (dst - src) beyond the %lu KB aligned gap; %d runs per point\r\n\r\n",
+               (unsigned long)(MEM_COLOR_PERIOD / 1024), PLACEMENT_RUNS);
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_PlacementEngines) && !g_TestAbort; e++) {
+        ops = dma_ops_get(g_PlacementEngines[e]);
+        if (ops == NULL || dma_ops_get_caps(g_PlacementEngines[e], &caps) != DMA_SUCCESS) {
+            continue;
+        }
+
+        for (uint32_t s = 0; s < ARRAY_SIZE(g_PlacementSizes) && !g_TestAbort; s++) {
+            uint32_t size = g_PlacementSizes[s];
+
+            if (size > caps.max_transfer_len) {
+                continue;
+            }
+
+            LOG_RESULT("%s, %luK transfers:\r\n\r\n", ops->name, (unsigned long)(size / 1024));
+            LOG_RESULT("  Offset  | Bank | L2 set | Avg MB/s | Min MB/s | Max MB/s | Noise | Mode\r\n");
+            LOG_RESULT("  --------|------|--------|----------|----------|----------|-------|------------\r\n");
+
+            best = 0;
+            worst = UINT32_MAX;
+            worst_noise = 0;
+
+            for (uint32_t o = 0; o < ARRAY_SIZE(g_PlacementOffsets) && !g_TestAbort; o++) {
+                uint64_t offset = g_PlacementOffsets[o];
+
+                /* Colors of the first lines; the pair block is period aligned */
+                dst = ALIGN_UP((uint64_t)size, (uint64_t)MEM_COLOR_PERIOD) + offset;
+                memory_get_addr_color(0, &src_color);
+                memory_get_addr_color(dst, &dst_color);
+
+                LOG_RESULT("  %5luK  | %4ld | %6ld |", (unsigned long)(offset / 1024),
+                           (long)dst_color.bank - (long)src_color.bank,
+                           (long)dst_color.l2_set - (long)src_color.l2_set);
+
+                status = placement_test_measure(g_PlacementEngines[e], size, offset, &result);
+                if (status != DMA_SUCCESS) {
+                    LOG_RESULT(" %8s |          |          |       | %s\r\n", "ERROR",
+                               placement_mode_name(offset));
+                    failures++;
+                    continue;
+                }
+                if (!result.data_integrity) {
+                    failures++;
+                }
+
+                LOG_RESULT(" %8lu%s| %8lu | %8lu | %4lu%% | %s\r\n",
+                           (unsigned long)result.avg_mbps, result.data_integrity ? " " : "!",
+                           (unsigned long)result.min_mbps, (unsigned long)result.max_mbps,
+                           (unsigned long)CALC_EFFICIENCY(result.max_mbps - result.min_mbps,
+                                                          MAX(result.avg_mbps, 1)),
+                           placement_mode_name(offset));
+
+                best = MAX(best, result.avg_mbps);
+                worst = MIN(worst, result.avg_mbps);
+                worst_noise = MAX(worst_noise,
+                                  CALC_EFFICIENCY(result.max_mbps - result.min_mbps,
+                                                  MAX(result.avg_mbps, 1)));
+            }
+
+            if (best > 0) {
+                LOG_RESULT("\r\n  Placement spread: %lu%% (best %lu, worst %lu MB/s), "
+                           "run-to-run noise up to %lu%%\r\n\r\n",
+                           (unsigned long)CALC_EFFICIENCY(best - worst, best),
+                           (unsigned long)best, (unsigned long)worst,
+                           (unsigned long)worst_noise);
+            }
+        }
+    }
+
+    LOG_RESULT("  Bank/L2 set = destination minus source color of the first line\r\n");
+    LOG_RESULT("  Noise = (max - min) / avg over the runs of one point\r\n");
+    LOG_RESULT("  '!' = data verification failed\r\n\r\n");
+    LOG_RESULT("Placement sweep complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int placement_test_measure(DmaType_t dma_type, uint32_t size, uint64_t color_offset,
+                           PlacementResult_t* result)
+{
+    const DmaOps_t* ops = dma_ops_get(dma_type);
+    MemBufferPair_t pair;
+    DmaCaps_t caps;
+    uint64_t sum = 0;
+    uint32_t mbps;
+    bool use_sg;
+    int status;
+
+    if (result == NULL || size == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (ops == NULL || dma_ops_get_caps(dma_type, &caps) != DMA_SUCCESS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    if (size > caps.max_transfer_len) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    use_sg = !caps.has_simple;
+
+    status = memory_alloc_dma_pair(MEM_REGION_DDR4, size, color_offset, &pair);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    pattern_fill((void*)(uintptr_t)pair.src, size, PATTERN_RANDOM, PLACEMENT_SEED);
+    memset((void*)(uintptr_t)pair.dst, 0, size);
+
+    if (ops->open_channel != NULL) {
+        status = ops->open_channel(0);
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->min_mbps = UINT32_MAX;
+    for (uint32_t run = 0; run < PLACEMENT_RUNS; run++) {
+        status = placement_run_once(ops, &pair, size, use_sg, &mbps);
+        if (status != DMA_SUCCESS) {
+            goto close;
+        }
+        sum += mbps;
+        result->min_mbps = MIN(result->min_mbps, mbps);
+        result->max_mbps = MAX(result->max_mbps, mbps);
+        result->runs++;
+    }
+    result->avg_mbps = (uint32_t)(sum / result->runs);
+
+    if (caps.needs_cache_maint) {
+        cache_complete_dma_dst(pair.dst, size);
+    }
+    result->data_integrity = pattern_verify((void*)(uintptr_t)pair.dst, size, PATTERN_RANDOM,
+                                            PLACEMENT_SEED, NULL, NULL, NULL);
+
+    g_BenchmarkStats.tests_run++;
+    if (result->data_integrity) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+
+close:
+    if (ops->close_channel != NULL) {
+        ops->close_channel(0);
+    }
+out:
+    memory_free_dma_pair(&pair);
+    return status;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file placement_test.h
+ * @brief Buffer Placement (Bank / Cache Color) Test Header
+ */
+
+#ifndef PLACEMENT_TEST_H
+#define PLACEMENT_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Result of one engine/size/offset point over several runs
+ */
+typedef struct {
+    uint32_t avg_mbps;
+    uint32_t min_mbps;
+    uint32_t max_mbps;
+    uint32_t runs;
+    bool data_integrity;
+} PlacementResult_t;
+
+/**
+ * @brief Sweep the source/destination relative offset for every engine
+ * @return 0 on success, negative error code on failure
+ */
+int placement_test_run_all(void);
+
+/**
+ * @brief Measure one engine and size at a given relative offset
+ * @param dma_type Engine
+ * @param size Transfer size in bytes
+ * @param color_offset Destination offset (see memory_alloc_dma_pair())
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int placement_test_measure(DmaType_t dma_type, uint32_t size, uint64_t color_offset,
+                           PlacementResult_t* result);
+
+#endif /* PLACEMENT_TEST_H */
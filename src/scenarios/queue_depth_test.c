@@ -0,0 +1,324 @@
+/**
+ * @file queue_depth_test.c
+ * @brief Queue Depth Sweep Test Implementation
+ *
+ * fio-style closed loop: each engine is kept at exactly N transfers in
+ * flight through the enqueue/reap ops, refilling as soon as completions
+ * are reaped. Every transfer is timestamped at enqueue and at the reap
+ * that retires it, so the percentiles include queueing behind the other
+ * N-1 transfers. Engines with a one-deep queue per channel (LPD DMA) get
+ * their depth by spreading it over channels.
+ */
+
+#include <string.h>
+#include "queue_depth_test.h"
+#include "../drivers/dma_ops.h"
+#include "../utils/dma_buf.h"
+#include "../utils/timer_utils.h"
+#include "../utils/memory_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define QD_MAX_DEPTH            128
+#define QD_MAX_LANES            8
+#define QD_MAX_SAMPLES          4096
+#define QD_BYTES_PER_POINT      MB(64)      /* Data moved per depth point */
+#define QD_MIN_ROUNDS           8           /* Times the queue turns over */
+#define QD_SLOTS                16          /* Buffer slots reused round-robin */
+#define QD_KNEE_PCT             95          /* Within 5% of the best rate */
+#define QD_MAX_SIZE             MB(1)
+#define QD_SPAN                 ((uint32_t)(QD_SLOTS * QD_MAX_SIZE))
+
+static const uint32_t g_QdDepths[] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+static const uint32_t g_QdSizes[] = { KB(4), KB(64), MB(1) };
+static const DmaType_t g_QdEngines[] = {
+    DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA
+};
+
+/* Per-lane FIFO of enqueue timestamps, in submission order */
+typedef struct {
+    uint64_t stamp[QD_MAX_DEPTH];
+    uint32_t head;
+    uint32_t inflight;
+} QdLane_t;
+
+static QdLane_t g_QdLanes[QD_MAX_LANES];
+static uint32_t g_QdSamples[QD_MAX_SAMPLES];
+static uint64_t g_QdSrc;
+static uint64_t g_QdDst;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void qd_print_us(const char* sep, uint32_t ns)
+{
+    LOG_RESULT("%s%6lu.%01lu", sep, (unsigned long)(ns / 1000),
+               (unsigned long)((ns % 1000) / 100));
+}
+
+/* Returns the number of depths measured */
+static uint32_t qd_sweep(DmaType_t dma_type, uint32_t size)
+{
+    QueueDepthResult_t results[ARRAY_SIZE(g_QdDepths)];
+    uint32_t best_mbps = 0;
+    uint32_t best_depth = 0;
+    uint32_t knee = 0;
+    uint32_t count = 0;
+    int status;
+
+    LOG_RESULT("  QD  | Lanes | MB/s  |  avg (us) |  p50 (us) |  p90 (us) |  p99 (us) |  max (us)\r\n");
+    LOG_RESULT("  ----|-------|-------|-----------|-----------|-----------|-----------|----------\r\n");
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(g_QdDepths) && !g_TestAbort; i++) {
+        QueueDepthResult_t* res = &results[count];
+
+        status = queue_depth_test_measure(dma_type, size, g_QdDepths[i], res);
+        if (status != DMA_SUCCESS) {
+            LOG_RESULT("  %3lu | %5s | %5s | %s\r\n", (unsigned long)g_QdDepths[i],
+                       "---", "---",
+                       (status == DMA_ERROR_NOT_SUPPORTED) ? "n/a" : "ERR");
+            if (status != DMA_ERROR_NOT_SUPPORTED) {
+                break;
+            }
+            continue;
+        }
+
+        LOG_RESULT("  %3lu | %5lu | %5lu |", (unsigned long)res->depth,
+                   (unsigned long)res->lanes, (unsigned long)res->throughput_mbps);
+        qd_print_us(" ", res->latency_ns.avg);
+        qd_print_us("  | ", res->latency_ns.p50);
+        qd_print_us("  | ", res->latency_ns.p90);
+        qd_print_us("  | ", res->latency_ns.p99);
+        qd_print_us("  | ", res->latency_ns.max);
+        LOG_RESULT("\r\n");
+
+        if (res->throughput_mbps > best_mbps) {
+            best_mbps = res->throughput_mbps;
+            best_depth = res->depth;
+        }
+        count++;
+    }
+
+    if (count > 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            if ((uint64_t)results[i].throughput_mbps * 100 >=
+                (uint64_t)best_mbps * QD_KNEE_PCT) {
+                knee = results[i].depth;
+                break;
+            }
+        }
+
+        LOG_RESULT("\r\n  Knee: QD=%lu reaches >= %lu%% of the best %lu MB/s (QD=%lu);\r\n",
+                   (unsigned long)knee, (unsigned long)QD_KNEE_PCT,
+                   (unsigned long)best_mbps, (unsigned long)best_depth);
+        LOG_RESULT("  deeper queues only add latency\r\n");
+
+        g_BenchmarkStats.tests_run++;
+        g_BenchmarkStats.tests_passed++;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int queue_depth_test_measure(DmaType_t dma_type, uint32_t size, uint32_t depth,
+                             QueueDepthResult_t* result)
+{
+    const DmaOps_t* ops = dma_ops_get(dma_type);
+    DmaCaps_t caps;
+    uint32_t lanes, per_lane, total;
+    uint32_t issued = 0;
+    uint32_t done = 0;
+    uint64_t start, progress, elapsed_us;
+    int status = DMA_SUCCESS;
+
+    if (ops == NULL || result == NULL || size == 0 || size > QD_MAX_SIZE ||
+        depth == 0 || depth > QD_MAX_DEPTH || g_QdSrc == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (ops->enqueue == NULL || dma_ops_get_caps(dma_type, &caps) != DMA_SUCCESS ||
+        caps.queue_depth == 0 || size > caps.max_transfer_len) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    /* Spread the depth over channels when one channel cannot hold it */
+    per_lane = MIN(depth, caps.queue_depth);
+    lanes = (depth + per_lane - 1) / per_lane;
+    if (lanes > caps.num_channels || lanes > QD_MAX_LANES) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    per_lane = depth / lanes;
+
+    total = MAX(QD_BYTES_PER_POINT / size, depth * QD_MIN_ROUNDS);
+    total = MIN(total, QD_MAX_SAMPLES);
+
+    for (uint32_t l = 0; l < lanes; l++) {
+        memset(&g_QdLanes[l], 0, sizeof(g_QdLanes[l]));
+        if (ops->open_channel != NULL && ops->open_channel(l) != DMA_SUCCESS) {
+            lanes = l;
+            status = DMA_ERROR_NOT_INIT;
+            goto out;
+        }
+    }
+
+    start = timer_start();
+    progress = start;
+
+    while (done < total) {
+        for (uint32_t l = 0; l < lanes && status == DMA_SUCCESS; l++) {
+            QdLane_t* lane = &g_QdLanes[l];
+            uint64_t now;
+            int reaped;
+
+            /* Top the lane back up to its share of the depth */
+            while (lane->inflight < per_lane && issued < total) {
+                uint64_t offset = (uint64_t)(issued % QD_SLOTS) * size;
+                uint64_t stamp = timer_get_cycles();
+
+                status = ops->enqueue(l, g_QdSrc + offset, g_QdDst + offset, size);
+                if (status == DMA_ERROR_BUSY) {
+                    status = DMA_SUCCESS;
+                    break;
+                }
+                if (status != DMA_SUCCESS) {
+                    break;
+                }
+                lane->stamp[(lane->head + lane->inflight) % QD_MAX_DEPTH] = stamp;
+                lane->inflight++;
+                issued++;
+            }
+            if (status != DMA_SUCCESS) {
+                break;
+            }
+
+            reaped = ops->reap(l);
+            if (reaped < 0) {
+                status = reaped;
+                break;
+            }
+            if (reaped == 0) {
+                continue;
+            }
+
+            now = timer_get_cycles();
+            for (int k = 0; k < reaped && lane->inflight > 0; k++) {
+                g_QdSamples[done++] = (uint32_t)timer_cycles_to_ns(now - lane->stamp[lane->head]);
+                lane->head = (lane->head + 1) % QD_MAX_DEPTH;
+                lane->inflight--;
+            }
+            progress = timer_start();
+        }
+
+        if (status != DMA_SUCCESS) {
+            break;
+        }
+        if (timer_stop_us(progress) > DMA_TIMEOUT_US) {
+            LOG_ERROR("QD: %s stalled with %lu of %lu transfers reaped\r\n",
+                      ops->name, (unsigned long)done, (unsigned long)total);
+            status = DMA_ERROR_TIMEOUT;
+            break;
+        }
+    }
+
+    elapsed_us = timer_stop_us(start);
+
+    if (status != DMA_SUCCESS) {
+        ops->reset();
+        goto out;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->depth = depth;
+    result->transfer_size = size;
+    result->lanes = lanes;
+    result->transfers = done;
+    result->throughput_mbps = CALC_THROUGHPUT_MBPS((uint64_t)done * size, MAX(elapsed_us, 1));
+    latency_stats_compute(g_QdSamples, done, &result->latency_ns);
+
+    g_BenchmarkStats.total_bytes_transferred += (uint64_t)done * size;
+    g_BenchmarkStats.total_time_us += elapsed_us;
+
+out:
+    for (uint32_t l = 0; l < lanes; l++) {
+        if (ops->close_channel != NULL) {
+            ops->close_channel(l);
+        }
+    }
+    return status;
+}
+
+int queue_depth_test_run_all(void)
+{
+    bool saved_tracking = dma_buf_get_tracking();
+    DmaBuf_t* src_buf;
+    DmaBuf_t* dst_buf;
+    uint32_t measured = 0;
+    uint32_t first_diff;
+    int status = DMA_SUCCESS;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("           Queue Depth Sweep (QD 1..%lu)\r\n", (unsigned long)QD_MAX_DEPTH);
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    g_QdSrc = memory_alloc_dma_buffer(MEM_REGION_DDR4, QD_SPAN);
+    g_QdDst = memory_alloc_dma_buffer(MEM_REGION_DDR4, QD_SPAN);
+    if (g_QdSrc == 0 || g_QdDst == 0) {
+        LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        memory_free_dma_buffer(g_QdSrc);
+        memory_free_dma_buffer(g_QdDst);
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    pattern_fill((void*)(uintptr_t)g_QdSrc, QD_SPAN, PATTERN_INCREMENTAL, 0);
+    memset((void*)(uintptr_t)g_QdDst, 0, QD_SPAN);
+
+    /* Hand both spans to the device once so latency excludes cache maintenance */
+    dma_buf_set_tracking(true);
+    src_buf = dma_buf_register(g_QdSrc, QD_SPAN);
+    dst_buf = dma_buf_register(g_QdDst, QD_SPAN);
+    dma_buf_sync_for_device(g_QdSrc, QD_SPAN, DMA_DIR_TO_DEVICE);
+    dma_buf_sync_for_device(g_QdDst, QD_SPAN, DMA_DIR_FROM_DEVICE);
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_QdEngines) && !g_TestAbort; e++) {
+        const DmaOps_t* ops = dma_ops_get(g_QdEngines[e]);
+
+        if (ops == NULL || ops->enqueue == NULL) {
+            continue;
+        }
+
+        for (uint32_t s = 0; s < ARRAY_SIZE(g_QdSizes) && !g_TestAbort; s++) {
+            LOG_RESULT("%s, %lu KB per transfer:\r\n\r\n", ops->name,
+                       (unsigned long)(g_QdSizes[s] / 1024));
+            measured += qd_sweep(g_QdEngines[e], g_QdSizes[s]);
+            LOG_RESULT("\r\n");
+        }
+    }
+
+    /* Every slot was copied from the same source: check the whole span */
+    dma_buf_sync_for_cpu(g_QdDst, QD_SPAN, DMA_DIR_FROM_DEVICE);
+    dma_buf_sync_for_cpu(g_QdSrc, QD_SPAN, DMA_DIR_TO_DEVICE);
+    if (measured > 0 &&
+        !memory_compare((void*)(uintptr_t)g_QdDst, (void*)(uintptr_t)g_QdSrc,
+                        QD_SPAN, &first_diff)) {
+        LOG_RESULT("  Data verification FAILED at offset 0x%08lX\r\n",
+                   (unsigned long)first_diff);
+        status = DMA_ERROR_VERIFY_FAIL;
+    }
+
+    dma_buf_unregister(src_buf);
+    dma_buf_unregister(dst_buf);
+    dma_buf_set_tracking(saved_tracking);
+    memory_free_dma_buffer(g_QdSrc);
+    memory_free_dma_buffer(g_QdDst);
+
+    return status;
+}
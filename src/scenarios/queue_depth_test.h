@@ -0,0 +1,42 @@
+/**
+ * @file queue_depth_test.h
+ * @brief Queue Depth Sweep Test Header
+ */
+
+#ifndef QUEUE_DEPTH_TEST_H
+#define QUEUE_DEPTH_TEST_H
+
+#include "../dma_benchmark.h"
+#include "../utils/latency_stats.h"
+
+/**
+ * @brief Result of one queue-depth measurement
+ */
+typedef struct {
+    uint32_t depth;             /* Transfers kept in flight */
+    uint32_t transfer_size;     /* Bytes per transfer */
+    uint32_t lanes;             /* Channels the depth was spread over */
+    uint32_t transfers;         /* Transfers completed */
+    uint32_t throughput_mbps;
+    LatencyStats_t latency_ns;  /* Submit-to-reap latency per transfer */
+} QueueDepthResult_t;
+
+/**
+ * @brief Sweep QD = 1..128 at 4KB, 64KB and 1MB on every queued engine
+ * @return 0 on success, negative error code on failure
+ */
+int queue_depth_test_run_all(void);
+
+/**
+ * @brief Keep a fixed number of transfers in flight on one engine
+ * @param dma_type DMA type to test
+ * @param size Bytes per transfer
+ * @param depth Transfers in flight (spread over channels when a channel
+ *        holds fewer)
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int queue_depth_test_measure(DmaType_t dma_type, uint32_t size, uint32_t depth,
+                             QueueDepthResult_t* result);
+
+#endif /* QUEUE_DEPTH_TEST_H */
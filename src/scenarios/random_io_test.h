@@ -0,0 +1,51 @@
+/**
+ * @file random_io_test.h
+ * @brief Random Scatter/Gather IOPS Test Header
+ */
+
+#ifndef RANDOM_IO_TEST_H
+#define RANDOM_IO_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Direction of a random-access chain
+ */
+typedef enum {
+    RANDIO_GATHER = 0,              /* Random blocks -> contiguous buffer */
+    RANDIO_SCATTER,                 /* Contiguous buffer -> random blocks */
+    RANDIO_DIR_COUNT
+} RandIoDir_t;
+
+/**
+ * @brief Result of one engine/direction/block size/span measurement
+ */
+typedef struct {
+    uint32_t iops;                  /* Blocks per second */
+    uint32_t throughput_mbps;
+    uint32_t ns_per_block;          /* End-to-end, including submit */
+    bool data_integrity;
+} RandIoResult_t;
+
+/**
+ * @brief Sweep block size and randomness span on AXI DMA, AXI CDMA and LPD DMA
+ * @return 0 on success, negative error code on failure
+ */
+int random_io_test_run_all(void);
+
+/**
+ * @brief Measure one engine, direction, block size and span
+ *
+ * Only valid while random_io_test_run_all() holds the test buffers.
+ *
+ * @param dma_type DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA or DMA_TYPE_LPD_DMA
+ * @param dir Gather or scatter
+ * @param block_size Block size in bytes (power of 2)
+ * @param span Bytes the random blocks are spread over (power of 2)
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int random_io_test_measure(DmaType_t dma_type, RandIoDir_t dir, uint32_t block_size,
+                           uint64_t span, RandIoResult_t* result);
+
+#endif /* RANDOM_IO_TEST_H */
@@ -0,0 +1,45 @@
+/**
+ * @file ring_place_test.h
+ * @brief Descriptor Ring Placement and Depth Test Header
+ */
+
+#ifndef RING_PLACE_TEST_H
+#define RING_PLACE_TEST_H
+
+#include "../dma_benchmark.h"
+#include "../utils/memory_utils.h"
+
+/**
+ * @brief Result of one engine/ring configuration/transfer size point
+ */
+typedef struct {
+    uint32_t ns_per_bd;             /* End-to-end, including submit */
+    uint32_t kbds_per_sec;          /* Thousands of descriptors per second */
+    uint32_t throughput_mbps;
+} RingPlaceResult_t;
+
+/**
+ * @brief Sweep ring region and depth with small transfers on AXI DMA,
+ *        AXI CDMA and AXI MCDMA channel 0
+ * @return 0 on success, negative error code on failure
+ */
+int ring_place_test_run_all(void);
+
+/**
+ * @brief Measure full-ring chains of small transfers with a given ring
+ *
+ * Reconfigures the engine's rings to @p config for the measurement and
+ * restores the previous configuration afterwards. Only valid while
+ * ring_place_test_run_all() holds the test buffers.
+ *
+ * @param dma_type DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA or DMA_TYPE_AXI_MCDMA
+ * @param config Ring region and depth (depth is also the chain length)
+ * @param xfer_size Bytes per descriptor
+ * @param result Result output
+ * @return 0 on success, DMA_ERROR_NO_MEMORY if the ring does not fit,
+ *         negative error code on failure
+ */
+int ring_place_test_measure(DmaType_t dma_type, const DescRingConfig_t* config,
+                            uint32_t xfer_size, RingPlaceResult_t* result);
+
+#endif /* RING_PLACE_TEST_H */
@@ -0,0 +1,403 @@
+/**
+ * @file smp_test.c
+ * @brief Dual-Core DMA Pipeline Test Implementation
+ *
+ * A ring of buffer slots cycles through fill -> DMA -> verify. On one core
+ * the engine idles while the CPU generates and checks data. In dual-core
+ * mode core 1 runs an smp_worker fed over SPSC queues: it fills the next
+ * slots and checks finished ones while core 0 only keeps the engine busy
+ * and does the cache maintenance.
+ */
+
+#include <string.h>
+#include "smp_test.h"
+#include "../drivers/dma_ops.h"
+#include "../utils/memory_utils.h"
+#include "../utils/cache_utils.h"
+#include "../utils/timer_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/smp_core.h"
+#include "../utils/smp_worker.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define SMP_TEST_SLOTS              4
+#define SMP_TEST_BYTES_PER_POINT    MB(64)
+#define SMP_TEST_MIN_TRANSFERS      16
+#define SMP_TEST_MAX_TRANSFERS      512
+#define SMP_TEST_STALL_US           1000000     /* No progress for this long aborts */
+#define SMP_TEST_START_US           100000
+#define SMP_TEST_SEED               0x534D5030
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_FILLING,                   /* Fill job queued on core 1 */
+    SLOT_READY,                     /* Source filled, waiting for the engine */
+    SLOT_VERIFYING                  /* Verify job queued on core 1 */
+} SmpSlotState_t;
+
+typedef struct {
+    uint64_t src;
+    uint64_t dst;
+    uint32_t size;
+    uint32_t seed;
+    SmpSlotState_t state;
+} SmpSlot_t;
+
+static const DmaType_t g_SmpEngines[] = {
+    DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA
+};
+
+static const uint32_t g_SmpSizes[] = { KB(64), KB(256), MB(1) };
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static SmpWorker_t g_SmpWorker __attribute__((aligned(64)));
+static SmpSlot_t g_SmpSlots[SMP_TEST_SLOTS];
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void smp_core1_main(void* arg)
+{
+    smp_worker_run((SmpWorker_t*)arg);
+}
+
+/* Worker jobs (run on core 1 in dual-core mode) */
+static int smp_fill_job(void* arg)
+{
+    SmpSlot_t* slot = (SmpSlot_t*)arg;
+
+    pattern_fill((void*)(uintptr_t)slot->src, slot->size, PATTERN_RANDOM, slot->seed);
+    return DMA_SUCCESS;
+}
+
+static int smp_verify_job(void* arg)
+{
+    SmpSlot_t* slot = (SmpSlot_t*)arg;
+
+    return pattern_verify((void*)(uintptr_t)slot->dst, slot->size, PATTERN_RANDOM,
+                          slot->seed, NULL, NULL, NULL) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+/* Everything on core 0, one slot at a time */
+static int smp_run_single(const DmaOps_t* ops, const DmaCaps_t* caps, uint32_t transfers,
+                          SmpTestResult_t* result)
+{
+    bool use_sg = !caps->has_simple;
+    int status;
+
+    for (uint32_t seq = 0; seq < transfers && !g_TestAbort; seq++) {
+        SmpSlot_t* slot = &g_SmpSlots[seq % SMP_TEST_SLOTS];
+
+        slot->seed = SMP_TEST_SEED + seq;
+        smp_fill_job(slot);
+
+        status = dma_ops_transfer(ops, 0, slot->src, slot->dst, slot->size, use_sg);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+        if (caps->needs_cache_maint) {
+            cache_complete_dma_dst(slot->dst, slot->size);
+        }
+
+        if (smp_verify_job(slot) != DMA_SUCCESS) {
+            result->failed_checks++;
+        }
+        result->transfers++;
+    }
+    return DMA_SUCCESS;
+}
+
+/* Core 0 keeps the engine busy; core 1 fills and verifies */
+static int smp_run_dual(const DmaOps_t* ops, const DmaCaps_t* caps, uint32_t transfers,
+                        SmpTestResult_t* result)
+{
+    bool use_sg = !caps->has_simple;
+    bool dma_busy = false;
+    uint32_t next_seq = 0, dma_seq = 0;
+    uint64_t last_progress;
+    SmpSlot_t* slot;
+    SmpDone_t done;
+    int status = DMA_SUCCESS;
+
+    for (uint32_t s = 0; s < SMP_TEST_SLOTS && next_seq < transfers; s++, next_seq++) {
+        g_SmpSlots[s].seed = SMP_TEST_SEED + next_seq;
+        g_SmpSlots[s].state = SLOT_FILLING;
+        smp_worker_submit(&g_SmpWorker, smp_fill_job, &g_SmpSlots[s], s);
+    }
+
+    last_progress = timer_start();
+    while (result->transfers < transfers && !g_TestAbort) {
+        /* Fill and verify completions from core 1 */
+        while (smp_worker_reap(&g_SmpWorker, &done)) {
+            slot = &g_SmpSlots[done.cookie];
+            last_progress = timer_start();
+
+            if (slot->state == SLOT_FILLING) {
+                slot->state = SLOT_READY;
+                continue;
+            }
+
+            if (done.status != DMA_SUCCESS) {
+                result->failed_checks++;
+            }
+            result->transfers++;
+
+            slot->state = SLOT_FREE;
+            if (next_seq < transfers) {
+                slot->seed = SMP_TEST_SEED + next_seq++;
+                slot->state = SLOT_FILLING;
+                smp_worker_submit(&g_SmpWorker, smp_fill_job, slot, done.cookie);
+            }
+        }
+
+        /* Engine completion: hand the destination to core 1 */
+        if (dma_busy) {
+            status = ops->poll(0);
+            if (status == DMA_ERROR_BUSY) {
+                status = DMA_SUCCESS;
+            } else if (status != DMA_SUCCESS) {
+                break;
+            } else {
+                slot = &g_SmpSlots[dma_seq % SMP_TEST_SLOTS];
+                if (caps->needs_cache_maint) {
+                    cache_complete_dma_dst(slot->dst, slot->size);
+                }
+                slot->state = SLOT_VERIFYING;
+                smp_worker_submit(&g_SmpWorker, smp_verify_job, slot, dma_seq % SMP_TEST_SLOTS);
+                dma_busy = false;
+                dma_seq++;
+                last_progress = timer_start();
+            }
+        }
+
+        /* Transfers go out in sequence order */
+        if (!dma_busy && dma_seq < transfers &&
+            g_SmpSlots[dma_seq % SMP_TEST_SLOTS].state == SLOT_READY) {
+            slot = &g_SmpSlots[dma_seq % SMP_TEST_SLOTS];
+            status = ops->submit(0, slot->src, slot->dst, slot->size, use_sg);
+            if (status != DMA_SUCCESS) {
+                break;
+            }
+            dma_busy = true;
+        }
+
+        if (timer_stop_us(last_progress) > SMP_TEST_STALL_US) {
+            status = DMA_ERROR_TIMEOUT;
+            break;
+        }
+    }
+
+    /* Buffers are freed next: let the engine and core 1 finish with them */
+    if (dma_busy) {
+        ops->wait(0, DMA_TIMEOUT_US);
+    }
+    last_progress = timer_start();
+    while (smp_worker_pending(&g_SmpWorker) > 0 &&
+           timer_stop_us(last_progress) <= SMP_TEST_STALL_US) {
+        smp_worker_reap(&g_SmpWorker, &done);
+    }
+    if (smp_worker_pending(&g_SmpWorker) > 0 && status == DMA_SUCCESS) {
+        status = DMA_ERROR_TIMEOUT;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int smp_test_run_all(void)
+{
+    SmpTestResult_t single, dual;
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    uint32_t failures = 0;
+    uint64_t start;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("       Dual-Core Pipeline: Core 1 Fills and Verifies\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    if (!smp_core1_available()) {
+        LOG_RESULT("  Core 1 cannot be started: no PSCI firmware (EL1) or PLM (EL3)\r\n");
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    smp_worker_init(&g_SmpWorker);
+
+    /* Set/way maintenance on core 0 would miss lines dirty in core 1's L1 */
+    cache_maint_set_smp(true);
+
+    status = smp_core1_start(smp_core1_main, &g_SmpWorker);
+    if (status != DMA_SUCCESS) {
+        LOG_RESULT("  Core 1 start failed (%d)\r\n", status);
+        cache_maint_set_smp(false);
+        return status;
+    }
+    start = timer_start();
+    while (!smp_worker_is_running(&g_SmpWorker)) {
+        if (timer_stop_us(start) > SMP_TEST_START_US) {
+            LOG_RESULT("  Core 1 did not reach the worker loop\r\n");
+            smp_worker_stop(&g_SmpWorker);
+            return DMA_ERROR_TIMEOUT;
+        }
+    }
+
+    LOG_RESULT("  %d slots; each transfer is filled, copied and verified\r\n\r\n",
+               SMP_TEST_SLOTS);
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_SmpEngines) && !g_TestAbort; e++) {
+        ops = dma_ops_get(g_SmpEngines[e]);
+        if (ops == NULL || dma_ops_get_caps(g_SmpEngines[e], &caps) != DMA_SUCCESS) {
+            continue;
+        }
+
+        LOG_RESULT("%s:\r\n\r\n", ops->name);
+        LOG_RESULT("  Size   | 1 core MB/s | 2 cores MB/s | Speedup\r\n");
+        LOG_RESULT("  -------|-------------|--------------|--------\r\n");
+
+        for (uint32_t s = 0; s < ARRAY_SIZE(g_SmpSizes) && !g_TestAbort; s++) {
+            uint32_t size = g_SmpSizes[s];
+
+            if (size > caps.max_transfer_len) {
+                continue;
+            }
+
+            LOG_RESULT("  %5luK |", (unsigned long)(size / 1024));
+
+            status = smp_test_measure(g_SmpEngines[e], size, false, &single);
+            if (status != DMA_SUCCESS) {
+                LOG_RESULT(" %11s |              |\r\n", "ERROR");
+                failures++;
+                continue;
+            }
+            if (!single.data_integrity) {
+                failures++;
+            }
+            LOG_RESULT(" %10lu%s |", (unsigned long)single.throughput_mbps,
+                       single.data_integrity ? " " : "!");
+
+            status = smp_test_measure(g_SmpEngines[e], size, true, &dual);
+            if (status != DMA_SUCCESS) {
+                LOG_RESULT(" %12s |\r\n", "ERROR");
+                failures++;
+                continue;
+            }
+            if (!dual.data_integrity) {
+                failures++;
+            }
+            LOG_RESULT(" %11lu%s | %5lu%%\r\n", (unsigned long)dual.throughput_mbps,
+                       dual.data_integrity ? " " : "!",
+                       (unsigned long)CALC_EFFICIENCY(dual.throughput_mbps,
+                                                      MAX(single.throughput_mbps, 1)));
+        }
+        LOG_RESULT("\r\n");
+    }
+
+    LOG_RESULT("  Core 1 ran %llu jobs\r\n",
+               (unsigned long long)__atomic_load_n(&g_SmpWorker.jobs_run, __ATOMIC_RELAXED));
+
+    smp_worker_stop(&g_SmpWorker);
+    if (smp_core1_wait_off(SMP_TEST_START_US) != DMA_SUCCESS) {
+        /* Keep set/way off: core 1 may still be running */
+        LOG_RESULT("  Core 1 did not power off\r\n");
+        failures++;
+    } else {
+        cache_maint_set_smp(false);
+    }
+
+    LOG_RESULT("  Speedup = 2-core rate relative to 1-core rate\r\n");
+    LOG_RESULT("  '!' = data verification failed\r\n\r\n");
+    LOG_RESULT("Dual-core pipeline test complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int smp_test_measure(DmaType_t dma_type, uint32_t size, bool dual, SmpTestResult_t* result)
+{
+    const DmaOps_t* ops = dma_ops_get(dma_type);
+    uint64_t start, elapsed_ns;
+    uint32_t transfers, s;
+    DmaCaps_t caps;
+    int status = DMA_SUCCESS;
+
+    if (result == NULL || size == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (ops == NULL || dma_ops_get_caps(dma_type, &caps) != DMA_SUCCESS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    if (size > caps.max_transfer_len) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+    if (dual && !smp_worker_is_running(&g_SmpWorker)) {
+        return DMA_ERROR_NOT_INIT;
+    }
+
+    memset(g_SmpSlots, 0, sizeof(g_SmpSlots));
+    for (s = 0; s < SMP_TEST_SLOTS; s++) {
+        g_SmpSlots[s].size = size;
+        g_SmpSlots[s].src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        g_SmpSlots[s].dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        if (g_SmpSlots[s].src == 0 || g_SmpSlots[s].dst == 0) {
+            status = DMA_ERROR_NO_MEMORY;
+            goto out;
+        }
+        memset((void*)(uintptr_t)g_SmpSlots[s].dst, 0, size);
+    }
+
+    transfers = MIN(MAX(SMP_TEST_BYTES_PER_POINT / size, SMP_TEST_MIN_TRANSFERS),
+                    SMP_TEST_MAX_TRANSFERS);
+
+    if (ops->open_channel != NULL) {
+        status = ops->open_channel(0);
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+    }
+
+    memset(result, 0, sizeof(*result));
+    start = timer_start();
+    if (dual) {
+        status = smp_run_dual(ops, &caps, transfers, result);
+    } else {
+        status = smp_run_single(ops, &caps, transfers, result);
+    }
+    elapsed_ns = timer_stop_ns(start);
+
+    if (status == DMA_SUCCESS) {
+        result->throughput_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * result->transfers,
+                                                       MAX(elapsed_ns / 1000, 1));
+        result->data_integrity = (result->failed_checks == 0 &&
+                                  result->transfers == transfers);
+
+        g_BenchmarkStats.tests_run++;
+        if (result->data_integrity) {
+            g_BenchmarkStats.tests_passed++;
+        } else {
+            g_BenchmarkStats.tests_failed++;
+        }
+        g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * result->transfers;
+        g_BenchmarkStats.total_time_us += elapsed_ns / 1000;
+    }
+
+    if (ops->close_channel != NULL) {
+        ops->close_channel(0);
+    }
+out:
+    for (s = 0; s < SMP_TEST_SLOTS; s++) {
+        memory_free_dma_buffer(g_SmpSlots[s].src);
+        memory_free_dma_buffer(g_SmpSlots[s].dst);
+    }
+    return status;
+}
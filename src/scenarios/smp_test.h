@@ -0,0 +1,42 @@
+/**
+ * @file smp_test.h
+ * @brief Dual-Core DMA Pipeline Test Header
+ */
+
+#ifndef SMP_TEST_H
+#define SMP_TEST_H
+
+#include "../dma_benchmark.h"
+
+/**
+ * @brief Result of one engine/size/mode measurement
+ */
+typedef struct {
+    uint32_t throughput_mbps;       /* Verified bytes per second, fill to last check */
+    uint32_t transfers;
+    uint32_t failed_checks;
+    bool data_integrity;
+} SmpTestResult_t;
+
+/**
+ * @brief Compare fill -> DMA -> verify on core 0 alone against core 0
+ *        driving the engine while core 1 fills and verifies
+ * @return 0 on success, negative error code on failure
+ */
+int smp_test_run_all(void);
+
+/**
+ * @brief Measure one engine and size
+ *
+ * Dual-core mode is only valid while smp_test_run_all() has the worker
+ * running on core 1.
+ *
+ * @param dma_type Engine
+ * @param size Transfer size in bytes
+ * @param dual Hand fill and verify to core 1
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int smp_test_measure(DmaType_t dma_type, uint32_t size, bool dual, SmpTestResult_t* result);
+
+#endif /* SMP_TEST_H */
@@ -0,0 +1,392 @@
+/**
+ * @file stream_test.c
+ * @brief STREAM-Style CPU Memory Bandwidth Test Implementation
+ *
+ * Read, write, copy, scale, add and triad over three arrays of doubles
+ * placed in one region. Sizes run from a footprint that fits the 32KB L1
+ * to far beyond the 1MB L2, so the largest points give the CPU's sustained
+ * bandwidth to each region: the roofline DMA throughput is normalized
+ * against, and a check for DDR controller or NoC changes between
+ * bitstreams. Bytes are counted the STREAM way (one read or write per
+ * array access, no write-allocate reads).
+ */
+
+#include <string.h>
+#include "stream_test.h"
+#include "../utils/memory_utils.h"
+#include "../utils/timer_utils.h"
+#include "../utils/debug_print.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define STREAM_NUM_ARRAYS       3
+#define STREAM_BYTES_PER_RUN    MB(16)  /* Per array; small arrays repeat the kernel */
+#define STREAM_MAX_REPS         4096
+#define STREAM_RUNS             5       /* Timed runs after one warm-up; best is reported */
+#define STREAM_SCALAR           3.0
+
+static const char* const g_StreamKernelNames[STREAM_KERNEL_COUNT] = {
+    [STREAM_READ]  = "read",
+    [STREAM_WRITE] = "write",
+    [STREAM_COPY]  = "copy",
+    [STREAM_SCALE] = "scale",
+    [STREAM_ADD]   = "add",
+    [STREAM_TRIAD] = "triad"
+};
+
+/* Array accesses per element, 8 bytes each */
+static const uint32_t g_StreamAccesses[STREAM_KERNEL_COUNT] = {
+    [STREAM_READ]  = 1,
+    [STREAM_WRITE] = 1,
+    [STREAM_COPY]  = 2,
+    [STREAM_SCALE] = 2,
+    [STREAM_ADD]   = 3,
+    [STREAM_TRIAD] = 3
+};
+
+static const MemoryRegion_t g_StreamRegions[] = {
+    MEM_REGION_DDR4, MEM_REGION_DDR_HIGH, MEM_REGION_OCM
+};
+
+/* Bytes per array: 6KB footprint (L1) up to 192MB (far beyond L2) */
+static const uint64_t g_StreamSizes[] = {
+    KB(2), KB(8), KB(32), KB(128), KB(256), MB(1), MB(4), MB(16), MB(64)
+};
+
+#define STREAM_NUM_REGIONS      ARRAY_SIZE(g_StreamRegions)
+#define STREAM_NUM_SIZES        ARRAY_SIZE(g_StreamSizes)
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+/* Every point of the last run, printed as CSV at the end */
+static BandwidthResult_t g_StreamResults[STREAM_NUM_REGIONS][STREAM_NUM_SIZES][STREAM_KERNEL_COUNT];
+
+/* Keeps the read kernel's sum live */
+static volatile double g_StreamSink;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Small integers keep every kernel's result exact in a double */
+static double stream_value(uint64_t i)
+{
+    return (double)((i & 0xFF) + 1);
+}
+
+static void stream_init(double* a, double* b, double* c, uint64_t n)
+{
+    for (uint64_t i = 0; i < n; i++) {
+        a[i] = stream_value(i);
+        b[i] = 2.0 * stream_value(i);
+        c[i] = 5.0 * stream_value(i);
+    }
+}
+
+/* One pass of a kernel; returns the sum for STREAM_READ */
+static double stream_kernel(StreamKernel_t kernel, double* restrict a, double* restrict b,
+                            double* restrict c, uint64_t n)
+{
+    double sum = 0.0;
+    uint64_t i;
+
+    switch (kernel) {
+        case STREAM_READ: {
+            /*
+             * Eight independent chains: a single "sum += a[i]" is bound by
+             * FADD latency, and -O2 without -ffast-math may not reassociate it.
+             * The values are small integers, so the order of adds is exact.
+             */
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            double s4 = 0.0, s5 = 0.0, s6 = 0.0, s7 = 0.0;
+
+            for (i = 0; i + 8 <= n; i += 8) {
+                s0 += a[i];
+                s1 += a[i + 1];
+                s2 += a[i + 2];
+                s3 += a[i + 3];
+                s4 += a[i + 4];
+                s5 += a[i + 5];
+                s6 += a[i + 6];
+                s7 += a[i + 7];
+            }
+            for (; i < n; i++) {
+                s0 += a[i];
+            }
+            sum = ((s0 + s1) + (s2 + s3)) + ((s4 + s5) + (s6 + s7));
+            break;
+        }
+        case STREAM_WRITE:
+            for (i = 0; i < n; i++) {
+                c[i] = STREAM_SCALAR;
+            }
+            break;
+        case STREAM_COPY:
+            for (i = 0; i < n; i++) {
+                c[i] = a[i];
+            }
+            break;
+        case STREAM_SCALE:
+            for (i = 0; i < n; i++) {
+                b[i] = STREAM_SCALAR * c[i];
+            }
+            break;
+        case STREAM_ADD:
+            for (i = 0; i < n; i++) {
+                c[i] = a[i] + b[i];
+            }
+            break;
+        case STREAM_TRIAD:
+            for (i = 0; i < n; i++) {
+                a[i] = b[i] + STREAM_SCALAR * c[i];
+            }
+            break;
+        default:
+            break;
+    }
+
+    return sum;
+}
+
+/* Check the output of a kernel run on freshly initialized arrays */
+static bool stream_verify(StreamKernel_t kernel, const double* a, const double* b,
+                          const double* c, uint64_t n, double sum)
+{
+    double expected = 0.0;
+    uint64_t i;
+
+    switch (kernel) {
+        case STREAM_READ:
+            for (i = 0; i < n; i++) {
+                expected += stream_value(i);
+            }
+            return sum == expected;
+        case STREAM_WRITE:
+            for (i = 0; i < n; i++) {
+                if (c[i] != STREAM_SCALAR) return false;
+            }
+            return true;
+        case STREAM_COPY:
+            for (i = 0; i < n; i++) {
+                if (c[i] != stream_value(i)) return false;
+            }
+            return true;
+        case STREAM_SCALE:
+            for (i = 0; i < n; i++) {
+                if (b[i] != 15.0 * stream_value(i)) return false;
+            }
+            return true;
+        case STREAM_ADD:
+            for (i = 0; i < n; i++) {
+                if (c[i] != 3.0 * stream_value(i)) return false;
+            }
+            return true;
+        case STREAM_TRIAD:
+            for (i = 0; i < n; i++) {
+                if (a[i] != 17.0 * stream_value(i)) return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void stream_print_header(void)
+{
+    LOG_RESULT("  Array    |");
+    for (uint32_t k = 0; k < STREAM_KERNEL_COUNT; k++) {
+        LOG_RESULT(" %8s |", g_StreamKernelNames[k]);
+    }
+    LOG_RESULT("\r\n  ---------|");
+    for (uint32_t k = 0; k < STREAM_KERNEL_COUNT; k++) {
+        LOG_RESULT("----------|");
+    }
+    LOG_RESULT("\r\n");
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int stream_test_run_all(void)
+{
+    BandwidthResult_t* result;
+    uint32_t failures = 0;
+    uint64_t max_array;
+    char size_str[16];
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("          STREAM-Style CPU Bandwidth per Memory Region\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    LOG_RESULT("  Best of %d runs, MB/s; footprint is %d arrays of the listed size\r\n\r\n",
+               STREAM_RUNS, STREAM_NUM_ARRAYS);
+
+    memset(g_StreamResults, 0, sizeof(g_StreamResults));
+
+    for (uint32_t r = 0; r < STREAM_NUM_REGIONS && !g_TestAbort; r++) {
+        MemoryRegion_t region = g_StreamRegions[r];
+
+        LOG_RESULT("%s:\r\n\r\n", memory_region_to_string(region));
+        max_array = memory_get_max_size(region) / STREAM_NUM_ARRAYS;
+        if (max_array < g_StreamSizes[0]) {
+            LOG_RESULT("  Region not available\r\n\r\n");
+            continue;
+        }
+
+        stream_print_header();
+        for (uint32_t s = 0; s < STREAM_NUM_SIZES && !g_TestAbort; s++) {
+            if (g_StreamSizes[s] > max_array) {
+                break;
+            }
+
+            results_logger_format_size(g_StreamSizes[s], size_str, sizeof(size_str));
+            LOG_RESULT("  %-8s |", size_str);
+            for (uint32_t k = 0; k < STREAM_KERNEL_COUNT; k++) {
+                result = &g_StreamResults[r][s][k];
+                status = stream_test_measure((StreamKernel_t)k, region, g_StreamSizes[s], result);
+                if (status != DMA_SUCCESS) {
+                    memset(result, 0, sizeof(*result));
+                    LOG_RESULT(" %8s |", "ERROR");
+                    failures++;
+                    continue;
+                }
+                if (!result->data_integrity) {
+                    failures++;
+                }
+                LOG_RESULT(" %7lu%s |", (unsigned long)result->best_mbps,
+                           result->data_integrity ? " " : "!");
+            }
+            LOG_RESULT("\r\n");
+        }
+        LOG_RESULT("\r\n");
+    }
+
+    /* Largest measured size per region: the sustained rate DMA is compared to */
+    LOG_RESULT("Sustained bandwidth (largest array per region), MB/s:\r\n\r\n");
+    LOG_RESULT("  Region      | Array    |     copy |    triad |     read |    write\r\n");
+    LOG_RESULT("  ------------|----------|----------|----------|----------|----------\r\n");
+    for (uint32_t r = 0; r < STREAM_NUM_REGIONS; r++) {
+        for (int32_t s = (int32_t)STREAM_NUM_SIZES - 1; s >= 0; s--) {
+            BandwidthResult_t* row = g_StreamResults[r][s];
+
+            if (row[STREAM_COPY].runs == 0) {
+                continue;
+            }
+            results_logger_format_size(g_StreamSizes[s], size_str, sizeof(size_str));
+            LOG_RESULT("  %-11s | %-8s | %8lu | %8lu | %8lu | %8lu\r\n",
+                       memory_region_to_string(g_StreamRegions[r]), size_str,
+                       (unsigned long)row[STREAM_COPY].best_mbps,
+                       (unsigned long)row[STREAM_TRIAD].best_mbps,
+                       (unsigned long)row[STREAM_READ].best_mbps,
+                       (unsigned long)row[STREAM_WRITE].best_mbps);
+            break;
+        }
+    }
+    LOG_RESULT("\r\n");
+
+    LOG_RESULT("CSV:\r\n");
+    results_logger_print_bw_csv_header();
+    for (uint32_t r = 0; r < STREAM_NUM_REGIONS; r++) {
+        for (uint32_t s = 0; s < STREAM_NUM_SIZES; s++) {
+            for (uint32_t k = 0; k < STREAM_KERNEL_COUNT; k++) {
+                if (g_StreamResults[r][s][k].runs > 0) {
+                    results_logger_log_bw_csv(&g_StreamResults[r][s][k]);
+                }
+            }
+        }
+    }
+    LOG_RESULT("\r\n");
+
+    LOG_RESULT("  '!' = data verification failed\r\n\r\n");
+    LOG_RESULT("STREAM bandwidth test complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int stream_test_measure(StreamKernel_t kernel, MemoryRegion_t region, uint64_t array_size,
+                        BandwidthResult_t* result)
+{
+    uint64_t bufs[STREAM_NUM_ARRAYS] = { 0 };
+    uint64_t start, elapsed_ns, bytes, sum_mbps = 0;
+    uint64_t n = array_size / sizeof(double);
+    uint32_t reps, run, rep, mbps;
+    double *a, *b, *c;
+    double sum = 0.0;
+    int status = DMA_SUCCESS;
+
+    if (result == NULL || kernel >= STREAM_KERNEL_COUNT || n == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < STREAM_NUM_ARRAYS; i++) {
+        bufs[i] = memory_alloc_dma_buffer(region, array_size);
+        if (bufs[i] == 0) {
+            status = DMA_ERROR_NO_MEMORY;
+            goto out;
+        }
+    }
+    a = (double*)(uintptr_t)bufs[0];
+    b = (double*)(uintptr_t)bufs[1];
+    c = (double*)(uintptr_t)bufs[2];
+
+    stream_init(a, b, c, n);
+
+    reps = (uint32_t)MIN(MAX(STREAM_BYTES_PER_RUN / array_size, 1), STREAM_MAX_REPS);
+    bytes = (uint64_t)g_StreamAccesses[kernel] * sizeof(double) * n * reps;
+
+    memset(result, 0, sizeof(*result));
+    result->kernel = g_StreamKernelNames[kernel];
+    result->region = region;
+    result->array_size = array_size;
+    result->bytes_per_elem = g_StreamAccesses[kernel] * sizeof(double);
+    result->min_mbps = UINT32_MAX;
+
+    /* Every kernel is idempotent, so repeated passes keep the output checkable */
+    sum = stream_kernel(kernel, a, b, c, n);
+
+    for (run = 0; run < STREAM_RUNS; run++) {
+        start = timer_start();
+        for (rep = 0; rep < reps; rep++) {
+            sum = stream_kernel(kernel, a, b, c, n);
+        }
+        __asm__ __volatile__("dsb sy" ::: "memory");
+        elapsed_ns = timer_stop_ns(start);
+
+        mbps = CALC_THROUGHPUT_MBPS(bytes, MAX(elapsed_ns / 1000, 1));
+        result->best_mbps = MAX(result->best_mbps, mbps);
+        result->min_mbps = MIN(result->min_mbps, mbps);
+        sum_mbps += mbps;
+        result->runs++;
+
+        g_BenchmarkStats.total_bytes_transferred += bytes;
+        g_BenchmarkStats.total_time_us += elapsed_ns / 1000;
+    }
+    result->avg_mbps = (uint32_t)(sum_mbps / result->runs);
+    g_StreamSink = sum;
+
+    result->data_integrity = stream_verify(kernel, a, b, c, n, sum);
+
+    g_BenchmarkStats.tests_run++;
+    if (result->data_integrity) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+
+out:
+    for (uint32_t i = 0; i < STREAM_NUM_ARRAYS; i++) {
+        memory_free_dma_buffer(bufs[i]);
+    }
+    return status;
+}
+
+const char* stream_kernel_to_string(StreamKernel_t kernel)
+{
+    return (kernel < STREAM_KERNEL_COUNT) ? g_StreamKernelNames[kernel] : "unknown";
+}
@@ -0,0 +1,51 @@
+/**
+ * @file stream_test.h
+ * @brief STREAM-Style CPU Memory Bandwidth Test Header
+ */
+
+#ifndef STREAM_TEST_H
+#define STREAM_TEST_H
+
+#include "../dma_benchmark.h"
+#include "../utils/results_logger.h"
+
+/**
+ * @brief Bandwidth kernel (a, b, c are arrays of doubles, s a scalar)
+ */
+typedef enum {
+    STREAM_READ = 0,                /* sum += a[i] */
+    STREAM_WRITE,                   /* c[i] = s */
+    STREAM_COPY,                    /* c[i] = a[i] */
+    STREAM_SCALE,                   /* b[i] = s * c[i] */
+    STREAM_ADD,                     /* c[i] = a[i] + b[i] */
+    STREAM_TRIAD,                   /* a[i] = b[i] + s * c[i] */
+    STREAM_KERNEL_COUNT
+} StreamKernel_t;
+
+/**
+ * @brief Run every kernel over DDR low, DDR high and OCM at sizes from
+ *        inside L1 to far beyond L2; prints tables, a per-region peak
+ *        summary and every point as CSV through results_logger
+ * @return 0 on success, negative error code on failure
+ */
+int stream_test_run_all(void);
+
+/**
+ * @brief Measure one kernel in one region
+ * @param kernel Kernel
+ * @param region Memory region holding all three arrays
+ * @param array_size Bytes per array (multiple of 8)
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int stream_test_measure(StreamKernel_t kernel, MemoryRegion_t region, uint64_t array_size,
+                        BandwidthResult_t* result);
+
+/**
+ * @brief Get kernel name
+ * @param kernel Kernel
+ * @return Name string
+ */
+const char* stream_kernel_to_string(StreamKernel_t kernel);
+
+#endif /* STREAM_TEST_H */
@@ -62,11 +62,13 @@ int stress_test_continuous(uint32_t duration_sec)
     int status;
 
     /* Allocate buffers */
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, 0, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, size * 2, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
     if (src_addr == 0 || dst_addr == 0) {
         LOG_RESULT("ERROR: Could not allocate stress test buffers\r\n");
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
         return DMA_ERROR_NO_MEMORY;
     }
 
@@ -157,6 +159,8 @@ int stress_test_continuous(uint32_t duration_sec)
     }
     g_BenchmarkStats.total_bytes_transferred += total_bytes;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return (errors == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
 }
 
@@ -170,10 +174,12 @@ int stress_test_random_pattern(uint32_t duration_sec)
     uint32_t transfer_count = 0;
     int status;
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, MB(32), size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, MB(33), size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
     if (src_addr == 0 || dst_addr == 0) {
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
         return DMA_ERROR_NO_MEMORY;
     }
 
@@ -215,6 +221,8 @@ int stress_test_random_pattern(uint32_t duration_sec)
     LOG_RESULT("Random pattern test: %lu transfers, %lu errors\r\n",
               transfer_count, errors);
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return (errors == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
 }
 
@@ -228,13 +236,14 @@ int stress_test_multi_dma(uint32_t duration_sec)
     int status;
 
     /* Allocate buffers for each DMA */
-    uint64_t cdma_src = memory_get_test_addr(MEM_REGION_DDR4, MB(64), size);
-    uint64_t cdma_dst = memory_get_test_addr(MEM_REGION_DDR4, MB(65), size);
-    uint64_t lpd_src = memory_get_test_addr(MEM_REGION_DDR4, MB(66), size);
-    uint64_t lpd_dst = memory_get_test_addr(MEM_REGION_DDR4, MB(67), size);
+    uint64_t cdma_src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t cdma_dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t lpd_src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t lpd_dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
     if (!cdma_src || !cdma_dst || !lpd_src || !lpd_dst) {
-        return DMA_ERROR_NO_MEMORY;
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
     }
 
     /* Prepare buffers */
@@ -276,6 +285,12 @@ int stress_test_multi_dma(uint32_t duration_sec)
               throughput, errors);
 
     g_BenchmarkStats.total_bytes_transferred += total_bytes;
+    status = (errors == 0) ? DMA_SUCCESS : DMA_ERROR_DMA_FAIL;
 
-    return (errors == 0) ? DMA_SUCCESS : DMA_ERROR_DMA_FAIL;
+out:
+    memory_free_dma_buffer(cdma_src);
+    memory_free_dma_buffer(cdma_dst);
+    memory_free_dma_buffer(lpd_src);
+    memory_free_dma_buffer(lpd_dst);
+    return status;
 }
@@ -10,16 +10,157 @@
 #include "../drivers/axi_cdma_driver.h"
 #include "../drivers/axi_mcdma_driver.h"
 #include "../drivers/lpd_dma_driver.h"
+#include "../drivers/dma_ops.h"
+#include "../drivers/dma_memcpy.h"
 #include "../utils/timer_utils.h"
 #include "../utils/memory_utils.h"
 #include "../utils/data_patterns.h"
 #include "../utils/results_logger.h"
 #include "../utils/cache_utils.h"
+#include "../utils/dma_buf.h"
+#include "../utils/cpu_copy.h"
 #include "../tests/axi_dma_test.h"
 #include "../tests/axi_cdma_test.h"
 #include "../tests/axi_mcdma_test.h"
 #include "../tests/lpd_dma_test.h"
 
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define CPU_BASELINE_BYTES_PER_POINT    MB(32)
+#define CPU_BASELINE_MIN_ITERATIONS     4
+#define CPU_BASELINE_MAX_ITERATIONS     1000
+
+/* One CPU copy variant: kernel plus prefetch distance (NEON+PF only) */
+typedef struct {
+    CpuCopyKernel_t kernel;
+    uint32_t pf_distance;
+    const char* name;
+} CpuCopyVariant_t;
+
+typedef struct {
+    MemoryRegion_t src;
+    MemoryRegion_t dst;
+    uint32_t max_size;
+    const char* name;
+} CpuCopyPair_t;
+
+static const CpuCopyVariant_t g_CpuCopyVariants[] = {
+    { CPU_COPY_MEMCPY,        0,    "memcpy"   },
+    { CPU_COPY_NEON,          0,    "NEON"     },
+    { CPU_COPY_NEON_PREFETCH, 256,  "PF 256"   },
+    { CPU_COPY_NEON_PREFETCH, 512,  "PF 512"   },
+    { CPU_COPY_NEON_PREFETCH, 1024, "PF 1K"    },
+    { CPU_COPY_NONTEMPORAL,   0,    "LDNP/STNP"},
+    { CPU_COPY_ZVA,           0,    "DC ZVA"   }
+};
+
+static const CpuCopyPair_t g_CpuCopyPairs[] = {
+    { MEM_REGION_DDR4, MEM_REGION_DDR4, MB(16), "DDR -> DDR" },
+    { MEM_REGION_DDR4, MEM_REGION_OCM,  KB(64), "DDR -> OCM" },
+    { MEM_REGION_OCM,  MEM_REGION_DDR4, KB(64), "OCM -> DDR" }
+};
+
+static const uint32_t g_CpuCopySizes[] = {
+    KB(1), KB(4), KB(16), KB(64), KB(256), MB(1), MB(4), MB(16)
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* One size row of the CPU baseline table; returns the number of failures */
+static uint32_t cpu_baseline_row(const CpuCopyPair_t* pair, uint32_t size, bool cold)
+{
+    uint64_t src = memory_alloc_dma_buffer(pair->src, size);
+    uint64_t dst = memory_alloc_dma_buffer(pair->dst, size);
+    uint32_t iterations, mbps, best = 0, best_idx = 0, failures = 0;
+    bool ok;
+    char size_str[16];
+
+    results_logger_format_size(size, size_str, sizeof(size_str));
+
+    if (src == 0 || dst == 0) {
+        LOG_RESULT("  %-8s | no memory\r\n", size_str);
+        memory_free_dma_buffer(src);
+        memory_free_dma_buffer(dst);
+        return 1;
+    }
+
+    iterations = MIN(MAX(CPU_BASELINE_BYTES_PER_POINT / size, CPU_BASELINE_MIN_ITERATIONS),
+                     CPU_BASELINE_MAX_ITERATIONS);
+    pattern_fill((void*)(uintptr_t)src, size, PATTERN_RANDOM, size);
+
+    LOG_RESULT("  %-8s |", size_str);
+    for (uint32_t v = 0; v < ARRAY_SIZE(g_CpuCopyVariants); v++) {
+        const CpuCopyVariant_t* variant = &g_CpuCopyVariants[v];
+
+        /* DC ZVA on Device or non-cacheable memory faults */
+        if (variant->kernel == CPU_COPY_ZVA && !g_MemoryRegions[pair->dst].cacheable) {
+            LOG_RESULT(" %9s |", "-");
+            continue;
+        }
+        if (variant->kernel == CPU_COPY_NEON_PREFETCH) {
+            cpu_copy_set_prefetch_distance(variant->pf_distance);
+        }
+
+        memset((void*)(uintptr_t)dst, 0, size);
+        mbps = cpu_copy_benchmark(variant->kernel, (void*)(uintptr_t)dst,
+                                  (const void*)(uintptr_t)src, size, iterations, cold);
+        ok = (memcmp((void*)(uintptr_t)dst, (void*)(uintptr_t)src, size) == 0);
+
+        g_BenchmarkStats.tests_run++;
+        if (ok) {
+            g_BenchmarkStats.tests_passed++;
+        } else {
+            g_BenchmarkStats.tests_failed++;
+            failures++;
+        }
+        g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * iterations;
+
+        LOG_RESULT(" %8lu%s |", (unsigned long)mbps, ok ? " " : "!");
+        if (ok && mbps > best) {
+            best = mbps;
+            best_idx = v;
+        }
+    }
+    LOG_RESULT(" %s\r\n", (best > 0) ? g_CpuCopyVariants[best_idx].name : "-");
+
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
+    return failures;
+}
+
+/* Size sweep of every variant for one region pair and cache state */
+static uint32_t cpu_baseline_table(const CpuCopyPair_t* pair, bool cold)
+{
+    uint32_t failures = 0;
+    uint32_t max_size = MIN((uint64_t)pair->max_size,
+                            MIN(memory_get_max_size(pair->src), memory_get_max_size(pair->dst)) / 2);
+
+    LOG_RESULT("  %s, %s caches, MB/s:\r\n\r\n", pair->name, cold ? "cold" : "warm");
+    LOG_RESULT("  Size     |");
+    for (uint32_t v = 0; v < ARRAY_SIZE(g_CpuCopyVariants); v++) {
+        LOG_RESULT(" %9s |", g_CpuCopyVariants[v].name);
+    }
+    LOG_RESULT(" Best\r\n");
+    LOG_RESULT("  ---------|");
+    for (uint32_t v = 0; v < ARRAY_SIZE(g_CpuCopyVariants); v++) {
+        LOG_RESULT("-----------|");
+    }
+    LOG_RESULT("----------\r\n");
+
+    for (uint32_t s = 0; s < ARRAY_SIZE(g_CpuCopySizes) && !g_TestAbort; s++) {
+        if (g_CpuCopySizes[s] > max_size) {
+            break;
+        }
+        failures += cpu_baseline_row(pair, g_CpuCopySizes[s], cold);
+    }
+    LOG_RESULT("\r\n");
+    return failures;
+}
+
 /*******************************************************************************
  * Public Functions
  ******************************************************************************/
@@ -35,7 +176,10 @@ int throughput_test_run_all(void)
     LOG_RESULT("1. Transfer Size Sweep Tests\r\n");
     LOG_RESULT("----------------------------\r\n\r\n");
 
+    throughput_test_size_sweep(DMA_TYPE_AXI_DMA);
     throughput_test_size_sweep(DMA_TYPE_AXI_CDMA);
+    throughput_test_size_sweep(DMA_TYPE_AXI_MCDMA);
+    throughput_test_size_sweep(DMA_TYPE_LPD_DMA);
 
     /* Memory matrix */
     LOG_RESULT("\r\n2. Memory-to-Memory Matrix\r\n");
@@ -43,8 +187,8 @@ int throughput_test_run_all(void)
     throughput_test_run_memory_matrix();
 
     /* CPU baseline */
-    LOG_RESULT("\r\n3. CPU memcpy Baseline\r\n");
-    LOG_RESULT("----------------------\r\n\r\n");
+    LOG_RESULT("\r\n3. CPU Copy Kernel Baseline\r\n");
+    LOG_RESULT("---------------------------\r\n\r\n");
     throughput_test_run_cpu_baseline();
 
     /* Alignment test */
@@ -52,6 +196,11 @@ int throughput_test_run_all(void)
     LOG_RESULT("------------------------\r\n\r\n");
     throughput_test_alignment();
 
+    /* Cost model */
+    LOG_RESULT("\r\n5. Size Cost Model (fixed + per-byte)\r\n");
+    LOG_RESULT("-------------------------------------\r\n\r\n");
+    throughput_test_size_model();
+
     LOG_RESULT("\r\nThroughput tests complete.\r\n");
     return DMA_SUCCESS;
 }
@@ -64,39 +213,24 @@ int throughput_test_run_memory_matrix(void)
 
 int throughput_test_run_cpu_baseline(void)
 {
-    uint32_t sizes[] = {KB(1), KB(4), KB(16), KB(64), KB(256), MB(1), MB(4), MB(16)};
-    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
-
-    LOG_RESULT("  Size       | Throughput (MB/s)\r\n");
-    LOG_RESULT("  -----------|------------------\r\n");
+    uint32_t failures = 0;
 
-    for (int i = 0; i < num_sizes; i++) {
-        uint32_t size = sizes[i];
-        uint64_t src = memory_get_test_addr(MEM_REGION_DDR4, 0, size);
-        uint64_t dst = memory_get_test_addr(MEM_REGION_DDR4, size * 2, size);
-
-        if (src == 0 || dst == 0) continue;
-
-        /* Fill source */
-        pattern_fill((void*)(uintptr_t)src, size, PATTERN_RANDOM, i);
-
-        /* Benchmark */
-        double throughput = memory_cpu_memcpy_benchmark(
-            (void*)(uintptr_t)dst,
-            (void*)(uintptr_t)src,
-            size, 100);
-
-        char size_str[16];
-        results_logger_format_size(size, size_str, sizeof(size_str));
-        LOG_RESULT("  %-10s | %16.2f\r\n", size_str, throughput);
+    LOG_RESULT("  DC ZVA block: %lu bytes, prefetch variants at 256/512/1024 bytes ahead\r\n\r\n",
+               (unsigned long)cpu_copy_zva_block_size());
 
-        /* Update global stats */
-        g_BenchmarkStats.tests_run++;
-        g_BenchmarkStats.tests_passed++;
-        g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * 100;
+    for (uint32_t p = 0; p < ARRAY_SIZE(g_CpuCopyPairs) && !g_TestAbort; p++) {
+        for (uint32_t cold = 0; cold < 2 && !g_TestAbort; cold++) {
+            failures += cpu_baseline_table(&g_CpuCopyPairs[p], cold != 0);
+        }
     }
 
-    return DMA_SUCCESS;
+    cpu_copy_set_prefetch_distance(CPU_COPY_DEFAULT_PF_DISTANCE);
+
+    LOG_RESULT("  Cold = source and destination flushed from the caches before every copy\r\n");
+    LOG_RESULT("  '-' = not run (DC ZVA needs a cacheable destination)\r\n");
+    LOG_RESULT("  '!' = data verification failed\r\n\r\n");
+    LOG_RESULT("CPU copy baseline complete, %lu failure(s).\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
 }
 
 int throughput_test_size_sweep(DmaType_t dma_type)
@@ -157,28 +291,908 @@ int throughput_test_size_sweep(DmaType_t dma_type)
     return DMA_SUCCESS;
 }
 
+/* Dense sizes: odd lengths and +/-1 around the 16B beat and 4KB burst */
+static const uint32_t g_ModelSizes[] = {
+    1, 15, 16, 17, 63, 64, 65, 127, 128, 129, 255, 256, 257,
+    511, 512, 513, 1000, 1023, 1024, 1025, 1500, 2047, 2048, 2049,
+    3000, 4095, 4096, 4097, 6000, 8191, 8192, 8193, 12288,
+    16383, 16384, 16385, 24576, 32767, 32768, 32769, 49152,
+    65535, 65536, 65537, 98304, 131071, 131072, 131073, 196608,
+    262144, 393216, 524288, 786432, 1048575, 1048576, 1048577,
+    1572864, 2097152, 3145728, 4194304
+};
+
+/* CPU first: it is the crossover reference */
+static const DmaType_t g_ModelEngines[] = {
+    DMA_TYPE_CPU_MEMCPY, DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA,
+    DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA
+};
+
+#define MODEL_NUM_SIZES         ARRAY_SIZE(g_ModelSizes)
+#define MODEL_NUM_ENGINES       ARRAY_SIZE(g_ModelEngines)
+#define MODEL_MAX_SIZE          MB(4)
+#define MODEL_BYTES_PER_POINT   MB(16)
+#define MODEL_MIN_ITERATIONS    8
+#define MODEL_MAX_ITERATIONS    256
+
+/* Fitted t(size) = fixed_ns + size * ns_per_byte */
+typedef struct {
+    bool     valid;
+    double   fixed_ns;
+    double   ns_per_byte;
+    uint32_t points;
+    uint32_t avg_error_pct;
+    uint32_t max_error_pct;
+    uint32_t max_error_size;
+} SizeModel_t;
+
+static uint32_t g_ModelNs[MODEL_NUM_ENGINES][MODEL_NUM_SIZES];
+
+/* Average ns per blocking transfer, including the driver's cache maintenance */
+static int size_model_time(const DmaOps_t* ops, bool use_sg, uint64_t src_addr,
+                           uint64_t dst_addr, uint32_t size, uint32_t* ns_per_xfer)
+{
+    uint32_t iterations = MODEL_BYTES_PER_POINT / size;
+    uint64_t start, elapsed_ns;
+    int status;
+
+    iterations = MIN(MAX(iterations, MODEL_MIN_ITERATIONS), MODEL_MAX_ITERATIONS);
+
+    status = dma_ops_transfer(ops, 0, src_addr, dst_addr, size, use_sg);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    start = timer_start();
+    for (uint32_t i = 0; i < iterations; i++) {
+        status = dma_ops_transfer(ops, 0, src_addr, dst_addr, size, use_sg);
+        if (status != DMA_SUCCESS) {
+            return status;
+        }
+    }
+    elapsed_ns = timer_stop_ns(start);
+
+    *ns_per_xfer = (uint32_t)MAX(elapsed_ns / iterations, 1);
+    g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * (iterations + 1);
+    g_BenchmarkStats.total_time_us += elapsed_ns / 1000;
+    return DMA_SUCCESS;
+}
+
+/*
+ * Least squares weighted by 1/t^2, i.e. minimizing relative error, so the
+ * small sizes pin down the fixed cost instead of being swamped by the
+ * large ones.
+ */
+static void size_model_fit(const uint32_t* ns, SizeModel_t* model)
+{
+    double sw = 0, ss = 0, sss = 0, st = 0, sst = 0;
+    double den, abs_err = 0;
+
+    memset(model, 0, sizeof(*model));
+
+    for (uint32_t i = 0; i < MODEL_NUM_SIZES; i++) {
+        double s = g_ModelSizes[i];
+        double t = ns[i];
+        double w;
+
+        if (ns[i] == 0) {
+            continue;
+        }
+        w = 1.0 / (t * t);
+        sw += w;
+        ss += w * s;
+        sss += w * s * s;
+        st += w * t;
+        sst += w * s * t;
+        model->points++;
+    }
+
+    den = sw * sss - ss * ss;
+    if (model->points < 2 || den <= 0) {
+        return;
+    }
+
+    model->ns_per_byte = (sw * sst - ss * st) / den;
+    model->fixed_ns = (st - model->ns_per_byte * ss) / sw;
+    model->valid = true;
+
+    for (uint32_t i = 0; i < MODEL_NUM_SIZES; i++) {
+        double err;
+        uint32_t err_pct;
+
+        if (ns[i] == 0) {
+            continue;
+        }
+        err = (ns[i] - (model->fixed_ns + model->ns_per_byte * g_ModelSizes[i])) / ns[i];
+        err = (err < 0) ? -err : err;
+        abs_err += err;
+
+        err_pct = (uint32_t)(err * 100.0 + 0.5);
+        if (err_pct >= model->max_error_pct) {
+            model->max_error_pct = err_pct;
+            model->max_error_size = g_ModelSizes[i];
+        }
+    }
+    model->avg_error_pct = (uint32_t)(abs_err * 100.0 / model->points + 0.5);
+}
+
+static long size_model_residual_pct(const SizeModel_t* model, uint32_t size, uint32_t ns)
+{
+    double predicted = model->fixed_ns + model->ns_per_byte * size;
+
+    return (long)(((double)ns - predicted) * 100.0 / ns);
+}
+
+/* Smallest measured size from which the engine beats the CPU at every larger size */
+static uint32_t size_model_measured_crossover(const uint32_t* cpu_ns, const uint32_t* dma_ns)
+{
+    uint32_t crossover = 0;
+
+    for (uint32_t i = MODEL_NUM_SIZES; i-- > 0; ) {
+        if (cpu_ns[i] == 0 || dma_ns[i] == 0) {
+            continue;
+        }
+        if (dma_ns[i] >= cpu_ns[i]) {
+            break;
+        }
+        crossover = g_ModelSizes[i];
+    }
+    return crossover;
+}
+
+static void size_model_print_crossover(const SizeModel_t* cpu, const SizeModel_t* dma,
+                                       uint32_t measured)
+{
+    double diff_rate = cpu->ns_per_byte - dma->ns_per_byte;
+
+    if (!cpu->valid) {
+        LOG_RESULT("%23s", "---");
+    } else if (diff_rate <= 0) {
+        LOG_RESULT("%23s", "never");
+    } else if (dma->fixed_ns <= cpu->fixed_ns) {
+        LOG_RESULT("%23s", "always");
+    } else {
+        LOG_RESULT("%23lu", (unsigned long)((dma->fixed_ns - cpu->fixed_ns) / diff_rate));
+    }
+
+    if (measured > 0) {
+        LOG_RESULT(" | %lu\r\n", (unsigned long)measured);
+    } else {
+        LOG_RESULT(" | ---\r\n");
+    }
+}
+
+int throughput_test_size_model(void)
+{
+    SizeModel_t models[MODEL_NUM_ENGINES];
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    uint32_t first_diff;
+    uint64_t src, dst;
+    int status = DMA_SUCCESS;
+
+    src = memory_alloc_dma_buffer(MEM_REGION_DDR4, MODEL_MAX_SIZE);
+    dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, MODEL_MAX_SIZE);
+    if (!src || !dst) {
+        LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        memory_free_dma_buffer(src);
+        memory_free_dma_buffer(dst);
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    memset(g_ModelNs, 0, sizeof(g_ModelNs));
+    pattern_fill((void*)(uintptr_t)src, MODEL_MAX_SIZE, PATTERN_RANDOM, 0x34);
+    cache_flush_range(src, MODEL_MAX_SIZE);
+
+    LOG_RESULT("  Blocking copies, DDR4 -> DDR4, %lu sizes from 1 B to %lu MB;\r\n",
+               (unsigned long)MODEL_NUM_SIZES, (unsigned long)(MODEL_MAX_SIZE / MB(1)));
+    LOG_RESULT("  model: t = fixed + size / peak, fitted on relative error\r\n\r\n");
+
+    for (uint32_t e = 0; e < MODEL_NUM_ENGINES && !g_TestAbort; e++) {
+        uint32_t largest = 0;
+        bool use_sg;
+
+        ops = dma_ops_get(g_ModelEngines[e]);
+        if (ops == NULL || dma_ops_get_caps(g_ModelEngines[e], &caps) != DMA_SUCCESS) {
+            continue;
+        }
+        if (ops->open_channel != NULL && ops->open_channel(0) != DMA_SUCCESS) {
+            continue;
+        }
+        use_sg = !caps.has_simple;
+
+        memset((void*)(uintptr_t)dst, 0, MODEL_MAX_SIZE);
+        cache_flush_range(dst, MODEL_MAX_SIZE);
+
+        for (uint32_t i = 0; i < MODEL_NUM_SIZES && !g_TestAbort; i++) {
+            uint32_t size = g_ModelSizes[i];
+
+            if (size > caps.max_transfer_len) {
+                continue;
+            }
+            if (size_model_time(ops, use_sg, src, dst, size, &g_ModelNs[e][i]) != DMA_SUCCESS) {
+                g_ModelNs[e][i] = 0;
+                ops->reset();
+                continue;
+            }
+            largest = size;
+        }
+
+        if (ops->close_channel != NULL) {
+            ops->close_channel(0);
+        }
+
+        /* Every copy starts at offset 0, so the largest one covers the rest */
+        if (caps.needs_cache_maint) {
+            cache_invalidate_range(dst, MODEL_MAX_SIZE);
+        }
+        if (largest > 0 &&
+            !memory_compare((void*)(uintptr_t)dst, (void*)(uintptr_t)src, largest, &first_diff)) {
+            LOG_RESULT("  %s: data verification FAILED at offset 0x%08lX\r\n",
+                       ops->name, (unsigned long)first_diff);
+            status = DMA_ERROR_VERIFY_FAIL;
+        }
+    }
+
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
+
+    for (uint32_t e = 0; e < MODEL_NUM_ENGINES; e++) {
+        size_model_fit(g_ModelNs[e], &models[e]);
+    }
+
+    /* Measured time per transfer and residual against the fitted model */
+    LOG_RESULT("  ns per transfer (residual %% vs model):\r\n\r\n");
+    LOG_RESULT("  Size (B) ");
+    for (uint32_t e = 0; e < MODEL_NUM_ENGINES; e++) {
+        LOG_RESULT(" | %-17s", dma_type_to_string(g_ModelEngines[e]));
+    }
+    LOG_RESULT("\r\n  ---------");
+    for (uint32_t e = 0; e < MODEL_NUM_ENGINES; e++) {
+        LOG_RESULT("-|------------------");
+    }
+    LOG_RESULT("\r\n");
+
+    for (uint32_t i = 0; i < MODEL_NUM_SIZES; i++) {
+        LOG_RESULT("  %9lu", (unsigned long)g_ModelSizes[i]);
+        for (uint32_t e = 0; e < MODEL_NUM_ENGINES; e++) {
+            uint32_t ns = g_ModelNs[e][i];
+
+            if (ns == 0 || !models[e].valid) {
+                LOG_RESULT(" | %17s", "---");
+            } else {
+                LOG_RESULT(" | %10lu (%4ld%%)", (unsigned long)ns,
+                           size_model_residual_pct(&models[e], g_ModelSizes[i], ns));
+            }
+        }
+        LOG_RESULT("\r\n");
+    }
+
+    LOG_RESULT("\r\n  Engine     | Fixed (ns) | Peak (MB/s) | Avg err | Max err (@size)     | "
+               "CPU crossover (B) model | measured\r\n");
+    LOG_RESULT("  -----------|------------|-------------|---------|---------------------|"
+               "-------------------------|---------\r\n");
+
+    for (uint32_t e = 0; e < MODEL_NUM_ENGINES; e++) {
+        const SizeModel_t* m = &models[e];
+
+        if (!m->valid) {
+            LOG_RESULT("  %-10s | %10s | %11s | %7s | %19s | %23s | %s\r\n",
+                       dma_type_to_string(g_ModelEngines[e]), "---", "---", "---", "---",
+                       "---", "---");
+            continue;
+        }
+
+        LOG_RESULT("  %-10s | %10ld | %11lu | %6lu%% | %6lu%% @ %10lu | ",
+                   dma_type_to_string(g_ModelEngines[e]),
+                   (long)m->fixed_ns,
+                   (unsigned long)((m->ns_per_byte > 0) ?
+                                   1e9 / (m->ns_per_byte * 1048576.0) : 0),
+                   (unsigned long)m->avg_error_pct,
+                   (unsigned long)m->max_error_pct,
+                   (unsigned long)m->max_error_size);
+
+        if (e == 0) {
+            LOG_RESULT("%23s | ---\r\n", "(reference)");
+        } else {
+            size_model_print_crossover(&models[0], m,
+                                       size_model_measured_crossover(g_ModelNs[0], g_ModelNs[e]));
+        }
+
+        g_BenchmarkStats.tests_run++;
+        g_BenchmarkStats.tests_passed++;
+    }
+
+    LOG_RESULT("\r\n");
+    return status;
+}
+
+/* Alignment sweep: every source/destination offset within a cache line */
+#define ALIGN_SIZE              KB(16)
+#define ALIGN_OFFSETS           BUFFER_ALIGNMENT
+#define ALIGN_GUARD             BUFFER_ALIGNMENT
+#define ALIGN_GUARD_BYTE        0x5A
+#define ALIGN_ITERATIONS        8
+#define ALIGN_MAX_ERRORS        4       /* Consecutive failed points before giving up */
+#define ALIGN_SRC_SPAN          (ALIGN_SIZE + 2 * ALIGN_OFFSETS)
+#define ALIGN_DST_SPAN          (ALIGN_SIZE + 2 * ALIGN_OFFSETS + 2 * ALIGN_GUARD)
+
+static const DmaType_t g_AlignEngines[] = {
+    DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA, DMA_TYPE_LPD_DMA,
+    DMA_TYPE_CPU_MEMCPY
+};
+
+/* Bytes past ALIGN_SIZE: none, then lengths that are not beat/line multiples */
+static const uint32_t g_AlignTails[] = { 0, 1, 2, 3, 4, 7, 8, 15, 16, 31, 33, 63 };
+
+/* Source/destination offsets probed in the length table besides 0/0 */
+#define ALIGN_TAIL_SRC_OFFSET   1
+#define ALIGN_TAIL_DST_OFFSET   3
+
+/* MB/s of one source/destination offset and length; *data_ok covers the guards */
+static int align_measure(const DmaOps_t* ops, const DmaCaps_t* caps, uint64_t src_base,
+                         uint64_t dst_base, uint32_t src_off, uint32_t dst_off,
+                         uint32_t length, uint32_t* mbps, bool* data_ok)
+{
+    const uint8_t* guard = (const uint8_t*)(uintptr_t)dst_base;
+    uint64_t src = src_base + src_off;
+    uint64_t dst = dst_base + ALIGN_GUARD + dst_off;
+    uint32_t end = ALIGN_GUARD + dst_off + length;
+    bool use_sg = !caps->has_simple;
+    uint64_t start, elapsed_ns;
+    int status;
+
+    /* Whole span clean in memory: partial lines at both ends hold guard bytes */
+    memset((void*)(uintptr_t)dst_base, ALIGN_GUARD_BYTE, ALIGN_DST_SPAN);
+    if (caps->needs_cache_maint) {
+        cache_flush_range(dst_base, ALIGN_DST_SPAN);
+    }
+
+    status = dma_ops_transfer(ops, 0, src, dst, length, use_sg);
+    if (status != DMA_SUCCESS) {
+        ops->reset();
+        return status;
+    }
+
+    start = timer_start();
+    for (uint32_t i = 0; i < ALIGN_ITERATIONS; i++) {
+        status = dma_ops_transfer(ops, 0, src, dst, length, use_sg);
+        if (status != DMA_SUCCESS) {
+            ops->reset();
+            return status;
+        }
+    }
+    elapsed_ns = MAX(timer_stop_ns(start), 1);
+
+    *mbps = (uint32_t)(((uint64_t)length * ALIGN_ITERATIONS * 1000000000ULL) /
+                       (elapsed_ns * 1048576ULL));
+
+    if (caps->needs_cache_maint) {
+        cache_invalidate_range(dst_base, ALIGN_DST_SPAN);
+    }
+    *data_ok = memcmp((const void*)(uintptr_t)dst, (const void*)(uintptr_t)src, length) == 0;
+    for (uint32_t i = 0; i < ALIGN_DST_SPAN && *data_ok; i++) {
+        if ((i < ALIGN_GUARD + dst_off || i >= end) && guard[i] != ALIGN_GUARD_BYTE) {
+            *data_ok = false;
+        }
+    }
+
+    g_BenchmarkStats.tests_run++;
+    if (*data_ok) {
+        g_BenchmarkStats.tests_passed++;
+    } else {
+        g_BenchmarkStats.tests_failed++;
+    }
+    g_BenchmarkStats.total_bytes_transferred += (uint64_t)length * (ALIGN_ITERATIONS + 1);
+    g_BenchmarkStats.total_time_us += elapsed_ns / 1000;
+    return DMA_SUCCESS;
+}
+
+static uint32_t align_penalty_pct(uint32_t mbps, uint32_t ref_mbps)
+{
+    return (mbps >= ref_mbps) ? 0 : 100 - CALC_EFFICIENCY(mbps, ref_mbps);
+}
+
+/* Heatmap cell: '.' under 10%, else the penalty's tens digit */
+static char align_cell(uint32_t penalty)
+{
+    return (penalty < 10) ? '.' : (char)('0' + MIN(penalty / 10, 9));
+}
+
+/* Returns the number of failed points; ref_mbps is the 0/0 aligned rate */
+static uint32_t align_heatmap(const DmaOps_t* ops, const DmaCaps_t* caps, uint64_t src,
+                              uint64_t dst, uint32_t* ref_mbps)
+{
+    char row[ALIGN_OFFSETS + 1];
+    uint64_t penalty_sum = 0;
+    uint32_t worst = 0, worst_src = 0, worst_dst = 0;
+    uint32_t failures = 0, errors = 0, points = 0;
+    uint32_t mbps, penalty;
+    bool data_ok;
+
+    *ref_mbps = 0;
+    if (align_measure(ops, caps, src, dst, 0, 0, ALIGN_SIZE, ref_mbps, &data_ok) != DMA_SUCCESS ||
+        *ref_mbps == 0) {
+        LOG_RESULT("  Aligned reference transfer failed\r\n");
+        return 1;
+    }
+
+    LOG_RESULT("  %lu KB copies, aligned %lu MB/s; penalty by source (rows) and\r\n",
+               (unsigned long)(ALIGN_SIZE / 1024), (unsigned long)*ref_mbps);
+    LOG_RESULT("  destination (columns) byte offset:\r\n\r\n");
+
+    LOG_RESULT("          ");
+    for (uint32_t d = 0; d < ALIGN_OFFSETS; d++) {
+        LOG_RESULT("%c", (d % 10 == 0) ? (char)('0' + d / 10) : ' ');
+    }
+    LOG_RESULT("\r\n          ");
+    for (uint32_t d = 0; d < ALIGN_OFFSETS; d++) {
+        LOG_RESULT("%c", (char)('0' + d % 10));
+    }
+    LOG_RESULT("\r\n");
+
+    for (uint32_t s = 0; s < ALIGN_OFFSETS && !g_TestAbort; s++) {
+        for (uint32_t d = 0; d < ALIGN_OFFSETS; d++) {
+            if (errors >= ALIGN_MAX_ERRORS) {
+                row[d] = ' ';
+                continue;
+            }
+            if (align_measure(ops, caps, src, dst, s, d, ALIGN_SIZE, &mbps,
+                              &data_ok) != DMA_SUCCESS) {
+                row[d] = 'E';
+                errors++;
+                failures++;
+                continue;
+            }
+            errors = 0;
+            points++;
+
+            penalty = align_penalty_pct(mbps, *ref_mbps);
+            penalty_sum += penalty;
+            if (penalty > worst) {
+                worst = penalty;
+                worst_src = s;
+                worst_dst = d;
+            }
+            if (!data_ok) {
+                failures++;
+            }
+            row[d] = data_ok ? align_cell(penalty) : '!';
+        }
+        row[ALIGN_OFFSETS] = '\0';
+        LOG_RESULT("  src %2lu  %s\r\n", (unsigned long)s, row);
+
+        if (errors >= ALIGN_MAX_ERRORS) {
+            LOG_RESULT("\r\n  Stopped after %d failed transfers in a row "
+                       "(unaligned addresses rejected?)\r\n", ALIGN_MAX_ERRORS);
+            break;
+        }
+    }
+
+    if (points > 0) {
+        LOG_RESULT("\r\n  Mean penalty %lu%%, worst %lu%% at src %lu / dst %lu\r\n",
+                   (unsigned long)(penalty_sum / points), (unsigned long)worst,
+                   (unsigned long)worst_src, (unsigned long)worst_dst);
+    }
+    return failures;
+}
+
+/* Lengths that are not bus-width multiples, aligned and misaligned */
+static uint32_t align_tail_table(const DmaOps_t* ops, const DmaCaps_t* caps, uint64_t src,
+                                 uint64_t dst, uint32_t ref_mbps)
+{
+    static const uint32_t offsets[2][2] = {
+        { 0, 0 }, { ALIGN_TAIL_SRC_OFFSET, ALIGN_TAIL_DST_OFFSET }
+    };
+    uint32_t failures = 0;
+    uint32_t mbps;
+    bool data_ok;
+
+    LOG_RESULT("\r\n  Length       | 0/0 MB/s | Penalty | %lu/%lu MB/s | Penalty\r\n",
+               (unsigned long)ALIGN_TAIL_SRC_OFFSET, (unsigned long)ALIGN_TAIL_DST_OFFSET);
+    LOG_RESULT("  -------------|----------|---------|----------|--------\r\n");
+
+    for (uint32_t t = 0; t < ARRAY_SIZE(g_AlignTails) && !g_TestAbort; t++) {
+        uint32_t length = ALIGN_SIZE + g_AlignTails[t];
+
+        LOG_RESULT("  %2luK + %2lu B  ", (unsigned long)(ALIGN_SIZE / 1024),
+                   (unsigned long)g_AlignTails[t]);
+        for (uint32_t o = 0; o < 2; o++) {
+            if (align_measure(ops, caps, src, dst, offsets[o][0], offsets[o][1], length,
+                              &mbps, &data_ok) != DMA_SUCCESS) {
+                LOG_RESULT("| %8s | %7s ", "ERROR", "---");
+                failures++;
+                continue;
+            }
+            if (!data_ok) {
+                failures++;
+            }
+            LOG_RESULT("| %7lu%s | %6lu%% ", (unsigned long)mbps, data_ok ? " " : "!",
+                       (unsigned long)align_penalty_pct(mbps, ref_mbps));
+        }
+        LOG_RESULT("\r\n");
+    }
+    return failures;
+}
+
 int throughput_test_alignment(void)
 {
-    TestResult_t result_aligned, result_unaligned;
-    uint32_t size = KB(64);
+    const DmaOps_t* ops;
+    DmaCaps_t caps;
+    uint64_t src, dst;
+    uint32_t ref_mbps;
+    uint32_t failures = 0;
+
+    src = memory_alloc_dma_buffer(MEM_REGION_DDR4, ALIGN_SRC_SPAN);
+    dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, ALIGN_DST_SPAN);
+    if (!src || !dst) {
+        LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        memory_free_dma_buffer(src);
+        memory_free_dma_buffer(dst);
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    pattern_fill((void*)(uintptr_t)src, ALIGN_SRC_SPAN, PATTERN_RANDOM, 0x44);
+    cache_flush_range(src, ALIGN_SRC_SPAN);
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(g_AlignEngines) && !g_TestAbort; e++) {
+        ops = dma_ops_get(g_AlignEngines[e]);
+        if (ops == NULL || dma_ops_get_caps(g_AlignEngines[e], &caps) != DMA_SUCCESS ||
+            caps.max_transfer_len < ALIGN_SIZE + BUFFER_ALIGNMENT) {
+            continue;
+        }
+        if (ops->open_channel != NULL && ops->open_channel(0) != DMA_SUCCESS) {
+            continue;
+        }
+
+        LOG_RESULT("  %s:\r\n\r\n", ops->name);
+        failures += align_heatmap(ops, &caps, src, dst, &ref_mbps);
+        if (ref_mbps > 0 && !g_TestAbort) {
+            failures += align_tail_table(ops, &caps, src, dst, ref_mbps);
+        }
+        LOG_RESULT("\r\n");
+
+        if (ops->close_channel != NULL) {
+            ops->close_channel(0);
+        }
+    }
+
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
+
+    LOG_RESULT("  '.' = under 10%% penalty, 1-9 = 10-19%% .. 90%%+, "
+               "E = transfer error, ! = data/guard mismatch\r\n");
+    LOG_RESULT("  Alignment sweep: %lu failure(s)\r\n", (unsigned long)failures);
+    return (failures == 0) ? DMA_SUCCESS : DMA_ERROR_VERIFY_FAIL;
+}
+
+int throughput_test_mode_matrix(uint32_t size)
+{
+    static const DmaType_t engines[] = {
+        DMA_TYPE_AXI_DMA, DMA_TYPE_AXI_CDMA, DMA_TYPE_AXI_MCDMA,
+        DMA_TYPE_LPD_DMA, DMA_TYPE_CPU_MEMCPY
+    };
+    TestConfig_t config;
+    TestResult_t result;
+    DmaCaps_t caps;
+    char size_str[16];
     int status;
 
-    LOG_RESULT("  Testing AXI CDMA with aligned vs unaligned addresses:\r\n\r\n");
+    results_logger_format_size(size, size_str, sizeof(size_str));
+    LOG_RESULT("  Engine/Mode Matrix (%s per channel, DDR4 -> DDR4):\r\n\r\n", size_str);
+    LOG_RESULT("  Engine     | Mode      | Ch | Bidir | MB/s     | Avg (us) | Setup (us) | Data\r\n");
+    LOG_RESULT("  -----------|-----------|----|-------|----------|----------|------------|-----\r\n");
+
+    for (uint32_t e = 0; e < ARRAY_SIZE(engines); e++) {
+        if (dma_ops_get_caps(engines[e], &caps) != DMA_SUCCESS) {
+            continue;
+        }
+
+        for (uint32_t m = 0; m < DMA_MODE_COUNT; m++) {
+            /* Single channel, all channels, then all channels bidirectional */
+            for (uint32_t v = 0; v < 3; v++) {
+                if (g_TestAbort) return DMA_SUCCESS;
 
-    /* Aligned transfer (64-byte aligned) */
-    memset(&result_aligned, 0, sizeof(result_aligned));
-    status = axi_cdma_test_throughput(MEM_REGION_DDR4, MEM_REGION_DDR4, size, &result_aligned);
+                /* Skip duplicate rows on single-channel engines */
+                if (v > 0 && caps.num_channels < 2) {
+                    continue;
+                }
 
-    if (status == DMA_SUCCESS) {
-        LOG_RESULT("  64-byte aligned:   %.2f MB/s\r\n", result_aligned.throughput_mbps);
+                memset(&config, 0, sizeof(config));
+                config.dma_type = engines[e];
+                config.test_type = TEST_THROUGHPUT;
+                config.src_region = MEM_REGION_DDR4;
+                config.dst_region = MEM_REGION_DDR4;
+                config.pattern = PATTERN_INCREMENTAL;
+                config.mode = (DmaMode_t)m;
+                config.transfer_size = size;
+                config.iterations = DEFAULT_TEST_ITERATIONS;
+                config.num_channels = (v == 0) ? 1 : caps.num_channels;
+                config.verify_data = true;
+                config.aligned = true;
+                config.bidirectional = (v == 2);
+
+                status = benchmark_run_test(&config, &result);
+
+                if (status == DMA_SUCCESS) {
+                    LOG_RESULT("  %-10s | %-9s | %2lu | %-5s | %8lu | %8lu | %10lu | %s\r\n",
+                               dma_type_to_string(engines[e]), dma_mode_to_string(config.mode),
+                               (unsigned long)config.num_channels,
+                               config.bidirectional ? "yes" : "no",
+                               (unsigned long)result.throughput_mbps,
+                               (unsigned long)result.latency_us,
+                               (unsigned long)result.setup_time_us,
+                               result.data_integrity ? "OK" : "FAIL");
+                } else {
+                    LOG_RESULT("  %-10s | %-9s | %2lu | %-5s | %8s | %8s | %10s | %s\r\n",
+                               dma_type_to_string(engines[e]), dma_mode_to_string(config.mode),
+                               (unsigned long)config.num_channels,
+                               config.bidirectional ? "yes" : "no",
+                               "---", "---", "---",
+                               (status == DMA_ERROR_NOT_SUPPORTED) ? "n/a" : "ERR");
+                }
+            }
+        }
     }
 
-    /* Note: True unaligned testing would require modifying the test to use
-     * addresses that are not 64-byte aligned. For now, we report the aligned result. */
+    LOG_RESULT("\r\n");
+    return DMA_SUCCESS;
+}
+
+/* Timed loop of CDMA simple copies, cache maintenance as a real client does it */
+static int cache_elision_run(uint64_t src_addr, uint64_t dst_addr, uint32_t size,
+                             uint32_t iterations, uint64_t* elapsed_us)
+{
+    uint64_t start_time;
+    int status;
+
+    start_time = timer_start();
 
-    LOG_RESULT("  Unaligned:         (requires DRE support)\r\n");
-    LOG_RESULT("\r\n  Note: All transfers use 64-byte aligned addresses for optimal performance.\r\n");
-    LOG_RESULT("  Data Realignment Engine (DRE) is enabled for handling unaligned data.\r\n");
+    for (uint32_t i = 0; i < iterations; i++) {
+        cache_prep_dma_dst(dst_addr, size);
 
+        status = axi_cdma_simple_transfer(src_addr, dst_addr, size);
+        if (status != DMA_SUCCESS) return status;
+
+        status = axi_cdma_wait_complete(DMA_TIMEOUT_US);
+        if (status != DMA_SUCCESS) return status;
+    }
+
+    *elapsed_us = timer_stop_us(start_time);
+    return DMA_SUCCESS;
+}
+
+int throughput_test_cache_elision(void)
+{
+    static const uint32_t sizes[] = {
+        KB(4), KB(16), KB(64), KB(256), MB(1), MB(4), MB(16)
+    };
+    uint32_t iterations = DEFAULT_TEST_ITERATIONS;
+    bool saved_tracking = dma_buf_get_tracking();
+    DmaBufStats_t stats;
+    DmaBuf_t* src_buf;
+    DmaBuf_t* dst_buf;
+    uint64_t src_addr, dst_addr;
+    uint64_t time_us[2];
+    char size_str[16];
+    int status = DMA_SUCCESS;
+
+    LOG_RESULT("  AXI CDMA simple mode, %lu transfers per size, DDR4 -> DDR4:\r\n",
+               (unsigned long)iterations);
+    LOG_RESULT("  'always' = flush/invalidate on every transfer,\r\n");
+    LOG_RESULT("  'owned'  = buffers stay device-owned, redundant maintenance skipped\r\n\r\n");
+    LOG_RESULT("  Size       | Always (us) | Owned (us) | Saved (us) | Saved %% | Elided ops\r\n");
+    LOG_RESULT("  -----------|-------------|------------|------------|---------|-----------\r\n");
+
+    for (uint32_t s = 0; s < ARRAY_SIZE(sizes) && status == DMA_SUCCESS; s++) {
+        uint32_t size = sizes[s];
+
+        if (g_TestAbort) break;
+
+        src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        src_buf = (src_addr != 0) ? dma_buf_register(src_addr, size) : NULL;
+        dst_buf = (dst_addr != 0) ? dma_buf_register(dst_addr, size) : NULL;
+        if (src_buf == NULL || dst_buf == NULL) {
+            dma_buf_unregister(src_buf);
+            dma_buf_unregister(dst_buf);
+            memory_free_dma_buffer(src_addr);
+            memory_free_dma_buffer(dst_addr);
+            status = DMA_ERROR_NO_MEMORY;
+            break;
+        }
+
+        pattern_fill((void*)(uintptr_t)src_addr, size, PATTERN_INCREMENTAL, 0);
+
+        /* Pass 0: tracking off (legacy behavior), pass 1: tracking on */
+        for (uint32_t pass = 0; pass < 2 && status == DMA_SUCCESS; pass++) {
+            dma_buf_set_tracking(pass == 1);
+
+            /* Full-buffer syncs hand both buffers to the device */
+            cache_prep_dma_src(src_addr, size);
+            cache_prep_dma_dst(dst_addr, size);
+            dma_buf_clear_stats();
+
+            status = cache_elision_run(src_addr, dst_addr, size, iterations, &time_us[pass]);
+
+            if (pass == 1) {
+                dma_buf_get_stats(&stats);
+            }
+            cache_complete_dma_dst(dst_addr, size);
+            dma_buf_sync_for_cpu(src_addr, size, DMA_DIR_TO_DEVICE);
+        }
+
+        if (status == DMA_SUCCESS &&
+            !pattern_verify((void*)(uintptr_t)dst_addr, size, PATTERN_INCREMENTAL, 0,
+                            NULL, NULL, NULL)) {
+            status = DMA_ERROR_VERIFY_FAIL;
+        }
+
+        dma_buf_unregister(src_buf);
+        dma_buf_unregister(dst_buf);
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+
+        results_logger_format_size(size, size_str, sizeof(size_str));
+
+        if (status == DMA_SUCCESS) {
+            uint64_t always_us = time_us[0] / iterations;
+            uint64_t owned_us = time_us[1] / iterations;
+            uint64_t saved_us = (time_us[0] > time_us[1]) ? (time_us[0] - time_us[1]) : 0;
+            uint32_t saved_pct = (time_us[0] > 0) ? (uint32_t)((saved_us * 100) / time_us[0]) : 0;
+
+            LOG_RESULT("  %-10s | %11lu | %10lu | %10lu | %6lu%% | %lu\r\n",
+                       size_str, (unsigned long)always_us, (unsigned long)owned_us,
+                       (unsigned long)(saved_us / iterations), (unsigned long)saved_pct,
+                       (unsigned long)stats.elided_ops);
+
+            g_BenchmarkStats.tests_run++;
+            g_BenchmarkStats.tests_passed++;
+            g_BenchmarkStats.total_bytes_transferred += (uint64_t)size * iterations * 2;
+            g_BenchmarkStats.total_time_us += time_us[0] + time_us[1];
+        } else {
+            LOG_RESULT("  %-10s | %11s | %10s | %10s | %7s | %s\r\n",
+                       size_str, "---", "---", "---", "---",
+                       (status == DMA_ERROR_VERIFY_FAIL) ? "VERIFY FAIL" : "ERROR");
+            g_BenchmarkStats.tests_run++;
+            g_BenchmarkStats.tests_failed++;
+        }
+    }
+
+    dma_buf_set_tracking(saved_tracking);
+    LOG_RESULT("\r\n");
+    return status;
+}
+
+/* Mixed workload: 60% 64B-4KB, 30% 4KB-256KB, 10% 256KB-4MB, line aligned */
+#define DISPATCH_WORKLOAD_OPS   256
+#define DISPATCH_MAX_SIZE       MB(4)
+
+static void dispatch_build_workload(uint32_t* sizes, uint32_t count)
+{
+    pattern_seed_prng(0x5EED0031);
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t r = pattern_get_random();
+        uint32_t lo, hi;
+
+        if ((r % 10) < 6) {
+            lo = 64;       hi = KB(4);
+        } else if ((r % 10) < 9) {
+            lo = KB(4);    hi = KB(256);
+        } else {
+            lo = KB(256);  hi = DISPATCH_MAX_SIZE;
+        }
+        sizes[i] = ALIGN_UP(lo + (pattern_get_random() % (hi - lo)), BUFFER_ALIGNMENT);
+    }
+}
+
+int throughput_test_dispatch_mixed(void)
+{
+    static const struct {
+        const char* name;
+        uint32_t flags;
+    } choices[] = {
+        { "Dispatcher", DMA_MEMCPY_F_AUTO },
+        { "CPU only",   DMA_MEMCPY_F_CPU },
+        { "CDMA only",  DMA_MEMCPY_F_CDMA },
+        { "MCDMA only", DMA_MEMCPY_F_MCDMA },
+        { "LPD only",   DMA_MEMCPY_F_LPD }
+    };
+    static uint32_t sizes[DISPATCH_WORKLOAD_OPS];
+    DmaMemcpyStats_t stats;
+    uint64_t total_bytes = 0;
+    uint64_t auto_us = 0;
+    uint32_t largest = 0;
+    uint32_t first_diff;
+    int status;
+
+    uint64_t src = memory_alloc_dma_buffer(MEM_REGION_DDR4, DISPATCH_MAX_SIZE);
+    uint64_t dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, DISPATCH_MAX_SIZE);
+
+    if (!src || !dst) {
+        LOG_RESULT("  ERROR: Could not allocate test buffers\r\n");
+        memory_free_dma_buffer(src);
+        memory_free_dma_buffer(dst);
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    dma_memcpy_print_table();
+
+    dispatch_build_workload(sizes, DISPATCH_WORKLOAD_OPS);
+    for (uint32_t i = 0; i < DISPATCH_WORKLOAD_OPS; i++) {
+        total_bytes += sizes[i];
+        largest = MAX(largest, sizes[i]);
+    }
+    pattern_fill((void*)(uintptr_t)src, DISPATCH_MAX_SIZE, PATTERN_RANDOM, 0x31);
+
+    LOG_RESULT("\r\n  Mixed workload: %lu copies, %lu KB total, DDR4 -> DDR4\r\n\r\n",
+               (unsigned long)DISPATCH_WORKLOAD_OPS, (unsigned long)(total_bytes / 1024));
+    LOG_RESULT("  Mover      | Total (us) | MB/s     | vs Dispatcher | Data\r\n");
+    LOG_RESULT("  -----------|------------|----------|---------------|-----\r\n");
+
+    for (uint32_t c = 0; c < ARRAY_SIZE(choices); c++) {
+        uint64_t start, elapsed_us;
+        bool ok;
+
+        if (g_TestAbort) break;
+
+        memset((void*)(uintptr_t)dst, 0, DISPATCH_MAX_SIZE);
+        cache_flush_range(dst, DISPATCH_MAX_SIZE);
+        dma_memcpy_clear_stats();
+        status = DMA_SUCCESS;
+
+        start = timer_start();
+        for (uint32_t i = 0; i < DISPATCH_WORKLOAD_OPS && status == DMA_SUCCESS; i++) {
+            status = dma_memcpy((void*)(uintptr_t)dst, (const void*)(uintptr_t)src,
+                                sizes[i], choices[c].flags);
+        }
+        elapsed_us = timer_stop_us(start);
+
+        if (status != DMA_SUCCESS) {
+            LOG_RESULT("  %-10s | %10s | %8s | %13s | %s\r\n", choices[c].name,
+                       "---", "---", "---",
+                       (status == DMA_ERROR_NOT_SUPPORTED) ? "n/a" : "ERR");
+            continue;
+        }
+
+        if (c == 0) {
+            auto_us = elapsed_us;
+            dma_memcpy_get_stats(&stats);
+        }
+
+        /* Every copy starts at offset 0, so the largest one covers the rest */
+        ok = memory_compare((void*)(uintptr_t)dst, (void*)(uintptr_t)src, largest, &first_diff);
+
+        LOG_RESULT("  %-10s | %10lu | %8lu | %12lu%% | %s\r\n", choices[c].name,
+                   (unsigned long)elapsed_us,
+                   (unsigned long)CALC_THROUGHPUT_MBPS(total_bytes, elapsed_us),
+                   (unsigned long)((auto_us > 0) ? (elapsed_us * 100) / auto_us : 0),
+                   ok ? "OK" : "FAIL");
+
+        g_BenchmarkStats.tests_run++;
+        if (ok) {
+            g_BenchmarkStats.tests_passed++;
+        } else {
+            g_BenchmarkStats.tests_failed++;
+        }
+        g_BenchmarkStats.total_bytes_transferred += total_bytes;
+        g_BenchmarkStats.total_time_us += elapsed_us;
+    }
+
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
+
+    if (auto_us > 0) {
+        LOG_RESULT("\r\n  Dispatcher choices:\r\n");
+        for (uint32_t m = 0; m < DMA_MEMCPY_MOVER_COUNT; m++) {
+            LOG_RESULT("    %-6s %5lu copies, %8lu KB\r\n",
+                       dma_memcpy_mover_to_string((DmaMemcpyMover_t)m),
+                       (unsigned long)stats.calls[m],
+                       (unsigned long)(stats.bytes[m] / 1024));
+        }
+    }
+
+    LOG_RESULT("\r\n");
     return DMA_SUCCESS;
 }
@@ -21,7 +21,9 @@ int throughput_test_run_all(void);
 int throughput_test_run_memory_matrix(void);
 
 /**
- * @brief Run CPU memcpy baseline test
+ * @brief Run the CPU copy baseline: memcpy and the cpu_copy kernels
+ *        (NEON, NEON with prefetch distances, LDNP/STNP, DC ZVA) over
+ *        DDR and OCM region pairs, with cold and warm caches
  * @return 0 on success, negative error code on failure
  */
 int throughput_test_run_cpu_baseline(void);
@@ -34,9 +36,44 @@ int throughput_test_run_cpu_baseline(void);
 int throughput_test_size_sweep(DmaType_t dma_type);
 
 /**
- * @brief Run aligned vs unaligned transfer test
+ * @brief Sweep dense (including odd) sizes on every engine and fit each to
+ *        t = fixed + size / peak; reports fit, residuals and the size at
+ *        which each engine overtakes CPU memcpy
+ * @return 0 on success, negative error code on failure
+ */
+int throughput_test_size_model(void);
+
+/**
+ * @brief Sweep source and destination byte offsets 0..63 on every engine
+ *
+ * Prints a penalty heatmap against the aligned rate per engine, then a
+ * table of lengths that are not bus-width multiples. Destination guard
+ * bytes are checked at every point.
+ *
  * @return 0 on success, negative error code on failure
  */
 int throughput_test_alignment(void);
 
+/**
+ * @brief Run every engine through every mode/channel combination
+ *        via the generic runner (benchmark_run_test)
+ * @param size Transfer size in bytes per channel
+ * @return 0 on success, negative error code on failure
+ */
+int throughput_test_mode_matrix(uint32_t size);
+
+/**
+ * @brief Compare per-transfer time with and without buffer-ownership
+ *        tracking eliding redundant cache maintenance (AXI CDMA)
+ * @return 0 on success, negative error code on failure
+ */
+int throughput_test_cache_elision(void);
+
+/**
+ * @brief Run a mixed-size copy workload through dma_memcpy() with the
+ *        dispatcher choosing, then with each mover fixed
+ * @return 0 on success, negative error code on failure
+ */
+int throughput_test_dispatch_mixed(void);
+
 #endif /* THROUGHPUT_TEST_H */
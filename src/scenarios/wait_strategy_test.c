@@ -0,0 +1,274 @@
+/**
+ * @file wait_strategy_test.c
+ * @brief Completion-Wait Strategy Comparison Implementation
+ *
+ * Runs the same transfers under every completion-wait strategy and reports
+ * latency, throughput and the number of MMIO reads spent waiting.
+ */
+
+#include <string.h>
+#include "wait_strategy_test.h"
+#include "../utils/debug_print.h"
+#include "../drivers/axi_dma_driver.h"
+#include "../drivers/axi_cdma_driver.h"
+#include "../drivers/axi_mcdma_driver.h"
+#include "../drivers/lpd_dma_driver.h"
+#include "../utils/timer_utils.h"
+#include "../utils/memory_utils.h"
+#include "../utils/data_patterns.h"
+#include "../utils/cache_utils.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define WAIT_TEST_ITERATIONS    200
+#define WAIT_TEST_WARMUP        10
+
+#define WAIT_CALIB_SMALL_SIZE   64
+#define WAIT_CALIB_LARGE_SIZE   MB(1)
+
+static const uint32_t g_WaitTestSizes[] = {
+    64, 256, KB(1), KB(4), KB(16), KB(64), KB(256), MB(1)
+};
+
+static const DmaType_t g_WaitTestEngines[] = {
+    DMA_TYPE_AXI_DMA,
+    DMA_TYPE_AXI_CDMA,
+    DMA_TYPE_AXI_MCDMA,
+    DMA_TYPE_LPD_DMA
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int wait_test_transfer(DmaType_t dma_type, uint64_t src_addr,
+                              uint64_t dst_addr, uint32_t size)
+{
+    int status;
+
+    switch (dma_type) {
+        case DMA_TYPE_AXI_DMA:
+            if (axi_dma_get_instance()->sg_mode) {
+                status = axi_dma_sg_transfer(src_addr, dst_addr, size);
+            } else {
+                status = axi_dma_simple_transfer(src_addr, dst_addr, size);
+            }
+            if (status != DMA_SUCCESS) return status;
+            return axi_dma_wait_complete(DMA_TIMEOUT_US);
+
+        case DMA_TYPE_AXI_CDMA:
+            if (axi_cdma_get_instance()->sg_mode) {
+                status = axi_cdma_sg_transfer(src_addr, dst_addr, size);
+            } else {
+                status = axi_cdma_simple_transfer(src_addr, dst_addr, size);
+            }
+            if (status != DMA_SUCCESS) return status;
+            return axi_cdma_wait_complete(DMA_TIMEOUT_US);
+
+        case DMA_TYPE_AXI_MCDMA:
+            status = axi_mcdma_transfer(0, src_addr, dst_addr, size);
+            if (status != DMA_SUCCESS) return status;
+            return axi_mcdma_wait_complete(0, DMA_TIMEOUT_US);
+
+        case DMA_TYPE_LPD_DMA:
+            status = lpd_dma_transfer(0, src_addr, dst_addr, size);
+            if (status != DMA_SUCCESS) return status;
+            return lpd_dma_wait_complete(0, DMA_TIMEOUT_US);
+
+        default:
+            return DMA_ERROR_NOT_SUPPORTED;
+    }
+}
+
+static void print_result_row(const char* engine, uint32_t size, WaitStrategy_t strategy,
+                             const WaitStrategyResult_t* r)
+{
+    /* Reads per transfer with one decimal, xil_printf has no %f */
+    uint32_t reads_x10 = (uint32_t)((r->mmio_reads * 10) / r->iterations);
+
+    LOG_RESULT("  %-9s | %7lu | %-10s | %8lu | %8lu | %8lu | %7lu | %5lu.%lu\r\n",
+               engine, (unsigned long)size, dma_wait_strategy_to_string(strategy),
+               (unsigned long)r->avg_latency_ns, (unsigned long)r->min_latency_ns,
+               (unsigned long)r->max_latency_ns, (unsigned long)r->throughput_mbps,
+               (unsigned long)(reads_x10 / 10), (unsigned long)(reads_x10 % 10));
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int wait_strategy_test_run_all(void)
+{
+    WaitStrategyResult_t result;
+    WaitStrategy_t saved_strategy = dma_wait_get_strategy();
+    uint32_t e, s, w;
+    int status;
+
+    LOG_RESULT("\r\n");
+    LOG_RESULT("================================================================\r\n");
+    LOG_RESULT("              Completion-Wait Strategy Comparison\r\n");
+    LOG_RESULT("================================================================\r\n\r\n");
+
+    axi_mcdma_enable_mm2s_channel(0, false);
+    axi_mcdma_enable_s2mm_channel(0, false);
+
+    /* Calibrate predictive waits from measured behavior */
+    LOG_RESULT("Predictive-wait calibration:\r\n");
+    for (e = 0; e < ARRAY_SIZE(g_WaitTestEngines); e++) {
+        if (wait_strategy_test_calibrate(g_WaitTestEngines[e]) == DMA_SUCCESS) {
+            const DmaWaitCalib_t* calib = dma_wait_get_calibration(g_WaitTestEngines[e]);
+            LOG_RESULT("  %-9s: %lu MB/s, %lu ns fixed\r\n",
+                       dma_type_to_string(g_WaitTestEngines[e]),
+                       (unsigned long)calib->bandwidth_mbps, (unsigned long)calib->fixed_ns);
+        }
+    }
+
+    LOG_RESULT("\r\n  Engine    | Size    | Strategy   | Avg (ns) | Min (ns) | Max (ns) | MB/s    | MMIO/xfer\r\n");
+    LOG_RESULT("  ----------|---------|------------|----------|----------|----------|---------|----------\r\n");
+
+    for (e = 0; e < ARRAY_SIZE(g_WaitTestEngines); e++) {
+        for (s = 0; s < ARRAY_SIZE(g_WaitTestSizes); s++) {
+            for (w = 0; w < WAIT_STRATEGY_COUNT; w++) {
+                if (g_TestAbort) goto done;
+
+                status = wait_strategy_test_run(g_WaitTestEngines[e], g_WaitTestSizes[s],
+                                                (WaitStrategy_t)w, &result);
+                if (status != DMA_SUCCESS) {
+                    LOG_RESULT("  %-9s | %7lu | %-10s | %8s | %8s | %8s | %7s | %9s\r\n",
+                               dma_type_to_string(g_WaitTestEngines[e]),
+                               (unsigned long)g_WaitTestSizes[s],
+                               dma_wait_strategy_to_string((WaitStrategy_t)w),
+                               "---", "---", "---", "---", "---");
+                    continue;
+                }
+
+                print_result_row(dma_type_to_string(g_WaitTestEngines[e]),
+                                 g_WaitTestSizes[s], (WaitStrategy_t)w, &result);
+            }
+        }
+        LOG_RESULT("\r\n");
+    }
+
+done:
+    axi_mcdma_disable_mm2s_channel(0);
+    axi_mcdma_disable_s2mm_channel(0);
+    dma_wait_set_strategy(saved_strategy);
+
+    LOG_RESULT("Wait strategy comparison complete.\r\n");
+    return DMA_SUCCESS;
+}
+
+int wait_strategy_test_run(DmaType_t dma_type, uint32_t size,
+                           WaitStrategy_t strategy, WaitStrategyResult_t* result)
+{
+    uint64_t src_addr, dst_addr;
+    uint64_t start, lat_ns;
+    uint64_t total_ns = 0;
+    uint64_t min_ns = UINT64_MAX;
+    uint64_t max_ns = 0;
+    DmaWaitStats_t stats;
+    uint32_t i;
+    int status;
+
+    if (result == NULL || size == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (src_addr == 0 || dst_addr == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    status = dma_wait_set_strategy(strategy);
+    if (status != DMA_SUCCESS) {
+        goto out;
+    }
+
+    pattern_fill((void*)(uintptr_t)src_addr, size, PATTERN_INCREMENTAL, 0);
+    cache_prep_dma_src(src_addr, size);
+
+    /* Warmup */
+    for (i = 0; i < WAIT_TEST_WARMUP; i++) {
+        cache_prep_dma_dst(dst_addr, size);
+        status = wait_test_transfer(dma_type, src_addr, dst_addr, size);
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+    }
+
+    /* Timed iterations; counters cover only the measured waits */
+    dma_wait_clear_stats();
+
+    for (i = 0; i < WAIT_TEST_ITERATIONS; i++) {
+        cache_prep_dma_dst(dst_addr, size);
+
+        start = timer_start();
+        status = wait_test_transfer(dma_type, src_addr, dst_addr, size);
+        lat_ns = timer_stop_ns(start);
+
+        if (status != DMA_SUCCESS) {
+            goto out;
+        }
+
+        total_ns += lat_ns;
+        if (lat_ns < min_ns) min_ns = lat_ns;
+        if (lat_ns > max_ns) max_ns = lat_ns;
+    }
+
+    dma_wait_get_stats(&stats);
+
+    memset(result, 0, sizeof(*result));
+    result->iterations = WAIT_TEST_ITERATIONS;
+    result->min_latency_ns = (uint32_t)min_ns;
+    result->avg_latency_ns = (uint32_t)(total_ns / WAIT_TEST_ITERATIONS);
+    result->max_latency_ns = (uint32_t)max_ns;
+    result->throughput_mbps = CALC_THROUGHPUT_MBPS((uint64_t)size * WAIT_TEST_ITERATIONS,
+                                                   total_ns / 1000);
+    result->mmio_reads = stats.mmio_reads;
+    result->bd_reads = stats.bd_reads;
+    result->polls = stats.polls;
+    status = DMA_SUCCESS;
+
+out:
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
+}
+
+int wait_strategy_test_calibrate(DmaType_t dma_type)
+{
+    WaitStrategyResult_t small, large;
+    WaitStrategy_t saved_strategy = dma_wait_get_strategy();
+    uint64_t stream_ns;
+    uint32_t bandwidth_mbps;
+    int status;
+
+    /* Calibrate with the tight spin so the wait itself adds no quantization */
+    status = wait_strategy_test_run(dma_type, WAIT_CALIB_SMALL_SIZE,
+                                    WAIT_STRATEGY_MMIO_SPIN, &small);
+    if (status == DMA_SUCCESS) {
+        status = wait_strategy_test_run(dma_type, WAIT_CALIB_LARGE_SIZE,
+                                        WAIT_STRATEGY_MMIO_SPIN, &large);
+    }
+    dma_wait_set_strategy(saved_strategy);
+
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    /* Fixed cost from the smallest transfer, bandwidth from the remainder */
+    if (large.min_latency_ns <= small.min_latency_ns) {
+        return DMA_ERROR_DMA_FAIL;
+    }
+
+    stream_ns = large.min_latency_ns - small.min_latency_ns;
+    bandwidth_mbps = (uint32_t)(((uint64_t)WAIT_CALIB_LARGE_SIZE * 1000000000ULL) /
+                                (stream_ns * 1048576ULL));
+
+    dma_wait_calibrate(dma_type, bandwidth_mbps, small.min_latency_ns);
+    return DMA_SUCCESS;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file wait_strategy_test.h
+ * @brief Completion-Wait Strategy Comparison Header
+ */
+
+#ifndef WAIT_STRATEGY_TEST_H
+#define WAIT_STRATEGY_TEST_H
+
+#include "../dma_benchmark.h"
+#include "../utils/dma_wait.h"
+
+/**
+ * @brief Result of one engine/size/strategy measurement
+ */
+typedef struct {
+    uint32_t iterations;
+    uint32_t min_latency_ns;
+    uint32_t avg_latency_ns;
+    uint32_t max_latency_ns;
+    uint32_t throughput_mbps;
+    uint64_t mmio_reads;        /* Status register reads while waiting */
+    uint64_t bd_reads;          /* Descriptor status reads while waiting */
+    uint64_t polls;             /* Poll loop iterations */
+} WaitStrategyResult_t;
+
+/**
+ * @brief Run the full wait-strategy comparison on every engine
+ * @return 0 on success, negative error code on failure
+ */
+int wait_strategy_test_run_all(void);
+
+/**
+ * @brief Measure one engine/size with a given wait strategy
+ * @param dma_type DMA engine (AXI DMA, CDMA, MCDMA ch0 or LPD ch0)
+ * @param size Transfer size in bytes
+ * @param strategy Wait strategy to use
+ * @param result Result output
+ * @return 0 on success, negative error code on failure
+ */
+int wait_strategy_test_run(DmaType_t dma_type, uint32_t size,
+                           WaitStrategy_t strategy, WaitStrategyResult_t* result);
+
+/**
+ * @brief Calibrate predictive-wait bandwidth and fixed cost for an engine
+ * @param dma_type DMA engine
+ * @return 0 on success, negative error code on failure
+ */
+int wait_strategy_test_calibrate(DmaType_t dma_type);
+
+#endif /* WAIT_STRATEGY_TEST_H */
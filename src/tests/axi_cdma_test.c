@@ -11,14 +11,9 @@
 #include "../utils/data_patterns.h"
 #include "../utils/results_logger.h"
 #include "../utils/cache_utils.h"
+#include "../utils/dma_buf.h"
 #include "../utils/debug_print.h"
-
-/*******************************************************************************
- * Local Variables
- ******************************************************************************/
-
-#define SRC_BUFFER_OFFSET   0x02000000  /* 32MB offset */
-#define DST_BUFFER_OFFSET   0x03000000  /* 48MB offset */
+#include "../utils/dma_phase.h"
 
 /*******************************************************************************
  * Helper Functions
@@ -32,8 +27,14 @@ static int run_cdma_transfer(uint64_t src_addr, uint64_t dst_addr,
     uint32_t iterations = DEFAULT_TEST_ITERATIONS;
     uint32_t warmup = WARMUP_ITERATIONS;
     uint32_t i, error_offset;
-    int status;
+    int status = DMA_SUCCESS;
     uint8_t expected, actual;
+    DmaBuf_t* src_buf;
+    DmaBuf_t* dst_buf;
+
+    /* Track ownership so the untouched buffers are not re-flushed every iteration */
+    src_buf = dma_buf_register(src_addr, size);
+    dst_buf = dma_buf_register(dst_addr, size);
 
     /* Fill source buffer */
     pattern_fill((void*)(uintptr_t)src_addr, size, pattern, 0xABCDEF01);
@@ -50,13 +51,14 @@ static int run_cdma_transfer(uint64_t src_addr, uint64_t dst_addr,
         } else {
             status = axi_cdma_simple_transfer(src_addr, dst_addr, size);
         }
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
 
         status = axi_cdma_wait_complete(DMA_TIMEOUT_US);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
     }
 
     /* Timed iterations */
+    dma_phase_record_start();
     start_time = timer_start();
 
     for (i = 0; i < iterations; i++) {
@@ -67,13 +69,14 @@ static int run_cdma_transfer(uint64_t src_addr, uint64_t dst_addr,
         } else {
             status = axi_cdma_simple_transfer(src_addr, dst_addr, size);
         }
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
 
         status = axi_cdma_wait_complete(DMA_TIMEOUT_US);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
     }
 
     elapsed_us = timer_stop_us(start_time);
+    dma_phase_record_stop(result->phase_ns);
 
     /* Verify data */
     cache_complete_dma_dst(dst_addr, size);
@@ -96,7 +99,11 @@ static int run_cdma_transfer(uint64_t src_addr, uint64_t dst_addr,
     result->error_count = integrity ? 0 : 1;
     result->first_error_offset = integrity ? 0 : error_offset;
 
-    return DMA_SUCCESS;
+out:
+    dma_phase_record_stop(NULL);
+    dma_buf_unregister(src_buf);
+    dma_buf_unregister(dst_buf);
+    return status;
 }
 
 /*******************************************************************************
@@ -148,25 +155,14 @@ int axi_cdma_test_throughput(MemoryRegion_t src_region, MemoryRegion_t dst_regio
 {
     uint64_t src_addr, dst_addr;
 
-    /* Determine buffer offset based on region */
-    uint32_t src_offset = SRC_BUFFER_OFFSET;
-    uint32_t dst_offset = DST_BUFFER_OFFSET;
-
-    /* Adjust for smaller regions */
-    if (src_region == MEM_REGION_OCM || src_region == MEM_REGION_BRAM ||
-        src_region == MEM_REGION_URAM) {
-        src_offset = 0;
-    }
-    if (dst_region == MEM_REGION_OCM || dst_region == MEM_REGION_BRAM ||
-        dst_region == MEM_REGION_URAM) {
-        dst_offset = size;  /* Use second half of small regions */
-    }
-
-    src_addr = memory_get_test_addr(src_region, src_offset, size);
-    dst_addr = memory_get_test_addr(dst_region, dst_offset, size);
+    /* Small regions (OCM) are packed by the allocator */
+    src_addr = memory_alloc_dma_buffer(src_region, size);
+    dst_addr = memory_alloc_dma_buffer(dst_region, size);
 
     if (src_addr == 0 || dst_addr == 0) {
-        return DMA_ERROR_INVALID_PARAM;
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
     }
 
     int status = run_cdma_transfer(src_addr, dst_addr, size,
@@ -175,6 +171,8 @@ int axi_cdma_test_throughput(MemoryRegion_t src_region, MemoryRegion_t dst_regio
     result->src_region = src_region;
     result->dst_region = dst_region;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return status;
 }
 
@@ -187,11 +185,13 @@ int axi_cdma_test_latency(MemoryRegion_t src_region, MemoryRegion_t dst_region,
     uint64_t total_ns = 0;
     int status;
 
-    src_addr = memory_get_test_addr(src_region, 0, size);
-    dst_addr = memory_get_test_addr(dst_region, size * 2, size);
+    src_addr = memory_alloc_dma_buffer(src_region, size);
+    dst_addr = memory_alloc_dma_buffer(dst_region, size);
 
     if (src_addr == 0 || dst_addr == 0) {
-        return DMA_ERROR_INVALID_PARAM;
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
     }
 
     /* Prepare */
@@ -220,6 +220,8 @@ int axi_cdma_test_latency(MemoryRegion_t src_region, MemoryRegion_t dst_region,
     result->latency_us = result->latency_ns / 1000;
     result->data_integrity = true;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return DMA_SUCCESS;
 }
 
@@ -228,8 +230,13 @@ int axi_cdma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     uint64_t src_addr, dst_addr;
     uint32_t size = KB(64);
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, SRC_BUFFER_OFFSET, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, DST_BUFFER_OFFSET, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (src_addr == 0 || dst_addr == 0) {
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
+    }
 
     int status = run_cdma_transfer(src_addr, dst_addr, size, pattern, false, result);
 
@@ -237,6 +244,8 @@ int axi_cdma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     result->src_region = MEM_REGION_DDR4;
     result->dst_region = MEM_REGION_DDR4;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return status;
 }
 
@@ -250,6 +259,7 @@ int axi_cdma_test_memory_matrix(void)
     MemoryRegion_t regions[] = {
         MEM_REGION_DDR4,
         MEM_REGION_LPDDR4,
+        MEM_REGION_DDR_HIGH,
         MEM_REGION_OCM,
         MEM_REGION_BRAM,
         MEM_REGION_URAM
@@ -13,14 +13,12 @@
 #include "../utils/results_logger.h"
 #include "../utils/cache_utils.h"
 #include "../utils/debug_print.h"
+#include "../utils/dma_phase.h"
 
 /*******************************************************************************
  * Local Variables
  ******************************************************************************/
 
-/* Test buffers - using fixed region offsets */
-#define SRC_BUFFER_OFFSET   0x00000000
-#define DST_BUFFER_OFFSET   0x01000000  /* 16MB offset */
 #define MAX_TEST_SIZE       MB(16)
 
 /*******************************************************************************
@@ -73,6 +71,7 @@ static int run_single_transfer_test(uint64_t src_addr, uint64_t dst_addr,
     LOG_DEBUG("Warmup complete\r\n");
 
     /* Timed iterations */
+    dma_phase_record_start();
     start_time = timer_start();
 
     for (i = 0; i < iterations; i++) {
@@ -94,6 +93,7 @@ static int run_single_transfer_test(uint64_t src_addr, uint64_t dst_addr,
     }
 
     elapsed_us = timer_stop_us(start_time);
+    dma_phase_record_stop(result->phase_ns);
 
     /* Verify last transfer */
     cache_complete_dma_dst(dst_addr, size);
@@ -212,9 +212,9 @@ int axi_dma_test_throughput(MemoryRegion_t src_region, MemoryRegion_t dst_region
     LOG_DEBUG("AXI DMA Test: src_region=%d, dst_region=%d, size=%lu\r\n",
               (int)src_region, (int)dst_region, (unsigned long)size);
 
-    /* Get test addresses */
-    src_addr = memory_get_test_addr(src_region, SRC_BUFFER_OFFSET, size);
-    dst_addr = memory_get_test_addr(dst_region, DST_BUFFER_OFFSET, size);
+    /* Allocate test buffers */
+    src_addr = memory_alloc_dma_buffer(src_region, size);
+    dst_addr = memory_alloc_dma_buffer(dst_region, size);
 
     LOG_DEBUG("AXI DMA Test: src_addr=0x%llX, dst_addr=0x%llX\r\n",
               (unsigned long long)src_addr, (unsigned long long)dst_addr);
@@ -222,7 +222,9 @@ int axi_dma_test_throughput(MemoryRegion_t src_region, MemoryRegion_t dst_region
     if (src_addr == 0 || dst_addr == 0) {
         LOG_ERROR("AXI DMA Test: Invalid address! src=0x%llX, dst=0x%llX\r\n",
                   (unsigned long long)src_addr, (unsigned long long)dst_addr);
-        return DMA_ERROR_INVALID_PARAM;
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
     }
 
     /* Run test */
@@ -232,6 +234,8 @@ int axi_dma_test_throughput(MemoryRegion_t src_region, MemoryRegion_t dst_region
     result->src_region = src_region;
     result->dst_region = dst_region;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return status;
 }
 
@@ -244,11 +248,13 @@ int axi_dma_test_latency(MemoryRegion_t src_region, MemoryRegion_t dst_region, T
     int status;
     uint32_t i;
 
-    src_addr = memory_get_test_addr(src_region, SRC_BUFFER_OFFSET, size);
-    dst_addr = memory_get_test_addr(dst_region, DST_BUFFER_OFFSET, size);
+    src_addr = memory_alloc_dma_buffer(src_region, size);
+    dst_addr = memory_alloc_dma_buffer(dst_region, size);
 
     if (src_addr == 0 || dst_addr == 0) {
-        return DMA_ERROR_INVALID_PARAM;
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
     }
 
     /* Prepare buffers */
@@ -297,6 +303,8 @@ int axi_dma_test_latency(MemoryRegion_t src_region, MemoryRegion_t dst_region, T
     result->max_latency = (uint32_t)(max_ns / 1000);
     result->data_integrity = true;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return DMA_SUCCESS;
 }
 
@@ -307,8 +315,13 @@ int axi_dma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     uint32_t size = KB(64);  /* Use 64KB for integrity test */
     int status;
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, SRC_BUFFER_OFFSET, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, DST_BUFFER_OFFSET, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (src_addr == 0 || dst_addr == 0) {
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
+    }
 
     /* Run test with specified pattern */
     status = run_single_transfer_test(src_addr, dst_addr, size, pattern, true, result);
@@ -318,6 +331,8 @@ int axi_dma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     result->dst_region = MEM_REGION_DDR4;
     result->pattern = pattern;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return status;
 }
 
@@ -325,24 +340,40 @@ int axi_dma_test_simple_mode(TestResult_t* result)
 {
     uint64_t src_addr, dst_addr;
     uint32_t size = KB(64);  /* 64KB - can go up to 64MB with 26-bit length */
+    int status;
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, SRC_BUFFER_OFFSET, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, DST_BUFFER_OFFSET, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (src_addr == 0 || dst_addr == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+    } else {
+        status = run_single_transfer_test(src_addr, dst_addr, size,
+                                          PATTERN_INCREMENTAL, false, result);
+    }
 
-    return run_single_transfer_test(src_addr, dst_addr, size,
-                                    PATTERN_INCREMENTAL, false, result);
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
 }
 
 int axi_dma_test_sg_mode(TestResult_t* result)
 {
     uint64_t src_addr, dst_addr;
     uint32_t size = KB(64);  /* 64KB - can go up to 64MB with 26-bit length */
+    int status;
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, SRC_BUFFER_OFFSET, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, DST_BUFFER_OFFSET, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (src_addr == 0 || dst_addr == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+    } else {
+        status = run_single_transfer_test(src_addr, dst_addr, size,
+                                          PATTERN_INCREMENTAL, true, result);
+    }
 
-    return run_single_transfer_test(src_addr, dst_addr, size,
-                                    PATTERN_INCREMENTAL, true, result);
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
 }
 
 int axi_dma_test_bidirectional(TestResult_t* result)
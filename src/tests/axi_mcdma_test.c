@@ -12,14 +12,20 @@
 #include "../utils/data_patterns.h"
 #include "../utils/results_logger.h"
 #include "../utils/cache_utils.h"
+#include "../utils/dma_phase.h"
 
 /*******************************************************************************
- * Local Variables
+ * Helper Functions
  ******************************************************************************/
 
-#define MCDMA_SRC_BASE_OFFSET  0x04000000  /* 64MB */
-#define MCDMA_DST_BASE_OFFSET  0x05000000  /* 80MB */
-#define MCDMA_CHANNEL_SPACING  0x00100000  /* 1MB per channel */
+static void free_channel_buffers(uint64_t* src_addrs, uint64_t* dst_addrs,
+                                 uint32_t num_channels)
+{
+    for (uint32_t ch = 0; ch < num_channels; ch++) {
+        memory_free_dma_buffer(src_addrs[ch]);
+        memory_free_dma_buffer(dst_addrs[ch]);
+    }
+}
 
 /*******************************************************************************
  * Public Functions
@@ -79,15 +85,12 @@ int axi_mcdma_test_single_channel(uint32_t channel, uint32_t size, TestResult_t*
     uint32_t i;
     int status;
 
-    /* Calculate addresses for this channel */
-    uint32_t src_offset = MCDMA_SRC_BASE_OFFSET + (channel * MCDMA_CHANNEL_SPACING);
-    uint32_t dst_offset = MCDMA_DST_BASE_OFFSET + (channel * MCDMA_CHANNEL_SPACING);
-
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, src_offset, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, dst_offset, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
     if (src_addr == 0 || dst_addr == 0) {
-        return DMA_ERROR_INVALID_PARAM;
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
     }
 
     /* Prepare buffers */
@@ -99,25 +102,27 @@ int axi_mcdma_test_single_channel(uint32_t channel, uint32_t size, TestResult_t*
     /* Warmup */
     for (i = 0; i < WARMUP_ITERATIONS; i++) {
         status = axi_mcdma_transfer(channel, src_addr, dst_addr, size);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
         status = axi_mcdma_wait_complete(channel, DMA_TIMEOUT_US);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
     }
 
     /* Timed iterations */
+    dma_phase_record_start();
     start_time = timer_start();
 
     for (i = 0; i < iterations; i++) {
         cache_prep_dma_dst(dst_addr, size);
 
         status = axi_mcdma_transfer(channel, src_addr, dst_addr, size);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
 
         status = axi_mcdma_wait_complete(channel, DMA_TIMEOUT_US);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
     }
 
     elapsed_us = timer_stop_us(start_time);
+    dma_phase_record_stop(result->phase_ns);
 
     /* Verify */
     cache_complete_dma_dst(dst_addr, size);
@@ -140,14 +145,19 @@ int axi_mcdma_test_single_channel(uint32_t channel, uint32_t size, TestResult_t*
     result->latency_us = elapsed_us / iterations;
     result->latency_ns = 0;
     result->data_integrity = integrity;
+    status = DMA_SUCCESS;
 
-    return DMA_SUCCESS;
+out:
+    dma_phase_record_stop(NULL);
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
 }
 
 int axi_mcdma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResult_t* result)
 {
-    uint64_t src_addrs[MCDMA_MAX_CHANNELS];
-    uint64_t dst_addrs[MCDMA_MAX_CHANNELS];
+    uint64_t src_addrs[MCDMA_MAX_CHANNELS] = {0};
+    uint64_t dst_addrs[MCDMA_MAX_CHANNELS] = {0};
     uint64_t start_time, elapsed_us;
     uint32_t iterations = DEFAULT_TEST_ITERATIONS / num_channels;
     uint32_t ch, i;
@@ -159,14 +169,12 @@ int axi_mcdma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResul
 
     /* Setup addresses for each channel */
     for (ch = 0; ch < num_channels; ch++) {
-        uint32_t src_offset = MCDMA_SRC_BASE_OFFSET + (ch * MCDMA_CHANNEL_SPACING);
-        uint32_t dst_offset = MCDMA_DST_BASE_OFFSET + (ch * MCDMA_CHANNEL_SPACING);
-
-        src_addrs[ch] = memory_get_test_addr(MEM_REGION_DDR4, src_offset, size);
-        dst_addrs[ch] = memory_get_test_addr(MEM_REGION_DDR4, dst_offset, size);
+        src_addrs[ch] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        dst_addrs[ch] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
 
         if (src_addrs[ch] == 0 || dst_addrs[ch] == 0) {
-            return DMA_ERROR_INVALID_PARAM;
+            free_channel_buffers(src_addrs, dst_addrs, ch + 1);
+            return DMA_ERROR_NO_MEMORY;
         }
 
         /* Enable channels */
@@ -190,6 +198,7 @@ int axi_mcdma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResul
     }
 
     /* Timed iterations - all channels running concurrently */
+    dma_phase_record_start();
     start_time = timer_start();
 
     for (i = 0; i < iterations; i++) {
@@ -201,17 +210,18 @@ int axi_mcdma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResul
         /* Start all channels */
         for (ch = 0; ch < num_channels; ch++) {
             status = axi_mcdma_transfer(ch, src_addrs[ch], dst_addrs[ch], size);
-            if (status != DMA_SUCCESS) return status;
+            if (status != DMA_SUCCESS) goto out;
         }
 
         /* Wait for all channels */
         for (ch = 0; ch < num_channels; ch++) {
             status = axi_mcdma_wait_complete(ch, DMA_TIMEOUT_US);
-            if (status != DMA_SUCCESS) return status;
+            if (status != DMA_SUCCESS) goto out;
         }
     }
 
     elapsed_us = timer_stop_us(start_time);
+    dma_phase_record_stop(result->phase_ns);
 
     /* Calculate aggregate throughput */
     uint64_t total_bytes = (uint64_t)size * iterations * num_channels;
@@ -227,8 +237,12 @@ int axi_mcdma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResul
     result->total_time_us = elapsed_us;
     result->throughput_mbps = CALC_THROUGHPUT_MBPS(total_bytes, elapsed_us);
     result->data_integrity = true;
+    status = DMA_SUCCESS;
 
-    return DMA_SUCCESS;
+out:
+    dma_phase_record_stop(NULL);
+    free_channel_buffers(src_addrs, dst_addrs, num_channels);
+    return status;
 }
 
 int axi_mcdma_test_round_robin(TestResult_t* result)
@@ -125,8 +125,8 @@ int comparison_test_throughput(uint32_t size)
     }
 
     /* CPU memcpy */
-    uint64_t src = memory_get_test_addr(MEM_REGION_DDR4, 0, size);
-    uint64_t dst = memory_get_test_addr(MEM_REGION_DDR4, size * 2, size);
+    uint64_t src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
     if (src && dst) {
         uint32_t cpu_tp = (uint32_t)memory_cpu_memcpy_benchmark((void*)(uintptr_t)dst,
                                                      (void*)(uintptr_t)src,
@@ -136,6 +136,8 @@ int comparison_test_throughput(uint32_t size)
     } else {
         LOG_RESULT(" %10s", "---");
     }
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
 
     LOG_RESULT("\r\n");
 
@@ -198,14 +200,24 @@ int comparison_test_vs_cpu(void)
     DmaType_t best_dma = DMA_TYPE_COUNT;
 
     /* CPU baseline */
-    uint64_t src = memory_get_test_addr(MEM_REGION_DDR4, 0, size);
-    uint64_t dst = memory_get_test_addr(MEM_REGION_DDR4, size * 2, size);
+    uint64_t src = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    uint64_t dst = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+
+    if (src == 0 || dst == 0) {
+        memory_free_dma_buffer(src);
+        memory_free_dma_buffer(dst);
+        return DMA_ERROR_NO_MEMORY;
+    }
 
     pattern_fill((void*)(uintptr_t)src, size, PATTERN_RANDOM, 0);
     cpu_throughput = (uint32_t)memory_cpu_memcpy_benchmark((void*)(uintptr_t)dst,
                                                   (void*)(uintptr_t)src,
                                                   size, 50);
 
+    /* Release before the DMA test allocates its own pair */
+    memory_free_dma_buffer(src);
+    memory_free_dma_buffer(dst);
+
     LOG_RESULT("  CPU memcpy (1MB):      %lu MB/s\r\n", (unsigned long)cpu_throughput);
 
     /* Best DMA */
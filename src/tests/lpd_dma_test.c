@@ -13,13 +13,20 @@
 #include "../utils/data_patterns.h"
 #include "../utils/results_logger.h"
 #include "../utils/cache_utils.h"
+#include "../utils/dma_phase.h"
 
 /*******************************************************************************
- * Local Variables
+ * Helper Functions
  ******************************************************************************/
 
-#define LPD_SRC_OFFSET  0x06000000  /* 96MB */
-#define LPD_DST_OFFSET  0x07000000  /* 112MB */
+static void free_channel_buffers(uint64_t* src_addrs, uint64_t* dst_addrs,
+                                 uint32_t num_channels)
+{
+    for (uint32_t ch = 0; ch < num_channels; ch++) {
+        memory_free_dma_buffer(src_addrs[ch]);
+        memory_free_dma_buffer(dst_addrs[ch]);
+    }
+}
 
 /*******************************************************************************
  * Public Functions
@@ -98,17 +105,22 @@ int lpd_dma_test_throughput(uint32_t channel, uint32_t size, TestResult_t* resul
 
     /* Use OCM for faster LPD DMA access, or DDR if size too large */
     MemoryRegion_t region = (size <= OCM_SIZE / 4) ? MEM_REGION_OCM : MEM_REGION_DDR4;
-    uint32_t src_off = (region == MEM_REGION_OCM) ? 0 : LPD_SRC_OFFSET;
-    uint32_t dst_off = (region == MEM_REGION_OCM) ? size * 2 : LPD_DST_OFFSET;
 
-    src_addr = memory_get_test_addr(region, src_off, size);
-    dst_addr = memory_get_test_addr(region, dst_off, size);
+    src_addr = memory_alloc_dma_buffer(region, size);
+    dst_addr = memory_alloc_dma_buffer(region, size);
 
-    if (src_addr == 0 || dst_addr == 0) {
+    if ((src_addr == 0 || dst_addr == 0) && region != MEM_REGION_DDR4) {
         /* Fall back to DDR */
-        src_addr = memory_get_test_addr(MEM_REGION_DDR4, LPD_SRC_OFFSET, size);
-        dst_addr = memory_get_test_addr(MEM_REGION_DDR4, LPD_DST_OFFSET, size);
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
         region = MEM_REGION_DDR4;
+        src_addr = memory_alloc_dma_buffer(region, size);
+        dst_addr = memory_alloc_dma_buffer(region, size);
+    }
+
+    if (src_addr == 0 || dst_addr == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
     }
 
     /* Prepare buffers */
@@ -120,25 +132,27 @@ int lpd_dma_test_throughput(uint32_t channel, uint32_t size, TestResult_t* resul
     /* Warmup */
     for (i = 0; i < WARMUP_ITERATIONS; i++) {
         status = lpd_dma_transfer(channel, src_addr, dst_addr, size);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
         status = lpd_dma_wait_complete(channel, DMA_TIMEOUT_US);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
     }
 
     /* Timed test */
+    dma_phase_record_start();
     start_time = timer_start();
 
     for (i = 0; i < iterations; i++) {
         cache_prep_dma_dst(dst_addr, size);
 
         status = lpd_dma_transfer(channel, src_addr, dst_addr, size);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
 
         status = lpd_dma_wait_complete(channel, DMA_TIMEOUT_US);
-        if (status != DMA_SUCCESS) return status;
+        if (status != DMA_SUCCESS) goto out;
     }
 
     elapsed_us = timer_stop_us(start_time);
+    dma_phase_record_stop(result->phase_ns);
 
     /* Verify */
     cache_complete_dma_dst(dst_addr, size);
@@ -161,8 +175,13 @@ int lpd_dma_test_throughput(uint32_t channel, uint32_t size, TestResult_t* resul
     result->latency_us = elapsed_us / iterations;
     result->latency_ns = 0;
     result->data_integrity = integrity;
+    status = DMA_SUCCESS;
 
-    return DMA_SUCCESS;
+out:
+    dma_phase_record_stop(NULL);
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
 }
 
 int lpd_dma_test_latency(uint32_t channel, TestResult_t* result)
@@ -173,11 +192,13 @@ int lpd_dma_test_latency(uint32_t channel, TestResult_t* result)
     uint64_t total_ns = 0;
     int status;
 
-    src_addr = memory_get_test_addr(MEM_REGION_OCM, 0, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_OCM, size * 2, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_OCM, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_OCM, size);
 
     if (src_addr == 0 || dst_addr == 0) {
-        return DMA_ERROR_INVALID_PARAM;
+        memory_free_dma_buffer(src_addr);
+        memory_free_dma_buffer(dst_addr);
+        return DMA_ERROR_NO_MEMORY;
     }
 
     pattern_fill((void*)(uintptr_t)src_addr, size, PATTERN_INCREMENTAL, 0);
@@ -199,13 +220,15 @@ int lpd_dma_test_latency(uint32_t channel, TestResult_t* result)
     result->latency_us = result->latency_ns / 1000;
     result->data_integrity = true;
 
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
     return DMA_SUCCESS;
 }
 
 int lpd_dma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResult_t* result)
 {
-    uint64_t src_addrs[LPD_DMA_NUM_CHANNELS];
-    uint64_t dst_addrs[LPD_DMA_NUM_CHANNELS];
+    uint64_t src_addrs[LPD_DMA_NUM_CHANNELS] = {0};
+    uint64_t dst_addrs[LPD_DMA_NUM_CHANNELS] = {0};
     uint64_t start_time, elapsed_us;
     uint32_t iterations = DEFAULT_TEST_ITERATIONS / num_channels;
     uint32_t ch, i;
@@ -217,9 +240,13 @@ int lpd_dma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResult_
 
     /* Setup addresses */
     for (ch = 0; ch < num_channels; ch++) {
-        uint32_t offset = LPD_SRC_OFFSET + (ch * size * 4);
-        src_addrs[ch] = memory_get_test_addr(MEM_REGION_DDR4, offset, size);
-        dst_addrs[ch] = memory_get_test_addr(MEM_REGION_DDR4, offset + size * 2, size);
+        src_addrs[ch] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+        dst_addrs[ch] = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+
+        if (src_addrs[ch] == 0 || dst_addrs[ch] == 0) {
+            free_channel_buffers(src_addrs, dst_addrs, ch + 1);
+            return DMA_ERROR_NO_MEMORY;
+        }
 
         pattern_fill((void*)(uintptr_t)src_addrs[ch], size, PATTERN_RANDOM, ch);
         cache_prep_dma_src(src_addrs[ch], size);
@@ -237,6 +264,7 @@ int lpd_dma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResult_
     }
 
     /* Timed test */
+    dma_phase_record_start();
     start_time = timer_start();
 
     for (i = 0; i < iterations; i++) {
@@ -247,17 +275,18 @@ int lpd_dma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResult_
         /* Start all channels */
         for (ch = 0; ch < num_channels; ch++) {
             status = lpd_dma_transfer(ch, src_addrs[ch], dst_addrs[ch], size);
-            if (status != DMA_SUCCESS) return status;
+            if (status != DMA_SUCCESS) goto out;
         }
 
         /* Wait all */
         for (ch = 0; ch < num_channels; ch++) {
             status = lpd_dma_wait_complete(ch, DMA_TIMEOUT_US);
-            if (status != DMA_SUCCESS) return status;
+            if (status != DMA_SUCCESS) goto out;
         }
     }
 
     elapsed_us = timer_stop_us(start_time);
+    dma_phase_record_stop(result->phase_ns);
 
     uint64_t total_bytes = (uint64_t)size * iterations * num_channels;
 
@@ -270,8 +299,12 @@ int lpd_dma_test_multi_channel(uint32_t num_channels, uint32_t size, TestResult_
     result->total_time_us = elapsed_us;
     result->throughput_mbps = CALC_THROUGHPUT_MBPS(total_bytes, elapsed_us);
     result->data_integrity = true;
+    status = DMA_SUCCESS;
 
-    return DMA_SUCCESS;
+out:
+    dma_phase_record_stop(NULL);
+    free_channel_buffers(src_addrs, dst_addrs, num_channels);
+    return status;
 }
 
 int lpd_dma_test_integrity(DataPattern_t pattern, TestResult_t* result)
@@ -280,8 +313,12 @@ int lpd_dma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     uint32_t size = KB(16);
     int status;
 
-    src_addr = memory_get_test_addr(MEM_REGION_DDR4, LPD_SRC_OFFSET, size);
-    dst_addr = memory_get_test_addr(MEM_REGION_DDR4, LPD_DST_OFFSET, size);
+    src_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    dst_addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, size);
+    if (src_addr == 0 || dst_addr == 0) {
+        status = DMA_ERROR_NO_MEMORY;
+        goto out;
+    }
 
     LOG_DEBUG("LPD DMA Integrity: pattern=%d, src=0x%llX, dst=0x%llX, size=%lu\r\n",
               (int)pattern, (unsigned long long)src_addr, (unsigned long long)dst_addr,
@@ -301,13 +338,13 @@ int lpd_dma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     status = lpd_dma_transfer(0, src_addr, dst_addr, size);
     if (status != DMA_SUCCESS) {
         LOG_ERROR("LPD DMA Integrity: transfer failed with %d\r\n", status);
-        return status;
+        goto out;
     }
 
     status = lpd_dma_wait_complete(0, DMA_TIMEOUT_US);
     if (status != DMA_SUCCESS) {
         LOG_ERROR("LPD DMA Integrity: wait failed with %d\r\n", status);
-        return status;
+        goto out;
     }
 
     /* Memory barrier and invalidate cache to read fresh data */
@@ -338,6 +375,10 @@ int lpd_dma_test_integrity(DataPattern_t pattern, TestResult_t* result)
     result->data_integrity = integrity;
     result->error_count = integrity ? 0 : 1;
     result->first_error_offset = integrity ? 0 : error_offset;
+    status = DMA_SUCCESS;
 
-    return DMA_SUCCESS;
+out:
+    memory_free_dma_buffer(src_addr);
+    memory_free_dma_buffer(dst_addr);
+    return status;
 }
@@ -0,0 +1,200 @@
+/**
+ * @file bd_ring.c
+ * @brief Generic Buffer-Descriptor Ring Implementation
+ *
+ * Pure C with no BSP includes so it can also be built and exercised on a
+ * development host; cache maintenance arrives through the callbacks.
+ */
+
+#include <string.h>
+#include "bd_ring.h"
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static inline uint32_t ring_wrap(const BdRing_t* ring, uint32_t index)
+{
+    return (index >= ring->count) ? (index % ring->count) : index;
+}
+
+static inline volatile uint32_t* ring_word(const BdRing_t* ring, uint32_t index,
+                                           uint32_t offset)
+{
+    return (volatile uint32_t*)(ring->base + (size_t)index * ring->layout->bd_size + offset);
+}
+
+/* Returns the number of range operations issued */
+static uint32_t ring_cache_op(const BdRing_t* ring, BdRingCacheOp_t op,
+                              uint32_t first, uint32_t n)
+{
+    uint32_t bd_size = ring->layout->bd_size;
+    uint32_t n_end;
+
+    if (op == NULL || n == 0) {
+        return 0;
+    }
+
+    /* Contiguous batch: one range op; wrapped batch: two */
+    if (first + n <= ring->count) {
+        op(bd_ring_bd_addr(ring, first), n * bd_size);
+        return 1;
+    }
+
+    n_end = ring->count - first;
+    op(bd_ring_bd_addr(ring, first), n_end * bd_size);
+    op(ring->base_addr, (n - n_end) * bd_size);
+    return 2;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+bool bd_ring_init(BdRing_t* ring, void* mem, uint32_t count,
+                  const BdRingLayout_t* layout,
+                  BdRingCacheOp_t flush, BdRingCacheOp_t invalidate)
+{
+    uint64_t next_addr;
+    uint32_t i;
+
+    if (ring == NULL || mem == NULL || layout == NULL || count == 0 ||
+        layout->bd_size < sizeof(uint32_t)) {
+        return false;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->base = (uint8_t*)mem;
+    ring->base_addr = (uint64_t)(uintptr_t)mem;
+    ring->count = count;
+    ring->layout = layout;
+    ring->flush = flush;
+    ring->invalidate = invalidate;
+
+    memset(mem, 0, (size_t)count * layout->bd_size);
+    for (i = 0; i < count; i++) {
+        next_addr = bd_ring_bd_addr(ring, i + 1);
+        *ring_word(ring, i, layout->next_lo_offset) = (uint32_t)(next_addr & 0xFFFFFFFF);
+        *ring_word(ring, i, layout->next_hi_offset) = (uint32_t)(next_addr >> 32);
+    }
+
+    if (flush != NULL) {
+        flush(ring->base_addr, count * layout->bd_size);
+    }
+
+    ring->last = count - 1;
+    return true;
+}
+
+void bd_ring_reset(BdRing_t* ring)
+{
+    ring->head = 0;
+    ring->tail = 0;
+    ring->allocated = 0;
+    ring->committed = 0;
+    ring->last = ring->count - 1;
+}
+
+uint32_t bd_ring_free_count(const BdRing_t* ring)
+{
+    return ring->count - ring->allocated;
+}
+
+uint32_t bd_ring_outstanding(const BdRing_t* ring)
+{
+    return ring->committed;
+}
+
+uint32_t bd_ring_alloc(BdRing_t* ring, uint32_t n)
+{
+    uint32_t first;
+
+    if (n == 0 || n > bd_ring_free_count(ring)) {
+        return BD_RING_INVALID_INDEX;
+    }
+
+    first = ring->head;
+    ring->head = ring_wrap(ring, ring->head + n);
+    ring->allocated += n;
+    return first;
+}
+
+void* bd_ring_bd(const BdRing_t* ring, uint32_t index)
+{
+    return ring->base + (size_t)ring_wrap(ring, index) * ring->layout->bd_size;
+}
+
+uint64_t bd_ring_bd_addr(const BdRing_t* ring, uint32_t index)
+{
+    return ring->base_addr + (uint64_t)ring_wrap(ring, index) * ring->layout->bd_size;
+}
+
+uint32_t bd_ring_next(const BdRing_t* ring, uint32_t index)
+{
+    return ring_wrap(ring, index + 1);
+}
+
+bool bd_ring_commit(BdRing_t* ring, uint32_t first, uint32_t n)
+{
+    /* Commits must follow allocation order */
+    if (n == 0 || first != ring_wrap(ring, ring->tail + ring->committed) ||
+        ring->committed + n > ring->allocated) {
+        return false;
+    }
+
+    ring->stats.flush_ops += ring_cache_op(ring, ring->flush, first, n);
+    ring->stats.flush_bytes += (uint64_t)n * ring->layout->bd_size;
+
+    ring->committed += n;
+    ring->last = ring_wrap(ring, first + n - 1);
+    ring->stats.bds_committed += n;
+    ring->stats.commits++;
+    return true;
+}
+
+void bd_ring_retire(BdRing_t* ring, uint32_t n)
+{
+    if (n > ring->committed) {
+        n = ring->committed;
+    }
+    if (n == 0) {
+        return;
+    }
+
+    ring->tail = ring_wrap(ring, ring->tail + n);
+    ring->committed -= n;
+    ring->allocated -= n;
+    ring->stats.bds_reaped += n;
+}
+
+uint32_t bd_ring_reap(BdRing_t* ring, uint32_t max)
+{
+    const BdRingLayout_t* layout = ring->layout;
+    uint32_t limit = ring->committed;
+    uint32_t reaped = 0;
+    uint32_t index = ring->tail;
+
+    if (max != 0 && max < limit) {
+        limit = max;
+    }
+
+    /* Invalidate the whole candidate span once, then walk it */
+    ring_cache_op(ring, ring->invalidate, index, limit);
+
+    while (reaped < limit) {
+        volatile uint32_t* status = ring_word(ring, index, layout->status_offset);
+        if ((*status & layout->complete_mask) == 0) {
+            break;
+        }
+        index = ring_wrap(ring, index + 1);
+        reaped++;
+    }
+
+    bd_ring_retire(ring, reaped);
+    return reaped;
+}
+
+void bd_ring_clear_stats(BdRing_t* ring)
+{
+    memset(&ring->stats, 0, sizeof(ring->stats));
+}
@@ -0,0 +1,179 @@
+/**
+ * @file bd_ring.h
+ * @brief Generic Buffer-Descriptor Ring Header
+ *
+ * Ring linking, head/tail/reap accounting and batched cache maintenance
+ * shared by the AXI DMA, AXI CDMA and AXI MCDMA drivers. The engine BD
+ * format is described by a BdRingLayout_t; cache maintenance is passed in
+ * as function pointers, so this module has no BSP dependencies.
+ */
+
+#ifndef BD_RING_H
+#define BD_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define BD_RING_INVALID_INDEX   0xFFFFFFFFU
+
+/**
+ * @brief Cache maintenance callback (matches cache_flush_range())
+ */
+typedef void (*BdRingCacheOp_t)(uint64_t addr, uint32_t size);
+
+/**
+ * @brief Engine-specific descriptor layout
+ */
+typedef struct {
+    uint32_t bd_size;           /* Descriptor stride in bytes */
+    uint32_t next_lo_offset;    /* Next-descriptor pointer, low word */
+    uint32_t next_hi_offset;    /* Next-descriptor pointer, high word */
+    uint32_t status_offset;     /* Status word written back by the engine */
+    uint32_t complete_mask;     /* Status bits meaning "BD finished" */
+} BdRingLayout_t;
+
+/**
+ * @brief Ring statistics
+ */
+typedef struct {
+    uint64_t bds_committed;     /* Descriptors handed to the engine */
+    uint64_t commits;           /* bd_ring_commit() calls */
+    uint64_t flush_ops;         /* Cache range operations issued */
+    uint64_t flush_bytes;       /* Bytes covered by those operations */
+    uint64_t bds_reaped;        /* Descriptors retired */
+} BdRingStats_t;
+
+/**
+ * @brief Descriptor ring
+ *
+ * Index space: [tail, tail+committed) is owned by the engine,
+ * [tail+committed, head) is allocated but not yet committed,
+ * [head, tail) is free. All indices wrap at count.
+ */
+typedef struct {
+    uint8_t* base;              /* CPU view of descriptor memory */
+    uint64_t base_addr;         /* Address the engine uses (identity mapped) */
+    uint32_t count;
+    const BdRingLayout_t* layout;
+    BdRingCacheOp_t flush;      /* NULL: descriptors are coherent */
+    BdRingCacheOp_t invalidate;
+
+    uint32_t head;              /* Next descriptor to allocate */
+    uint32_t tail;              /* Oldest descriptor not yet retired */
+    uint32_t allocated;         /* Descriptors between tail and head */
+    uint32_t committed;         /* Of those, handed to the engine */
+    uint32_t last;              /* Last committed descriptor */
+
+    BdRingStats_t stats;
+} BdRing_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Initialize a ring: zero, link with wraparound, flush once
+ * @param ring Ring to initialize
+ * @param mem Descriptor memory (count * layout->bd_size bytes)
+ * @param count Number of descriptors
+ * @param layout Engine descriptor layout
+ * @param flush Cache clean callback (NULL if coherent)
+ * @param invalidate Cache invalidate callback (NULL if coherent)
+ * @return true on success, false on invalid parameters
+ */
+bool bd_ring_init(BdRing_t* ring, void* mem, uint32_t count,
+                  const BdRingLayout_t* layout,
+                  BdRingCacheOp_t flush, BdRingCacheOp_t invalidate);
+
+/**
+ * @brief Return every descriptor to the free state (after an engine reset)
+ * @param ring Ring
+ */
+void bd_ring_reset(BdRing_t* ring);
+
+/**
+ * @brief Number of free descriptors
+ * @param ring Ring
+ * @return Free descriptor count
+ */
+uint32_t bd_ring_free_count(const BdRing_t* ring);
+
+/**
+ * @brief Number of committed descriptors not yet retired
+ * @param ring Ring
+ * @return Outstanding descriptor count
+ */
+uint32_t bd_ring_outstanding(const BdRing_t* ring);
+
+/**
+ * @brief Reserve n consecutive descriptors (indices may wrap)
+ * @param ring Ring
+ * @param n Number of descriptors
+ * @return Index of the first descriptor, or BD_RING_INVALID_INDEX if full
+ */
+uint32_t bd_ring_alloc(BdRing_t* ring, uint32_t n);
+
+/**
+ * @brief Get the CPU pointer of a descriptor
+ * @param ring Ring
+ * @param index Descriptor index (taken modulo count)
+ * @return Descriptor pointer
+ */
+void* bd_ring_bd(const BdRing_t* ring, uint32_t index);
+
+/**
+ * @brief Get the engine-visible address of a descriptor
+ * @param ring Ring
+ * @param index Descriptor index (taken modulo count)
+ * @return Descriptor address
+ */
+uint64_t bd_ring_bd_addr(const BdRing_t* ring, uint32_t index);
+
+/**
+ * @brief Index following another, with wraparound
+ * @param ring Ring
+ * @param index Descriptor index
+ * @return Next index
+ */
+uint32_t bd_ring_next(const BdRing_t* ring, uint32_t index);
+
+/**
+ * @brief Hand n allocated descriptors to the engine
+ *
+ * Cleans the whole batch with one cache range operation, or two when the
+ * batch wraps past the end of the ring.
+ *
+ * @param ring Ring
+ * @param first Index returned by bd_ring_alloc()
+ * @param n Number of descriptors (as allocated)
+ * @return true on success, false if the range was not allocated in order
+ */
+bool bd_ring_commit(BdRing_t* ring, uint32_t first, uint32_t n);
+
+/**
+ * @brief Retire the oldest n committed descriptors without inspecting them
+ *        (completion already known from the engine status register)
+ * @param ring Ring
+ * @param n Number of descriptors (clamped to the outstanding count)
+ */
+void bd_ring_retire(BdRing_t* ring, uint32_t n);
+
+/**
+ * @brief Retire committed descriptors whose status shows completion
+ * @param ring Ring
+ * @param max Maximum number to retire (0 = no limit)
+ * @return Number of descriptors retired
+ */
+uint32_t bd_ring_reap(BdRing_t* ring, uint32_t max);
+
+/**
+ * @brief Clear ring statistics
+ * @param ring Ring
+ */
+void bd_ring_clear_stats(BdRing_t* ring);
+
+#endif /* BD_RING_H */
@@ -3,8 +3,89 @@
  * @brief Cache Management Utilities Implementation
  */
 
+#include <string.h>
 #include "cache_utils.h"
+#include "dma_buf.h"
+#include "timer_utils.h"
+#include "memory_utils.h"
 #include "xil_cache.h"
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+/* Calibration sweep: buffer sizes from MIN to MAX (scratch from the DDR4 arena), best of REPS */
+#define CACHE_CAL_MIN_SIZE      KB(64)
+#define CACHE_CAL_MAX_SIZE      MB(16)
+#define CACHE_CAL_REPS          3
+
+static const char* const g_CacheMethodNames[CACHE_METHOD_COUNT] = {
+    [CACHE_METHOD_RANGE]   = "range",
+    [CACHE_METHOD_SET_WAY] = "set/way"
+};
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static CacheCostModel_t g_CacheCostModel = {
+    .calibrated = false,
+    .flush_threshold = CACHE_SETWAY_DEFAULT_THRESHOLD,
+    .inval_threshold = CACHE_SETWAY_DEFAULT_THRESHOLD,
+    .num_points = 0
+};
+
+/* Another core is running: set/way would miss its caches */
+static volatile bool g_CacheSmpActive = false;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Best of CACHE_CAL_REPS, each starting from a freshly dirtied buffer */
+static uint32_t cache_cal_time(uint64_t addr, uint32_t size, CacheMethod_t method, bool flush)
+{
+    uint64_t start, ns;
+    uint32_t best = UINT32_MAX;
+
+    for (uint32_t rep = 0; rep < CACHE_CAL_REPS; rep++) {
+        memset((void*)(uintptr_t)addr, (int)(rep + 1), size);
+        __asm__ __volatile__("dsb sy" ::: "memory");
+
+        start = timer_start();
+        if (method == CACHE_METHOD_SET_WAY) {
+            Xil_DCacheFlush();
+        } else if (flush) {
+            Xil_DCacheFlushRange((UINTPTR)addr, size);
+        } else {
+            Xil_DCacheInvalidateRange((UINTPTR)addr, size);
+        }
+        ns = timer_stop_ns(start);
+
+        if (ns < best) {
+            best = (uint32_t)MIN(ns, (uint64_t)UINT32_MAX);
+        }
+    }
+    return best;
+}
+
+/* Smallest size from which set/way stays cheaper up to the largest point */
+static uint32_t cache_cal_threshold(const CacheCostPoint_t* points, uint32_t count, bool flush)
+{
+    uint32_t threshold = CACHE_SETWAY_NEVER;
+
+    for (uint32_t i = count; i > 0; i--) {
+        const CacheCostPoint_t* pt = &points[i - 1];
+        uint32_t range_ns = flush ? pt->range_flush_ns : pt->range_inval_ns;
+
+        if (pt->setway_ns >= range_ns) {
+            break;
+        }
+        threshold = pt->size;
+    }
+    return threshold;
+}
 
 /*******************************************************************************
  * Public Functions
@@ -66,21 +147,99 @@ void cache_instruction_barrier(void)
 
 void cache_prep_dma_src(uint64_t addr, uint32_t size)
 {
-    /* Flush source buffer to ensure DMA reads current data */
-    Xil_DCacheFlushRange((UINTPTR)addr, size);
+    /* Flush source buffer to ensure DMA reads current data (skipped if device-owned) */
+    dma_buf_sync_for_device(addr, size, DMA_DIR_TO_DEVICE);
     __asm__ __volatile__("dsb sy" ::: "memory");
 }
 
 void cache_prep_dma_dst(uint64_t addr, uint32_t size)
 {
-    /* Invalidate destination buffer before DMA writes */
-    Xil_DCacheInvalidateRange((UINTPTR)addr, size);
+    /* Invalidate destination buffer before DMA writes (skipped if device-owned) */
+    dma_buf_sync_for_device(addr, size, DMA_DIR_FROM_DEVICE);
     __asm__ __volatile__("dsb sy" ::: "memory");
 }
 
 void cache_complete_dma_dst(uint64_t addr, uint32_t size)
 {
     /* Invalidate destination buffer after DMA to see new data */
-    __asm__ __volatile__("dsb sy" ::: "memory");
+    dma_buf_sync_for_cpu(addr, size, DMA_DIR_FROM_DEVICE);
+}
+
+CacheMethod_t cache_maint_flush(uint64_t addr, uint32_t size)
+{
+    if (!g_CacheSmpActive && size >= g_CacheCostModel.flush_threshold) {
+        Xil_DCacheFlush();
+        return CACHE_METHOD_SET_WAY;
+    }
+
+    Xil_DCacheFlushRange((UINTPTR)addr, size);
+    return CACHE_METHOD_RANGE;
+}
+
+CacheMethod_t cache_maint_invalidate(uint64_t addr, uint32_t size)
+{
+    /* Never invalidate by set/way alone: other buffers' dirty lines would be lost */
+    if (!g_CacheSmpActive && size >= g_CacheCostModel.inval_threshold) {
+        Xil_DCacheFlush();
+        return CACHE_METHOD_SET_WAY;
+    }
+
     Xil_DCacheInvalidateRange((UINTPTR)addr, size);
+    return CACHE_METHOD_RANGE;
+}
+
+int cache_maint_calibrate(void)
+{
+    CacheCostModel_t model;
+    uint64_t addr;
+    uint32_t size;
+
+    addr = memory_alloc_dma_buffer(MEM_REGION_DDR4, CACHE_CAL_MAX_SIZE);
+    if (addr == 0) {
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    memset(&model, 0, sizeof(model));
+
+    for (size = CACHE_CAL_MIN_SIZE;
+         size <= CACHE_CAL_MAX_SIZE && model.num_points < CACHE_COST_POINTS;
+         size *= 2) {
+        CacheCostPoint_t* pt = &model.points[model.num_points++];
+
+        pt->size = size;
+        pt->range_flush_ns = cache_cal_time(addr, size, CACHE_METHOD_RANGE, true);
+        pt->range_inval_ns = cache_cal_time(addr, size, CACHE_METHOD_RANGE, false);
+        pt->setway_ns = cache_cal_time(addr, size, CACHE_METHOD_SET_WAY, true);
+    }
+    memory_free_dma_buffer(addr);
+
+    model.flush_threshold = cache_cal_threshold(model.points, model.num_points, true);
+    model.inval_threshold = cache_cal_threshold(model.points, model.num_points, false);
+    model.calibrated = true;
+
+    g_CacheCostModel = model;
+    return DMA_SUCCESS;
+}
+
+void cache_maint_set_threshold(uint32_t threshold)
+{
+    g_CacheCostModel.flush_threshold = threshold;
+    g_CacheCostModel.inval_threshold = threshold;
+}
+
+void cache_maint_set_smp(bool active)
+{
+    g_CacheSmpActive = active;
+}
+
+void cache_maint_get_model(CacheCostModel_t* model)
+{
+    if (model != NULL) {
+        *model = g_CacheCostModel;
+    }
+}
+
+const char* cache_method_to_string(CacheMethod_t method)
+{
+    return (method < CACHE_METHOD_COUNT) ? g_CacheMethodNames[method] : "unknown";
 }
@@ -9,6 +9,41 @@
 #define CACHE_UTILS_H
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Adaptive Maintenance Definitions
+ ******************************************************************************/
+
+/* Sizes at or above this use set/way until calibration says otherwise */
+#define CACHE_SETWAY_DEFAULT_THRESHOLD  (4 * 1024 * 1024)
+
+/* Threshold value that keeps every size on range operations */
+#define CACHE_SETWAY_NEVER              UINT32_MAX
+
+/* Calibration sweep: 64KB .. 16MB, doubling */
+#define CACHE_COST_POINTS               9
+
+typedef enum {
+    CACHE_METHOD_RANGE = 0,     /* Clean/invalidate by VA, line by line */
+    CACHE_METHOD_SET_WAY,       /* Clean and invalidate all of L1/L2 by set/way */
+    CACHE_METHOD_COUNT
+} CacheMethod_t;
+
+typedef struct {
+    uint32_t size;              /* Bytes, all dirty at the start of the op */
+    uint32_t range_flush_ns;
+    uint32_t range_inval_ns;
+    uint32_t setway_ns;
+} CacheCostPoint_t;
+
+typedef struct {
+    bool calibrated;
+    uint32_t flush_threshold;   /* Flushes at or above use set/way */
+    uint32_t inval_threshold;   /* Invalidates at or above use set/way */
+    uint32_t num_points;
+    CacheCostPoint_t points[CACHE_COST_POINTS];
+} CacheCostModel_t;
 
 /*******************************************************************************
  * Function Prototypes
@@ -72,24 +107,87 @@ void cache_memory_barrier(void);
 void cache_instruction_barrier(void);
 
 /**
- * @brief Prepare source buffer for DMA (flush)
+ * @brief Prepare source buffer for DMA (flush, elided for device-owned buffers)
  * @param addr Buffer address
  * @param size Buffer size
  */
 void cache_prep_dma_src(uint64_t addr, uint32_t size);
 
 /**
- * @brief Prepare destination buffer for DMA (invalidate)
+ * @brief Prepare destination buffer for DMA (invalidate, elided for device-owned buffers)
  * @param addr Buffer address
  * @param size Buffer size
  */
 void cache_prep_dma_dst(uint64_t addr, uint32_t size);
 
 /**
- * @brief Complete DMA to destination (invalidate to see new data)
+ * @brief Complete DMA to destination (invalidate to see new data, returns ownership to CPU)
  * @param addr Buffer address
  * @param size Buffer size
  */
 void cache_complete_dma_dst(uint64_t addr, uint32_t size);
 
+/**
+ * @brief Clean a range with the cheaper method for its size
+ *
+ * Above the flush threshold the whole data cache is cleaned and
+ * invalidated by set/way, which also covers the range. Set/way operations
+ * only reach the local core's caches, so they are skipped while a second
+ * core is running (see cache_maint_set_smp()); range operations by VA are
+ * broadcast to the other core.
+ *
+ * @param addr Start address
+ * @param size Size in bytes
+ * @return Method used
+ */
+CacheMethod_t cache_maint_flush(uint64_t addr, uint32_t size);
+
+/**
+ * @brief Invalidate a range with the cheaper method for its size
+ *
+ * The set/way path cleans before invalidating, so dirty lines outside the
+ * range are written back rather than lost.
+ *
+ * @param addr Start address
+ * @param size Size in bytes
+ * @return Method used
+ */
+CacheMethod_t cache_maint_invalidate(uint64_t addr, uint32_t size);
+
+/**
+ * @brief Measure range and set/way cost over the calibration sweep and set
+ *        both thresholds to the smallest size from which set/way stays cheaper
+ * @return 0 on success, negative error code on failure
+ */
+int cache_maint_calibrate(void);
+
+/**
+ * @brief Override both thresholds (CACHE_SETWAY_NEVER disables set/way)
+ * @param threshold Size in bytes
+ */
+void cache_maint_set_threshold(uint32_t threshold);
+
+/**
+ * @brief Mark whether another core is running and may hold dirty lines
+ *
+ * While set, cache_maint_flush() and cache_maint_invalidate() always use
+ * range operations regardless of the thresholds.
+ *
+ * @param active true while a second core is running
+ */
+void cache_maint_set_smp(bool active);
+
+/**
+ * @brief Get the current cost model
+ * @param model Model output
+ */
+void cache_maint_get_model(CacheCostModel_t* model);
+
+/**
+ * @brief Get method name
+ * @param method Method
+ * @return Name string
+ */
+const char* cache_method_to_string(CacheMethod_t method);
+
 #endif /* CACHE_UTILS_H */
@@ -0,0 +1,215 @@
+/**
+ * @file cpu_copy.c
+ * @brief Optimized AArch64 CPU Copy Kernels Implementation
+ *
+ * Each kernel is one inline-assembly loop so the compiler cannot split,
+ * vectorize differently or turn it back into a memcpy() call.
+ */
+
+#include <string.h>
+#include "cpu_copy.h"
+#include "cache_utils.h"
+#include "timer_utils.h"
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define CPU_COPY_WARMUP             3
+
+static const char* const g_CpuCopyNames[CPU_COPY_KERNEL_COUNT] = {
+    [CPU_COPY_MEMCPY]        = "memcpy",
+    [CPU_COPY_NEON]          = "NEON",
+    [CPU_COPY_NEON_PREFETCH] = "NEON+PF",
+    [CPU_COPY_NONTEMPORAL]   = "LDNP/STNP",
+    [CPU_COPY_ZVA]           = "DC ZVA"
+};
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static uint32_t g_CpuCopyPfDistance = CPU_COPY_DEFAULT_PF_DISTANCE;
+
+/*******************************************************************************
+ * Kernels (blocks = number of 64-byte blocks, at least 1)
+ ******************************************************************************/
+
+static void copy_neon(uint8_t* dst, const uint8_t* src, uint64_t blocks)
+{
+    __asm__ __volatile__(
+        "1:\n\t"
+        "ldp    q0, q1, [%[s]], #32\n\t"
+        "ldp    q2, q3, [%[s]], #32\n\t"
+        "stp    q0, q1, [%[d]], #32\n\t"
+        "stp    q2, q3, [%[d]], #32\n\t"
+        "subs   %[n], %[n], #1\n\t"
+        "b.ne   1b\n\t"
+        : [d] "+r" (dst), [s] "+r" (src), [n] "+r" (blocks)
+        :
+        : "v0", "v1", "v2", "v3", "cc", "memory");
+}
+
+static void copy_neon_prefetch(uint8_t* dst, const uint8_t* src, uint64_t blocks,
+                               uint64_t distance)
+{
+    __asm__ __volatile__(
+        "1:\n\t"
+        "prfm   pldl1keep, [%[s], %[pf]]\n\t"
+        "prfm   pstl1keep, [%[d], %[pf]]\n\t"
+        "ldp    q0, q1, [%[s]], #32\n\t"
+        "ldp    q2, q3, [%[s]], #32\n\t"
+        "stp    q0, q1, [%[d]], #32\n\t"
+        "stp    q2, q3, [%[d]], #32\n\t"
+        "subs   %[n], %[n], #1\n\t"
+        "b.ne   1b\n\t"
+        : [d] "+r" (dst), [s] "+r" (src), [n] "+r" (blocks)
+        : [pf] "r" (distance)
+        : "v0", "v1", "v2", "v3", "cc", "memory");
+}
+
+/* Non-temporal pairs have no writeback addressing: offset, then advance */
+static void copy_nontemporal(uint8_t* dst, const uint8_t* src, uint64_t blocks)
+{
+    __asm__ __volatile__(
+        "1:\n\t"
+        "ldnp   q0, q1, [%[s]]\n\t"
+        "ldnp   q2, q3, [%[s], #32]\n\t"
+        "add    %[s], %[s], #64\n\t"
+        "stnp   q0, q1, [%[d]]\n\t"
+        "stnp   q2, q3, [%[d], #32]\n\t"
+        "add    %[d], %[d], #64\n\t"
+        "subs   %[n], %[n], #1\n\t"
+        "b.ne   1b\n\t"
+        : [d] "+r" (dst), [s] "+r" (src), [n] "+r" (blocks)
+        :
+        : "v0", "v1", "v2", "v3", "cc", "memory");
+}
+
+/* DC ZVA allocates the destination line zeroed: no read for ownership */
+static void copy_zva(uint8_t* dst, const uint8_t* src, uint64_t blocks)
+{
+    __asm__ __volatile__(
+        "1:\n\t"
+        "ldp    q0, q1, [%[s]], #32\n\t"
+        "ldp    q2, q3, [%[s]], #32\n\t"
+        "dc     zva, %[d]\n\t"
+        "stp    q0, q1, [%[d]], #32\n\t"
+        "stp    q2, q3, [%[d]], #32\n\t"
+        "subs   %[n], %[n], #1\n\t"
+        "b.ne   1b\n\t"
+        : [d] "+r" (dst), [s] "+r" (src), [n] "+r" (blocks)
+        :
+        : "v0", "v1", "v2", "v3", "cc", "memory");
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+void cpu_copy(CpuCopyKernel_t kernel, void* dst, const void* src, uint32_t size)
+{
+    uint64_t blocks = size / CPU_COPY_BLOCK;
+    uint32_t done = (uint32_t)(blocks * CPU_COPY_BLOCK);
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    if (kernel == CPU_COPY_MEMCPY || kernel >= CPU_COPY_KERNEL_COUNT || blocks == 0) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    if (kernel == CPU_COPY_ZVA &&
+        (cpu_copy_zva_block_size() != CPU_COPY_BLOCK ||
+         ((uintptr_t)dst & (CPU_COPY_BLOCK - 1)) != 0)) {
+        kernel = CPU_COPY_NEON;
+    }
+
+    switch (kernel) {
+        case CPU_COPY_NEON_PREFETCH:
+            copy_neon_prefetch(d, s, blocks, g_CpuCopyPfDistance);
+            break;
+        case CPU_COPY_NONTEMPORAL:
+            copy_nontemporal(d, s, blocks);
+            break;
+        case CPU_COPY_ZVA:
+            copy_zva(d, s, blocks);
+            break;
+        default:
+            copy_neon(d, s, blocks);
+            break;
+    }
+
+    if (done < size) {
+        memcpy(d + done, s + done, size - done);
+    }
+}
+
+void cpu_copy_set_prefetch_distance(uint32_t distance)
+{
+    g_CpuCopyPfDistance = distance;
+}
+
+uint32_t cpu_copy_get_prefetch_distance(void)
+{
+    return g_CpuCopyPfDistance;
+}
+
+uint32_t cpu_copy_zva_block_size(void)
+{
+    uint64_t dczid;
+
+    __asm__ __volatile__("mrs %0, dczid_el0" : "=r" (dczid));
+
+    /* DZP set: prohibited; BS: log2 of the block size in words */
+    if (dczid & 0x10) {
+        return 0;
+    }
+    return 4U << (dczid & 0xF);
+}
+
+uint32_t cpu_copy_benchmark(CpuCopyKernel_t kernel, void* dst, const void* src,
+                            uint32_t size, uint32_t iterations, bool cold)
+{
+    uint64_t start, elapsed_ns = 0;
+    uint32_t i;
+
+    if (size == 0 || iterations == 0) {
+        return 0;
+    }
+
+    for (i = 0; i < CPU_COPY_WARMUP; i++) {
+        cpu_copy(kernel, dst, src, size);
+    }
+
+    if (cold) {
+        for (i = 0; i < iterations; i++) {
+            cache_flush_range((uint64_t)(uintptr_t)src, size);
+            cache_flush_range((uint64_t)(uintptr_t)dst, size);
+
+            start = timer_start();
+            cpu_copy(kernel, dst, src, size);
+            __asm__ __volatile__("dsb sy" ::: "memory");
+            elapsed_ns += timer_stop_ns(start);
+        }
+    } else {
+        start = timer_start();
+        for (i = 0; i < iterations; i++) {
+            cpu_copy(kernel, dst, src, size);
+        }
+        __asm__ __volatile__("dsb sy" ::: "memory");
+        elapsed_ns = timer_stop_ns(start);
+    }
+
+    return (uint32_t)(((uint64_t)size * iterations * 1000000000ULL) /
+                      (MAX(elapsed_ns, 1) * 1048576ULL));
+}
+
+const char* cpu_copy_kernel_to_string(CpuCopyKernel_t kernel)
+{
+    if (kernel >= CPU_COPY_KERNEL_COUNT) {
+        return "unknown";
+    }
+    return g_CpuCopyNames[kernel];
+}
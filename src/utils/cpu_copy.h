@@ -0,0 +1,95 @@
+/**
+ * @file cpu_copy.h
+ * @brief Optimized AArch64 CPU Copy Kernels Header
+ *
+ * Hand-written copy loops used as the CPU baseline DMA is compared
+ * against: NEON q-register pairs, the same with software prefetch at a
+ * configurable distance, non-temporal pairs, and DC ZVA to allocate each
+ * destination line without reading it first. Kernels move 64-byte blocks;
+ * a shorter tail is left to memcpy().
+ */
+
+#ifndef CPU_COPY_H
+#define CPU_COPY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define CPU_COPY_BLOCK                  64      /* Bytes per kernel iteration */
+#define CPU_COPY_DEFAULT_PF_DISTANCE    512     /* Prefetch distance (bytes) */
+
+typedef enum {
+    CPU_COPY_MEMCPY = 0,        /* newlib memcpy() */
+    CPU_COPY_NEON,              /* ldp/stp q0-q3, 64B per iteration */
+    CPU_COPY_NEON_PREFETCH,     /* NEON plus prfm of src/dst at the set distance */
+    CPU_COPY_NONTEMPORAL,       /* ldnp/stnp q0-q3 */
+    CPU_COPY_ZVA,               /* DC ZVA on each destination line, then NEON stores */
+    CPU_COPY_KERNEL_COUNT
+} CpuCopyKernel_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Copy with a given kernel
+ *
+ * CPU_COPY_ZVA needs Normal cacheable destination memory. It falls back
+ * to CPU_COPY_NEON when the destination is not aligned to the ZVA block,
+ * or when the ZVA block is not one 64-byte line.
+ *
+ * @param kernel Kernel
+ * @param dst Destination
+ * @param src Source
+ * @param size Size in bytes
+ */
+void cpu_copy(CpuCopyKernel_t kernel, void* dst, const void* src, uint32_t size);
+
+/**
+ * @brief Set the CPU_COPY_NEON_PREFETCH distance
+ * @param distance Bytes ahead of the current block (multiple of 64)
+ */
+void cpu_copy_set_prefetch_distance(uint32_t distance);
+
+/**
+ * @brief Get the CPU_COPY_NEON_PREFETCH distance
+ * @return Distance in bytes
+ */
+uint32_t cpu_copy_get_prefetch_distance(void);
+
+/**
+ * @brief Bytes zeroed by one DC ZVA
+ * @return Block size, 0 if DC ZVA is prohibited
+ */
+uint32_t cpu_copy_zva_block_size(void);
+
+/**
+ * @brief Time a kernel
+ *
+ * Warm: untimed warm-up copies, then the timed loop. Cold: source and
+ * destination are cleaned and invalidated before every copy, outside the
+ * timed interval.
+ *
+ * @param kernel Kernel
+ * @param dst Destination
+ * @param src Source
+ * @param size Size in bytes
+ * @param iterations Timed copies
+ * @param cold Start every copy with neither buffer in the cache
+ * @return Throughput in MB/s
+ */
+uint32_t cpu_copy_benchmark(CpuCopyKernel_t kernel, void* dst, const void* src,
+                            uint32_t size, uint32_t iterations, bool cold);
+
+/**
+ * @brief Get kernel name
+ * @param kernel Kernel
+ * @return Name string
+ */
+const char* cpu_copy_kernel_to_string(CpuCopyKernel_t kernel);
+
+#endif /* CPU_COPY_H */
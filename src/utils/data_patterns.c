@@ -1,11 +1,85 @@
 /**
  * @file data_patterns.c
  * @brief Data Pattern Generator Implementation
+ *
+ * pattern_fill() and pattern_verify() run 64 bytes per iteration. A
+ * generator produces the next 64 expected bytes as four 16-byte vectors;
+ * fill stores them and verify XORs them against the buffer and only drops
+ * to a byte scan in the block that differs. Vectors are NEON on AArch64
+ * and GCC generic vectors elsewhere, so host builds get the same code.
+ *
+ * Every pattern except PATTERN_RANDOM can start the generator at any
+ * block, so the _range variants cost the same wherever the range starts.
+ * PATTERN_RANDOM is sequential and has to step past everything before it.
  */
 
 #include <string.h>
 #include "data_patterns.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*******************************************************************************
+ * SIMD Helpers
+ ******************************************************************************/
+
+#define PAT_BLOCK           64      /* Bytes per fill/verify iteration */
+#define PAT_VECS            (PAT_BLOCK / 16)
+
+#if defined(__ARM_NEON)
+
+typedef uint8x16_t PatVec_t;
+
+static inline PatVec_t pat_vec_splat(uint8_t b)                 { return vdupq_n_u8(b); }
+static inline PatVec_t pat_vec_load(const uint8_t* p)           { return vld1q_u8(p); }
+static inline void     pat_vec_store(uint8_t* p, PatVec_t v)    { vst1q_u8(p, v); }
+static inline PatVec_t pat_vec_add(PatVec_t a, PatVec_t b)      { return vaddq_u8(a, b); }
+static inline PatVec_t pat_vec_xor(PatVec_t a, PatVec_t b)      { return veorq_u8(a, b); }
+static inline PatVec_t pat_vec_or(PatVec_t a, PatVec_t b)       { return vorrq_u8(a, b); }
+static inline bool     pat_vec_any(PatVec_t v)                  { return vmaxvq_u8(v) != 0; }
+
+#else
+
+typedef uint8_t PatVec_t __attribute__((vector_size(16)));
+
+static inline PatVec_t pat_vec_splat(uint8_t b)
+{
+    PatVec_t v = { 0 };
+    return v + b;
+}
+
+static inline PatVec_t pat_vec_load(const uint8_t* p)
+{
+    PatVec_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void pat_vec_store(uint8_t* p, PatVec_t v)        { memcpy(p, &v, sizeof(v)); }
+static inline PatVec_t pat_vec_add(PatVec_t a, PatVec_t b)      { return a + b; }
+static inline PatVec_t pat_vec_xor(PatVec_t a, PatVec_t b)      { return a ^ b; }
+static inline PatVec_t pat_vec_or(PatVec_t a, PatVec_t b)       { return a | b; }
+
+static inline bool pat_vec_any(PatVec_t v)
+{
+    uint64_t half[2];
+    memcpy(half, &v, sizeof(half));
+    return (half[0] | half[1]) != 0;
+}
+
+#endif
+
+/* Next PAT_BLOCK expected bytes of a pattern */
+typedef struct {
+    DataPattern_t pattern;
+    PatVec_t v[PAT_VECS];
+    PatVec_t step;                  /* PATTERN_INCREMENTAL: added per block */
+    uint64_t s[2];                  /* PATTERN_RANDOM: private xorshift128+ state */
+    uint64_t key;                   /* PATTERN_RANDOM_CTR: derived from the seed */
+    uint64_t ctr;                   /* PATTERN_RANDOM_CTR: next 64-bit word index */
+} PatGen_t;
+
 /*******************************************************************************
  * PRNG State (xorshift128+)
  ******************************************************************************/
@@ -41,56 +115,174 @@ uint32_t pattern_get_random(void)
 }
 
 /*******************************************************************************
- * Pattern Fill Functions
+ * Block Generator
  ******************************************************************************/
 
-void pattern_fill(void* buffer, uint32_t size, DataPattern_t pattern, uint32_t seed)
+/* Same sequence as pattern_get_random() after pattern_seed_prng(seed) */
+static inline uint32_t pat_gen_random(uint64_t s[2])
 {
+    uint64_t s1 = s[0];
+    const uint64_t s0 = s[1];
+
+    s[0] = s0;
+    s1 ^= s1 << 23;
+    s[1] = s1 ^ s0 ^ (s1 >> 18) ^ (s0 >> 5);
+
+    return (uint32_t)((s[1] + s0) & 0xFFFFFFFF);
+}
+
+static inline void pat_gen_random_block(PatGen_t* g)
+{
+    uint32_t words[PAT_BLOCK / 4];
+
+    for (uint32_t i = 0; i < PAT_BLOCK / 4; i++) {
+        words[i] = pat_gen_random(g->s);
+    }
+    for (uint32_t k = 0; k < PAT_VECS; k++) {
+        g->v[k] = pat_vec_load((const uint8_t*)words + k * 16);
+    }
+}
+
+/* SplitMix64 output for word index of a key: no state between words */
+static inline uint64_t pat_ctr_word(uint64_t key, uint64_t index)
+{
+    uint64_t z = key + (index + 1) * 0x9E3779B97F4A7C15ULL;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline void pat_gen_ctr_block(PatGen_t* g)
+{
+    uint64_t words[PAT_BLOCK / 8];
+
+    for (uint32_t i = 0; i < PAT_BLOCK / 8; i++) {
+        words[i] = pat_ctr_word(g->key, g->ctr + i);
+    }
+    g->ctr += PAT_BLOCK / 8;
+
+    for (uint32_t k = 0; k < PAT_VECS; k++) {
+        g->v[k] = pat_vec_load((const uint8_t*)words + k * 16);
+    }
+}
+
+/* Generator positioned at byte block * PAT_BLOCK of the pattern */
+static void pat_gen_init(PatGen_t* g, DataPattern_t pattern, uint32_t seed, uint64_t block)
+{
+    uint8_t bytes[PAT_BLOCK];
+    uint64_t i;
+
+    g->pattern = pattern;
+    g->step = pat_vec_splat(0);
+
     switch (pattern) {
         case PATTERN_INCREMENTAL:
-            pattern_fill_incremental(buffer, size);
+            for (i = 0; i < PAT_BLOCK; i++) {
+                bytes[i] = (uint8_t)(block * PAT_BLOCK + i);
+            }
+            g->step = pat_vec_splat(PAT_BLOCK);
             break;
         case PATTERN_ALL_ONES:
-            pattern_fill_all_ones(buffer, size);
-            break;
-        case PATTERN_ALL_ZEROS:
-            pattern_fill_all_zeros(buffer, size);
+            memset(bytes, 0xFF, sizeof(bytes));
             break;
         case PATTERN_RANDOM:
-            pattern_fill_random(buffer, size, seed);
-            break;
+            g->s[0] = ((uint64_t)seed << 32) | (seed ^ 0xDEADBEEF);
+            g->s[1] = ((uint64_t)seed << 16) | (seed ^ 0xCAFEBABE);
+            for (i = 0; i < 20 + block * (PAT_BLOCK / 4); i++) {
+                pat_gen_random(g->s);
+            }
+            pat_gen_random_block(g);
+            return;
+        case PATTERN_RANDOM_CTR:
+            g->key = pat_ctr_word(seed, 0);
+            g->ctr = block * (PAT_BLOCK / 8);
+            pat_gen_ctr_block(g);
+            return;
         case PATTERN_CHECKERBOARD:
-            pattern_fill_checkerboard(buffer, size);
+            /* 0xAA55AA55 little-endian: 0x55 at even offsets */
+            for (i = 0; i < PAT_BLOCK; i++) {
+                bytes[i] = (i & 1) ? 0xAA : 0x55;
+            }
             break;
         default:
-            memset(buffer, 0, size);
+            memset(bytes, 0x00, sizeof(bytes));
             break;
     }
+
+    for (uint32_t k = 0; k < PAT_VECS; k++) {
+        g->v[k] = pat_vec_load(bytes + k * 16);
+    }
 }
 
-void pattern_fill_incremental(void* buffer, uint32_t size)
+static inline void pat_gen_next(PatGen_t* g)
 {
-    uint8_t* p = (uint8_t*)buffer;
-    uint32_t i;
+    if (g->pattern == PATTERN_RANDOM) {
+        pat_gen_random_block(g);
+    } else if (g->pattern == PATTERN_RANDOM_CTR) {
+        pat_gen_ctr_block(g);
+    } else if (g->pattern == PATTERN_INCREMENTAL) {
+        for (uint32_t k = 0; k < PAT_VECS; k++) {
+            g->v[k] = pat_vec_add(g->v[k], g->step);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Pattern Fill Functions
+ ******************************************************************************/
+
+static inline void pat_gen_store(const PatGen_t* g, uint8_t* p)
+{
+    pat_vec_store(p,      g->v[0]);
+    pat_vec_store(p + 16, g->v[1]);
+    pat_vec_store(p + 32, g->v[2]);
+    pat_vec_store(p + 48, g->v[3]);
+}
 
-    /* Fill in 4-byte chunks for efficiency */
-    uint32_t* p32 = (uint32_t*)buffer;
-    uint32_t count32 = size / 4;
+void pattern_fill(void* buffer, uint32_t size, DataPattern_t pattern, uint32_t seed)
+{
+    pattern_fill_range(buffer, 0, size, pattern, seed);
+}
+
+void pattern_fill_range(void* buffer, uint64_t offset, uint32_t size,
+                        DataPattern_t pattern, uint32_t seed)
+{
+    uint8_t* p = (uint8_t*)buffer;
+    uint8_t bytes[PAT_BLOCK];
+    uint32_t skip = (uint32_t)(offset % PAT_BLOCK);
+    uint32_t n;
+    PatGen_t g;
+
+    pat_gen_init(&g, (pattern < PATTERN_COUNT) ? pattern : PATTERN_ALL_ZEROS, seed,
+                 offset / PAT_BLOCK);
+
+    /* Range starting inside a block */
+    if (skip != 0 && size > 0) {
+        pat_gen_store(&g, bytes);
+        n = MIN(size, PAT_BLOCK - skip);
+        memcpy(p, bytes + skip, n);
+        p += n;
+        size -= n;
+        pat_gen_next(&g);
+    }
 
-    for (i = 0; i < count32; i++) {
-        uint32_t base = i * 4;
-        p32[i] = (((base + 3) & 0xFF) << 24) |
-                 (((base + 2) & 0xFF) << 16) |
-                 (((base + 1) & 0xFF) << 8) |
-                 ((base) & 0xFF);
+    for (; size >= PAT_BLOCK; size -= PAT_BLOCK, p += PAT_BLOCK) {
+        pat_gen_store(&g, p);
+        pat_gen_next(&g);
     }
 
-    /* Fill remaining bytes */
-    for (i = count32 * 4; i < size; i++) {
-        p[i] = (uint8_t)(i & 0xFF);
+    if (size > 0) {
+        pat_gen_store(&g, bytes);
+        memcpy(p, bytes, size);
     }
 }
 
+void pattern_fill_incremental(void* buffer, uint32_t size)
+{
+    pattern_fill(buffer, size, PATTERN_INCREMENTAL, 0);
+}
+
 void pattern_fill_all_ones(void* buffer, uint32_t size)
 {
     memset(buffer, 0xFF, size);
@@ -103,47 +295,12 @@ void pattern_fill_all_zeros(void* buffer, uint32_t size)
 
 void pattern_fill_random(void* buffer, uint32_t size, uint32_t seed)
 {
-    uint32_t* p32 = (uint32_t*)buffer;
-    uint8_t* p8 = (uint8_t*)buffer;
-    uint32_t count32 = size / 4;
-    uint32_t i;
-
-    /* Initialize PRNG with seed */
-    pattern_seed_prng(seed);
-
-    /* Fill in 4-byte chunks */
-    for (i = 0; i < count32; i++) {
-        p32[i] = pattern_get_random();
-    }
-
-    /* Fill remaining bytes */
-    if (size % 4 != 0) {
-        uint32_t last = pattern_get_random();
-        for (i = count32 * 4; i < size; i++) {
-            p8[i] = (uint8_t)(last & 0xFF);
-            last >>= 8;
-        }
-    }
+    pattern_fill(buffer, size, PATTERN_RANDOM, seed);
 }
 
 void pattern_fill_checkerboard(void* buffer, uint32_t size)
 {
-    uint8_t* p = (uint8_t*)buffer;
-    uint32_t i;
-
-    /* Fill in 4-byte chunks with 0xAA55AA55 */
-    uint32_t* p32 = (uint32_t*)buffer;
-    uint32_t count32 = size / 4;
-    uint32_t pattern = 0xAA55AA55;
-
-    for (i = 0; i < count32; i++) {
-        p32[i] = pattern;
-    }
-
-    /* Fill remaining bytes */
-    for (i = count32 * 4; i < size; i++) {
-        p[i] = (i & 1) ? 0x55 : 0xAA;
-    }
+    pattern_fill(buffer, size, PATTERN_CHECKERBOARD, 0);
 }
 
 void pattern_fill_walking_ones(void* buffer, uint32_t size)
@@ -177,57 +334,72 @@ void pattern_fill_walking_zeros(void* buffer, uint32_t size)
  * Pattern Verify Functions
  ******************************************************************************/
 
+/* Byte scan against expected bytes [skip, skip + len) of the current block */
+static bool pat_verify_bytes(const uint8_t* p, const PatGen_t* g, uint32_t skip, uint32_t len,
+                             uint32_t base, uint32_t* error_offset,
+                             uint8_t* error_expected, uint8_t* error_actual)
+{
+    uint8_t expected[PAT_BLOCK];
+
+    pat_gen_store(g, expected);
+
+    for (uint32_t i = 0; i < len; i++) {
+        if (p[i] != expected[skip + i]) {
+            if (error_offset) *error_offset = base + i;
+            if (error_expected) *error_expected = expected[skip + i];
+            if (error_actual) *error_actual = p[i];
+            return false;
+        }
+    }
+    return true;
+}
+
 bool pattern_verify(const void* buffer, uint32_t size, DataPattern_t pattern,
                    uint32_t seed, uint32_t* error_offset,
                    uint8_t* error_expected, uint8_t* error_actual)
+{
+    return pattern_verify_range(buffer, 0, size, pattern, seed,
+                                error_offset, error_expected, error_actual);
+}
+
+bool pattern_verify_range(const void* buffer, uint64_t offset, uint32_t size,
+                          DataPattern_t pattern, uint32_t seed, uint32_t* error_offset,
+                          uint8_t* error_expected, uint8_t* error_actual)
 {
     const uint8_t* p = (const uint8_t*)buffer;
-    uint8_t expected;
-    uint32_t i;
-    uint32_t rand_val = 0;  /* Moved outside for RANDOM pattern */
+    uint32_t skip = (uint32_t)(offset % PAT_BLOCK);
+    uint32_t done = 0, n;
+    PatVec_t diff;
+    PatGen_t g;
 
-    /* For random pattern, we need to regenerate the sequence */
-    if (pattern == PATTERN_RANDOM) {
-        pattern_seed_prng(seed);
-    }
+    pat_gen_init(&g, (pattern < PATTERN_COUNT) ? pattern : PATTERN_ALL_ZEROS, seed,
+                 offset / PAT_BLOCK);
 
-    for (i = 0; i < size; i++) {
-        switch (pattern) {
-            case PATTERN_INCREMENTAL:
-                expected = (uint8_t)(i & 0xFF);
-                break;
-            case PATTERN_ALL_ONES:
-                expected = 0xFF;
-                break;
-            case PATTERN_ALL_ZEROS:
-                expected = 0x00;
-                break;
-            case PATTERN_RANDOM:
-                /* Generate new random value every 4 bytes */
-                if ((i % 4) == 0) {
-                    rand_val = pattern_get_random();
-                }
-                expected = (uint8_t)((rand_val >> ((i % 4) * 8)) & 0xFF);
-                break;
-            case PATTERN_CHECKERBOARD:
-                /* Match fill pattern: 0xAA55AA55 in little-endian
-                 * byte[0]=0x55, byte[1]=0xAA, byte[2]=0x55, byte[3]=0xAA */
-                expected = (i & 1) ? 0xAA : 0x55;
-                break;
-            default:
-                expected = 0x00;
-                break;
+    if (skip != 0 && size > 0) {
+        n = MIN(size, PAT_BLOCK - skip);
+        if (!pat_verify_bytes(p, &g, skip, n, 0, error_offset, error_expected, error_actual)) {
+            return false;
         }
+        done = n;
+        pat_gen_next(&g);
+    }
 
-        if (p[i] != expected) {
-            if (error_offset) *error_offset = i;
-            if (error_expected) *error_expected = expected;
-            if (error_actual) *error_actual = p[i];
-            return false;
+    for (; size - done >= PAT_BLOCK; done += PAT_BLOCK) {
+        const uint8_t* q = p + done;
+
+        diff = pat_vec_or(pat_vec_or(pat_vec_xor(pat_vec_load(q),      g.v[0]),
+                                     pat_vec_xor(pat_vec_load(q + 16), g.v[1])),
+                          pat_vec_or(pat_vec_xor(pat_vec_load(q + 32), g.v[2]),
+                                     pat_vec_xor(pat_vec_load(q + 48), g.v[3])));
+        if (pat_vec_any(diff)) {
+            return pat_verify_bytes(q, &g, 0, PAT_BLOCK, done,
+                                    error_offset, error_expected, error_actual);
         }
+        pat_gen_next(&g);
     }
 
-    return true;
+    return pat_verify_bytes(p + done, &g, 0, size - done, done,
+                            error_offset, error_expected, error_actual);
 }
 
 const char* pattern_get_name(DataPattern_t pattern)
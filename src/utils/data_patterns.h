@@ -3,6 +3,9 @@
  * @brief Data Pattern Generator Header
  *
  * Test data pattern generation and verification utilities.
+ * pattern_fill() and pattern_verify() are vectorized (64 bytes per
+ * iteration) and keep their PRNG state on the stack, so they can run on
+ * both cores at once.
  */
 
 #ifndef DATA_PATTERNS_H
@@ -25,12 +28,29 @@
  */
 void pattern_fill(void* buffer, uint32_t size, DataPattern_t pattern, uint32_t seed);
 
+/**
+ * @brief Fill buffer with bytes [offset, offset + size) of a pattern
+ *
+ * The buffer receives what pattern_fill() would have written at that
+ * offset of a larger buffer. Costs the same at any offset, except for
+ * PATTERN_RANDOM, which regenerates everything before the offset; use
+ * PATTERN_RANDOM_CTR for chunked or parallel work.
+ *
+ * @param buffer Buffer to fill
+ * @param offset Pattern offset of the first byte
+ * @param size Bytes to fill
+ * @param pattern Pattern type
+ * @param seed Random seed (for PATTERN_RANDOM and PATTERN_RANDOM_CTR)
+ */
+void pattern_fill_range(void* buffer, uint64_t offset, uint32_t size,
+                        DataPattern_t pattern, uint32_t seed);
+
 /**
  * @brief Verify buffer contains expected pattern
  * @param buffer Buffer to verify
  * @param size Buffer size in bytes
  * @param pattern Expected pattern type
- * @param seed Random seed (for PATTERN_RANDOM)
+ * @param seed Random seed (for PATTERN_RANDOM and PATTERN_RANDOM_CTR)
  * @param error_offset Output: offset of first error (if any)
  * @param error_expected Output: expected value at error offset
  * @param error_actual Output: actual value at error offset
@@ -40,6 +60,26 @@ bool pattern_verify(const void* buffer, uint32_t size, DataPattern_t pattern,
                    uint32_t seed, uint32_t* error_offset,
                    uint8_t* error_expected, uint8_t* error_actual);
 
+/**
+ * @brief Verify buffer holds bytes [offset, offset + size) of a pattern
+ *
+ * Counterpart of pattern_fill_range(): any slice can be checked on its
+ * own, e.g. chunks on different cores or spot checks of a large buffer.
+ *
+ * @param buffer Buffer to verify
+ * @param offset Pattern offset of the first byte
+ * @param size Bytes to verify
+ * @param pattern Expected pattern type
+ * @param seed Random seed (for PATTERN_RANDOM and PATTERN_RANDOM_CTR)
+ * @param error_offset Output: buffer offset of first error (if any)
+ * @param error_expected Output: expected value at error offset
+ * @param error_actual Output: actual value at error offset
+ * @return true if buffer matches pattern, false otherwise
+ */
+bool pattern_verify_range(const void* buffer, uint64_t offset, uint32_t size,
+                          DataPattern_t pattern, uint32_t seed, uint32_t* error_offset,
+                          uint8_t* error_expected, uint8_t* error_actual);
+
 /**
  * @brief Generate incremental pattern
  * @param buffer Buffer to fill
@@ -0,0 +1,404 @@
+/**
+ * @file dma_alloc.c
+ * @brief DMA Buffer Arena Allocator Implementation
+ */
+
+#include <string.h>
+#include "dma_alloc.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+#define ALLOC_NO_OFFSET     UINT64_MAX
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint64_t alloc_align_up(uint64_t value, uint64_t align)
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+static bool alloc_insert_extent(DmaArena_t* arena, uint32_t idx, uint64_t offset,
+                                uint64_t size, DmaExtentState_t state)
+{
+    if (arena->num_extents >= DMA_ALLOC_MAX_EXTENTS) {
+        return false;
+    }
+
+    memmove(&arena->extents[idx + 1], &arena->extents[idx],
+            (arena->num_extents - idx) * sizeof(arena->extents[0]));
+    arena->extents[idx].offset = offset;
+    arena->extents[idx].size = size;
+    arena->extents[idx].state = (uint8_t)state;
+    arena->num_extents++;
+    return true;
+}
+
+static void alloc_remove_extent(DmaArena_t* arena, uint32_t idx)
+{
+    memmove(&arena->extents[idx], &arena->extents[idx + 1],
+            (arena->num_extents - idx - 1) * sizeof(arena->extents[0]));
+    arena->num_extents--;
+}
+
+/* First fit; returns the block offset or ALLOC_NO_OFFSET */
+static uint64_t alloc_take_extent(DmaArena_t* arena, uint64_t size, uint64_t align,
+                                  DmaExtentState_t state)
+{
+    for (uint32_t i = 0; i < arena->num_extents; i++) {
+        DmaExtent_t* ext = &arena->extents[i];
+        uint64_t start, pad, tail;
+        uint32_t needed;
+
+        if (ext->state != DMA_EXTENT_FREE) {
+            continue;
+        }
+
+        /* Alignment is of the address, not of the offset */
+        start = alloc_align_up(arena->base + ext->offset, align) - arena->base;
+        pad = start - ext->offset;
+        if (pad + size > ext->size) {
+            continue;
+        }
+
+        tail = ext->size - pad - size;
+        needed = (pad != 0) + (tail != 0);
+        if (arena->num_extents + needed > DMA_ALLOC_MAX_EXTENTS) {
+            return ALLOC_NO_OFFSET;
+        }
+
+        if (pad != 0) {
+            ext->size = pad;
+            alloc_insert_extent(arena, ++i, start, size, state);
+        } else {
+            ext->size = size;
+            ext->state = (uint8_t)state;
+        }
+        if (tail != 0) {
+            alloc_insert_extent(arena, i + 1, start + size, tail, DMA_EXTENT_FREE);
+        }
+        return start;
+    }
+    return ALLOC_NO_OFFSET;
+}
+
+static int alloc_release_extent(DmaArena_t* arena, uint64_t offset, DmaExtentState_t state)
+{
+    uint32_t i;
+
+    for (i = 0; i < arena->num_extents; i++) {
+        if (arena->extents[i].offset == offset) {
+            break;
+        }
+    }
+    if (i == arena->num_extents || arena->extents[i].state != state) {
+        return DMA_ALLOC_ERR_INVALID;
+    }
+
+    arena->extents[i].state = DMA_EXTENT_FREE;
+
+    /* Coalesce with the following, then the preceding free extent */
+    if (i + 1 < arena->num_extents && arena->extents[i + 1].state == DMA_EXTENT_FREE) {
+        arena->extents[i].size += arena->extents[i + 1].size;
+        alloc_remove_extent(arena, i + 1);
+    }
+    if (i > 0 && arena->extents[i - 1].state == DMA_EXTENT_FREE) {
+        arena->extents[i - 1].size += arena->extents[i].size;
+        alloc_remove_extent(arena, i);
+    }
+    return DMA_ALLOC_OK;
+}
+
+static uint32_t alloc_blocks_per_slab(const DmaArena_t* arena, uint32_t cls)
+{
+    return arena->slab_size / dma_alloc_class_size(cls);
+}
+
+/* Largest power-of-two slab within arena / DMA_ALLOC_SLAB_DIVISOR */
+static void alloc_size_slabs(DmaArena_t* arena)
+{
+    uint32_t slab = DMA_ALLOC_MAX_SLAB_SIZE;
+
+    while (slab > DMA_ALLOC_MIN_SLAB_SIZE &&
+           (uint64_t)slab * DMA_ALLOC_SLAB_DIVISOR > arena->size) {
+        slab >>= 1;
+    }
+    if ((uint64_t)slab * DMA_ALLOC_SLAB_DIVISOR > arena->size) {
+        arena->slab_size = 0;
+        arena->slab_classes = 0;
+        return;
+    }
+
+    arena->slab_size = slab;
+    arena->slab_classes = 0;
+    while (arena->slab_classes < DMA_ALLOC_NUM_CLASSES &&
+           dma_alloc_class_size(arena->slab_classes) * DMA_ALLOC_MIN_SLAB_BLOCKS <= slab) {
+        arena->slab_classes++;
+    }
+}
+
+static uint16_t alloc_new_slab(DmaArena_t* arena, uint32_t cls)
+{
+    uint32_t blocks = alloc_blocks_per_slab(arena, cls);
+    DmaSlab_t* slab = NULL;
+    uint64_t offset;
+    uint16_t s;
+
+    for (s = 0; s < DMA_ALLOC_MAX_SLABS; s++) {
+        if (!arena->slabs[s].in_use) {
+            slab = &arena->slabs[s];
+            break;
+        }
+    }
+    if (slab == NULL) {
+        return DMA_ALLOC_NO_SLAB;
+    }
+
+    offset = alloc_take_extent(arena, arena->slab_size, arena->slab_size, DMA_EXTENT_SLAB);
+    if (offset == ALLOC_NO_OFFSET) {
+        return DMA_ALLOC_NO_SLAB;
+    }
+
+    memset(slab, 0, sizeof(*slab));
+    slab->offset = offset;
+    slab->cls = (uint8_t)cls;
+    slab->free_blocks = (uint16_t)blocks;
+    slab->in_use = true;
+    for (uint32_t w = 0; w < blocks / 32; w++) {
+        slab->bitmap[w] = UINT32_MAX;
+    }
+    if (blocks % 32) {
+        slab->bitmap[blocks / 32] = (1U << (blocks % 32)) - 1;
+    }
+
+    slab->next = arena->class_free[cls];
+    arena->class_free[cls] = s;
+    arena->stats.slabs++;
+    return s;
+}
+
+static uint64_t alloc_small(DmaArena_t* arena, uint32_t cls)
+{
+    uint16_t s = arena->class_free[cls];
+    DmaSlab_t* slab;
+    uint32_t w, bit;
+
+    if (s == DMA_ALLOC_NO_SLAB) {
+        s = alloc_new_slab(arena, cls);
+        if (s == DMA_ALLOC_NO_SLAB) {
+            return 0;
+        }
+    }
+
+    slab = &arena->slabs[s];
+    for (w = 0; slab->bitmap[w] == 0; w++) {
+    }
+    bit = (uint32_t)__builtin_ctz(slab->bitmap[w]);
+    slab->bitmap[w] &= ~(1U << bit);
+
+    /* Full slabs leave the free list (it is always the head) */
+    if (--slab->free_blocks == 0) {
+        arena->class_free[cls] = slab->next;
+        slab->next = DMA_ALLOC_NO_SLAB;
+    }
+
+    return arena->base + slab->offset + (uint64_t)(w * 32 + bit) * dma_alloc_class_size(cls);
+}
+
+static int alloc_free_small(DmaArena_t* arena, DmaSlab_t* slab, uint64_t addr)
+{
+    uint32_t cls = slab->cls;
+    uint32_t cls_size = dma_alloc_class_size(cls);
+    uint64_t rel = addr - (arena->base + slab->offset);
+    uint32_t block = (uint32_t)(rel / cls_size);
+    uint16_t s = (uint16_t)(slab - arena->slabs);
+    uint16_t* link;
+
+    if ((rel % cls_size) != 0 || (slab->bitmap[block / 32] & (1U << (block % 32)))) {
+        return DMA_ALLOC_ERR_INVALID;
+    }
+
+    slab->bitmap[block / 32] |= 1U << (block % 32);
+    if (slab->free_blocks++ == 0) {
+        slab->next = arena->class_free[cls];
+        arena->class_free[cls] = s;
+    }
+
+    arena->stats.bytes_in_use -= cls_size;
+    arena->stats.class_blocks[cls]--;
+
+    /* Hand empty slabs back to the extent pool */
+    if (slab->free_blocks == alloc_blocks_per_slab(arena, cls)) {
+        for (link = &arena->class_free[cls]; *link != s; link = &arena->slabs[*link].next) {
+        }
+        *link = slab->next;
+        slab->in_use = false;
+        arena->stats.slabs--;
+        alloc_release_extent(arena, slab->offset, DMA_EXTENT_SLAB);
+    }
+    return DMA_ALLOC_OK;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int dma_arena_init(DmaArena_t* arena, const char* name, uint64_t base, uint64_t size)
+{
+    uint64_t aligned_base = alloc_align_up(base, DMA_ALLOC_MIN_ALIGN);
+
+    if (arena == NULL || size <= aligned_base - base) {
+        return DMA_ALLOC_ERR_INVALID;
+    }
+
+    size = (size - (aligned_base - base)) & ~(uint64_t)(DMA_ALLOC_MIN_ALIGN - 1);
+    if (size == 0) {
+        return DMA_ALLOC_ERR_INVALID;
+    }
+
+    arena->name = name;
+    arena->base = aligned_base;
+    arena->size = size;
+    alloc_size_slabs(arena);
+    dma_arena_reset(arena);
+    return DMA_ALLOC_OK;
+}
+
+void dma_arena_reset(DmaArena_t* arena)
+{
+    memset(arena->extents, 0, sizeof(arena->extents));
+    memset(arena->slabs, 0, sizeof(arena->slabs));
+    memset(&arena->stats, 0, sizeof(arena->stats));
+
+    arena->extents[0].offset = 0;
+    arena->extents[0].size = arena->size;
+    arena->extents[0].state = DMA_EXTENT_FREE;
+    arena->num_extents = 1;
+
+    for (uint32_t c = 0; c < DMA_ALLOC_NUM_CLASSES; c++) {
+        arena->class_free[c] = DMA_ALLOC_NO_SLAB;
+    }
+}
+
+uint64_t dma_arena_alloc(DmaArena_t* arena, uint64_t size, uint32_t alignment)
+{
+    uint32_t cls;
+    uint64_t addr, offset, bytes;
+
+    if (arena == NULL || size == 0 || (alignment & (alignment - 1)) != 0) {
+        return 0;
+    }
+
+    cls = dma_alloc_size_class(size, alignment);
+    if (cls >= arena->slab_classes) {
+        cls = DMA_ALLOC_NUM_CLASSES;
+    }
+    if (cls < DMA_ALLOC_NUM_CLASSES) {
+        addr = alloc_small(arena, cls);
+        bytes = dma_alloc_class_size(cls);
+    } else {
+        bytes = alloc_align_up(size, DMA_ALLOC_MIN_ALIGN);
+        offset = alloc_take_extent(arena, bytes,
+                                   (alignment > DMA_ALLOC_MIN_ALIGN) ? alignment : DMA_ALLOC_MIN_ALIGN,
+                                   DMA_EXTENT_LARGE);
+        addr = (offset == ALLOC_NO_OFFSET) ? 0 : arena->base + offset;
+    }
+
+    if (addr == 0) {
+        arena->stats.failures++;
+        return 0;
+    }
+
+    arena->stats.allocs++;
+    arena->stats.bytes_in_use += bytes;
+    if (arena->stats.bytes_in_use > arena->stats.peak_bytes) {
+        arena->stats.peak_bytes = arena->stats.bytes_in_use;
+    }
+    if (cls < DMA_ALLOC_NUM_CLASSES) {
+        arena->stats.class_blocks[cls]++;
+    } else {
+        arena->stats.large_blocks++;
+    }
+    return addr;
+}
+
+int dma_arena_free(DmaArena_t* arena, uint64_t addr)
+{
+    uint64_t offset;
+    int status;
+
+    if (arena == NULL || !dma_arena_owns(arena, addr)) {
+        return DMA_ALLOC_ERR_INVALID;
+    }
+
+    for (uint32_t s = 0; s < DMA_ALLOC_MAX_SLABS; s++) {
+        DmaSlab_t* slab = &arena->slabs[s];
+        uint64_t slab_base = arena->base + slab->offset;
+
+        if (slab->in_use && addr >= slab_base && addr < slab_base + arena->slab_size) {
+            status = alloc_free_small(arena, slab, addr);
+            if (status == DMA_ALLOC_OK) {
+                arena->stats.frees++;
+            }
+            return status;
+        }
+    }
+
+    offset = addr - arena->base;
+    for (uint32_t i = 0; i < arena->num_extents; i++) {
+        if (arena->extents[i].offset == offset && arena->extents[i].state == DMA_EXTENT_LARGE) {
+            arena->stats.bytes_in_use -= arena->extents[i].size;
+            arena->stats.large_blocks--;
+            arena->stats.frees++;
+            return alloc_release_extent(arena, offset, DMA_EXTENT_LARGE);
+        }
+    }
+    return DMA_ALLOC_ERR_INVALID;
+}
+
+bool dma_arena_owns(const DmaArena_t* arena, uint64_t addr)
+{
+    return arena != NULL && addr >= arena->base && addr < arena->base + arena->size;
+}
+
+void dma_arena_get_stats(const DmaArena_t* arena, DmaAllocStats_t* stats)
+{
+    if (arena == NULL || stats == NULL) {
+        return;
+    }
+
+    *stats = arena->stats;
+    stats->free_bytes = 0;
+    stats->largest_free = 0;
+    for (uint32_t i = 0; i < arena->num_extents; i++) {
+        const DmaExtent_t* ext = &arena->extents[i];
+        if (ext->state == DMA_EXTENT_FREE) {
+            stats->free_bytes += ext->size;
+            if (ext->size > stats->largest_free) {
+                stats->largest_free = ext->size;
+            }
+        }
+    }
+}
+
+uint32_t dma_alloc_size_class(uint64_t size, uint32_t alignment)
+{
+    uint64_t need = (size > alignment) ? size : alignment;
+    uint32_t cls = 0;
+
+    if (need > DMA_ALLOC_MAX_CLASS_SIZE) {
+        return DMA_ALLOC_NUM_CLASSES;
+    }
+    while (dma_alloc_class_size(cls) < need) {
+        cls++;
+    }
+    return cls;
+}
+
+uint32_t dma_alloc_class_size(uint32_t cls)
+{
+    return DMA_ALLOC_MIN_ALIGN << cls;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file dma_alloc.h
+ * @brief DMA Buffer Arena Allocator Header
+ *
+ * Region arena allocator for DMA buffers. Small requests come from
+ * power-of-two size classes (64B .. 32KB) carved out of slabs, each class
+ * keeping a free list of slabs with free blocks. Larger requests take a
+ * first-fit extent path that coalesces on free. Every block is at least
+ * cache-line aligned, so two buffers never share a line.
+ *
+ * The slab size scales with the arena (at most 1/16 of it, 4KB .. 64KB)
+ * so a small arena such as OCM is not tied up by one slab per class; a
+ * class whose blocks do not fit a slab at least twice uses the extent
+ * path, and arenas under 64KB use the extent path for everything.
+ *
+ * All bookkeeping lives in the arena structure, never in the managed
+ * memory: an arena can describe OCM, PL memory or an address range that
+ * is not backed at all. The module depends only on the C library so it
+ * builds and runs unchanged on a Linux host.
+ */
+
+#ifndef DMA_ALLOC_H
+#define DMA_ALLOC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define DMA_ALLOC_MIN_ALIGN         64U     /* Cache line */
+#define DMA_ALLOC_NUM_CLASSES       10U     /* 64B .. 32KB */
+#define DMA_ALLOC_MAX_CLASS_SIZE    (DMA_ALLOC_MIN_ALIGN << (DMA_ALLOC_NUM_CLASSES - 1))
+#define DMA_ALLOC_MAX_SLAB_SIZE     (64U * 1024U)
+#define DMA_ALLOC_MIN_SLAB_SIZE     (4U * 1024U)
+#define DMA_ALLOC_SLAB_DIVISOR      16U     /* Slab is at most arena / 16 */
+#define DMA_ALLOC_MIN_SLAB_BLOCKS   2U      /* Else the class uses extents */
+#define DMA_ALLOC_MAX_SLABS         64U
+#define DMA_ALLOC_MAX_EXTENTS       128U
+
+#define DMA_ALLOC_SLAB_WORDS        (DMA_ALLOC_MAX_SLAB_SIZE / DMA_ALLOC_MIN_ALIGN / 32U)
+#define DMA_ALLOC_NO_SLAB           0xFFFFU
+
+/* Return codes (same values as DMA_ERROR_*) */
+#define DMA_ALLOC_OK                0
+#define DMA_ALLOC_ERR_INVALID       (-1)    /* Not a live block of this arena */
+
+typedef enum {
+    DMA_EXTENT_FREE = 0,
+    DMA_EXTENT_LARGE,           /* One large-path block */
+    DMA_EXTENT_SLAB             /* Backing for a size-class slab */
+} DmaExtentState_t;
+
+typedef struct {
+    uint64_t offset;            /* From arena base */
+    uint64_t size;
+    uint8_t state;              /* DmaExtentState_t */
+} DmaExtent_t;
+
+typedef struct {
+    uint64_t offset;            /* From arena base, slab-size aligned in address */
+    uint16_t next;              /* Next slab with free blocks in the class list */
+    uint16_t free_blocks;
+    uint8_t cls;
+    bool in_use;
+    uint32_t bitmap[DMA_ALLOC_SLAB_WORDS];  /* 1 = block free */
+} DmaSlab_t;
+
+typedef struct {
+    uint64_t bytes_in_use;      /* Block bytes handed out (after rounding) */
+    uint64_t peak_bytes;
+    uint64_t free_bytes;        /* In free extents (excludes free slab blocks) */
+    uint64_t largest_free;      /* Largest free extent */
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t failures;
+    uint32_t large_blocks;      /* Live large-path blocks */
+    uint32_t slabs;             /* Live slabs */
+    uint32_t class_blocks[DMA_ALLOC_NUM_CLASSES];  /* Live blocks per class */
+} DmaAllocStats_t;
+
+typedef struct {
+    const char* name;
+    uint64_t base;
+    uint64_t size;
+    uint32_t slab_size;                             /* 0: no slabs */
+    uint32_t slab_classes;                          /* Classes below this use slabs */
+    uint32_t num_extents;
+    DmaExtent_t extents[DMA_ALLOC_MAX_EXTENTS];     /* Sorted, cover the arena */
+    DmaSlab_t slabs[DMA_ALLOC_MAX_SLABS];
+    uint16_t class_free[DMA_ALLOC_NUM_CLASSES];     /* Free-list heads */
+    DmaAllocStats_t stats;
+} DmaArena_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Initialize an arena over [base, base + size)
+ * @param arena Arena
+ * @param name Name for reports
+ * @param base Start address (rounded up to a cache line)
+ * @param size Size in bytes (rounded down to a cache line)
+ * @return DMA_ALLOC_OK, or DMA_ALLOC_ERR_INVALID if nothing is left
+ */
+int dma_arena_init(DmaArena_t* arena, const char* name, uint64_t base, uint64_t size);
+
+/**
+ * @brief Drop every allocation
+ * @param arena Arena
+ */
+void dma_arena_reset(DmaArena_t* arena);
+
+/**
+ * @brief Allocate a block
+ * @param arena Arena
+ * @param size Size in bytes
+ * @param alignment Alignment (power of 2, raised to DMA_ALLOC_MIN_ALIGN)
+ * @return Block address, or 0 on failure
+ */
+uint64_t dma_arena_alloc(DmaArena_t* arena, uint64_t size, uint32_t alignment);
+
+/**
+ * @brief Free a block
+ * @param arena Arena
+ * @param addr Address returned by dma_arena_alloc()
+ * @return DMA_ALLOC_OK, or DMA_ALLOC_ERR_INVALID for a foreign address or
+ *         a double free
+ */
+int dma_arena_free(DmaArena_t* arena, uint64_t addr);
+
+/**
+ * @brief Check whether an address lies inside the arena
+ * @param arena Arena
+ * @param addr Address
+ * @return true if inside
+ */
+bool dma_arena_owns(const DmaArena_t* arena, uint64_t addr);
+
+/**
+ * @brief Get usage statistics
+ * @param arena Arena
+ * @param stats Statistics output
+ */
+void dma_arena_get_stats(const DmaArena_t* arena, DmaAllocStats_t* stats);
+
+/**
+ * @brief Size class of a request
+ * @param size Size in bytes
+ * @param alignment Alignment in bytes
+ * @return Class index, or DMA_ALLOC_NUM_CLASSES if larger than every class
+ *         (an arena serves classes at or above its slab_classes from the
+ *         large path too)
+ */
+uint32_t dma_alloc_size_class(uint64_t size, uint32_t alignment);
+
+/**
+ * @brief Block size of a class
+ * @param cls Class index
+ * @return Bytes
+ */
+uint32_t dma_alloc_class_size(uint32_t cls);
+
+#endif /* DMA_ALLOC_H */
@@ -0,0 +1,157 @@
+/**
+ * @file dma_buf.c
+ * @brief DMA Buffer Ownership Tracking Implementation
+ */
+
+#include <string.h>
+#include "dma_buf.h"
+#include "dma_phase.h"
+#include "cache_utils.h"
+#include "dma_pool.h"
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static DmaBuf_t g_DmaBufs[DMA_BUF_MAX_TRACKED];
+static DmaBufStats_t g_DmaBufStats = {0};
+static bool g_DmaBufTracking = true;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Registered buffer that fully contains [addr, addr+size), or NULL */
+static DmaBuf_t* dma_buf_find(uint64_t addr, uint32_t size)
+{
+    uint32_t i;
+
+    for (i = 0; i < DMA_BUF_MAX_TRACKED; i++) {
+        DmaBuf_t* buf = &g_DmaBufs[i];
+        if (buf->in_use && addr >= buf->addr &&
+            addr + size <= buf->addr + buf->size) {
+            return buf;
+        }
+    }
+    return NULL;
+}
+
+static void dma_buf_cache_op(uint64_t addr, uint32_t size, DmaDir_t dir)
+{
+    CacheMethod_t method;
+
+    if (dir == DMA_DIR_FROM_DEVICE) {
+        method = cache_maint_invalidate(addr, size);
+    } else {
+        method = cache_maint_flush(addr, size);
+    }
+
+    g_DmaBufStats.cache_ops++;
+    g_DmaBufStats.cache_bytes += size;
+    if (method == CACHE_METHOD_SET_WAY) {
+        g_DmaBufStats.setway_ops++;
+    }
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+DmaBuf_t* dma_buf_register(uint64_t addr, uint32_t size)
+{
+    uint32_t i;
+
+    for (i = 0; i < DMA_BUF_MAX_TRACKED; i++) {
+        if (!g_DmaBufs[i].in_use) {
+            g_DmaBufs[i].addr = addr;
+            g_DmaBufs[i].size = size;
+            g_DmaBufs[i].owner = DMA_BUF_OWNER_CPU;
+            g_DmaBufs[i].in_use = true;
+            return &g_DmaBufs[i];
+        }
+    }
+    return NULL;
+}
+
+void dma_buf_unregister(DmaBuf_t* buf)
+{
+    if (buf != NULL) {
+        buf->in_use = false;
+    }
+}
+
+void dma_buf_unregister_all(void)
+{
+    memset(g_DmaBufs, 0, sizeof(g_DmaBufs));
+}
+
+void dma_buf_sync_for_device(uint64_t addr, uint32_t size, DmaDir_t dir)
+{
+    uint64_t phase_start = dma_phase_begin();
+    DmaBuf_t* buf = dma_buf_find(addr, size);
+
+    /* Device-owned buffers hold no dirty lines: nothing to clean or drop */
+    if (g_DmaBufTracking && buf != NULL && buf->owner == DMA_BUF_OWNER_DEVICE) {
+        g_DmaBufStats.elided_ops++;
+        g_DmaBufStats.elided_bytes += size;
+    } else if (dma_pool_is_uncached(addr, size)) {
+        /* Never cached: only the CPU's buffered writes must land first */
+        __asm__ __volatile__("dsb sy" ::: "memory");
+        g_DmaBufStats.elided_ops++;
+        g_DmaBufStats.elided_bytes += size;
+    } else {
+        dma_buf_cache_op(addr, size, dir);
+
+        /* Only a whole-buffer sync proves the buffer clean */
+        if (buf != NULL && addr == buf->addr && size == buf->size) {
+            buf->owner = DMA_BUF_OWNER_DEVICE;
+        }
+    }
+
+    dma_phase_end((dir == DMA_DIR_FROM_DEVICE) ? DMA_PHASE_DST_INVALIDATE : DMA_PHASE_SRC_FLUSH,
+                  phase_start);
+}
+
+void dma_buf_sync_for_cpu(uint64_t addr, uint32_t size, DmaDir_t dir)
+{
+    uint64_t phase_start = dma_phase_begin();
+    DmaBuf_t* buf = dma_buf_find(addr, size);
+
+    /* Drop lines speculatively fetched while the device was writing */
+    if (dir != DMA_DIR_TO_DEVICE) {
+        __asm__ __volatile__("dsb sy" ::: "memory");
+        if (!dma_pool_is_uncached(addr, size)) {
+            dma_buf_cache_op(addr, size, DMA_DIR_FROM_DEVICE);
+        }
+    }
+
+    if (buf != NULL) {
+        buf->owner = DMA_BUF_OWNER_CPU;
+    }
+
+    if (dir != DMA_DIR_TO_DEVICE) {
+        dma_phase_end(DMA_PHASE_POST_INVALIDATE, phase_start);
+    }
+}
+
+void dma_buf_set_tracking(bool enable)
+{
+    g_DmaBufTracking = enable;
+}
+
+bool dma_buf_get_tracking(void)
+{
+    return g_DmaBufTracking;
+}
+
+void dma_buf_get_stats(DmaBufStats_t* stats)
+{
+    if (stats != NULL) {
+        *stats = g_DmaBufStats;
+    }
+}
+
+void dma_buf_clear_stats(void)
+{
+    memset(&g_DmaBufStats, 0, sizeof(g_DmaBufStats));
+}
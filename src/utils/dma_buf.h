@@ -0,0 +1,123 @@
+/**
+ * @file dma_buf.h
+ * @brief DMA Buffer Ownership Tracking Header
+ *
+ * Linux dma_sync-style ownership model. A registered buffer is either
+ * CPU-owned (caches may hold dirty lines) or device-owned (no dirty lines,
+ * CPU promises not to touch it). Handing a buffer to the device that it
+ * already owns needs no cache maintenance, so the drivers' per-transfer
+ * flush/invalidate is skipped. Unregistered ranges keep the unconditional
+ * maintenance the drivers always did.
+ */
+
+#ifndef DMA_BUF_H
+#define DMA_BUF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define DMA_BUF_MAX_TRACKED     32
+
+typedef enum {
+    DMA_DIR_TO_DEVICE = 0,      /* Device reads (source) */
+    DMA_DIR_FROM_DEVICE,        /* Device writes (destination) */
+    DMA_DIR_BIDIRECTIONAL
+} DmaDir_t;
+
+typedef enum {
+    DMA_BUF_OWNER_CPU = 0,
+    DMA_BUF_OWNER_DEVICE
+} DmaBufOwner_t;
+
+typedef struct {
+    uint64_t addr;
+    uint32_t size;
+    DmaBufOwner_t owner;
+    bool in_use;
+} DmaBuf_t;
+
+typedef struct {
+    uint64_t cache_ops;         /* Flush/invalidate range operations issued */
+    uint64_t cache_bytes;
+    uint64_t setway_ops;        /* Of those, done as a whole-cache set/way clean */
+    uint64_t elided_ops;        /* Operations skipped as redundant */
+    uint64_t elided_bytes;
+} DmaBufStats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Register a buffer for ownership tracking (starts CPU-owned)
+ * @param addr Buffer address
+ * @param size Buffer size in bytes
+ * @return Buffer handle, or NULL if the table is full
+ */
+DmaBuf_t* dma_buf_register(uint64_t addr, uint32_t size);
+
+/**
+ * @brief Stop tracking a buffer
+ * @param buf Buffer handle (NULL is ignored)
+ */
+void dma_buf_unregister(DmaBuf_t* buf);
+
+/**
+ * @brief Stop tracking all buffers
+ */
+void dma_buf_unregister_all(void);
+
+/**
+ * @brief Make a range visible to the device before a transfer
+ *
+ * Skipped when the range lies in a registered device-owned buffer;
+ * otherwise flushes (TO_DEVICE) or invalidates (FROM_DEVICE) and marks a
+ * registered buffer device-owned. Called by the drivers on every transfer.
+ *
+ * @param addr Start address
+ * @param size Size in bytes
+ * @param dir Transfer direction
+ */
+void dma_buf_sync_for_device(uint64_t addr, uint32_t size, DmaDir_t dir);
+
+/**
+ * @brief Return a range to the CPU after a transfer
+ *
+ * Invalidates for FROM_DEVICE/BIDIRECTIONAL so the CPU sees device data,
+ * and marks a registered buffer CPU-owned (next device sync will flush).
+ *
+ * @param addr Start address
+ * @param size Size in bytes
+ * @param dir Transfer direction
+ */
+void dma_buf_sync_for_cpu(uint64_t addr, uint32_t size, DmaDir_t dir);
+
+/**
+ * @brief Enable or disable elision (disabled: every sync does cache maintenance)
+ * @param enable true to elide redundant maintenance
+ */
+void dma_buf_set_tracking(bool enable);
+
+/**
+ * @brief Check whether elision is enabled
+ * @return true if enabled
+ */
+bool dma_buf_get_tracking(void);
+
+/**
+ * @brief Get cache maintenance statistics
+ * @param stats Statistics output
+ */
+void dma_buf_get_stats(DmaBufStats_t* stats);
+
+/**
+ * @brief Clear cache maintenance statistics
+ */
+void dma_buf_clear_stats(void);
+
+#endif /* DMA_BUF_H */
@@ -0,0 +1,94 @@
+/**
+ * @file dma_phase.c
+ * @brief Per-Phase Transfer Time Accounting Implementation
+ */
+
+#include <string.h>
+#include "dma_phase.h"
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+bool g_DmaPhaseActive = false;
+
+static uint64_t g_PhaseCycles[DMA_PHASE_COUNT];
+static uint64_t g_KickCycles;       /* Doorbell or end of the previous wait */
+
+static const char* const g_PhaseNames[DMA_PHASE_COUNT] = {
+    [DMA_PHASE_SRC_FLUSH]       = "src_flush",
+    [DMA_PHASE_DST_INVALIDATE]  = "dst_inval",
+    [DMA_PHASE_PROGRAM]         = "program",
+    [DMA_PHASE_HW_TRANSFER]     = "hw_xfer",
+    [DMA_PHASE_COMPLETION]      = "completion",
+    [DMA_PHASE_POST_INVALIDATE] = "post_inval"
+};
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+void dma_phase_record_start(void)
+{
+    memset(g_PhaseCycles, 0, sizeof(g_PhaseCycles));
+    g_KickCycles = 0;
+    g_DmaPhaseActive = true;
+}
+
+void dma_phase_record_stop(uint64_t phase_ns[DMA_PHASE_COUNT])
+{
+    g_DmaPhaseActive = false;
+
+    if (phase_ns == NULL) {
+        return;
+    }
+    for (uint32_t p = 0; p < DMA_PHASE_COUNT; p++) {
+        phase_ns[p] = timer_cycles_to_ns(g_PhaseCycles[p]);
+    }
+}
+
+void dma_phase_end(DmaPhase_t phase, uint64_t start_cycles)
+{
+    if (!g_DmaPhaseActive || start_cycles == 0 || phase >= DMA_PHASE_COUNT) {
+        return;
+    }
+    g_PhaseCycles[phase] += timer_get_cycles() - start_cycles;
+}
+
+void dma_phase_kick(uint64_t start_cycles)
+{
+    uint64_t now;
+
+    if (!g_DmaPhaseActive || start_cycles == 0) {
+        return;
+    }
+
+    now = timer_get_cycles();
+    g_PhaseCycles[DMA_PHASE_PROGRAM] += now - start_cycles;
+    g_KickCycles = now;
+}
+
+void dma_phase_complete(uint64_t seen_cycles)
+{
+    uint64_t now;
+
+    if (!g_DmaPhaseActive) {
+        return;
+    }
+
+    now = timer_get_cycles();
+    if (g_KickCycles != 0 && seen_cycles > g_KickCycles) {
+        g_PhaseCycles[DMA_PHASE_HW_TRANSFER] += seen_cycles - g_KickCycles;
+    }
+    if (now > seen_cycles) {
+        g_PhaseCycles[DMA_PHASE_COMPLETION] += now - seen_cycles;
+    }
+
+    /* A second wait on the same transfer (e.g. S2MM after MM2S) starts here */
+    g_KickCycles = now;
+}
+
+const char* dma_phase_to_string(DmaPhase_t phase)
+{
+    return (phase < DMA_PHASE_COUNT) ? g_PhaseNames[phase] : "unknown";
+}
@@ -0,0 +1,76 @@
+/**
+ * @file dma_phase.h
+ * @brief Per-Phase Transfer Time Accounting Header
+ *
+ * Drivers and the cache/wait layers bracket each phase of a transfer
+ * (cache maintenance, programming, hardware time, completion) with PMU
+ * cycle stamps. While a recording is active the phases are summed, so a
+ * test can report where each microsecond of a transfer goes. With no
+ * recording active each hook costs one flag test.
+ */
+
+#ifndef DMA_PHASE_H
+#define DMA_PHASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../dma_benchmark.h"
+#include "timer_utils.h"
+
+/* Exposed for the inline hook below */
+extern bool g_DmaPhaseActive;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Clear the phase totals and start recording
+ */
+void dma_phase_record_start(void);
+
+/**
+ * @brief Stop recording and return the totals
+ * @param phase_ns Per-phase totals output in nanoseconds (may be NULL)
+ */
+void dma_phase_record_stop(uint64_t phase_ns[DMA_PHASE_COUNT]);
+
+/**
+ * @brief Start stamp for a phase
+ * @return Cycle count, or 0 when not recording
+ */
+static inline uint64_t dma_phase_begin(void)
+{
+    return g_DmaPhaseActive ? timer_get_cycles() : 0;
+}
+
+/**
+ * @brief Add the time since start_cycles to a phase
+ * @param phase Phase
+ * @param start_cycles Stamp from dma_phase_begin()
+ */
+void dma_phase_end(DmaPhase_t phase, uint64_t start_cycles);
+
+/**
+ * @brief End the programming phase at the doorbell write; hardware time
+ *        is counted from here
+ * @param start_cycles Stamp from dma_phase_begin()
+ */
+void dma_phase_kick(uint64_t start_cycles);
+
+/**
+ * @brief Close a completion wait: hardware time runs from the doorbell (or
+ *        the previous wait) to the poll that saw completion, the rest of
+ *        the wait is completion handling
+ * @param seen_cycles Cycle count at the start of the completing poll
+ */
+void dma_phase_complete(uint64_t seen_cycles);
+
+/**
+ * @brief Get phase name
+ * @param phase Phase
+ * @return Name string (also used as the CSV column prefix)
+ */
+const char* dma_phase_to_string(DmaPhase_t phase);
+
+#endif /* DMA_PHASE_H */
@@ -0,0 +1,241 @@
+/**
+ * @file dma_pool.c
+ * @brief Memory-Attribute Buffer Pools Implementation
+ */
+
+#include <string.h>
+#include "xil_mmu.h"
+#include "dma_pool.h"
+#include "cache_utils.h"
+#include "../platform_config.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+/* Block descriptor fields (ARMv8 VMSA) */
+#define POOL_ATTRINDX_SHIFT     2
+#define POOL_ATTRINDX_MASK      (0x7ULL << POOL_ATTRINDX_SHIFT)
+#define POOL_XN                 ((1ULL << 53) | (1ULL << 54))   /* PXN | UXN */
+
+/* MAIR encoding of Device-GRE */
+#define POOL_MAIR_DEVICE_GRE    0x0CU
+
+/* MAIR slots the BSP translation tables leave unused (attribute byte 0) */
+#define POOL_MAIR_FREE_FIRST    5
+#define POOL_MAIR_FREE_LAST     7
+
+typedef struct {
+    uint64_t base;
+    uint32_t used;
+    bool created;
+} DmaPool_t;
+
+static const char* const g_PoolTypeNames[DMA_POOL_TYPE_COUNT] = {
+    [DMA_POOL_CACHEABLE]     = "Cacheable",
+    [DMA_POOL_NON_CACHEABLE] = "Non-cache",
+    [DMA_POOL_WRITE_COMBINE] = "WC (GRE)"
+};
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static DmaPool_t g_DmaPools[DMA_POOL_TYPE_COUNT];
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint64_t pool_base(DmaPoolType_t type)
+{
+    return DMA_POOL_REGION_BASE + (uint64_t)type * DMA_POOL_SIZE;
+}
+
+static bool pool_at_el3(void)
+{
+    uint64_t el;
+
+    __asm__ __volatile__("mrs %0, CurrentEL" : "=r" (el));
+    return ((el >> 2) & 0x3) == 3;
+}
+
+/*
+ * MAIR slot holding Device-GRE at the current exception level, or -1.
+ * The stock BSP MAIR has no Device-GRE entry, so the first unused slot
+ * is programmed with one. No descriptor references an unused slot, so
+ * existing mappings are unaffected; the TLB is still invalidated so no
+ * walk cached against the old MAIR value survives.
+ */
+static int pool_find_gre_index(void)
+{
+    bool el3 = pool_at_el3();
+    uint64_t mair;
+
+    if (el3) {
+        __asm__ __volatile__("mrs %0, mair_el3" : "=r" (mair));
+    } else {
+        __asm__ __volatile__("mrs %0, mair_el1" : "=r" (mair));
+    }
+
+    for (int i = 0; i < 8; i++) {
+        if (((mair >> (i * 8)) & 0xFF) == POOL_MAIR_DEVICE_GRE) {
+            return i;
+        }
+    }
+
+    for (int i = POOL_MAIR_FREE_FIRST; i <= POOL_MAIR_FREE_LAST; i++) {
+        if (((mair >> (i * 8)) & 0xFF) != 0) {
+            continue;
+        }
+        mair |= (uint64_t)POOL_MAIR_DEVICE_GRE << (i * 8);
+
+        __asm__ __volatile__("dsb sy" ::: "memory");
+        if (el3) {
+            __asm__ __volatile__("msr mair_el3, %0\n"
+                                 "isb\n"
+                                 "tlbi alle3\n"
+                                 : : "r" (mair) : "memory");
+        } else {
+            __asm__ __volatile__("msr mair_el1, %0\n"
+                                 "isb\n"
+                                 "tlbi vmalle1\n"
+                                 : : "r" (mair) : "memory");
+        }
+        __asm__ __volatile__("dsb sy\n"
+                             "isb\n" ::: "memory");
+        return i;
+    }
+    return -1;
+}
+
+static int pool_attributes(DmaPoolType_t type, uint64_t* attr)
+{
+    int gre;
+
+    switch (type) {
+        case DMA_POOL_CACHEABLE:
+            *attr = NORM_WB_CACHE;
+            return DMA_SUCCESS;
+
+        case DMA_POOL_NON_CACHEABLE:
+            *attr = NORM_NONCACHE;
+            return DMA_SUCCESS;
+
+        case DMA_POOL_WRITE_COMBINE:
+            gre = pool_find_gre_index();
+            if (gre < 0) {
+                return DMA_ERROR_NOT_SUPPORTED;
+            }
+            *attr = ((uint64_t)NORM_NONCACHE & ~POOL_ATTRINDX_MASK) |
+                    ((uint64_t)gre << POOL_ATTRINDX_SHIFT) | POOL_XN;
+            return DMA_SUCCESS;
+
+        default:
+            return DMA_ERROR_INVALID_PARAM;
+    }
+}
+
+static void pool_remap(uint64_t base, uint64_t attr)
+{
+    /* No line of the pool may survive the change of memory type */
+    cache_flush_invalidate_range(base, DMA_POOL_SIZE);
+
+    for (uint64_t off = 0; off < DMA_POOL_SIZE; off += DMA_POOL_BLOCK_SIZE) {
+        Xil_SetTlbAttributes((UINTPTR)(base + off), attr);
+    }
+    cache_memory_barrier();
+    cache_instruction_barrier();
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+int dma_pool_create(DmaPoolType_t type)
+{
+    DmaPool_t* pool;
+    uint64_t attr;
+    int status;
+
+    if (type >= DMA_POOL_TYPE_COUNT) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    pool = &g_DmaPools[type];
+    if (pool->created) {
+        return DMA_SUCCESS;
+    }
+
+    status = pool_attributes(type, &attr);
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    pool->base = pool_base(type);
+    pool->used = 0;
+    if (type != DMA_POOL_CACHEABLE) {
+        pool_remap(pool->base, attr);
+    }
+    pool->created = true;
+
+    return DMA_SUCCESS;
+}
+
+void dma_pool_destroy(DmaPoolType_t type)
+{
+    DmaPool_t* pool;
+
+    if (type >= DMA_POOL_TYPE_COUNT || !g_DmaPools[type].created) {
+        return;
+    }
+
+    pool = &g_DmaPools[type];
+    if (type != DMA_POOL_CACHEABLE) {
+        pool_remap(pool->base, NORM_WB_CACHE);
+    }
+    memset(pool, 0, sizeof(*pool));
+}
+
+void* dma_pool_alloc(DmaPoolType_t type, uint32_t size, uint32_t alignment)
+{
+    DmaPool_t* pool;
+    uint64_t addr;
+
+    if (type >= DMA_POOL_TYPE_COUNT || !g_DmaPools[type].created || size == 0) {
+        return NULL;
+    }
+
+    pool = &g_DmaPools[type];
+    addr = ALIGN_UP(pool->base + pool->used, (uint64_t)MAX(alignment, 1U));
+    if (addr + size > pool->base + DMA_POOL_SIZE) {
+        return NULL;
+    }
+
+    pool->used = (uint32_t)(addr + size - pool->base);
+    return (void*)(uintptr_t)addr;
+}
+
+void dma_pool_reset(DmaPoolType_t type)
+{
+    if (type < DMA_POOL_TYPE_COUNT) {
+        g_DmaPools[type].used = 0;
+    }
+}
+
+bool dma_pool_is_uncached(uint64_t addr, uint32_t size)
+{
+    for (uint32_t t = DMA_POOL_NON_CACHEABLE; t < DMA_POOL_TYPE_COUNT; t++) {
+        const DmaPool_t* pool = &g_DmaPools[t];
+        if (pool->created && addr >= pool->base &&
+            addr + size <= pool->base + DMA_POOL_SIZE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* dma_pool_type_to_string(DmaPoolType_t type)
+{
+    return (type < DMA_POOL_TYPE_COUNT) ? g_PoolTypeNames[type] : "unknown";
+}
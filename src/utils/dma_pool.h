@@ -0,0 +1,86 @@
+/**
+ * @file dma_pool.h
+ * @brief Memory-Attribute Buffer Pools Header
+ *
+ * Bump-allocated DMA buffer pools whose pages are remapped through the MMU.
+ * Non-cacheable and write-combining pools need no cache maintenance, so
+ * dma_buf skips the flush/invalidate for ranges inside them and only
+ * issues a barrier. Remapping works on the BSP's 2MB block entries, so
+ * pools stay block mapped and cost one TLB entry per 2MB.
+ */
+
+#ifndef DMA_POOL_H
+#define DMA_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define DMA_POOL_BLOCK_SIZE     MB(2)       /* MMU block mapping granule */
+#define DMA_POOL_SIZE           MB(16)      /* Per pool type */
+
+typedef enum {
+    DMA_POOL_CACHEABLE = 0,     /* Normal write-back (default mapping) */
+    DMA_POOL_NON_CACHEABLE,     /* Normal non-cacheable */
+    DMA_POOL_WRITE_COMBINE,     /* Device-GRE: gathered writes, no speculation */
+    DMA_POOL_TYPE_COUNT
+} DmaPoolType_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Remap a pool's blocks to its memory type (idempotent)
+ *
+ * Device-GRE pools use a Device-GRE slot in MAIR, programming an unused
+ * one (indices 5-7) if none exists; with no free slot the pool is
+ * reported unsupported. CPU access to them must be naturally aligned
+ * and must not use DC ZVA (memset of zero), which faults on Device memory.
+ *
+ * @param type Pool type
+ * @return 0 on success, negative error code on failure
+ */
+int dma_pool_create(DmaPoolType_t type);
+
+/**
+ * @brief Restore a pool's blocks to the default cacheable mapping
+ * @param type Pool type
+ */
+void dma_pool_destroy(DmaPoolType_t type);
+
+/**
+ * @brief Allocate from a pool
+ * @param type Pool type (must be created)
+ * @param size Size in bytes
+ * @param alignment Alignment in bytes (power of 2)
+ * @return Buffer address, or NULL if the pool is full or not created
+ */
+void* dma_pool_alloc(DmaPoolType_t type, uint32_t size, uint32_t alignment);
+
+/**
+ * @brief Release every allocation of a pool
+ * @param type Pool type
+ */
+void dma_pool_reset(DmaPoolType_t type);
+
+/**
+ * @brief Check whether a range lies in a pool that bypasses the data cache
+ * @param addr Start address
+ * @param size Size in bytes
+ * @return true if no cache maintenance is needed for the range
+ */
+bool dma_pool_is_uncached(uint64_t addr, uint32_t size);
+
+/**
+ * @brief Get pool type name
+ * @param type Pool type
+ * @return Name string
+ */
+const char* dma_pool_type_to_string(DmaPoolType_t type);
+
+#endif /* DMA_POOL_H */
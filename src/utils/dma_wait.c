@@ -0,0 +1,254 @@
+/**
+ * @file dma_wait.c
+ * @brief DMA Completion-Wait Strategies Implementation
+ *
+ * Replaces the fixed usleep(10) poll interval of the drivers with a
+ * selectable strategy, timed on the PMU cycle counter.
+ */
+
+#include <string.h>
+#include "xil_cache.h"
+#include "sleep.h"
+#include "dma_wait.h"
+#include "timer_utils.h"
+#include "dma_phase.h"
+#include "debug_print.h"
+#include "../platform_config.h"
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+DmaWaitStats_t g_DmaWaitStats = {0};
+
+static WaitStrategy_t g_WaitStrategy = WAIT_STRATEGY_MMIO_SPIN;
+
+static DmaWaitCalib_t g_WaitCalib[DMA_TYPE_COUNT] = {
+    [DMA_TYPE_AXI_DMA]    = { 3000, 1500 },
+    [DMA_TYPE_AXI_CDMA]   = { 3000, 1500 },
+    [DMA_TYPE_AXI_MCDMA]  = { 2000, 2000 },
+    [DMA_TYPE_LPD_DMA]    = { 1000, 1000 },
+    [DMA_TYPE_QDMA]       = { DMA_WAIT_DEFAULT_MBPS, DMA_WAIT_DEFAULT_FIXED_NS },
+    [DMA_TYPE_CPU_MEMCPY] = { DMA_WAIT_DEFAULT_MBPS, DMA_WAIT_DEFAULT_FIXED_NS },
+};
+
+static const char* g_WaitStrategyNames[WAIT_STRATEGY_COUNT] = {
+    "USLEEP",
+    "MMIO_SPIN",
+    "BD_POLL",
+    "PREDICTIVE",
+    "WFE"
+};
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static inline uint64_t wait_us_to_cycles(uint64_t us)
+{
+    return (us * timer_get_frequency()) / 1000000ULL;
+}
+
+static inline uint64_t wait_ns_to_cycles(uint64_t ns)
+{
+    return (ns * timer_get_frequency()) / 1000000000ULL;
+}
+
+/**
+ * Enable the generic timer event stream so WFE wakes periodically even
+ * when the DMA engine raises no event. An event is generated on every
+ * 0->1 transition of counter bit EVNTI, i.e. every 2^(EVNTI+1) ticks.
+ */
+static void wait_enable_event_stream(void)
+{
+    uint64_t cntfrq;
+    uint64_t period_ticks;
+    uint64_t ctl;
+    uint32_t evnti = 0;
+
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r" (cntfrq));
+    if (cntfrq == 0) {
+        cntfrq = TTC_CLK_FREQ_HZ;
+    }
+
+    period_ticks = (cntfrq * DMA_WAIT_WFE_PERIOD_NS) / 1000000000ULL;
+    while (evnti < 15 && (2ULL << (evnti + 1)) <= period_ticks) {
+        evnti++;
+    }
+
+    __asm__ __volatile__("mrs %0, cntkctl_el1" : "=r" (ctl));
+    ctl &= ~(0xFULL << 4);              /* EVNTI */
+    ctl &= ~(1ULL << 3);                /* EVNTDIR: 0->1 transition */
+    ctl |= ((uint64_t)evnti << 4) | (1ULL << 2);    /* EVNTEN */
+    __asm__ __volatile__("msr cntkctl_el1, %0" : : "r" (ctl));
+    __asm__ __volatile__("isb");
+
+    LOG_DEBUG("DMA wait: event stream every %lu ticks (CNTFRQ=%llu Hz)\r\n",
+              (unsigned long)(2UL << evnti), (unsigned long long)cntfrq);
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+void dma_wait_init(void)
+{
+    wait_enable_event_stream();
+    dma_wait_clear_stats();
+    LOG_DEBUG("DMA wait: strategy %s\r\n", dma_wait_strategy_to_string(g_WaitStrategy));
+}
+
+int dma_wait_set_strategy(WaitStrategy_t strategy)
+{
+    if (strategy >= WAIT_STRATEGY_COUNT) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+
+    g_WaitStrategy = strategy;
+    return DMA_SUCCESS;
+}
+
+WaitStrategy_t dma_wait_get_strategy(void)
+{
+    return g_WaitStrategy;
+}
+
+const char* dma_wait_strategy_to_string(WaitStrategy_t strategy)
+{
+    if (strategy < WAIT_STRATEGY_COUNT) {
+        return g_WaitStrategyNames[strategy];
+    }
+    return "UNKNOWN";
+}
+
+void dma_wait_calibrate(DmaType_t dma_type, uint32_t bandwidth_mbps, uint32_t fixed_ns)
+{
+    if (dma_type >= DMA_TYPE_COUNT || bandwidth_mbps == 0) {
+        return;
+    }
+
+    g_WaitCalib[dma_type].bandwidth_mbps = bandwidth_mbps;
+    g_WaitCalib[dma_type].fixed_ns = fixed_ns;
+}
+
+const DmaWaitCalib_t* dma_wait_get_calibration(DmaType_t dma_type)
+{
+    if (dma_type >= DMA_TYPE_COUNT) {
+        return NULL;
+    }
+    return &g_WaitCalib[dma_type];
+}
+
+uint32_t dma_wait_expected_ns(DmaType_t dma_type, uint32_t length)
+{
+    const DmaWaitCalib_t* calib;
+    uint64_t stream_ns;
+
+    if (dma_type >= DMA_TYPE_COUNT || length == 0) {
+        return 0;
+    }
+
+    calib = &g_WaitCalib[dma_type];
+
+    /* MB/s uses 2^20 bytes, matching CALC_THROUGHPUT_MBPS() */
+    stream_ns = ((uint64_t)length * 1000000000ULL) /
+                ((uint64_t)calib->bandwidth_mbps * 1048576ULL);
+
+    return (uint32_t)MIN(stream_ns + calib->fixed_ns, 0xFFFFFFFFULL);
+}
+
+void dma_wait_begin(DmaWait_t* wait, uint32_t timeout_us, uint32_t expected_ns)
+{
+    uint64_t holdoff_end;
+
+    wait->strategy = g_WaitStrategy;
+    wait->timeout_us = timeout_us;
+    wait->legacy_elapsed_us = 0;
+    wait->polls = 0;
+    wait->start_cycles = timer_get_cycles();
+    wait->deadline_cycles = wait->start_cycles + wait_us_to_cycles(timeout_us);
+
+    /* Predictive: spin on the local cycle counter, no bus traffic */
+    if (wait->strategy == WAIT_STRATEGY_PREDICTIVE && expected_ns > 0) {
+        holdoff_end = wait->start_cycles +
+                      wait_ns_to_cycles(((uint64_t)expected_ns * DMA_WAIT_PREDICT_PERCENT) / 100);
+        while (timer_get_cycles() < holdoff_end) {
+            __asm__ __volatile__("yield");
+        }
+    }
+    wait->poll_cycles = dma_phase_begin();
+}
+
+bool dma_wait_continue(DmaWait_t* wait)
+{
+    uint64_t now;
+
+    wait->polls++;
+
+    switch (wait->strategy) {
+        case WAIT_STRATEGY_USLEEP:
+            /* Keep the legacy accounting so behavior is unchanged */
+            usleep(DMA_WAIT_LEGACY_POLL_US);
+            wait->legacy_elapsed_us += DMA_WAIT_LEGACY_POLL_US;
+            wait->poll_cycles = dma_phase_begin();
+            return wait->legacy_elapsed_us < wait->timeout_us;
+
+        case WAIT_STRATEGY_WFE:
+            __asm__ __volatile__("wfe" ::: "memory");
+            break;
+
+        case WAIT_STRATEGY_MMIO_SPIN:
+        case WAIT_STRATEGY_BD_POLL:
+        case WAIT_STRATEGY_PREDICTIVE:
+        default:
+            break;
+    }
+
+    now = timer_get_cycles();
+    wait->poll_cycles = now;
+    return now < wait->deadline_cycles;
+}
+
+void dma_wait_end(DmaWait_t* wait, bool timed_out)
+{
+    g_DmaWaitStats.waits++;
+    g_DmaWaitStats.polls += wait->polls;
+    if (timed_out) {
+        g_DmaWaitStats.timeouts++;
+    } else {
+        dma_phase_complete(wait->poll_cycles);
+    }
+}
+
+uint32_t dma_wait_elapsed_us(const DmaWait_t* wait)
+{
+    if (wait->strategy == WAIT_STRATEGY_USLEEP) {
+        return wait->legacy_elapsed_us;
+    }
+    return (uint32_t)timer_cycles_to_us(timer_get_cycles() - wait->start_cycles);
+}
+
+bool dma_wait_use_bd(void)
+{
+    return g_WaitStrategy == WAIT_STRATEGY_BD_POLL;
+}
+
+bool dma_wait_bd_complete(volatile uint32_t* status_word, uint32_t complete_mask)
+{
+    /* Drop the stale line so the next load observes the engine's write-back */
+    Xil_DCacheInvalidateRange((UINTPTR)status_word, sizeof(uint32_t));
+    g_DmaWaitStats.bd_reads++;
+    return (*status_word & complete_mask) != 0;
+}
+
+void dma_wait_get_stats(DmaWaitStats_t* stats)
+{
+    if (stats != NULL) {
+        *stats = g_DmaWaitStats;
+    }
+}
+
+void dma_wait_clear_stats(void)
+{
+    memset(&g_DmaWaitStats, 0, sizeof(g_DmaWaitStats));
+}
@@ -0,0 +1,186 @@
+/**
+ * @file dma_wait.h
+ * @brief DMA Completion-Wait Strategies Header
+ *
+ * Common completion-wait layer shared by all DMA drivers. The drivers keep
+ * their own status decoding; this module decides how long to pause between
+ * status polls and accounts for the MMIO reads spent waiting.
+ */
+
+#ifndef DMA_WAIT_H
+#define DMA_WAIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xil_io.h"
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Wait Strategy Definitions
+ ******************************************************************************/
+
+typedef enum {
+    WAIT_STRATEGY_USLEEP = 0,       /* Status read + usleep(10) (legacy) */
+    WAIT_STRATEGY_MMIO_SPIN,        /* Tight status register spin */
+    WAIT_STRATEGY_BD_POLL,          /* Spin on BD completion bit in memory */
+    WAIT_STRATEGY_PREDICTIVE,       /* Sleep for expected duration, then spin */
+    WAIT_STRATEGY_WFE,              /* WFE on timer event stream between polls */
+    WAIT_STRATEGY_COUNT
+} WaitStrategy_t;
+
+#define DMA_WAIT_LEGACY_POLL_US     10      /* Legacy usleep() poll interval */
+#define DMA_WAIT_PREDICT_PERCENT    90      /* Hold-off as % of expected time */
+#define DMA_WAIT_WFE_PERIOD_NS      1000    /* Target event stream period */
+
+/* Default calibration used until dma_wait_calibrate() is called */
+#define DMA_WAIT_DEFAULT_MBPS       1000
+#define DMA_WAIT_DEFAULT_FIXED_NS   1000
+
+/*******************************************************************************
+ * Wait Context and Statistics
+ ******************************************************************************/
+
+typedef struct {
+    WaitStrategy_t strategy;
+    uint64_t start_cycles;
+    uint64_t deadline_cycles;
+    uint64_t poll_cycles;           /* Start of the latest status poll */
+    uint32_t timeout_us;
+    uint32_t legacy_elapsed_us;
+    uint32_t polls;
+} DmaWait_t;
+
+typedef struct {
+    uint64_t waits;             /* Completed wait calls */
+    uint64_t polls;             /* Poll loop iterations */
+    uint64_t mmio_reads;        /* Status register reads while waiting */
+    uint64_t bd_reads;          /* Descriptor status reads while waiting */
+    uint64_t timeouts;          /* Waits that hit the timeout */
+} DmaWaitStats_t;
+
+typedef struct {
+    uint32_t bandwidth_mbps;    /* Calibrated streaming bandwidth */
+    uint32_t fixed_ns;          /* Calibrated per-transfer fixed cost */
+} DmaWaitCalib_t;
+
+/* Exposed for the inline accessors below */
+extern DmaWaitStats_t g_DmaWaitStats;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Initialize wait layer (enables the WFE event stream)
+ */
+void dma_wait_init(void);
+
+/**
+ * @brief Select the completion-wait strategy used by all drivers
+ * @param strategy Wait strategy
+ * @return 0 on success, negative error code on failure
+ */
+int dma_wait_set_strategy(WaitStrategy_t strategy);
+
+/**
+ * @brief Get the active completion-wait strategy
+ * @return Active wait strategy
+ */
+WaitStrategy_t dma_wait_get_strategy(void);
+
+/**
+ * @brief Get wait strategy name string
+ * @param strategy Wait strategy
+ * @return Strategy name
+ */
+const char* dma_wait_strategy_to_string(WaitStrategy_t strategy);
+
+/**
+ * @brief Set bandwidth/fixed-cost calibration for predictive waits
+ * @param dma_type DMA engine
+ * @param bandwidth_mbps Streaming bandwidth in MB/s
+ * @param fixed_ns Fixed per-transfer cost in nanoseconds
+ */
+void dma_wait_calibrate(DmaType_t dma_type, uint32_t bandwidth_mbps, uint32_t fixed_ns);
+
+/**
+ * @brief Get calibration for a DMA engine
+ * @param dma_type DMA engine
+ * @return Pointer to calibration entry
+ */
+const DmaWaitCalib_t* dma_wait_get_calibration(DmaType_t dma_type);
+
+/**
+ * @brief Expected transfer duration from calibration
+ * @param dma_type DMA engine
+ * @param length Transfer length in bytes
+ * @return Expected duration in nanoseconds
+ */
+uint32_t dma_wait_expected_ns(DmaType_t dma_type, uint32_t length);
+
+/**
+ * @brief Begin a wait; predictive strategy holds off here without polling
+ * @param wait Wait context
+ * @param timeout_us Timeout in microseconds
+ * @param expected_ns Expected duration (0 if unknown)
+ */
+void dma_wait_begin(DmaWait_t* wait, uint32_t timeout_us, uint32_t expected_ns);
+
+/**
+ * @brief Pause between polls according to the strategy
+ * @param wait Wait context
+ * @return true to poll again, false if the timeout expired
+ */
+bool dma_wait_continue(DmaWait_t* wait);
+
+/**
+ * @brief Finish a wait and account its statistics
+ * @param wait Wait context
+ * @param timed_out true if the wait hit its timeout
+ */
+void dma_wait_end(DmaWait_t* wait, bool timed_out);
+
+/**
+ * @brief Elapsed time since dma_wait_begin()
+ * @param wait Wait context
+ * @return Elapsed time in microseconds
+ */
+uint32_t dma_wait_elapsed_us(const DmaWait_t* wait);
+
+/**
+ * @brief Check whether drivers should poll descriptor status in memory
+ * @return true if the BD polling strategy is active
+ */
+bool dma_wait_use_bd(void);
+
+/**
+ * @brief Read a descriptor status word from memory (invalidates its line)
+ * @param status_word Pointer to descriptor status word
+ * @param complete_mask Completion bit mask
+ * @return true if the completion bit is set
+ */
+bool dma_wait_bd_complete(volatile uint32_t* status_word, uint32_t complete_mask);
+
+/**
+ * @brief Get wait statistics
+ * @param stats Statistics output
+ */
+void dma_wait_get_stats(DmaWaitStats_t* stats);
+
+/**
+ * @brief Clear wait statistics
+ */
+void dma_wait_clear_stats(void);
+
+/**
+ * @brief Counted MMIO status read for use in driver wait loops
+ * @param addr Register address
+ * @return Register value
+ */
+static inline uint32_t dma_wait_mmio_read(UINTPTR addr)
+{
+    g_DmaWaitStats.mmio_reads++;
+    return Xil_In32(addr);
+}
+
+#endif /* DMA_WAIT_H */
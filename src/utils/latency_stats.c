@@ -0,0 +1,64 @@
+/**
+ * @file latency_stats.c
+ * @brief Latency Distribution Utilities Implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "latency_stats.h"
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int latency_stats_compare(const void* a, const void* b)
+{
+    uint32_t va = *(const uint32_t*)a;
+    uint32_t vb = *(const uint32_t*)b;
+
+    return (va > vb) - (va < vb);
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+uint32_t latency_stats_percentile(const uint32_t* sorted, uint32_t count, uint32_t per_mille)
+{
+    uint64_t rank;
+
+    /* Nearest rank: ceil(p * n), 1-based */
+    rank = ((uint64_t)per_mille * count + 999) / 1000;
+    if (rank == 0) {
+        rank = 1;
+    }
+    if (rank > count) {
+        rank = count;
+    }
+    return sorted[rank - 1];
+}
+
+void latency_stats_compute(uint32_t* samples, uint32_t count, LatencyStats_t* stats)
+{
+    uint64_t sum = 0;
+
+    memset(stats, 0, sizeof(*stats));
+    if (samples == NULL || count == 0) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), latency_stats_compare);
+
+    for (uint32_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+
+    stats->count = count;
+    stats->min = samples[0];
+    stats->max = samples[count - 1];
+    stats->avg = (uint32_t)(sum / count);
+    stats->p50 = latency_stats_percentile(samples, count, 500);
+    stats->p90 = latency_stats_percentile(samples, count, 900);
+    stats->p99 = latency_stats_percentile(samples, count, 990);
+    stats->p999 = latency_stats_percentile(samples, count, 999);
+}
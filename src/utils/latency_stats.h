@@ -0,0 +1,53 @@
+/**
+ * @file latency_stats.h
+ * @brief Latency Distribution Utilities Header
+ *
+ * Summarizes a set of per-transfer latency samples as min/avg/max and
+ * nearest-rank percentiles. Plain C with no BSP dependencies.
+ */
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Latency distribution summary (same unit as the samples)
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    uint32_t p999;
+    uint32_t max;
+} LatencyStats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Summarize latency samples
+ * @param samples Sample array; sorted in place
+ * @param count Number of samples
+ * @param stats Summary output (all zero when count is 0)
+ */
+void latency_stats_compute(uint32_t* samples, uint32_t count, LatencyStats_t* stats);
+
+/**
+ * @brief Nearest-rank percentile of sorted samples
+ * @param sorted Samples in ascending order
+ * @param count Number of samples (> 0)
+ * @param per_mille Percentile in tenths of a percent (990 = p99)
+ * @return Sample value at that rank
+ */
+uint32_t latency_stats_percentile(const uint32_t* sorted, uint32_t count, uint32_t per_mille);
+
+#endif /* LATENCY_STATS_H */
@@ -7,62 +7,235 @@
 #include "memory_utils.h"
 #include "timer_utils.h"
 #include "debug_print.h"
+#include "data_patterns.h"
 #include "xil_cache.h"
 #include "../dma_benchmark.h"
 
 /*******************************************************************************
- * Static Memory Pools for Test Regions
+ * Test Region Arenas
  ******************************************************************************/
 
-/* Track allocations from each region */
-static uint32_t g_RegionOffsets[MEM_REGION_COUNT] = {0};
+static DmaArena_t g_RegionArenas[MEM_REGION_COUNT];
+static DmaArena_t* g_RegionArena[MEM_REGION_COUNT];     /* NULL until first use */
+
+static const char* const g_PlacementNames[MEM_PLACE_COUNT] = {
+    [MEM_PLACE_SAME_COLOR]  = "Same color",
+    [MEM_PLACE_SAME_BANK]   = "Same bank",
+    [MEM_PLACE_BANK_SPREAD] = "Bank spread"
+};
 
 /*******************************************************************************
- * Public Functions
+ * Helper Functions
  ******************************************************************************/
 
-void* memory_alloc_aligned(MemoryRegion_t region, uint32_t size, uint32_t alignment)
+static DmaArena_t* memory_get_arena(MemoryRegion_t region)
 {
-    uint64_t base;
-    uint64_t aligned_addr;
-    uint32_t current_offset;
     const MemoryRegionInfo_t* info;
+    uint32_t r;
 
     if (region >= MEM_REGION_COUNT || region == MEM_REGION_HOST) {
         return NULL;
     }
+    if (g_RegionArena[region] != NULL) {
+        return g_RegionArena[region];
+    }
 
     info = &g_MemoryRegions[region];
-    current_offset = g_RegionOffsets[region];
+    if (info->test_size == 0) {
+        return NULL;
+    }
 
-    /* Calculate aligned address */
-    base = info->test_base + current_offset;
-    aligned_addr = ALIGN_UP(base, alignment);
+    /* Regions aliasing the same memory must not hand out the same bytes twice */
+    for (r = 0; r < MEM_REGION_COUNT; r++) {
+        if (g_RegionArena[r] != NULL && g_MemoryRegions[r].test_base == info->test_base) {
+            g_RegionArena[region] = g_RegionArena[r];
+            return g_RegionArena[region];
+        }
+    }
 
-    /* Check if allocation fits */
-    if ((aligned_addr - info->test_base) + size > info->test_size) {
-        LOG_WARNING("Allocation failed in %s (size=%u)\r\n", info->name, size);
+    if (dma_arena_init(&g_RegionArenas[region], info->name,
+                       info->test_base, info->test_size) != DMA_ALLOC_OK) {
         return NULL;
     }
+    g_RegionArena[region] = &g_RegionArenas[region];
+    return g_RegionArena[region];
+}
 
-    /* Update offset for next allocation */
-    g_RegionOffsets[region] = (aligned_addr - info->test_base) + size;
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
 
-    return (void*)(uintptr_t)aligned_addr;
+void* memory_alloc_aligned(MemoryRegion_t region, uint64_t size, uint32_t alignment)
+{
+    DmaArena_t* arena = memory_get_arena(region);
+    uint64_t addr;
+
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    addr = dma_arena_alloc(arena, size, alignment);
+    if (addr == 0) {
+        LOG_WARNING("Allocation failed in %s (size=%llu)\r\n",
+                    g_MemoryRegions[region].name, (unsigned long long)size);
+        return NULL;
+    }
+
+    return (void*)(uintptr_t)addr;
 }
 
 void memory_free_aligned(void* ptr)
 {
-    /* Simple allocator - no individual frees, use reset instead */
-    (void)ptr;
+    uint64_t addr = (uint64_t)(uintptr_t)ptr;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    for (uint32_t r = 0; r < MEM_REGION_COUNT; r++) {
+        if (g_RegionArena[r] == &g_RegionArenas[r] && dma_arena_owns(g_RegionArena[r], addr)) {
+            if (dma_arena_free(g_RegionArena[r], addr) != DMA_ALLOC_OK) {
+                LOG_WARNING("Free of 0x%llX in %s: not an allocated block\r\n",
+                            (unsigned long long)addr, g_RegionArena[r]->name);
+            }
+            return;
+        }
+    }
+
+    LOG_WARNING("Free of 0x%llX outside every arena\r\n", (unsigned long long)addr);
+}
+
+uint64_t memory_alloc_dma_buffer(MemoryRegion_t region, uint64_t size)
+{
+    return (uint64_t)(uintptr_t)memory_alloc_aligned(region, size, DMA_ALLOC_MIN_ALIGN);
+}
+
+void memory_free_dma_buffer(uint64_t addr)
+{
+    memory_free_aligned((void*)(uintptr_t)addr);
+}
+
+bool memory_desc_ring_config_valid(const DescRingConfig_t* config)
+{
+    return config != NULL && config->depth >= 2 && config->depth <= DESC_RING_MAX_DEPTH &&
+           memory_get_arena(config->region) != NULL;
+}
+
+void* memory_alloc_desc_ring(const DescRingConfig_t* config, uint32_t bd_size)
+{
+    if (!memory_desc_ring_config_valid(config) || bd_size == 0) {
+        return NULL;
+    }
+    return memory_alloc_aligned(config->region, (uint64_t)config->depth * bd_size,
+                                DESC_ALIGNMENT);
+}
+
+int memory_alloc_dma_pair(MemoryRegion_t region, uint64_t size, uint64_t color_offset,
+                          MemBufferPair_t* pair)
+{
+    uint64_t rel;
+
+    if (pair == NULL || size == 0) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    memset(pair, 0, sizeof(*pair));
+
+    rel = ALIGN_UP(size, (uint64_t)MEM_COLOR_PERIOD) + color_offset;
+    pair->block = (uint64_t)(uintptr_t)memory_alloc_aligned(region, rel + size,
+                                                            (uint32_t)MEM_COLOR_PERIOD);
+    if (pair->block == 0) {
+        return DMA_ERROR_NO_MEMORY;
+    }
+
+    pair->src = pair->block;
+    pair->dst = pair->block + rel;
+    return DMA_SUCCESS;
+}
+
+void memory_free_dma_pair(MemBufferPair_t* pair)
+{
+    if (pair != NULL) {
+        memory_free_dma_buffer(pair->block);
+        memset(pair, 0, sizeof(*pair));
+    }
+}
+
+uint64_t memory_placement_offset(MemPlacement_t mode)
+{
+    switch (mode) {
+        case MEM_PLACE_SAME_BANK:
+            /* Other half of the same bank row: only the L2 sets move */
+            return DDR_PAGE_SIZE / 2;
+        case MEM_PLACE_BANK_SPREAD:
+            return MEM_COLOR_PERIOD / 2;
+        default:
+            return 0;
+    }
+}
+
+const char* memory_placement_to_string(MemPlacement_t mode)
+{
+    return (mode < MEM_PLACE_COUNT) ? g_PlacementNames[mode] : "unknown";
+}
+
+void memory_get_addr_color(uint64_t addr, MemAddrColor_t* color)
+{
+    if (color == NULL) {
+        return;
+    }
+    color->bank = (uint32_t)((addr >> DDR_BANK_SHIFT) & (DDR_NUM_BANKS - 1));
+    color->l2_set = (uint32_t)((addr / CPU_CACHE_LINE_SIZE) & (CPU_L2_NUM_SETS - 1));
+    color->row = addr / DDR_BANK_SPAN;
+}
+
+void memory_get_alloc_stats(MemoryRegion_t region, DmaAllocStats_t* stats)
+{
+    DmaArena_t* arena = memory_get_arena(region);
+
+    if (stats == NULL) {
+        return;
+    }
+    if (arena == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    dma_arena_get_stats(arena, stats);
+}
+
+void memory_print_alloc_stats(void)
+{
+    DmaAllocStats_t stats;
+
+    LOG_RESULT("\r\n=== Buffer Allocator ===\r\n");
+    for (uint32_t r = 0; r < MEM_REGION_COUNT; r++) {
+        /* Each arena once, under the region that created it */
+        if (g_RegionArena[r] != &g_RegionArenas[r]) {
+            continue;
+        }
+
+        dma_arena_get_stats(g_RegionArena[r], &stats);
+        LOG_RESULT("  %s:\r\n", g_RegionArena[r]->name);
+        LOG_RESULT("    In use:       %llu KB (peak %llu KB)\r\n",
+                   (unsigned long long)(stats.bytes_in_use / 1024),
+                   (unsigned long long)(stats.peak_bytes / 1024));
+        LOG_RESULT("    Free:         %llu KB (largest %llu KB)\r\n",
+                   (unsigned long long)(stats.free_bytes / 1024),
+                   (unsigned long long)(stats.largest_free / 1024));
+        LOG_RESULT("    Allocs/Frees: %lu / %lu, %lu failed\r\n",
+                   (unsigned long)stats.allocs, (unsigned long)stats.frees,
+                   (unsigned long)stats.failures);
+        LOG_RESULT("    Live blocks:  %lu large, %lu slabs\r\n",
+                   (unsigned long)stats.large_blocks, (unsigned long)stats.slabs);
+    }
+    LOG_RESULT("========================\r\n");
 }
 
-uint64_t memory_get_test_addr(MemoryRegion_t region, uint32_t offset, uint32_t size)
+uint64_t memory_get_test_addr(MemoryRegion_t region, uint64_t offset, uint64_t size)
 {
     const MemoryRegionInfo_t* info;
 
-    LOG_DEBUG("memory_get_test_addr: region=%d, offset=0x%lX, size=%lu\r\n",
-              (int)region, (unsigned long)offset, (unsigned long)size);
+    LOG_DEBUG("memory_get_test_addr: region=%d, offset=0x%llX, size=%llu\r\n",
+              (int)region, (unsigned long long)offset, (unsigned long long)size);
 
     if (region >= MEM_REGION_COUNT || region == MEM_REGION_HOST) {
         LOG_ERROR("memory_get_test_addr: Invalid region %d\r\n", (int)region);
@@ -75,7 +248,7 @@ uint64_t memory_get_test_addr(MemoryRegion_t region, uint32_t offset, uint32_t s
               info->name, (unsigned long long)info->test_base, (unsigned long long)info->test_size);
 
     /* Check if requested range fits */
-    if (offset + size > info->test_size) {
+    if (offset > info->test_size || size > info->test_size - offset) {
         LOG_ERROR("memory_get_test_addr: Range doesn't fit! offset+size=0x%llX > test_size=0x%llX\r\n",
                   (unsigned long long)(offset + size), (unsigned long long)info->test_size);
         return 0;
@@ -86,7 +259,7 @@ uint64_t memory_get_test_addr(MemoryRegion_t region, uint32_t offset, uint32_t s
     return info->test_base + offset;
 }
 
-bool memory_is_valid_range(MemoryRegion_t region, uint64_t addr, uint32_t size)
+bool memory_is_valid_range(MemoryRegion_t region, uint64_t addr, uint64_t size)
 {
     const MemoryRegionInfo_t* info;
 
@@ -101,7 +274,7 @@ bool memory_is_valid_range(MemoryRegion_t region, uint64_t addr, uint32_t size)
         return false;
     }
 
-    if (addr + size > info->test_base + info->test_size) {
+    if (size > info->test_size || addr - info->test_base > info->test_size - size) {
         return false;
     }
 
@@ -149,37 +322,12 @@ bool memory_compare(const void* buf1, const void* buf2, uint32_t size, uint32_t*
 
 bool memory_verify_pattern(const void* buf, uint32_t size, uint8_t pattern_type, uint32_t* first_diff)
 {
-    const uint8_t* p = (const uint8_t*)buf;
-    uint8_t expected;
-    uint32_t i;
-
-    for (i = 0; i < size; i++) {
-        switch (pattern_type) {
-            case PATTERN_INCREMENTAL:
-                expected = (uint8_t)(i & 0xFF);
-                break;
-            case PATTERN_ALL_ONES:
-                expected = 0xFF;
-                break;
-            case PATTERN_ALL_ZEROS:
-                expected = 0x00;
-                break;
-            case PATTERN_CHECKERBOARD:
-                expected = (i & 1) ? 0x55 : 0xAA;
-                break;
-            default:
-                return false;
-        }
-
-        if (p[i] != expected) {
-            if (first_diff) {
-                *first_diff = i;
-            }
-            return false;
-        }
+    /* Random data needs the fill seed: use pattern_verify() directly */
+    if (pattern_type >= PATTERN_COUNT || pattern_type == PATTERN_RANDOM ||
+        pattern_type == PATTERN_RANDOM_CTR) {
+        return false;
     }
-
-    return true;
+    return pattern_verify(buf, size, (DataPattern_t)pattern_type, 0, first_diff, NULL, NULL);
 }
 
 uint32_t memory_cpu_memcpy_benchmark(void* dst, const void* src, uint32_t size, uint32_t iterations)
@@ -11,6 +11,51 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../platform_config.h"
+#include "dma_alloc.h"
+
+/*******************************************************************************
+ * Type Definitions
+ ******************************************************************************/
+
+/**
+ * @brief Source/destination placement relative to DDR banks and L2 sets
+ */
+typedef enum {
+    MEM_PLACE_SAME_COLOR = 0,       /* Same DDR bank, same L2 sets */
+    MEM_PLACE_SAME_BANK,            /* Same DDR bank, different L2 sets */
+    MEM_PLACE_BANK_SPREAD,          /* Opposite half of the banks and L2 sets */
+    MEM_PLACE_COUNT
+} MemPlacement_t;
+
+/**
+ * @brief Source and destination carved from one backing block
+ */
+typedef struct {
+    uint64_t src;
+    uint64_t dst;
+    uint64_t block;                 /* Backing allocation */
+} MemBufferPair_t;
+
+/**
+ * @brief Placement and depth of an engine's descriptor rings
+ */
+typedef struct {
+    MemoryRegion_t region;          /* Where the rings are allocated (DDR4, OCM, ...) */
+    uint32_t depth;                 /* Descriptors per ring */
+} DescRingConfig_t;
+
+#define DESC_RING_DEFAULT_DEPTH     MAX_SG_DESCRIPTORS
+#define DESC_RING_MAX_DEPTH         4096
+#define DESC_RING_CONFIG_DEFAULT    { MEM_REGION_DDR4, DESC_RING_DEFAULT_DEPTH }
+
+/**
+ * @brief DDR bank, row and L2 set an address maps to
+ */
+typedef struct {
+    uint32_t bank;
+    uint32_t l2_set;
+    uint64_t row;
+} MemAddrColor_t;
 
 /*******************************************************************************
  * Function Prototypes
@@ -18,19 +63,109 @@
 
 /**
  * @brief Allocate aligned buffer in specified memory region
+ *
+ * Each region's test area is a dma_alloc arena; regions that share a test
+ * area (DDR4 and LPDDR4 on this board) share the arena. Buffers are at
+ * least cache-line aligned.
+ *
  * @param region Memory region to allocate from
  * @param size Size in bytes
  * @param alignment Alignment requirement (must be power of 2)
  * @return Pointer to allocated buffer, NULL on failure
  */
-void* memory_alloc_aligned(MemoryRegion_t region, uint32_t size, uint32_t alignment);
+void* memory_alloc_aligned(MemoryRegion_t region, uint64_t size, uint32_t alignment);
 
 /**
  * @brief Free aligned buffer
- * @param ptr Pointer to buffer
+ * @param ptr Pointer to buffer (NULL is ignored)
  */
 void memory_free_aligned(void* ptr);
 
+/**
+ * @brief Allocate a cache-line aligned DMA test buffer
+ * @param region Memory region to allocate from
+ * @param size Size in bytes
+ * @return Buffer address, 0 on failure
+ */
+uint64_t memory_alloc_dma_buffer(MemoryRegion_t region, uint64_t size);
+
+/**
+ * @brief Free a DMA test buffer
+ * @param addr Buffer address (0 is ignored)
+ */
+void memory_free_dma_buffer(uint64_t addr);
+
+/**
+ * @brief Allocate descriptor memory for one ring
+ * @param config Ring placement and depth
+ * @param bd_size Descriptor stride in bytes
+ * @return Descriptor memory (DESC_ALIGNMENT aligned), NULL on failure
+ */
+void* memory_alloc_desc_ring(const DescRingConfig_t* config, uint32_t bd_size);
+
+/**
+ * @brief Check a ring configuration
+ * @param config Ring placement and depth
+ * @return true if the depth is in range and the region has an arena
+ */
+bool memory_desc_ring_config_valid(const DescRingConfig_t* config);
+
+/**
+ * @brief Allocate a source/destination pair with a controlled relative offset
+ *
+ * Both buffers come from one block aligned to MEM_COLOR_PERIOD. The
+ * destination starts at the first color period boundary past the source
+ * plus color_offset, so dst - src modulo MEM_COLOR_PERIOD is color_offset
+ * and the buffers never overlap.
+ *
+ * @param region Memory region to allocate from
+ * @param size Size of each buffer in bytes
+ * @param color_offset Destination offset beyond the aligned gap
+ * @param pair Buffer pair output
+ * @return 0 on success, negative error code on failure
+ */
+int memory_alloc_dma_pair(MemoryRegion_t region, uint64_t size, uint64_t color_offset,
+                          MemBufferPair_t* pair);
+
+/**
+ * @brief Free a buffer pair (an empty pair is ignored)
+ * @param pair Buffer pair
+ */
+void memory_free_dma_pair(MemBufferPair_t* pair);
+
+/**
+ * @brief Color offset implementing a placement mode
+ * @param mode Placement mode
+ * @return Offset for memory_alloc_dma_pair()
+ */
+uint64_t memory_placement_offset(MemPlacement_t mode);
+
+/**
+ * @brief Get placement mode name
+ * @param mode Placement mode
+ * @return Name string
+ */
+const char* memory_placement_to_string(MemPlacement_t mode);
+
+/**
+ * @brief Decode the DDR bank, row and L2 set of an address
+ * @param addr Physical address
+ * @param color Color output
+ */
+void memory_get_addr_color(uint64_t addr, MemAddrColor_t* color);
+
+/**
+ * @brief Get allocator statistics of a region's arena
+ * @param region Memory region
+ * @param stats Statistics output (zeroed if the region has no arena)
+ */
+void memory_get_alloc_stats(MemoryRegion_t region, DmaAllocStats_t* stats);
+
+/**
+ * @brief Print allocator statistics of every arena
+ */
+void memory_print_alloc_stats(void);
+
 /**
  * @brief Get buffer address in specified memory region for testing
  * @param region Memory region
@@ -38,7 +173,7 @@ void memory_free_aligned(void* ptr);
  * @param size Required size
  * @return Address if valid, 0 on error
  */
-uint64_t memory_get_test_addr(MemoryRegion_t region, uint32_t offset, uint32_t size);
+uint64_t memory_get_test_addr(MemoryRegion_t region, uint64_t offset, uint64_t size);
 
 /**
  * @brief Check if address range is valid for a memory region
@@ -47,7 +182,7 @@ uint64_t memory_get_test_addr(MemoryRegion_t region, uint32_t offset, uint32_t s
  * @param size Size in bytes
  * @return true if valid, false otherwise
  */
-bool memory_is_valid_range(MemoryRegion_t region, uint64_t addr, uint32_t size);
+bool memory_is_valid_range(MemoryRegion_t region, uint64_t addr, uint64_t size);
 
 /**
  * @brief Compare two memory buffers
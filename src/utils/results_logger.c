@@ -110,10 +110,11 @@ void results_logger_log_csv(const TestResult_t* result)
 
     /* CSV format:
      * dma_type,test_type,src_memory,dst_memory,transfer_size,data_pattern,mode,
-     * throughput_mbps,latency_us,cpu_util,integrity,iterations
+     * throughput_mbps,latency_us,cpu_util,integrity,iterations,
+     * src_flush_ns,dst_inval_ns,program_ns,hw_xfer_ns,completion_ns,post_inval_ns
      * Note: Using integer format for xil_printf compatibility
      */
-    LOG_RESULT("%s,%s,%s,%s,%lu,%s,%s,%lu,%lu,%lu,%s,%lu\r\n",
+    LOG_RESULT("%s,%s,%s,%s,%lu,%s,%s,%lu,%lu,%lu,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
                dma_type_to_string(result->dma_type),
                test_type_to_string(result->test_type),
                memory_region_to_string(result->src_region),
@@ -125,7 +126,13 @@ void results_logger_log_csv(const TestResult_t* result)
                (unsigned long)result->latency_us,
                (unsigned long)result->cpu_utilization,
                result->data_integrity ? "PASS" : "FAIL",
-               (unsigned long)result->iterations);
+               (unsigned long)result->iterations,
+               (unsigned long)result->phase_ns[DMA_PHASE_SRC_FLUSH],
+               (unsigned long)result->phase_ns[DMA_PHASE_DST_INVALIDATE],
+               (unsigned long)result->phase_ns[DMA_PHASE_PROGRAM],
+               (unsigned long)result->phase_ns[DMA_PHASE_HW_TRANSFER],
+               (unsigned long)result->phase_ns[DMA_PHASE_COMPLETION],
+               (unsigned long)result->phase_ns[DMA_PHASE_POST_INVALIDATE]);
 }
 
 void results_logger_log_text(const TestResult_t* result)
@@ -157,7 +164,36 @@ void results_logger_print_csv_header(void)
 {
     LOG_RESULT("dma_type,test_type,src_memory,dst_memory,transfer_size,"
                "data_pattern,mode,throughput_mbps,latency_us,cpu_util,"
-               "integrity,iterations\r\n");
+               "integrity,iterations,src_flush_ns,dst_inval_ns,program_ns,"
+               "hw_xfer_ns,completion_ns,post_inval_ns\r\n");
+}
+
+void results_logger_print_bw_csv_header(void)
+{
+    if (!g_CsvEnabled) {
+        return;
+    }
+
+    LOG_RESULT("kernel,memory,array_size,bytes_per_elem,best_mbps,avg_mbps,"
+               "min_mbps,runs,integrity\r\n");
+}
+
+void results_logger_log_bw_csv(const BandwidthResult_t* result)
+{
+    if (!result || !g_CsvEnabled) {
+        return;
+    }
+
+    LOG_RESULT("%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%s\r\n",
+               result->kernel,
+               memory_region_to_string(result->region),
+               (unsigned long)result->array_size,
+               (unsigned long)result->bytes_per_elem,
+               (unsigned long)result->best_mbps,
+               (unsigned long)result->avg_mbps,
+               (unsigned long)result->min_mbps,
+               (unsigned long)result->runs,
+               result->data_integrity ? "PASS" : "FAIL");
 }
 
 void results_logger_print_summary(void)
@@ -19,6 +19,25 @@
 #define MAX_SESSION_NAME_LEN    64
 #define MAX_CSV_LINE_LEN        512
 
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+
+/**
+ * @brief One CPU bandwidth measurement (kernel x region x size)
+ */
+typedef struct {
+    const char* kernel;             /* Kernel name */
+    MemoryRegion_t region;
+    uint64_t array_size;            /* Bytes per array */
+    uint32_t bytes_per_elem;        /* Bytes moved per element (reads + writes) */
+    uint32_t best_mbps;
+    uint32_t avg_mbps;
+    uint32_t min_mbps;
+    uint32_t runs;
+    bool data_integrity;
+} BandwidthResult_t;
+
 /*******************************************************************************
  * Function Prototypes
  ******************************************************************************/
@@ -68,6 +87,17 @@ void results_logger_log_text(const TestResult_t* result);
  */
 void results_logger_print_csv_header(void);
 
+/**
+ * @brief Print CSV header line for bandwidth results
+ */
+void results_logger_print_bw_csv_header(void);
+
+/**
+ * @brief Log a bandwidth result in CSV format (to UART)
+ * @param result Bandwidth result to log
+ */
+void results_logger_log_bw_csv(const BandwidthResult_t* result);
+
 /**
  * @brief Print session summary
  */
@@ -0,0 +1,343 @@
+/**
+ * @file smp_core.c
+ * @brief Second A72 Core Bring-Up Implementation
+ *
+ * At EL1, PSCI starts core 1 at smp_core1_entry with the MMU and caches
+ * off and the boot block address in x0. At EL3 there is no PSCI firmware:
+ * the PLM powers core 1 up at smp_core1_entry_el3 (XPm_RequestWakeUp sets
+ * its reset vector), which finds the boot block by address. Either
+ * trampoline loads core 0's system registers from the block, turns the
+ * MMU and caches on and calls the entry function on its own stack. The
+ * build only compiles C sources, so the trampolines are top-level inline
+ * assembly.
+ */
+
+#include <stddef.h>
+#include "xstatus.h"
+#include "xipipsu.h"
+#include "pm_api_sys.h"
+#include "xil_cache.h"
+#include "xparameters.h"
+#include "smp_core.h"
+#include "cache_utils.h"
+#include "timer_utils.h"
+#include "../dma_benchmark.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+/* PSCI function IDs (SMC64 where an address is passed) */
+#define PSCI_CPU_OFF                0x84000002U
+#define PSCI_CPU_ON                 0xC4000003U
+#define PSCI_AFFINITY_INFO          0xC4000004U
+
+/* PSCI return codes */
+#define PSCI_RET_SUCCESS            0
+#define PSCI_RET_NOT_SUPPORTED      (-1)
+#define PSCI_RET_ALREADY_ON         (-4)
+#define PSCI_RET_ON_PENDING         (-5)
+
+#define PSCI_AFFINITY_OFF           1
+
+/* IPI channel owned by this core, used to reach the PLM */
+#define SMP_IPI_DEVICE_ID           XPAR_XIPIPSU_0_DEVICE_ID
+
+/* Boot block read by the trampoline with the MMU off (offsets are fixed) */
+typedef struct {
+    uint64_t sp;                    /* 0x00 */
+    uint64_t cpacr;                 /* 0x08 CPACR_EL1, or CPTR_EL3 at EL3 */
+    uint64_t mair;                  /* 0x10 */
+    uint64_t tcr;                   /* 0x18 */
+    uint64_t ttbr0;                 /* 0x20 */
+    uint64_t vbar;                  /* 0x28 */
+    uint64_t sctlr;                 /* 0x30 */
+    uint64_t entry;                 /* 0x38 */
+    uint64_t arg;                   /* 0x40 */
+} SmpCoreBoot_t;
+
+_Static_assert(offsetof(SmpCoreBoot_t, sctlr) == 0x30, "trampoline offsets");
+_Static_assert(offsetof(SmpCoreBoot_t, arg) == 0x40, "trampoline offsets");
+
+void smp_core1_entry(void);
+void smp_core1_entry_el3(void);
+
+__asm__(
+    "   .section .text.smp_core1_entry, \"ax\"\n"
+    "   .global  smp_core1_entry\n"
+    "   .type    smp_core1_entry, %function\n"
+    "   .balign  8\n"
+    "smp_core1_entry:\n"
+    "   mov     x19, x0\n"
+    "   ldr     x1, [x19, #0x00]\n"
+    "   mov     sp, x1\n"
+    "   ldr     x1, [x19, #0x08]\n"
+    "   msr     cpacr_el1, x1\n"
+    "   ldr     x1, [x19, #0x10]\n"
+    "   msr     mair_el1, x1\n"
+    "   ldr     x1, [x19, #0x18]\n"
+    "   msr     tcr_el1, x1\n"
+    "   ldr     x1, [x19, #0x20]\n"
+    "   msr     ttbr0_el1, x1\n"
+    "   ldr     x1, [x19, #0x28]\n"
+    "   msr     vbar_el1, x1\n"
+    "   isb\n"
+    "   tlbi    vmalle1\n"
+    "   ic      iallu\n"
+    "   dsb     nsh\n"
+    "   isb\n"
+    "   ldr     x1, [x19, #0x30]\n"
+    "   msr     sctlr_el1, x1\n"
+    "   isb\n"
+    "   ldr     x0, [x19, #0x40]\n"
+    "   ldr     x1, [x19, #0x38]\n"
+    "   blr     x1\n"
+    "   movz    x0, #0x8400, lsl #16\n"
+    "   movk    x0, #0x0002\n"
+    "   smc     #0\n"
+    "1: wfe\n"
+    "   b       1b\n"
+    "   .size    smp_core1_entry, . - smp_core1_entry\n"
+    "   .previous\n"
+);
+
+/*
+ * EL3 entry from reset: caches come up invalid, SMPEN must be set before
+ * they are enabled so core 1 joins the cluster's coherency, and the block
+ * is found PC-relative because the PLM passes no argument.
+ */
+__asm__(
+    "   .section .text.smp_core1_entry_el3, \"ax\"\n"
+    "   .global  smp_core1_entry_el3\n"
+    "   .type    smp_core1_entry_el3, %function\n"
+    "   .balign  8\n"
+    "smp_core1_entry_el3:\n"
+    "   adrp    x19, g_Core1Boot\n"
+    "   add     x19, x19, :lo12:g_Core1Boot\n"
+    "   ldr     x1, [x19, #0x00]\n"
+    "   mov     sp, x1\n"
+    "   ldr     x1, [x19, #0x08]\n"
+    "   msr     cptr_el3, x1\n"
+    "   mrs     x1, s3_1_c15_c2_1\n"
+    "   orr     x1, x1, #0x40\n"
+    "   msr     s3_1_c15_c2_1, x1\n"
+    "   ldr     x1, [x19, #0x10]\n"
+    "   msr     mair_el3, x1\n"
+    "   ldr     x1, [x19, #0x18]\n"
+    "   msr     tcr_el3, x1\n"
+    "   ldr     x1, [x19, #0x20]\n"
+    "   msr     ttbr0_el3, x1\n"
+    "   ldr     x1, [x19, #0x28]\n"
+    "   msr     vbar_el3, x1\n"
+    "   isb\n"
+    "   tlbi    alle3\n"
+    "   ic      iallu\n"
+    "   dsb     sy\n"
+    "   isb\n"
+    "   ldr     x1, [x19, #0x30]\n"
+    "   msr     sctlr_el3, x1\n"
+    "   isb\n"
+    "   ldr     x0, [x19, #0x40]\n"
+    "   ldr     x1, [x19, #0x38]\n"
+    "   blr     x1\n"
+    "   bl      smp_core1_el3_exit\n"
+    "1: wfi\n"
+    "   b       1b\n"
+    "   .size    smp_core1_entry_el3, . - smp_core1_entry_el3\n"
+    "   .previous\n"
+);
+
+/*******************************************************************************
+ * Local Variables
+ ******************************************************************************/
+
+static SmpCoreBoot_t g_Core1Boot __attribute__((aligned(64), used));
+static uint8_t g_Core1Stack[SMP_CORE1_STACK_SIZE] __attribute__((aligned(64)));
+
+/* EL3 only: PLM client state and core 1's "about to power down" flag */
+static XIpiPsu g_SmpIpi;
+static bool g_SmpPmReady = false;
+static volatile bool g_Core1Parked __attribute__((aligned(64))) = false;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int64_t psci_call(uint64_t fn, uint64_t arg1, uint64_t arg2, uint64_t arg3)
+{
+    register uint64_t x0 __asm__("x0") = fn;
+    register uint64_t x1 __asm__("x1") = arg1;
+    register uint64_t x2 __asm__("x2") = arg2;
+    register uint64_t x3 __asm__("x3") = arg3;
+
+    /* SMC calling convention: x4-x17 may be clobbered */
+    __asm__ __volatile__("smc #0"
+                         : "+r" (x0), "+r" (x1), "+r" (x2), "+r" (x3)
+                         :
+                         : "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11",
+                           "x12", "x13", "x14", "x15", "x16", "x17", "memory");
+    return (int64_t)x0;
+}
+
+static uint64_t smp_current_el(void)
+{
+    uint64_t el;
+
+    __asm__ __volatile__("mrs %0, CurrentEL" : "=r" (el));
+    return (el >> 2) & 0x3;
+}
+
+/* Core 1 of this core's cluster */
+static uint64_t smp_core1_mpidr(void)
+{
+    uint64_t mpidr;
+
+    __asm__ __volatile__("mrs %0, mpidr_el1" : "=r" (mpidr));
+    return (mpidr & 0xFF00FFFF00ULL) | 1;
+}
+
+static int smp_pm_init(void)
+{
+    XIpiPsu_Config* cfg;
+
+    if (g_SmpPmReady) {
+        return DMA_SUCCESS;
+    }
+
+    cfg = XIpiPsu_LookupConfig(SMP_IPI_DEVICE_ID);
+    if (cfg == NULL ||
+        XIpiPsu_CfgInitialize(&g_SmpIpi, cfg, cfg->BaseAddress) != XST_SUCCESS ||
+        XPm_InitXilpm(&g_SmpIpi) != XST_SUCCESS) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    g_SmpPmReady = true;
+    return DMA_SUCCESS;
+}
+
+/* Core 1, EL3: entry returned. Runs once, never returns. */
+static void __attribute__((used, noreturn)) smp_core1_el3_exit(void)
+{
+    /* Arm the PSM to power the core down at WFI */
+    XPm_SelfSuspend(PM_DEV_ACPU_1, XPM_MAX_LATENCY, PM_SUSPEND_STATE_CPU_IDLE, 0);
+
+    /* Power-down drops core 1's L1 without writing it back */
+    Xil_DCacheFlush();
+
+    g_Core1Parked = true;
+    cache_flush_range((uint64_t)(uintptr_t)&g_Core1Parked, sizeof(g_Core1Parked));
+
+    for (;;) {
+        __asm__ __volatile__("dsb sy\n\twfi" ::: "memory");
+    }
+}
+
+static int smp_core1_start_el3(void)
+{
+    int status = smp_pm_init();
+
+    if (status != DMA_SUCCESS) {
+        return status;
+    }
+
+    g_Core1Parked = false;
+    cache_flush_range((uint64_t)(uintptr_t)&g_Core1Parked, sizeof(g_Core1Parked));
+
+    /* SetAddress = 1: the PLM programs core 1's reset vector */
+    if (XPm_RequestWakeUp(PM_DEV_ACPU_1, 1, (uint64_t)(uintptr_t)smp_core1_entry_el3,
+                          REQUEST_ACK_BLOCKING) != XST_SUCCESS) {
+        return DMA_ERROR_BUSY;
+    }
+    return DMA_SUCCESS;
+}
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+bool smp_core1_available(void)
+{
+    uint64_t el = smp_current_el();
+
+    return el == 1 || (el == 3 && smp_pm_init() == DMA_SUCCESS);
+}
+
+int smp_core1_start(SmpCoreEntry_t entry, void* arg)
+{
+    SmpCoreBoot_t* boot = &g_Core1Boot;
+    int64_t ret;
+
+    if (entry == NULL) {
+        return DMA_ERROR_INVALID_PARAM;
+    }
+    if (!smp_core1_available()) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    boot->sp = (uint64_t)(uintptr_t)(g_Core1Stack + sizeof(g_Core1Stack));
+    boot->entry = (uint64_t)(uintptr_t)entry;
+    boot->arg = (uint64_t)(uintptr_t)arg;
+
+    if (smp_current_el() == 3) {
+        __asm__ __volatile__("mrs %0, cptr_el3" : "=r" (boot->cpacr));
+        __asm__ __volatile__("mrs %0, mair_el3" : "=r" (boot->mair));
+        __asm__ __volatile__("mrs %0, tcr_el3" : "=r" (boot->tcr));
+        __asm__ __volatile__("mrs %0, ttbr0_el3" : "=r" (boot->ttbr0));
+        __asm__ __volatile__("mrs %0, vbar_el3" : "=r" (boot->vbar));
+        __asm__ __volatile__("mrs %0, sctlr_el3" : "=r" (boot->sctlr));
+
+        /* Core 1 reads the block with its caches off */
+        cache_flush_range((uint64_t)(uintptr_t)boot, sizeof(*boot));
+        return smp_core1_start_el3();
+    }
+
+    __asm__ __volatile__("mrs %0, cpacr_el1" : "=r" (boot->cpacr));
+    __asm__ __volatile__("mrs %0, mair_el1" : "=r" (boot->mair));
+    __asm__ __volatile__("mrs %0, tcr_el1" : "=r" (boot->tcr));
+    __asm__ __volatile__("mrs %0, ttbr0_el1" : "=r" (boot->ttbr0));
+    __asm__ __volatile__("mrs %0, vbar_el1" : "=r" (boot->vbar));
+    __asm__ __volatile__("mrs %0, sctlr_el1" : "=r" (boot->sctlr));
+
+    /* Core 1 reads the block with its caches off */
+    cache_flush_range((uint64_t)(uintptr_t)boot, sizeof(*boot));
+
+    ret = psci_call(PSCI_CPU_ON, smp_core1_mpidr(),
+                    (uint64_t)(uintptr_t)smp_core1_entry, (uint64_t)(uintptr_t)boot);
+    switch (ret) {
+        case PSCI_RET_SUCCESS:
+            return DMA_SUCCESS;
+        case PSCI_RET_ALREADY_ON:
+        case PSCI_RET_ON_PENDING:
+            return DMA_ERROR_BUSY;
+        case PSCI_RET_NOT_SUPPORTED:
+            return DMA_ERROR_NOT_SUPPORTED;
+        default:
+            return DMA_ERROR_DMA_FAIL;
+    }
+}
+
+int smp_core1_wait_off(uint32_t timeout_us)
+{
+    uint64_t start = timer_start();
+
+    if (!smp_core1_available()) {
+        return DMA_ERROR_NOT_SUPPORTED;
+    }
+
+    /* EL3: core 1 has written back its caches and is at its final WFI */
+    if (smp_current_el() == 3) {
+        while (!g_Core1Parked) {
+            if (timer_stop_us(start) > timeout_us) {
+                return DMA_ERROR_TIMEOUT;
+            }
+        }
+        return DMA_SUCCESS;
+    }
+
+    while (psci_call(PSCI_AFFINITY_INFO, smp_core1_mpidr(), 0, 0) != PSCI_AFFINITY_OFF) {
+        if (timer_stop_us(start) > timeout_us) {
+            return DMA_ERROR_TIMEOUT;
+        }
+    }
+    return DMA_SUCCESS;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file smp_core.h
+ * @brief Second A72 Core Bring-Up Header
+ *
+ * Starts core 1 of the APU cluster on a C function, with the same
+ * translation tables, vectors and FP/SIMD access as core 0, so both cores
+ * see the same coherent memory. At non-secure EL1 this goes through PSCI
+ * CPU_ON (ATF/BL31). At EL3, the default build, there is no PSCI firmware:
+ * the PLM is asked over IPI (xilpm) to wake core 1 at a reset vector, and
+ * core 1 suspends itself through the PLM when its function returns.
+ */
+
+#ifndef SMP_CORE_H
+#define SMP_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define SMP_CORE1_STACK_SIZE    (16 * 1024)
+
+typedef void (*SmpCoreEntry_t)(void* arg);
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Power up core 1 and run entry(arg) on it
+ *
+ * When entry() returns, core 1 powers itself off (PSCI CPU_OFF at EL1,
+ * PLM self-suspend at EL3) and may be started again.
+ *
+ * @param entry Function to run on core 1
+ * @param arg Argument
+ * @return 0 on success, DMA_ERROR_BUSY if core 1 is still on,
+ *         DMA_ERROR_NOT_SUPPORTED without PSCI or the PLM, negative error code
+ *         on failure
+ */
+int smp_core1_start(SmpCoreEntry_t entry, void* arg);
+
+/**
+ * @brief Wait for core 1 to power off after its entry function returned
+ * @param timeout_us Timeout in microseconds
+ * @return 0 once off, DMA_ERROR_TIMEOUT otherwise
+ */
+int smp_core1_wait_off(uint32_t timeout_us);
+
+/**
+ * @brief Whether core 1 can be started here (EL1 with PSCI, or EL3 with a
+ *        reachable PLM)
+ * @return true if smp_core1_start() can succeed
+ */
+bool smp_core1_available(void);
+
+#endif /* SMP_CORE_H */
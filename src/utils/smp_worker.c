@@ -0,0 +1,104 @@
+/**
+ * @file smp_worker.c
+ * @brief Second-Core Worker Loop Implementation
+ *
+ * The completion queue is as deep as the job queue and submit() refuses
+ * once that many jobs are unreaped, so the worker never blocks posting a
+ * completion.
+ */
+
+#include <string.h>
+#include "smp_worker.h"
+
+/*******************************************************************************
+ * Local Definitions
+ ******************************************************************************/
+
+/* Spin-wait hint while the job queue is empty */
+#if defined(__aarch64__)
+#define SMP_WORKER_RELAX()  __asm__ __volatile__("yield" ::: "memory")
+#elif defined(__x86_64__) || defined(__i386__)
+#define SMP_WORKER_RELAX()  __asm__ __volatile__("pause" ::: "memory")
+#else
+#define SMP_WORKER_RELAX()  __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+void smp_worker_init(SmpWorker_t* w)
+{
+    memset(w, 0, sizeof(*w));
+    spsc_queue_init(&w->jobs, w->job_storage, SMP_WORKER_QUEUE_DEPTH, sizeof(SmpJob_t));
+    spsc_queue_init(&w->done, w->done_storage, SMP_WORKER_QUEUE_DEPTH, sizeof(SmpDone_t));
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+bool smp_worker_submit(SmpWorker_t* w, SmpJobFn_t fn, void* arg, uint64_t cookie)
+{
+    SmpJob_t job = { .fn = fn, .arg = arg, .cookie = cookie };
+
+    if (fn == NULL || w->in_flight >= SMP_WORKER_QUEUE_DEPTH) {
+        return false;
+    }
+    if (!spsc_queue_push(&w->jobs, &job)) {
+        return false;
+    }
+    w->in_flight++;
+    return true;
+}
+
+bool smp_worker_reap(SmpWorker_t* w, SmpDone_t* done)
+{
+    if (!spsc_queue_pop(&w->done, done)) {
+        return false;
+    }
+    w->in_flight--;
+    return true;
+}
+
+uint32_t smp_worker_pending(const SmpWorker_t* w)
+{
+    return w->in_flight;
+}
+
+void smp_worker_run(SmpWorker_t* w)
+{
+    SmpJob_t job;
+    SmpDone_t done;
+
+    __atomic_store_n(&w->running, 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        if (spsc_queue_pop(&w->jobs, &job)) {
+            done.cookie = job.cookie;
+            done.status = job.fn(job.arg);
+
+            /* Cannot fail: completions never outnumber submitted jobs */
+            while (!spsc_queue_push(&w->done, &done)) {
+                SMP_WORKER_RELAX();
+            }
+            __atomic_store_n(&w->jobs_run, w->jobs_run + 1, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (__atomic_load_n(&w->stop, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        __atomic_store_n(&w->idle_polls, w->idle_polls + 1, __ATOMIC_RELAXED);
+        SMP_WORKER_RELAX();
+    }
+
+    __atomic_store_n(&w->running, 0, __ATOMIC_RELEASE);
+}
+
+void smp_worker_stop(SmpWorker_t* w)
+{
+    __atomic_store_n(&w->stop, 1, __ATOMIC_RELEASE);
+}
+
+bool smp_worker_is_running(SmpWorker_t* w)
+{
+    return __atomic_load_n(&w->running, __ATOMIC_ACQUIRE) != 0;
+}
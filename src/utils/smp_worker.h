@@ -0,0 +1,113 @@
+/**
+ * @file smp_worker.h
+ * @brief Second-Core Worker Loop Header
+ *
+ * A worker runs jobs (function + argument) taken from one SPSC queue and
+ * posts each job's status with its cookie on a second queue. The owner
+ * submits and reaps from one thread; smp_worker_run() runs on another
+ * (core 1 on the board, a pthread on a host). Like spsc_queue, this file
+ * uses no BSP headers.
+ */
+
+#ifndef SMP_WORKER_H
+#define SMP_WORKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "spsc_queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define SMP_WORKER_QUEUE_DEPTH  64      /* Jobs in flight (power of 2) */
+
+typedef int (*SmpJobFn_t)(void* arg);
+
+typedef struct {
+    SmpJobFn_t fn;
+    void* arg;
+    uint64_t cookie;                /* Returned with the completion */
+} SmpJob_t;
+
+typedef struct {
+    uint64_t cookie;
+    int status;                     /* fn() return value */
+} SmpDone_t;
+
+typedef struct {
+    SpscQueue_t jobs;               /* Owner -> worker */
+    SpscQueue_t done;               /* Worker -> owner */
+    SmpJob_t job_storage[SMP_WORKER_QUEUE_DEPTH];
+    SmpDone_t done_storage[SMP_WORKER_QUEUE_DEPTH];
+
+    /* Owner side */
+    uint32_t in_flight;             /* Submitted, not yet reaped */
+
+    /* Shared */
+    uint32_t stop;                  /* Set by owner, read by worker */
+    uint32_t running;               /* Set by worker while in smp_worker_run() */
+
+    /* Worker side, read by the owner */
+    uint64_t jobs_run;
+    uint64_t idle_polls;
+} SmpWorker_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Initialize a worker (before either side uses it)
+ * @param w Worker
+ */
+void smp_worker_init(SmpWorker_t* w);
+
+/**
+ * @brief Queue a job (owner only)
+ * @param w Worker
+ * @param fn Job function, run on the worker
+ * @param arg Job argument
+ * @param cookie Returned with the completion
+ * @return true if queued, false if SMP_WORKER_QUEUE_DEPTH jobs are unreaped
+ */
+bool smp_worker_submit(SmpWorker_t* w, SmpJobFn_t fn, void* arg, uint64_t cookie);
+
+/**
+ * @brief Retire one completed job (owner only)
+ * @param w Worker
+ * @param done Completion output
+ * @return true if a completion was returned, false if none is ready
+ */
+bool smp_worker_reap(SmpWorker_t* w, SmpDone_t* done);
+
+/**
+ * @brief Jobs submitted and not yet reaped (owner only)
+ * @param w Worker
+ * @return Count
+ */
+uint32_t smp_worker_pending(const SmpWorker_t* w);
+
+/**
+ * @brief Worker loop: run jobs until smp_worker_stop() (worker side)
+ *
+ * Jobs still queued when the stop is seen are run before returning.
+ *
+ * @param w Worker
+ */
+void smp_worker_run(SmpWorker_t* w);
+
+/**
+ * @brief Ask the worker loop to return (owner only)
+ * @param w Worker
+ */
+void smp_worker_stop(SmpWorker_t* w);
+
+/**
+ * @brief Whether the worker loop is executing
+ * @param w Worker
+ * @return true while inside smp_worker_run()
+ */
+bool smp_worker_is_running(SmpWorker_t* w);
+
+#endif /* SMP_WORKER_H */
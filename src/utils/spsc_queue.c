@@ -0,0 +1,71 @@
+/**
+ * @file spsc_queue.c
+ * @brief Lock-Free Single-Producer/Single-Consumer Queue Implementation
+ *
+ * head and tail are free-running counters; tail - head is the fill level.
+ * The element is written before tail is released and read before head is
+ * released, so acquire/release on the two indices is the only ordering
+ * needed.
+ */
+
+#include <string.h>
+#include "spsc_queue.h"
+
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+bool spsc_queue_init(SpscQueue_t* q, void* storage, uint32_t capacity, uint32_t elem_size)
+{
+    if (q == NULL || storage == NULL || elem_size == 0 ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+
+    memset(q, 0, sizeof(*q));
+    q->storage = (uint8_t*)storage;
+    q->mask = capacity - 1;
+    q->elem_size = elem_size;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return true;
+}
+
+bool spsc_queue_push(SpscQueue_t* q, const void* elem)
+{
+    uint32_t tail = q->tail;        /* Only this side writes tail */
+
+    if (tail - q->cached_head > q->mask) {
+        q->cached_head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+        if (tail - q->cached_head > q->mask) {
+            return false;
+        }
+    }
+
+    memcpy(q->storage + (size_t)(tail & q->mask) * q->elem_size, elem, q->elem_size);
+    __atomic_store_n(&q->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool spsc_queue_pop(SpscQueue_t* q, void* elem)
+{
+    uint32_t head = q->head;        /* Only this side writes head */
+
+    if (head == q->cached_tail) {
+        q->cached_tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+        if (head == q->cached_tail) {
+            return false;
+        }
+    }
+
+    memcpy(elem, q->storage + (size_t)(head & q->mask) * q->elem_size, q->elem_size);
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t spsc_queue_count(SpscQueue_t* q)
+{
+    uint32_t tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    uint32_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+
+    return tail - head;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file spsc_queue.h
+ * @brief Lock-Free Single-Producer/Single-Consumer Queue Header
+ *
+ * Fixed-size elements in a power-of-two ring supplied by the caller. One
+ * thread or core pushes, one pops; the indices live on separate cache
+ * lines and each side keeps a private copy of the other's index, so the
+ * shared lines only move when the cached view runs out.
+ *
+ * Plain C with GCC __atomic builtins and no BSP headers: the same code runs
+ * between the two A72 cores and between pthreads on a Linux host.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#define SPSC_CACHE_LINE     64
+
+typedef struct {
+    /* Consumer side */
+    uint32_t head __attribute__((aligned(SPSC_CACHE_LINE)));
+    uint32_t cached_tail;           /* Consumer's last view of tail */
+
+    /* Producer side */
+    uint32_t tail __attribute__((aligned(SPSC_CACHE_LINE)));
+    uint32_t cached_head;           /* Producer's last view of head */
+
+    /* Read-only after init */
+    uint8_t* storage __attribute__((aligned(SPSC_CACHE_LINE)));
+    uint32_t mask;                  /* capacity - 1 */
+    uint32_t elem_size;
+} SpscQueue_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief Initialize a queue over caller storage
+ * @param q Queue
+ * @param storage capacity * elem_size bytes
+ * @param capacity Number of elements (power of 2)
+ * @param elem_size Element size in bytes
+ * @return true on success, false on bad parameters
+ */
+bool spsc_queue_init(SpscQueue_t* q, void* storage, uint32_t capacity, uint32_t elem_size);
+
+/**
+ * @brief Append one element (producer only)
+ * @param q Queue
+ * @param elem Element to copy in
+ * @return true if queued, false if full
+ */
+bool spsc_queue_push(SpscQueue_t* q, const void* elem);
+
+/**
+ * @brief Remove the oldest element (consumer only)
+ * @param q Queue
+ * @param elem Output
+ * @return true if an element was removed, false if empty
+ */
+bool spsc_queue_pop(SpscQueue_t* q, void* elem);
+
+/**
+ * @brief Number of queued elements (exact only when both sides are idle)
+ * @param q Queue
+ * @return Element count
+ */
+uint32_t spsc_queue_count(SpscQueue_t* q);
+
+#endif /* SPSC_QUEUE_H */